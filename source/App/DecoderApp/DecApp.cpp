@@ -876,6 +876,9 @@ void DecApp::xCreateDecLib()
 #endif
   );
   m_cDecLib.setDecodedPictureHashSEIEnabled(m_decodedPictureHashSEIEnabled);
+  m_cDecLib.setNumThreads(m_numThreads);
+  m_cDecLib.setPipelinedDecoding(m_pipelinedDecoding);
+  m_cDecLib.setFrameParallelDecoding(m_frameParallelDecoding);
 
 
   if (!m_outputDecodedSEIMessagesFilename.empty())
@@ -999,6 +1002,8 @@ void DecApp::xWriteOutput( PicList* pcListPic, uint32_t tId )
           (!(pcPicTop->getPOC()%2) && pcPicBottom->getPOC() == pcPicTop->getPOC()+1) &&
           (pcPicTop->getPOC() == m_iPOCLastDisplay+1 || m_iPOCLastDisplay < 0))
       {
+        m_cDecLib.finishLoopFilters( pcPicTop );
+        m_cDecLib.finishLoopFilters( pcPicBottom );
         // write to file
         numPicsNotYetDisplayed = numPicsNotYetDisplayed-2;
         if ( !m_reconFileName.empty() )
@@ -1051,6 +1056,7 @@ void DecApp::xWriteOutput( PicList* pcListPic, uint32_t tId )
       if(pcPic->neededForOutput && pcPic->getPOC() >= m_iPOCLastDisplay &&
         (numPicsNotYetDisplayed >  maxNumReorderPicsHighestTid || dpbFullness > maxDecPicBufferingHighestTid))
       {
+        m_cDecLib.finishLoopFilters( pcPic );
         // write to file
         numPicsNotYetDisplayed--;
         if (!pcPic->referenced)
@@ -1174,6 +1180,7 @@ void DecApp::xFlushOutput( PicList* pcListPic, const int layerId )
   {
     return;
   }
+  m_cDecLib.finishLoopFilters();
   PicList::iterator iterPic   = pcListPic->begin();
 
   iterPic   = pcListPic->begin();
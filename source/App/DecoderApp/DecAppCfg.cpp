@@ -85,6 +85,9 @@ bool DecAppCfg::parseCfg( int argc, char* argv[] )
 #endif
 
   ("WarnUnknowParameter,w",     warnUnknowParameter,                   0,          "warn for unknown configuration parameters instead of failing")
+  ("Threads",                   m_numThreads,                          0,          "number of worker threads used for the substreams of a slice and the in-loop filters (0: single threaded)")
+  ("PipelinedDecoding",         m_pipelinedDecoding,                   true,       "parse, reconstruct and deblock the CTU rows of a slice as pipelined jobs on the worker threads")
+  ("FrameParallelDecoding",     m_frameParallelDecoding,               false,      "decode the next picture while SAO and ALF of the previous one run, motion compensation waits for the referenced CTU rows (needs Threads > 0)")
   ("SkipFrames,s",              m_iSkipFrame,                          0,          "number of frames to skip before random access")
   ("OutputBitDepth,d",          m_outputBitDepth[CHANNEL_TYPE_LUMA],   0,          "bit depth of YUV output luma component (default: use 0 for native depth)")
   ("OutputBitDepthC,d",         m_outputBitDepth[CHANNEL_TYPE_CHROMA], 0,          "bit depth of YUV output chroma component (default: use luma output bit-depth)")
@@ -277,6 +280,9 @@ DecAppCfg::DecAppCfg()
 , m_packedYUVMode(false)
 , m_statMode(0)
 , m_mctsCheck(false)
+, m_numThreads(0)
+, m_pipelinedDecoding(true)
+, m_frameParallelDecoding(false)
 {
   for (uint32_t channelTypeIndex = 0; channelTypeIndex < MAX_NUM_CHANNEL_TYPE; channelTypeIndex++)
   {
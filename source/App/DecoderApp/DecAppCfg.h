@@ -90,6 +90,9 @@ protected:
   std::string   m_cacheCfgFile;                       ///< Config file of cache model
   int           m_statMode;                           ///< Config statistic mode (0 - bit stat, 1 - tool stat, 3 - both)
   bool          m_mctsCheck;
+  int           m_numThreads;                         ///< number of worker threads, 0: single threaded
+  bool          m_pipelinedDecoding;                  ///< parse, reconstruct and deblock the CTU rows of a slice in separate jobs
+  bool          m_frameParallelDecoding;              ///< overlap SAO/ALF of a picture with the decoding of the next one
 
   int          m_upscaledOutput;                     ////< Output upscaled (2), decoded but in full resolution buffer (1) or decoded cropped (0, default) picture for RPR.
   int           m_targetSubPicIdx;                    ///< Specify which subpicture shall be write to output, using subpicture index
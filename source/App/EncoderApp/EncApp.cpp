@@ -707,6 +707,7 @@ void EncApp::xInitLibCfg()
   m_cEncLib.setAffine                                            ( m_Affine );
   m_cEncLib.setAffineType                                        ( m_AffineType );
   m_cEncLib.setAdaptBypassAffineMe                               ( m_adaptBypassAffineMe );
+  m_cEncLib.setAffineMeEarlyTerm                                 ( m_affineMeEarlyTerm );
   m_cEncLib.setPROF                                              ( m_PROF );
   m_cEncLib.setBIO                                               (m_BIO);
   m_cEncLib.setUseLMChroma                                       ( m_LMChroma );
@@ -797,6 +798,8 @@ void EncApp::xInitLibCfg()
   m_cEncLib.setUseMRL                                            ( m_MRL );
   m_cEncLib.setUseMIP                                            ( m_MIP );
   m_cEncLib.setUseFastMIP                                        ( m_useFastMIP );
+  m_cEncLib.setFastIntraGradHist                                 ( m_fastIntraGradHist );
+  m_cEncLib.setFastIntraCandReuse                                ( m_fastIntraCandReuse );
   m_cEncLib.setFastLocalDualTreeMode                             ( m_fastLocalDualTreeMode );
   m_cEncLib.setUseReconBasedCrossCPredictionEstimate             ( m_reconBasedCrossCPredictionEstimate );
   m_cEncLib.setUseTransformSkip                                  ( m_useTransformSkip      );
@@ -1188,6 +1191,8 @@ void EncApp::xInitLibCfg()
   m_cEncLib.setNnPostFilterSEIActivationEnabled                  (m_nnPostFilterSEIActivationEnabled);
   m_cEncLib.setNnPostFilterSEIActivationId                       (m_nnPostFilterSEIActivationId);
   m_cEncLib.setEntropyCodingSyncEnabledFlag                      ( m_entropyCodingSyncEnabledFlag );
+  m_cEncLib.setNumThreads                                        ( m_numThreads );
+  m_cEncLib.setParallelMeMinArea                                 ( m_parallelMeMinArea );
   m_cEncLib.setEntryPointPresentFlag                             ( m_entryPointPresentFlag );
   m_cEncLib.setTMVPModeId                                        ( m_TMVPModeId );
   m_cEncLib.setSliceLevelRpl                                     ( m_sliceLevelRpl  );
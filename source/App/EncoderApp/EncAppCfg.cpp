@@ -757,6 +757,8 @@ bool EncAppCfg::parseCfg( int argc, char* argv[] )
   ("help",                                            do_help,                                          false, "this help text")
   ("c",    po::parseConfigFile, "configuration file name")
   ("WarnUnknowParameter,w",                           warnUnknowParameter,                                  0, "warn for unknown configuration parameters instead of failing")
+  ("Threads",                                         m_numThreads,                                         0, "number of worker threads used for the in-loop filters and the parallel motion search (0: single threaded)")
+  ("ParallelMEMinArea",                               m_parallelMeMinArea,                                  0, "minimum luma area of a prediction unit whose reference picture searches run as parallel tasks, requires Threads > 0 (0: disabled)")
   ("isSDR",                                           sdr,                                              false, "compatibility")
 #if ENABLE_SIMD_OPT
   ("SIMD",                                            ignore,                                      string(""), "SIMD extension to use (SCALAR, SSE41, SSE42, AVX, AVX2, AVX512), default: the highest supported extension\n")
@@ -967,6 +969,7 @@ bool EncAppCfg::parseCfg( int argc, char* argv[] )
   ("Affine",                                          m_Affine,                                         false, "Enable affine prediction (0:off, 1:on)  [default: off]")
   ("AffineType",                                      m_AffineType,                                      true,  "Enable affine type prediction (0:off, 1:on)  [default: on]" )
   ("AdaptBypassAffineMe",                             m_adaptBypassAffineMe,                            false, "Adaptively bypass affine ME (0: off, 1:on, defaul: off]")
+  ("AffineMeEarlyTerm",                               m_affineMeEarlyTerm,                              false, "Stop the gradient iterations of the affine ME when the cost did not improve in two consecutive iterations (0: off, 1:on, default: off)")
   ("PROF",                                            m_PROF,                                           false, "Enable Prediction refinement with optical flow for affine mode (0:off, 1:on)  [default: off]")
   ("BIO",                                             m_BIO,                                            false, "Enable bi-directional optical flow")
   ("IMV",                                             m_ImvMode,                                            1, "Adaptive MV precision Mode (IMV)\n"
@@ -1055,6 +1058,8 @@ bool EncAppCfg::parseCfg( int argc, char* argv[] )
   ("MRL",                                             m_MRL,                                            false,  "Enable MRL (multiple reference line intra prediction)")
   ("MIP",                                             m_MIP,                                             true,  "Enable MIP (matrix-based intra prediction)")
   ("FastMIP",                                         m_useFastMIP,                                     false,  "Fast encoder search for MIP (matrix-based intra prediction)")
+  ("FastIntraGradHist",                               m_fastIntraGradHist,                              false,  "Prune the angular modes of the intra SATD pre-selection with a gradient orientation histogram of the original block")
+  ("FastIntraCandReuse",                              m_fastIntraCandReuse,                             false,  "Reuse the intra SATD candidate lists of a CU area reached again through another split path with the same MPMs and neighbour availability")
   ("FastLocalDualTreeMode",                           m_fastLocalDualTreeMode,                              0,  "Fast intra pass coding for local dual-tree in intra coding region, 0: off, 1: use threshold, 2: one intra mode only")
   ("SplitPredictAdaptMode",                           m_fastAdaptCostPredMode,                              0,  "Mode for split cost prediction, 0..2 (Default: 0)" )
   ("DisableFastTTfromBT",                             m_disableFastDecisionTT,                          false,  "Disable fast decision for TT from BT")
@@ -1084,7 +1089,7 @@ bool EncAppCfg::parseCfg( int argc, char* argv[] )
   ("IDRRefParamList",                                 m_idrRefParamList,                            false, "Enable indication of reference picture list syntax elements in slice headers of IDR pictures")
   // motion search options
   ("DisableIntraInInter",                             m_bDisableIntraPUsInInterSlices,                  false, "Flag to disable intra PUs in inter slices")
-  ("FastSearch",                                      tmpMotionEstimationSearchMethod,  int(MESEARCH_DIAMOND), "0:Full search 1:Diamond 2:Selective 3:Enhanced Diamond")
+  ("FastSearch",                                      tmpMotionEstimationSearchMethod,  int(MESEARCH_DIAMOND), "0:Full search 1:Diamond 2:Selective 3:Enhanced Diamond 4:Pyramid")
   ("SearchRange,-sr",                                 m_iSearchRange,                                      96, "Motion search range")
   ("BipredSearchRange",                               m_bipredSearchRange,                                  4, "Motion search range for bipred refinement")
   ("MinSearchWindow",                                 m_minSearchWindow,                                    8, "Minimum motion search window size for the adaptive window ME")
@@ -4970,6 +4975,7 @@ void EncAppCfg::xPrintParameter()
     {
       msg( VERBOSE, "AffineType:%d ", m_AffineType );
       msg( VERBOSE, "AdaptBypassAffineMe:%d ", m_adaptBypassAffineMe);
+      msg( VERBOSE, "AffineMeEarlyTerm:%d ", m_affineMeEarlyTerm);
     }
     msg(VERBOSE, "PROF:%d ", m_PROF);
     msg(VERBOSE, "SbTMVP:%d ", m_sbTmvpEnableFlag);
@@ -5072,6 +5078,8 @@ void EncAppCfg::xPrintParameter()
   msg( VERBOSE, "UseNonLinearAlfChroma:%d ", m_useNonLinearAlfChroma );
   msg( VERBOSE, "MaxNumAlfAlternativesChroma:%d ", m_maxNumAlfAlternativesChroma );
   if( m_MIP ) msg(VERBOSE, "FastMIP:%d ", m_useFastMIP);
+  msg( VERBOSE, "FastIntraGradHist:%d ", m_fastIntraGradHist );
+  msg( VERBOSE, "FastIntraCandReuse:%d ", m_fastIntraCandReuse );
   msg( VERBOSE, "TTFastSkip:%d ", m_ttFastSkip);
   msg( VERBOSE, "TTFastSkipThr:%.3f ", m_ttFastSkipThr);
   msg( VERBOSE, "FastLocalDualTree:%d ", m_fastLocalDualTreeMode );
@@ -346,6 +346,7 @@ protected:
   bool      m_Affine;
   bool      m_AffineType;
   bool      m_adaptBypassAffineMe;
+  bool      m_affineMeEarlyTerm;
   bool      m_PROF;
   bool      m_BIO;
   int       m_LMChroma;
@@ -426,6 +427,8 @@ protected:
   bool      m_MRL;
   bool      m_MIP;
   bool      m_useFastMIP;
+  bool      m_fastIntraGradHist;
+  bool      m_fastIntraCandReuse;
   int       m_fastLocalDualTreeMode;
 
   int       m_log2MaxTbSize;
@@ -503,6 +506,9 @@ protected:
   bool      m_entropyCodingSyncEnabledFlag;
   bool      m_entryPointPresentFlag;                          ///< flag for the presence of entry points
 
+  int       m_numThreads;                                     ///< number of worker threads, 0: single threaded
+  int       m_parallelMeMinArea;                              ///< minimum PU area for the parallel motion search, 0: disabled
+
   bool      m_bFastUDIUseMPMEnabled;
   bool      m_bFastMEForGenBLowDelayEnabled;
   bool      m_bUseBLambdaForNonKeyLowDelayPictures;
@@ -46,6 +46,7 @@ constexpr int AdaptiveLoopFilter::ALF_NUM_CLIP_VALS[];
 
 AdaptiveLoopFilter::AdaptiveLoopFilter()
   : m_classifier( nullptr )
+  , m_threadPool( nullptr )
 {
   for (size_t i = 0; i < NUM_DIRECTIONS; i++)
   {
@@ -66,6 +67,7 @@ AdaptiveLoopFilter::AdaptiveLoopFilter()
   m_filterCcAlf = filterBlkCcAlf<CC_ALF>;
   m_filter5x5Blk = filterBlk<ALF_FILTER_5>;
   m_filter7x7Blk = filterBlk<ALF_FILTER_7>;
+  m_accumulateCovariance = accumulateCovariance;
 
 #if ENABLE_SIMD_OPT_ALF
 #ifdef TARGET_SIMD_X86
@@ -74,6 +76,25 @@ AdaptiveLoopFilter::AdaptiveLoopFilter()
 #endif
 }
 
+/** accumulates the auto-correlation of the clipped filter inputs of two samples of the same class
+ * ePair holds input f = coeff * numBins + bin of the first sample at 2 * f and of the second sample at 2 * f + 1,
+ * zero padded to m_COV_ACC_STRIDE inputs. Row f0 is only updated for the columns of coefficients not below its own.
+ */
+void AdaptiveLoopFilter::accumulateCovariance(int *acc, const int16_t *ePair, const int numCoeff, const int numBins)
+{
+  const int size = numCoeff * numBins;
+  for (int f0 = 0; f0 < size; f0++)
+  {
+    const int e0     = ePair[2 * f0];
+    const int e1     = ePair[2 * f0 + 1];
+    int      *accRow = acc + f0 * m_COV_ACC_STRIDE;
+    for (int f1 = f0 - f0 % numBins; f1 < size; f1++)
+    {
+      accRow[f1] += e0 * ePair[2 * f1] + e1 * ePair[2 * f1 + 1];
+    }
+  }
+}
+
 bool AdaptiveLoopFilter::isCrossedByVirtualBoundaries( const CodingStructure& cs, const int xPos, const int yPos, const int width, const int height, bool& clipTop, bool& clipBottom, bool& clipLeft, bool& clipRight, int& numHorVirBndry, int& numVerVirBndry, int horVirBndryPos[], int verVirBndryPos[], int& rasterSliceAlfPad )
 {
   clipTop = false; clipBottom = false; clipLeft = false; clipRight = false;
@@ -302,14 +323,13 @@ void AdaptiveLoopFilter::applyCcAlfFilter(CodingStructure &cs, ComponentID compI
                                           const short filterSet[MAX_NUM_CC_ALF_FILTERS][MAX_NUM_CC_ALF_CHROMA_COEFF],
                                           const int   selectedFilterIdx)
 {
-  bool clipTop = false, clipBottom = false, clipLeft = false, clipRight = false;
-  int  numHorVirBndry = 0, numVerVirBndry = 0;
-  int  horVirBndryPos[] = { 0, 0, 0 };
-  int  verVirBndryPos[] = { 0, 0, 0 };
-
-  int ctuIdx = 0;
-  for( int yPos = 0; yPos < m_picHeight; yPos += m_maxCUHeight )
+  auto filterRow = [&]( const int yPos, PelStorage& tempBuf )
   {
+    bool clipTop = false, clipBottom = false, clipLeft = false, clipRight = false;
+    int  numHorVirBndry = 0, numVerVirBndry = 0;
+    int  horVirBndryPos[] = { 0, 0, 0 };
+    int  verVirBndryPos[] = { 0, 0, 0 };
+
     for( int xPos = 0; xPos < m_picWidth; xPos += m_maxCUWidth )
     {
       int filterIdx =
@@ -352,7 +372,7 @@ void AdaptiveLoopFilter::applyCcAlfFilter(CodingStructure &cs, ComponentID compI
               const bool clipR = (j == numVerVirBndry && clipRight) || (j < numVerVirBndry) || (xEnd == m_picWidth);
               const int  wBuf  = w + (clipL ? 0 : MAX_ALF_PADDING_SIZE) + (clipR ? 0 : MAX_ALF_PADDING_SIZE);
               const int  hBuf  = h + (clipT ? 0 : MAX_ALF_PADDING_SIZE) + (clipB ? 0 : MAX_ALF_PADDING_SIZE);
-              PelUnitBuf buf   = m_tempBuf2.subBuf(UnitArea(cs.area.chromaFormat, Area(0, 0, wBuf, hBuf)));
+              PelUnitBuf buf   = tempBuf.subBuf(UnitArea(cs.area.chromaFormat, Area(0, 0, wBuf, hBuf)));
               buf.copyFrom(recYuvExt.subBuf(
                 UnitArea(cs.area.chromaFormat, Area(xStart - (clipL ? 0 : MAX_ALF_PADDING_SIZE),
                                                     yStart - (clipT ? 0 : MAX_ALF_PADDING_SIZE), wBuf, hBuf))));
@@ -394,7 +414,23 @@ void AdaptiveLoopFilter::applyCcAlfFilter(CodingStructure &cs, ComponentID compI
                         m_alfVBLumaPos);
         }
       }
-      ctuIdx++;
+    }
+  };
+
+  if( m_threadPool && m_threadPool->getNumThreads() > 0 )
+  {
+    createThreadBufs();
+    for( int yPos = 0; yPos < m_picHeight; yPos += m_maxCUHeight )
+    {
+      m_threadPool->addJob( [this, &filterRow, yPos]( int threadIdx ) { filterRow( yPos, m_threadBufs[threadIdx]->tempBuf ); } );
+    }
+    m_threadPool->waitForJobs();
+  }
+  else
+  {
+    for( int yPos = 0; yPos < m_picHeight; yPos += m_maxCUHeight )
+    {
+      filterRow( yPos, m_tempBuf2 );
     }
   }
 }
@@ -411,8 +447,6 @@ void AdaptiveLoopFilter::ALFProcess(CodingStructure& cs)
     m_ctuEnableFlag[compIdx] = cs.picture->getAlfCtuEnableFlag( compIdx );
     m_ctuAlternative[compIdx] = cs.picture->getAlfCtuAlternativeData( compIdx );
   }
-  short* alfCtuFilterIndex = nullptr;
-  uint32_t lastSliceIdx = 0xFFFFFFFF;
 
   PelUnitBuf recYuv = cs.getRecoBuf();
   m_tempBuf.copyFrom( recYuv );
@@ -421,11 +455,9 @@ void AdaptiveLoopFilter::ALFProcess(CodingStructure& cs)
 
   const PreCalcValues& pcv = *cs.pcv;
 
-  int ctuIdx = 0;
-  bool clipTop = false, clipBottom = false, clipLeft = false, clipRight = false;
-  int numHorVirBndry = 0, numVerVirBndry = 0;
-  int horVirBndryPos[] = { 0, 0, 0 };
-  int verVirBndryPos[] = { 0, 0, 0 };
+  // the ALF APSs are loaded once per slice and all CTUs of the slice are filtered before the next slice is loaded
+  std::vector<uint32_t> filteredSlices;
+  Slice* lastAlfSlice = nullptr;
 
   for( int yPos = 0; yPos < pcv.lumaHeight; yPos += pcv.maxCUHeight )
   {
@@ -437,135 +469,142 @@ void AdaptiveLoopFilter::ALFProcess(CodingStructure& cs)
       // skip this CTU if ALF is disabled
       if (!cu->slice->getAlfEnabledFlag(COMPONENT_Y) && !cu->slice->getAlfEnabledFlag(COMPONENT_Cb) && !cu->slice->getAlfEnabledFlag(COMPONENT_Cr))
       {
-        ctuIdx++;
         continue;
       }
+      lastAlfSlice = cu->slice;
 
-      // reload ALF APS each time the slice changes during raster scan filtering
-      if(ctuIdx == 0 || lastSliceIdx != cu->slice->getSliceID() || alfCtuFilterIndex==nullptr)
+      if( std::find( filteredSlices.begin(), filteredSlices.end(), cu->slice->getSliceID() ) != filteredSlices.end() )
       {
-        cs.slice = cu->slice;
-        reconstructCoeffAPSs(cs, true, cu->slice->getAlfEnabledFlag(COMPONENT_Cb) || cu->slice->getAlfEnabledFlag(COMPONENT_Cr), false);
-        alfCtuFilterIndex = cu->slice->getPic()->getAlfCtbFilterIndex();
-        m_ccAlfFilterParam = cu->slice->m_ccAlfFilterParam;
+        continue;
       }
-      lastSliceIdx = cu->slice->getSliceID();
+      filteredSlices.push_back( cu->slice->getSliceID() );
 
-      const int width = ( xPos + pcv.maxCUWidth > pcv.lumaWidth ) ? ( pcv.lumaWidth - xPos ) : pcv.maxCUWidth;
-      const int height = ( yPos + pcv.maxCUHeight > pcv.lumaHeight ) ? ( pcv.lumaHeight - yPos ) : pcv.maxCUHeight;
-      bool ctuEnableFlag = m_ctuEnableFlag[COMPONENT_Y][ctuIdx];
-      for( int compIdx = 1; compIdx < MAX_NUM_COMPONENT; compIdx++ )
-      {
-        ctuEnableFlag |= m_ctuEnableFlag[compIdx][ctuIdx] > 0;
-        if (cu->slice->m_ccAlfFilterParam.ccAlfFilterEnabled[compIdx - 1])
-        {
-          ctuEnableFlag |= m_ccAlfFilterControl[compIdx - 1][ctuIdx] > 0;
-        }
-      }
-      int rasterSliceAlfPad = 0;
-      if( ctuEnableFlag && isCrossedByVirtualBoundaries( cs, xPos, yPos, width, height, clipTop, clipBottom, clipLeft, clipRight, numHorVirBndry, numVerVirBndry, horVirBndryPos, verVirBndryPos, rasterSliceAlfPad ) )
-      {
-        int yStart = yPos;
-        for( int i = 0; i <= numHorVirBndry; i++ )
-        {
-          const int yEnd = i == numHorVirBndry ? yPos + height : horVirBndryPos[i];
-          const int h = yEnd - yStart;
-          const bool clipT = ( i == 0 && clipTop ) || ( i > 0 ) || ( yStart == 0 );
-          const bool clipB = ( i == numHorVirBndry && clipBottom ) || ( i < numHorVirBndry ) || ( yEnd == pcv.lumaHeight );
-          int xStart = xPos;
-          for( int j = 0; j <= numVerVirBndry; j++ )
-          {
-            const int xEnd = j == numVerVirBndry ? xPos + width : verVirBndryPos[j];
-            const int w = xEnd - xStart;
-            const bool clipL = ( j == 0 && clipLeft ) || ( j > 0 ) || ( xStart == 0 );
-            const bool clipR = ( j == numVerVirBndry && clipRight ) || ( j < numVerVirBndry ) || ( xEnd == pcv.lumaWidth );
-            const int wBuf = w + (clipL ? 0 : MAX_ALF_PADDING_SIZE) + (clipR ? 0 : MAX_ALF_PADDING_SIZE);
-            const int hBuf = h + (clipT ? 0 : MAX_ALF_PADDING_SIZE) + (clipB ? 0 : MAX_ALF_PADDING_SIZE);
-            PelUnitBuf buf = m_tempBuf2.subBuf( UnitArea( cs.area.chromaFormat, Area( 0, 0, wBuf, hBuf ) ) );
-            buf.copyFrom( tmpYuv.subBuf( UnitArea( cs.area.chromaFormat, Area( xStart - (clipL ? 0 : MAX_ALF_PADDING_SIZE), yStart - (clipT ? 0 : MAX_ALF_PADDING_SIZE), wBuf, hBuf ) ) ) );
-            // pad top-left unavailable samples for raster slice
-            if ( xStart == xPos && yStart == yPos && ( rasterSliceAlfPad & 1 ) )
-            {
-              buf.padBorderPel( MAX_ALF_PADDING_SIZE, 1 );
-            }
+      cs.slice = cu->slice;
+      reconstructCoeffAPSs(cs, true, cu->slice->getAlfEnabledFlag(COMPONENT_Cb) || cu->slice->getAlfEnabledFlag(COMPONENT_Cr), false);
+      m_ccAlfFilterParam = cu->slice->m_ccAlfFilterParam;
 
-            // pad bottom-right unavailable samples for raster slice
-            if ( xEnd == xPos + width && yEnd == yPos + height && ( rasterSliceAlfPad & 2 ) )
-            {
-              buf.padBorderPel( MAX_ALF_PADDING_SIZE, 2 );
-            }
-            buf.extendBorderPel( MAX_ALF_PADDING_SIZE );
-            buf = buf.subBuf( UnitArea ( cs.area.chromaFormat, Area( clipL ? 0 : MAX_ALF_PADDING_SIZE, clipT ? 0 : MAX_ALF_PADDING_SIZE, w, h ) ) );
+      filterCTURows( cs, recYuv, tmpYuv, cu->slice->getPic()->getAlfCtbFilterIndex(), true, true, cu->slice );
+    }
+  }
 
-            if( m_ctuEnableFlag[COMPONENT_Y][ctuIdx] )
-            {
-              const Area blkSrc( 0, 0, w, h );
-              const Area blkDst( xStart, yStart, w, h );
-              deriveClassification( m_classifier, buf.get(COMPONENT_Y), blkDst, blkSrc );
-              short filterSetIndex = alfCtuFilterIndex[ctuIdx];
-              short *coeff;
-              Pel *clip;
-              if (filterSetIndex >= NUM_FIXED_FILTER_SETS)
-              {
-                coeff = m_coeffApsLuma[filterSetIndex - NUM_FIXED_FILTER_SETS];
-                clip = m_clippApsLuma[filterSetIndex - NUM_FIXED_FILTER_SETS];
-              }
-              else
-              {
-                coeff = m_fixedFilterSetCoeffDec[filterSetIndex];
-                clip = m_clipDefault;
-              }
-              m_filter7x7Blk(m_classifier, recYuv, buf, blkDst, blkSrc, COMPONENT_Y, coeff, clip, m_clpRngs.comp[COMPONENT_Y], cs
-                , m_alfVBLumaCTUHeight
-                , m_alfVBLumaPos
-              );
-            }
+  if( lastAlfSlice )
+  {
+    cs.slice = lastAlfSlice;
+  }
+}
 
-            for( int compIdx = 1; compIdx < MAX_NUM_COMPONENT; compIdx++ )
-            {
-              ComponentID compID = ComponentID( compIdx );
-              const int chromaScaleX = getComponentScaleX( compID, tmpYuv.chromaFormat );
-              const int chromaScaleY = getComponentScaleY( compID, tmpYuv.chromaFormat );
+/** filters the CTU rows of a picture, either serially or as one job per CTU row
+ * \param slice if not null, only the CTUs of this slice are filtered
+ */
+void AdaptiveLoopFilter::filterCTURows( CodingStructure& cs, const PelUnitBuf& recDst, const CPelUnitBuf& recSrc,
+                                        const short* alfCtuFilterIndex, const bool classify, const bool applyCcAlf,
+                                        const Slice* slice )
+{
+  const PreCalcValues& pcv = *cs.pcv;
 
-              if( m_ctuEnableFlag[compIdx][ctuIdx] )
-              {
-                const Area blkSrc( 0, 0, w >> chromaScaleX, h >> chromaScaleY );
-                const Area blkDst( xStart >> chromaScaleX, yStart >> chromaScaleY, w >> chromaScaleX, h >> chromaScaleY );
-                uint8_t alt_num = m_ctuAlternative[compIdx][ctuIdx];
-                m_filter5x5Blk(m_classifier, recYuv, buf, blkDst, blkSrc, compID, m_chromaCoeffFinal[alt_num], m_chromaClippFinal[alt_num], m_clpRngs.comp[compIdx], cs
-                  , m_alfVBChmaCTUHeight
-                   , m_alfVBChmaPos );
-              }
-              if (cu->slice->m_ccAlfFilterParam.ccAlfFilterEnabled[compIdx - 1])
-              {
-                const int filterIdx = m_ccAlfFilterControl[compIdx - 1][ctuIdx];
+  auto filterRow = [&]( const int yPos, PelStorage& tempBuf, int** laplacian[NUM_DIRECTIONS] )
+  {
+    int ctuIdx = ( yPos / pcv.maxCUHeight ) * pcv.widthInCtus;
+    for( int xPos = 0; xPos < pcv.lumaWidth; xPos += pcv.maxCUWidth, ctuIdx++ )
+    {
+      if( slice == nullptr || cs.getCU( Position( xPos, yPos ), CHANNEL_TYPE_LUMA )->slice == slice )
+      {
+        filterCTU( cs, recDst, recSrc, ctuIdx, xPos, yPos, alfCtuFilterIndex, classify, applyCcAlf, tempBuf, laplacian );
+      }
+    }
+  };
 
-                if (filterIdx != 0)
-                {
-                  const Area blkSrc(0, 0, w, h);
-                  Area blkDst(xStart >> chromaScaleX, yStart >> chromaScaleY, w >> chromaScaleX, h >> chromaScaleY);
+  if( m_threadPool && m_threadPool->getNumThreads() > 0 )
+  {
+    createThreadBufs();
+    for( int yPos = 0; yPos < pcv.lumaHeight; yPos += pcv.maxCUHeight )
+    {
+      m_threadPool->addJob( [this, &filterRow, yPos]( int threadIdx )
+      {
+        filterRow( yPos, m_threadBufs[threadIdx]->tempBuf, m_threadBufs[threadIdx]->laplacian );
+      } );
+    }
+    m_threadPool->waitForJobs();
+  }
+  else
+  {
+    for( int yPos = 0; yPos < pcv.lumaHeight; yPos += pcv.maxCUHeight )
+    {
+      filterRow( yPos, m_tempBuf2, m_laplacian );
+    }
+  }
+}
 
-                  const int16_t *filterCoeff = m_ccAlfFilterParam.ccAlfCoeff[compIdx - 1][filterIdx - 1];
+/** applies ALF and, if applyCcAlf is set, CC-ALF to one CTU
+ * The samples are read from recSrc, which has to be padded, and written to recDst. CTUs crossed by virtual
+ * boundaries are filtered through tempBuf.
+ */
+void AdaptiveLoopFilter::filterCTU( CodingStructure& cs, const PelUnitBuf& recDst, const CPelUnitBuf& recSrc,
+                                    const int ctuIdx, const int xPos, const int yPos, const short* alfCtuFilterIndex,
+                                    const bool classify, const bool applyCcAlf, PelStorage& tempBuf,
+                                    int** laplacian[NUM_DIRECTIONS] )
+{
+  const PreCalcValues& pcv = *cs.pcv;
 
-                  m_filterCcAlf(recYuv.get(compID), buf, blkDst, blkSrc, compID, filterCoeff, m_clpRngs, cs,
-                                m_alfVBLumaCTUHeight, m_alfVBLumaPos);
-                }
-              }
-            }
+  bool clipTop = false, clipBottom = false, clipLeft = false, clipRight = false;
+  int numHorVirBndry = 0, numVerVirBndry = 0;
+  int horVirBndryPos[] = { 0, 0, 0 };
+  int verVirBndryPos[] = { 0, 0, 0 };
 
-            xStart = xEnd;
-          }
+  const int width = ( xPos + pcv.maxCUWidth > pcv.lumaWidth ) ? ( pcv.lumaWidth - xPos ) : pcv.maxCUWidth;
+  const int height = ( yPos + pcv.maxCUHeight > pcv.lumaHeight ) ? ( pcv.lumaHeight - yPos ) : pcv.maxCUHeight;
+  bool ctuEnableFlag = m_ctuEnableFlag[COMPONENT_Y][ctuIdx];
+  for( int compIdx = 1; compIdx < MAX_NUM_COMPONENT; compIdx++ )
+  {
+    ctuEnableFlag |= m_ctuEnableFlag[compIdx][ctuIdx] > 0;
+    if (applyCcAlf && m_ccAlfFilterParam.ccAlfFilterEnabled[compIdx - 1])
+    {
+      ctuEnableFlag |= m_ccAlfFilterControl[compIdx - 1][ctuIdx] > 0;
+    }
+  }
+  int rasterSliceAlfPad = 0;
+  if( ctuEnableFlag && isCrossedByVirtualBoundaries( cs, xPos, yPos, width, height, clipTop, clipBottom, clipLeft, clipRight, numHorVirBndry, numVerVirBndry, horVirBndryPos, verVirBndryPos, rasterSliceAlfPad ) )
+  {
+    int yStart = yPos;
+    for( int i = 0; i <= numHorVirBndry; i++ )
+    {
+      const int yEnd = i == numHorVirBndry ? yPos + height : horVirBndryPos[i];
+      const int h = yEnd - yStart;
+      const bool clipT = ( i == 0 && clipTop ) || ( i > 0 ) || ( yStart == 0 );
+      const bool clipB = ( i == numHorVirBndry && clipBottom ) || ( i < numHorVirBndry ) || ( yEnd == pcv.lumaHeight );
+      int xStart = xPos;
+      for( int j = 0; j <= numVerVirBndry; j++ )
+      {
+        const int xEnd = j == numVerVirBndry ? xPos + width : verVirBndryPos[j];
+        const int w = xEnd - xStart;
+        const bool clipL = ( j == 0 && clipLeft ) || ( j > 0 ) || ( xStart == 0 );
+        const bool clipR = ( j == numVerVirBndry && clipRight ) || ( j < numVerVirBndry ) || ( xEnd == pcv.lumaWidth );
+        const int wBuf = w + (clipL ? 0 : MAX_ALF_PADDING_SIZE) + (clipR ? 0 : MAX_ALF_PADDING_SIZE);
+        const int hBuf = h + (clipT ? 0 : MAX_ALF_PADDING_SIZE) + (clipB ? 0 : MAX_ALF_PADDING_SIZE);
+        PelUnitBuf buf = tempBuf.subBuf( UnitArea( cs.area.chromaFormat, Area( 0, 0, wBuf, hBuf ) ) );
+        buf.copyFrom( recSrc.subBuf( UnitArea( cs.area.chromaFormat, Area( xStart - (clipL ? 0 : MAX_ALF_PADDING_SIZE), yStart - (clipT ? 0 : MAX_ALF_PADDING_SIZE), wBuf, hBuf ) ) ) );
+        // pad top-left unavailable samples for raster slice
+        if ( xStart == xPos && yStart == yPos && ( rasterSliceAlfPad & 1 ) )
+        {
+          buf.padBorderPel( MAX_ALF_PADDING_SIZE, 1 );
+        }
 
-          yStart = yEnd;
+        // pad bottom-right unavailable samples for raster slice
+        if ( xEnd == xPos + width && yEnd == yPos + height && ( rasterSliceAlfPad & 2 ) )
+        {
+          buf.padBorderPel( MAX_ALF_PADDING_SIZE, 2 );
         }
-      }
-      else
-      {
-        const UnitArea area( cs.area.chromaFormat, Area( xPos, yPos, width, height ) );
+        buf.extendBorderPel( MAX_ALF_PADDING_SIZE );
+        buf = buf.subBuf( UnitArea ( cs.area.chromaFormat, Area( clipL ? 0 : MAX_ALF_PADDING_SIZE, clipT ? 0 : MAX_ALF_PADDING_SIZE, w, h ) ) );
+
         if( m_ctuEnableFlag[COMPONENT_Y][ctuIdx] )
         {
-          Area blk( xPos, yPos, width, height );
-          deriveClassification( m_classifier, tmpYuv.get( COMPONENT_Y ), blk, blk );
+          const Area blkSrc( 0, 0, w, h );
+          const Area blkDst( xStart, yStart, w, h );
+          if( classify )
+          {
+            deriveClassification( m_classifier, buf.get(COMPONENT_Y), blkDst, blkSrc, laplacian );
+          }
           short filterSetIndex = alfCtuFilterIndex[ctuIdx];
           short *coeff;
           Pel *clip;
@@ -579,42 +618,138 @@ void AdaptiveLoopFilter::ALFProcess(CodingStructure& cs)
             coeff = m_fixedFilterSetCoeffDec[filterSetIndex];
             clip = m_clipDefault;
           }
-          m_filter7x7Blk(m_classifier, recYuv, tmpYuv, blk, blk, COMPONENT_Y, coeff, clip, m_clpRngs.comp[COMPONENT_Y],
-                         cs, m_alfVBLumaCTUHeight, m_alfVBLumaPos);
+          m_filter7x7Blk(m_classifier, recDst, buf, blkDst, blkSrc, COMPONENT_Y, coeff, clip, m_clpRngs.comp[COMPONENT_Y], cs
+            , m_alfVBLumaCTUHeight
+            , m_alfVBLumaPos
+          );
         }
 
         for( int compIdx = 1; compIdx < MAX_NUM_COMPONENT; compIdx++ )
         {
           ComponentID compID = ComponentID( compIdx );
-          const int chromaScaleX = getComponentScaleX( compID, tmpYuv.chromaFormat );
-          const int chromaScaleY = getComponentScaleY( compID, tmpYuv.chromaFormat );
+          const int chromaScaleX = getComponentScaleX( compID, recDst.chromaFormat );
+          const int chromaScaleY = getComponentScaleY( compID, recDst.chromaFormat );
 
-          if (m_ctuEnableFlag[compIdx][ctuIdx])
+          if( m_ctuEnableFlag[compIdx][ctuIdx] )
           {
-            Area    blk(xPos >> chromaScaleX, yPos >> chromaScaleY, width >> chromaScaleX, height >> chromaScaleY);
+            const Area blkSrc( 0, 0, w >> chromaScaleX, h >> chromaScaleY );
+            const Area blkDst( xStart >> chromaScaleX, yStart >> chromaScaleY, w >> chromaScaleX, h >> chromaScaleY );
             uint8_t alt_num = m_ctuAlternative[compIdx][ctuIdx];
-            m_filter5x5Blk(m_classifier, recYuv, tmpYuv, blk, blk, compID, m_chromaCoeffFinal[alt_num],
-                           m_chromaClippFinal[alt_num], m_clpRngs.comp[compIdx], cs, m_alfVBChmaCTUHeight,
-                           m_alfVBChmaPos);
+            m_filter5x5Blk(m_classifier, recDst, buf, blkDst, blkSrc, compID, m_chromaCoeffFinal[alt_num], m_chromaClippFinal[alt_num], m_clpRngs.comp[compIdx], cs
+              , m_alfVBChmaCTUHeight
+               , m_alfVBChmaPos );
           }
-          if (cu->slice->m_ccAlfFilterParam.ccAlfFilterEnabled[compIdx - 1])
+          if (applyCcAlf && m_ccAlfFilterParam.ccAlfFilterEnabled[compIdx - 1])
           {
             const int filterIdx = m_ccAlfFilterControl[compIdx - 1][ctuIdx];
 
             if (filterIdx != 0)
             {
-              Area blkDst(xPos >> chromaScaleX, yPos >> chromaScaleY, width >> chromaScaleX, height >> chromaScaleY);
-              Area blkSrc(xPos, yPos, width, height);
+              const Area blkSrc(0, 0, w, h);
+              Area blkDst(xStart >> chromaScaleX, yStart >> chromaScaleY, w >> chromaScaleX, h >> chromaScaleY);
 
               const int16_t *filterCoeff = m_ccAlfFilterParam.ccAlfCoeff[compIdx - 1][filterIdx - 1];
 
-              m_filterCcAlf(recYuv.get(compID), tmpYuv, blkDst, blkSrc, compID, filterCoeff, m_clpRngs, cs,
+              m_filterCcAlf(recDst.get(compID), buf, blkDst, blkSrc, compID, filterCoeff, m_clpRngs, cs,
                             m_alfVBLumaCTUHeight, m_alfVBLumaPos);
             }
           }
         }
+
+        xStart = xEnd;
+      }
+
+      yStart = yEnd;
+    }
+  }
+  else
+  {
+    const UnitArea area( cs.area.chromaFormat, Area( xPos, yPos, width, height ) );
+    if( m_ctuEnableFlag[COMPONENT_Y][ctuIdx] )
+    {
+      Area blk( xPos, yPos, width, height );
+      if( classify )
+      {
+        deriveClassification( m_classifier, recSrc.get( COMPONENT_Y ), blk, blk, laplacian );
+      }
+      short filterSetIndex = alfCtuFilterIndex[ctuIdx];
+      short *coeff;
+      Pel *clip;
+      if (filterSetIndex >= NUM_FIXED_FILTER_SETS)
+      {
+        coeff = m_coeffApsLuma[filterSetIndex - NUM_FIXED_FILTER_SETS];
+        clip = m_clippApsLuma[filterSetIndex - NUM_FIXED_FILTER_SETS];
+      }
+      else
+      {
+        coeff = m_fixedFilterSetCoeffDec[filterSetIndex];
+        clip = m_clipDefault;
+      }
+      m_filter7x7Blk(m_classifier, recDst, recSrc, blk, blk, COMPONENT_Y, coeff, clip, m_clpRngs.comp[COMPONENT_Y],
+                     cs, m_alfVBLumaCTUHeight, m_alfVBLumaPos);
+    }
+
+    for( int compIdx = 1; compIdx < MAX_NUM_COMPONENT; compIdx++ )
+    {
+      ComponentID compID = ComponentID( compIdx );
+      const int chromaScaleX = getComponentScaleX( compID, recDst.chromaFormat );
+      const int chromaScaleY = getComponentScaleY( compID, recDst.chromaFormat );
+
+      if (m_ctuEnableFlag[compIdx][ctuIdx])
+      {
+        Area    blk(xPos >> chromaScaleX, yPos >> chromaScaleY, width >> chromaScaleX, height >> chromaScaleY);
+        uint8_t alt_num = m_ctuAlternative[compIdx][ctuIdx];
+        m_filter5x5Blk(m_classifier, recDst, recSrc, blk, blk, compID, m_chromaCoeffFinal[alt_num],
+                       m_chromaClippFinal[alt_num], m_clpRngs.comp[compIdx], cs, m_alfVBChmaCTUHeight,
+                       m_alfVBChmaPos);
+      }
+      if (applyCcAlf && m_ccAlfFilterParam.ccAlfFilterEnabled[compIdx - 1])
+      {
+        const int filterIdx = m_ccAlfFilterControl[compIdx - 1][ctuIdx];
+
+        if (filterIdx != 0)
+        {
+          Area blkDst(xPos >> chromaScaleX, yPos >> chromaScaleY, width >> chromaScaleX, height >> chromaScaleY);
+          Area blkSrc(xPos, yPos, width, height);
+
+          const int16_t *filterCoeff = m_ccAlfFilterParam.ccAlfCoeff[compIdx - 1][filterIdx - 1];
+
+          m_filterCcAlf(recDst.get(compID), recSrc, blkDst, blkSrc, compID, filterCoeff, m_clpRngs, cs,
+                        m_alfVBLumaCTUHeight, m_alfVBLumaPos);
+        }
       }
-      ctuIdx++;
+    }
+  }
+}
+
+void AdaptiveLoopFilter::createThreadBufs()
+{
+  while( m_threadBufs.size() < m_threadPool->getNumThreadSlots() )
+  {
+    CtuFilterBuf* threadBuf = new CtuFilterBuf;
+    threadBuf->tempBuf.create( m_chromaFormat, Area( 0, 0, m_maxCUWidth + (MAX_ALF_PADDING_SIZE << 1), m_maxCUHeight + (MAX_ALF_PADDING_SIZE << 1) ), m_maxCUWidth, MAX_ALF_PADDING_SIZE, 0, false );
+    m_threadBufs.push_back( threadBuf );
+  }
+}
+
+void AdaptiveLoopFilter::destroyThreadBufs()
+{
+  for( auto &threadBuf : m_threadBufs )
+  {
+    threadBuf->tempBuf.destroy();
+    delete threadBuf;
+  }
+  m_threadBufs.clear();
+}
+
+AdaptiveLoopFilter::CtuFilterBuf::CtuFilterBuf()
+{
+  for (size_t i = 0; i < NUM_DIRECTIONS; i++)
+  {
+    laplacian[i] = laplacianPtr[i];
+    for (size_t j = 0; j < sizeof(laplacianPtr[i]) / sizeof(laplacianPtr[i][0]); j++)
+    {
+      laplacianPtr[i][j] = laplacianData[i][j];
     }
   }
 }
@@ -807,6 +942,7 @@ void AdaptiveLoopFilter::destroy()
 
   m_tempBuf.destroy();
   m_tempBuf2.destroy();
+  destroyThreadBufs();
   m_filterShapes[CHANNEL_TYPE_LUMA].clear();
   m_filterShapes[CHANNEL_TYPE_CHROMA].clear();
   m_created = false;
@@ -826,7 +962,8 @@ void AdaptiveLoopFilter::destroy()
   }
 }
 
-void AdaptiveLoopFilter::deriveClassification( AlfClassifier** classifier, const CPelBuf& srcLuma, const Area& blkDst, const Area& blk )
+void AdaptiveLoopFilter::deriveClassification( AlfClassifier** classifier, const CPelBuf& srcLuma, const Area& blkDst, const Area& blk,
+                                               int** laplacian[NUM_DIRECTIONS] )
 {
   int height = blk.pos().y + blk.height;
   int width = blk.pos().x + blk.width;
@@ -838,7 +975,7 @@ void AdaptiveLoopFilter::deriveClassification( AlfClassifier** classifier, const
     for( int j = blk.pos().x; j < width; j += m_CLASSIFICATION_BLK_SIZE )
     {
       int nWidth = std::min( j + m_CLASSIFICATION_BLK_SIZE, width ) - j;
-      m_deriveClassificationBlk(classifier, m_laplacian, srcLuma, Area( j - blk.pos().x + blkDst.pos().x, i - blk.pos().y + blkDst.pos().y, nWidth, nHeight ), Area(j, i, nWidth, nHeight), m_inputBitDepth[CHANNEL_TYPE_LUMA] + 4
+      m_deriveClassificationBlk(classifier, laplacian, srcLuma, Area( j - blk.pos().x + blkDst.pos().x, i - blk.pos().y + blkDst.pos().y, nWidth, nHeight ), Area(j, i, nWidth, nHeight), m_inputBitDepth[CHANNEL_TYPE_LUMA] + 4
         , m_alfVBLumaCTUHeight
         , m_alfVBLumaPos
       );
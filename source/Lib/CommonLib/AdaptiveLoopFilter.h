@@ -42,6 +42,7 @@
 
 #include "Unit.h"
 #include "UnitTools.h"
+#include "ThreadPool.h"
 
 struct AlfClassifier
 {
@@ -77,18 +78,26 @@ public:
 
   static constexpr int   m_NUM_BITS = 8;
   static constexpr int   m_CLASSIFICATION_BLK_SIZE = 32;   // non-normative, local buffer size
+  static constexpr int   m_COV_ACC_STRIDE = 56;   // non-normative, row stride of the integer covariance accumulators
 
   AdaptiveLoopFilter();
-  virtual ~AdaptiveLoopFilter() {}
+  virtual ~AdaptiveLoopFilter() { destroyThreadBufs(); }
   void reconstructCoeffAPSs(CodingStructure& cs, bool luma, bool chroma, bool isRdo);
   void reconstructCoeff(AlfParam& alfParam, ChannelType channel, const bool isRdo, const bool isRedo = false);
   void ALFProcess(CodingStructure& cs);
   void create( const int picWidth, const int picHeight, const ChromaFormat format, const int maxCUWidth, const int maxCUHeight, const int maxCUDepth, const int inputBitDepth[MAX_NUM_CHANNEL_TYPE] );
   void destroy();
+  /// ALFProcess and the reconstruction of the encoder filter CTU rows in parallel if the thread pool has worker threads
+  void setThreadPool( ThreadPool* threadPool ) { m_threadPool = threadPool; }
   static void deriveClassificationBlk(AlfClassifier **classifier, int **laplacian[NUM_DIRECTIONS],
                                       const CPelBuf &srcLuma, const Area &blkDst, const Area &blk, const int shift,
                                       const int vbCTUHeight, int vbPos);
-  void deriveClassification( AlfClassifier** classifier, const CPelBuf& srcLuma, const Area& blkDst, const Area& blk );
+  void deriveClassification( AlfClassifier** classifier, const CPelBuf& srcLuma, const Area& blkDst, const Area& blk )
+  {
+    deriveClassification( classifier, srcLuma, blkDst, blk, m_laplacian );
+  }
+  void deriveClassification( AlfClassifier** classifier, const CPelBuf& srcLuma, const Area& blkDst, const Area& blk,
+                             int** laplacian[NUM_DIRECTIONS] );
   template<AlfFilterType filtTypeCcAlf>
   static void filterBlkCcAlf(const PelBuf &dstBuf, const CPelUnitBuf &recSrc, const Area &blkDst, const Area &blkSrc,
                              const ComponentID compId, const int16_t *filterCoeff, const ClpRngs &clpRngs,
@@ -99,6 +108,7 @@ public:
                         const Area &blkDst, const Area &blk, const ComponentID compId, const short *filterSet,
                        const Pel *fClipSet, const ClpRng &clpRng, CodingStructure &cs, const int vbCTUHeight,
                        int vbPos);
+  static void accumulateCovariance(int *acc, const int16_t *ePair, const int numCoeff, const int numBins);
   void (*m_deriveClassificationBlk)(AlfClassifier **classifier, int **laplacian[NUM_DIRECTIONS], const CPelBuf &srcLuma,
                                     const Area &blkDst, const Area &blk, const int shift, const int vbCTUHeight,
                                     int vbPos);
@@ -121,6 +131,10 @@ public:
                          const Pel *fClipSet, const ClpRng &clpRng, CodingStructure &cs, const int vbCTUHeight,
                          int vbPos);
 
+  // adds the products of two samples' clipped filter inputs to the upper block triangle of an integer
+  // auto-correlation matrix, used by the encoder statistics collection
+  void (*m_accumulateCovariance)(int *acc, const int16_t *ePair, const int numCoeff, const int numBins);
+
 #ifdef TARGET_SIMD_X86
   void initAdaptiveLoopFilterX86();
   template <X86_VEXT vext>
@@ -128,6 +142,24 @@ public:
 #endif
 
 protected:
+  // scratch buffers of the CTU filtering, one set is used per thread
+  struct CtuFilterBuf
+  {
+    CtuFilterBuf();
+    PelStorage tempBuf;
+    int**      laplacian[NUM_DIRECTIONS];
+    int*       laplacianPtr[NUM_DIRECTIONS][m_CLASSIFICATION_BLK_SIZE + 5];
+    int        laplacianData[NUM_DIRECTIONS][m_CLASSIFICATION_BLK_SIZE + 5][m_CLASSIFICATION_BLK_SIZE + 5];
+  };
+
+  void filterCTU( CodingStructure& cs, const PelUnitBuf& recDst, const CPelUnitBuf& recSrc, const int ctuIdx,
+                  const int xPos, const int yPos, const short* alfCtuFilterIndex, const bool classify,
+                  const bool applyCcAlf, PelStorage& tempBuf, int** laplacian[NUM_DIRECTIONS] );
+  void filterCTURows( CodingStructure& cs, const PelUnitBuf& recDst, const CPelUnitBuf& recSrc,
+                      const short* alfCtuFilterIndex, const bool classify, const bool applyCcAlf, const Slice* slice );
+  void createThreadBufs();
+  void destroyThreadBufs();
+
   bool isCrossedByVirtualBoundaries( const CodingStructure& cs, const int xPos, const int yPos, const int width, const int height, bool& clipTop, bool& clipBottom, bool& clipLeft, bool& clipRight, int& numHorVirBndry, int& numVerVirBndry, int horVirBndryPos[], int verVirBndryPos[], int& rasterSliceAlfPad );
   static constexpr int   m_scaleBits = 7; // 8-bits
   CcAlfFilterParam       m_ccAlfFilterParam;
@@ -170,6 +202,8 @@ protected:
   int                          m_alfVBChmaCTUHeight;
   ChromaFormat                 m_chromaFormat;
   ClpRngs                      m_clpRngs;
+  ThreadPool*                  m_threadPool;
+  std::vector<CtuFilterBuf*>   m_threadBufs;
 };
 
 #endif
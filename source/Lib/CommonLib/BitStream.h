@@ -178,6 +178,33 @@ public:
 #endif
   }
 
+  /// reads up to numBytes (at most 8) whole bytes MSB first, numBytes is reduced at the end of the FIFO
+  uint64_t    readBytes       ( uint32_t &numBytes )
+  {
+    numBytes             = std::min<uint32_t>( numBytes, uint32_t( m_fifo.size() ) - m_fifo_idx );
+    const uint8_t* bytes = m_fifo.data() + m_fifo_idx;
+    uint64_t       word  = 0;
+    for( uint32_t i = 0; i < numBytes; i++ )
+    {
+      word = ( word << 8 ) | bytes[i];
+    }
+    m_fifo_idx += numBytes;
+#if ENABLE_TRACING
+    m_numBitsRead += 8 * numBytes;
+#endif
+    return word;
+  }
+
+  /// moves the read position back over bytes that were read ahead
+  void        unreadBytes     ( uint32_t numBytes )
+  {
+    CHECK( numBytes > m_fifo_idx, "FIFO underrun" );
+    m_fifo_idx -= numBytes;
+#if ENABLE_TRACING
+    m_numBitsRead -= 8 * numBytes;
+#endif
+  }
+
   void        peekPreviousByte( uint32_t &byte )
   {
     CHECK( m_fifo_idx == 0, "FIFO empty" );
@@ -1779,6 +1779,20 @@ void CodingStructure::storePrevPLT(PLTBuf& predictor)
   }
 }
 
+CodingStructure *CodingStructure::getColLumaCS()
+{
+  // the decoder keeps both trees of a CTU in the coding structure decoding it
+  return pcv->isEncoder ? picture->cs : this;
+}
+
+void CodingStructure::rebindPicRecoBuf()
+{
+  CHECK( !parent, "rebindPicRecoBuf can only be used for a sub-structure" );
+
+  // reconstruct directly into the picture, the structure is not copied back with its reconstruction
+  m_reco.createFromBuf( picture->getRecoBuf( clipArea( area, *picture ) ) );
+}
+
 void CodingStructure::rebindPicBufs()
 {
   CHECK( parent, "rebindPicBufs can only be used for the top level CodingStructure" );
@@ -146,6 +146,7 @@ public:
   bool isSubPuClean(PredictionUnit &pu, const Mv *mv) const;
 #endif
   void rebindPicBufs();
+  void rebindPicRecoBuf();
 
   void createCoeffs(const bool isPLTused);
   void destroyCoeffs();
@@ -156,6 +157,9 @@ public:
   // global accessors
   // ---------------------------------------------------------------------------
 
+  /// structure holding the co-located luma units of a separate tree chroma block (the picture structure in the encoder, this structure or one of its parents in the decoder)
+  CodingStructure *getColLumaCS();
+
   bool isDecomp (const Position &pos, const ChannelType _chType) const;
   bool isDecomp (const Position &pos, const ChannelType _chType);
   void setDecomp(const CompArea &area, const bool _isCoded = true);
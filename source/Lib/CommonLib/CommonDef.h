@@ -121,6 +121,7 @@ typedef enum
 static constexpr int    AFFINE_ME_LIST_SIZE    =                        4;
 static constexpr int    AFFINE_ME_LIST_SIZE_LD =                        3;
 static constexpr double AFFINE_ME_LIST_MVP_TH  =                        1.0;
+static constexpr int    AFFINE_ME_PRED_CACHE_SIZE =                     16; ///< luma predictions (with gradients) kept per CTU by the affine ME
 
 // ====================================================================================================================
 // Common constants
@@ -156,6 +157,7 @@ static constexpr int IBC_MRG_MAX_NUM_CANDS =                            6; ///<
 static constexpr int MAX_TLAYER =                                       7; ///< Explicit temporal layer QP offset - max number of temporal layer
 
 static constexpr int ADAPT_SR_SCALE =                                   1; ///< division factor for adaptive search range
+static constexpr int ME_PYRAMID_LEVELS =                                2; ///< number of downsampled levels (1/2, 1/4) of the hierarchical motion search
 
 static constexpr int MIN_TB_LOG2_SIZEY = 2;
 static constexpr int MAX_TB_LOG2_SIZEY = 6;
@@ -256,6 +258,8 @@ static constexpr int LM_SYMBOL_NUM = (1 + NUM_LMC_MODE);
 
 static constexpr int MAX_NUM_MIP_MODE =                                32; ///< maximum number of MIP pred. modes
 static constexpr int FAST_UDI_MAX_RDMODE_NUM = (NUM_LUMA_MODE + MAX_NUM_MIP_MODE); ///< maximum number of RD comparison in fast-UDI estimation loop
+static constexpr int GRAD_HIST_NUM_ANG_CAND =                           8; ///< angular modes kept in the first SATD round by the gradient histogram pre-selection
+static constexpr int INTRA_CAND_CACHE_SIZE =                         8192; ///< luma intra SATD candidate lists kept per CTU
 
 static constexpr int MAX_LFNST_COEF_NUM =                              16;
 
@@ -368,6 +372,7 @@ static constexpr int DMVR_SUBCU_WIDTH_LOG2 = 4;
 static constexpr int DMVR_SUBCU_HEIGHT_LOG2 = 4;
 static constexpr int MAX_NUM_SUBCU_DMVR = ((MAX_CU_SIZE * MAX_CU_SIZE) >> (DMVR_SUBCU_WIDTH_LOG2 + DMVR_SUBCU_HEIGHT_LOG2));
 static constexpr int DMVR_NUM_ITERATION = 2;
+static constexpr int MC_REF_ROW_MARGIN = 16;                             ///< luma rows below a block that interpolation, DMVR and BDOF may read
 
 //QTBT high level parameters
 //for I slice luma CTB configuration para.
@@ -388,6 +393,7 @@ static constexpr int    FAST_SKIP_DEPTH =                               2;
 
 static constexpr double PBINTRA_RATIO     =                             1.1;
 static constexpr int    NUM_MRG_SATD_CAND =                             4;
+static constexpr int    MRG_PRED_CACHE_MAX_SAMPLES =                    ( 1 << 23 ); ///< sample capacity of the per-CTU cache of merge candidate predictions
 static constexpr double MRG_FAST_RATIO    =                             1.25;
 static constexpr int    NUM_AFF_MRG_SATD_CAND =                         2;
 
@@ -447,6 +453,7 @@ static constexpr int CHROMA_REFINEMENT_CANDIDATES = 8; /// 8 candidates BV to ch
 static constexpr int IBC_FAST_METHOD_NOINTRA_IBCCBF0 = 0x01;
 static constexpr int IBC_FAST_METHOD_BUFFERBV = 0X02;
 static constexpr int IBC_FAST_METHOD_ADAPTIVE_SEARCHRANGE = 0X04;
+static constexpr int HASH_ME_MAX_MATCHES = 5; ///< maximum number of hash matches tested per reference picture
 static constexpr int MV_EXPONENT_BITCOUNT    = 4;
 static constexpr int MV_MANTISSA_BITCOUNT    = 6;
 static constexpr int MV_MANTISSA_UPPER_LIMIT = ((1 << (MV_MANTISSA_BITCOUNT - 1)) - 1);
@@ -102,13 +102,11 @@ public:
     int rate0 = m_rate >> 4;
     int rate1 = m_rate & 15;
 
-    m_state[0] -= (m_state[0] >> rate0) & MASK_0;
-    m_state[1] -= (m_state[1] >> rate1) & MASK_1;
-    if (bin)
-    {
-      m_state[0] += (0x7fffu >> rate0) & MASK_0;
-      m_state[1] += (0x7fffu >> rate1) & MASK_1;
-    }
+    // the bin selects the increment with a mask instead of a data dependent branch
+    const unsigned binMask = 0u - bin;
+
+    m_state[0] += ((0x7fffu >> rate0) & MASK_0 & binMask) - ((m_state[0] >> rate0) & MASK_0);
+    m_state[1] += ((0x7fffu >> rate1) & MASK_1 & binMask) - ((m_state[1] >> rate1) & MASK_1);
   }
   void setLog2WindowSize(uint8_t log2WindowSize)
   {
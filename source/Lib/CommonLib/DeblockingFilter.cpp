@@ -103,11 +103,24 @@ void DeblockingFilter::clearFilterLengthAndTransformEdge()
 // ====================================================================================================================
 
 DeblockingFilter::DeblockingFilter()
+  : m_enc              ( false )
+  , m_maxCUDepth       ( 0 )
+  , m_threadPool       ( nullptr )
+  , m_numCtuRowProgress( 0 )
 {
+  m_filterLumaSegment   = xFilterLumaSegment;
+  m_filterChromaSegment = xFilterChromaSegment;
+
+#if ENABLE_SIMD_OPT_DEBLOCK
+#ifdef TARGET_SIMD_X86
+  initDeblockingFilterX86();
+#endif
+#endif
 }
 
 DeblockingFilter::~DeblockingFilter()
 {
+  destroy();
 }
 
 // ====================================================================================================================
@@ -116,6 +129,7 @@ DeblockingFilter::~DeblockingFilter()
 void DeblockingFilter::create(const unsigned maxCUDepth)
 {
   destroy();
+  m_maxCUDepth = maxCUDepth;
   const unsigned numPartitions = 1 << (maxCUDepth << 1);
   for( int edgeDir = 0; edgeDir < NUM_EDGE_DIR; edgeDir++ )
   {
@@ -140,6 +154,14 @@ void DeblockingFilter::destroy()
     m_aapbEdgeFilter[edgeDir].clear();
   }
   m_encPicYuvBuffer.destroy();
+
+  for( auto &threadFilter : m_threadFilters )
+  {
+    delete threadFilter;
+  }
+  m_threadFilters.clear();
+  m_ctuRowProgress.reset();
+  m_numCtuRowProgress = 0;
 }
 
 /**
@@ -167,81 +189,162 @@ void DeblockingFilter::deblockingFilterPic( CodingStructure& cs
   }
 #endif
 
-  for( int y = 0; y < pcv.heightInCtus; y++ )
+  if( m_threadPool && m_threadPool->getNumThreads() > 0 && !m_enc )
   {
-    for( int x = 0; x < pcv.widthInCtus; x++ )
+    xDeblockPicParallel( cs );
+  }
+  else
+  {
+    for( int y = 0; y < pcv.heightInCtus; y++ )
     {
-      memset( m_aapucBS       [EDGE_VER].data(), 0,     m_aapucBS       [EDGE_VER].byte_size() );
-      memset( m_aapbEdgeFilter[EDGE_VER].data(), false, m_aapbEdgeFilter[EDGE_VER].byte_size() );
-      clearFilterLengthAndTransformEdge();
-      m_ctuXLumaSamples = x << pcv.maxCUWidthLog2;
-      m_ctuYLumaSamples = y << pcv.maxCUHeightLog2;
-
-      const UnitArea ctuArea( pcv.chrFormat, Area( x << pcv.maxCUWidthLog2, y << pcv.maxCUHeightLog2, pcv.maxCUWidth, pcv.maxCUWidth ) );
-      CodingUnit* firstCU = cs.getCU( ctuArea.lumaPos(), CH_L);
-      cs.slice = firstCU->slice;
-
-      // CU-based deblocking
-      for( auto &currCU : cs.traverseCUs( CS::getArea( cs, ctuArea, CH_L ), CH_L ) )
+      for( int x = 0; x < pcv.widthInCtus; x++ )
       {
-        xDeblockCU( currCU, EDGE_VER );
+        xDeblockCtu( cs, x, y, EDGE_VER, true );
       }
+    }
 
-      if( CS::isDualITree( cs ) )
+    // Vertical filtering
+    for( int y = 0; y < pcv.heightInCtus; y++ )
+    {
+      for( int x = 0; x < pcv.widthInCtus; x++ )
       {
-        memset( m_aapucBS       [EDGE_VER].data(), 0,     m_aapucBS       [EDGE_VER].byte_size() );
-        memset( m_aapbEdgeFilter[EDGE_VER].data(), false, m_aapbEdgeFilter[EDGE_VER].byte_size() );
-        clearFilterLengthAndTransformEdge();
-
-        for( auto &currCU : cs.traverseCUs( CS::getArea( cs, ctuArea, CH_C ), CH_C ) )
-        {
-          xDeblockCU( currCU, EDGE_VER );
-        }
+        xDeblockCtu( cs, x, y, EDGE_HOR, true );
       }
     }
   }
 
-  // Vertical filtering
-  for( int y = 0; y < pcv.heightInCtus; y++ )
+  DTRACE_PIC_COMP(D_REC_CB_LUMA_LF,   cs, cs.getRecoBuf(), COMPONENT_Y);
+  DTRACE_PIC_COMP(D_REC_CB_CHROMA_LF, cs, cs.getRecoBuf(), COMPONENT_Cb);
+  DTRACE_PIC_COMP(D_REC_CB_CHROMA_LF, cs, cs.getRecoBuf(), COMPONENT_Cr);
+
+  DTRACE    ( g_trace_ctx, D_CRC, "DeblockingFilter" );
+  DTRACE_CRC( g_trace_ctx, D_CRC, cs, cs.getRecoBuf() );
+}
+
+/**
+ - CTU row wise deblocking
+ .
+ The horizontal edges of a row do not modify samples of the rows below and its vertical edges only modify samples of the
+ row itself. Filtering the vertical and then the horizontal edges of one row after the other therefore yields the
+ picture-level result. cs has to hold the units of the row, cs.slice is not changed.
+ */
+void DeblockingFilter::deblockCtuRow( CodingStructure& cs, const int ctuY )
+{
+  const PreCalcValues& pcv = *cs.pcv;
+  m_shiftHor = ::getComponentScaleX( COMPONENT_Cb, pcv.chrFormat );
+  m_shiftVer = ::getComponentScaleY( COMPONENT_Cb, pcv.chrFormat );
+
+  for( int x = 0; x < pcv.widthInCtus; x++ )
   {
-    for( int x = 0; x < pcv.widthInCtus; x++ )
+    xDeblockCtu( cs, x, ctuY, EDGE_VER, false );
+  }
+  for( int x = 0; x < pcv.widthInCtus; x++ )
+  {
+    xDeblockCtu( cs, x, ctuY, EDGE_HOR, false );
+  }
+}
+
+void DeblockingFilter::xDeblockCtu( CodingStructure& cs, const int ctuX, const int ctuY, const DeblockEdgeDir edgeDir, const bool setSlice )
+{
+  const PreCalcValues& pcv = *cs.pcv;
+
+  memset( m_aapucBS       [edgeDir].data(), 0,     m_aapucBS       [edgeDir].byte_size() );
+  memset( m_aapbEdgeFilter[edgeDir].data(), false, m_aapbEdgeFilter[edgeDir].byte_size() );
+  clearFilterLengthAndTransformEdge();
+  m_ctuXLumaSamples = ctuX << pcv.maxCUWidthLog2;
+  m_ctuYLumaSamples = ctuY << pcv.maxCUHeightLog2;
+
+  const UnitArea ctuArea( pcv.chrFormat, Area( ctuX << pcv.maxCUWidthLog2, ctuY << pcv.maxCUHeightLog2, pcv.maxCUWidth, pcv.maxCUWidth ) );
+  if( setSlice )
+  {
+    CodingUnit* firstCU = cs.getCU( ctuArea.lumaPos(), CH_L);
+    cs.slice = firstCU->slice;
+  }
+
+  // CU-based deblocking
+  for( auto &currCU : cs.traverseCUs( CS::getArea( cs, ctuArea, CH_L ), CH_L ) )
+  {
+    xDeblockCU( currCU, edgeDir );
+  }
+
+  if( CS::isDualITree( cs ) )
+  {
+    memset( m_aapucBS       [edgeDir].data(), 0,     m_aapucBS       [edgeDir].byte_size() );
+    memset( m_aapbEdgeFilter[edgeDir].data(), false, m_aapbEdgeFilter[edgeDir].byte_size() );
+    clearFilterLengthAndTransformEdge();
+
+    for( auto &currCU : cs.traverseCUs( CS::getArea( cs, ctuArea, CH_C ), CH_C ) )
     {
-      memset( m_aapucBS       [EDGE_HOR].data(), 0,     m_aapucBS       [EDGE_HOR].byte_size() );
-      memset( m_aapbEdgeFilter[EDGE_HOR].data(), false, m_aapbEdgeFilter[EDGE_HOR].byte_size() );
-      clearFilterLengthAndTransformEdge();
-      m_ctuXLumaSamples = x << pcv.maxCUWidthLog2;
-      m_ctuYLumaSamples = y << pcv.maxCUHeightLog2;
+      xDeblockCU( currCU, edgeDir );
+    }
+  }
+}
 
-      const UnitArea ctuArea( pcv.chrFormat, Area( x << pcv.maxCUWidthLog2, y << pcv.maxCUHeightLog2, pcv.maxCUWidth, pcv.maxCUWidth ) );
-      CodingUnit* firstCU = cs.getCU( ctuArea.lumaPos(), CH_L);
-      cs.slice = firstCU->slice;
+/**
+ - CTU row parallel deblocking
+ .
+ The vertical edges of all CTU rows are filtered independently. Filtering a horizontal edge modifies up to seven
+ lines on both sides, so the horizontal edges of a CTU are filtered once the CTU above has been finished. The filter
+ state of a CTU is held by one DeblockingFilter instance per thread and cs.slice is only set after all rows are done.
+ */
+void DeblockingFilter::xDeblockPicParallel( CodingStructure& cs )
+{
+  const PreCalcValues& pcv = *cs.pcv;
+
+  while( m_threadFilters.size() < m_threadPool->getNumThreadSlots() )
+  {
+    DeblockingFilter* threadFilter = new DeblockingFilter;
+    threadFilter->create( m_maxCUDepth );
+    m_threadFilters.push_back( threadFilter );
+  }
+  for( auto &threadFilter : m_threadFilters )
+  {
+    threadFilter->m_shiftHor = m_shiftHor;
+    threadFilter->m_shiftVer = m_shiftVer;
+  }
+  if( m_numCtuRowProgress < pcv.heightInCtus )
+  {
+    m_ctuRowProgress.reset( new ProgressCounter[pcv.heightInCtus] );
+    m_numCtuRowProgress = pcv.heightInCtus;
+  }
 
-      // CU-based deblocking
-      for( auto &currCU : cs.traverseCUs( CS::getArea( cs, ctuArea, CH_L ), CH_L ) )
+  for( int y = 0; y < pcv.heightInCtus; y++ )
+  {
+    m_threadPool->addJob( [this, &cs, &pcv, y]( int threadIdx )
+    {
+      for( int x = 0; x < pcv.widthInCtus; x++ )
       {
-        xDeblockCU( currCU, EDGE_HOR );
+        m_threadFilters[threadIdx]->xDeblockCtu( cs, x, y, EDGE_VER, false );
       }
+    } );
+  }
+  m_threadPool->waitForJobs();
 
-      if( CS::isDualITree( cs ) )
+  for( int y = 0; y < pcv.heightInCtus; y++ )
+  {
+    m_ctuRowProgress[y].reset();
+  }
+  // the rows are queued in order, hence a row only waits for rows which have already been started
+  for( int y = 0; y < pcv.heightInCtus; y++ )
+  {
+    m_threadPool->addJob( [this, &cs, &pcv, y]( int threadIdx )
+    {
+      for( int x = 0; x < pcv.widthInCtus; x++ )
       {
-        memset( m_aapucBS       [EDGE_HOR].data(), 0,     m_aapucBS       [EDGE_HOR].byte_size() );
-        memset( m_aapbEdgeFilter[EDGE_HOR].data(), false, m_aapbEdgeFilter[EDGE_HOR].byte_size() );
-        clearFilterLengthAndTransformEdge();
-
-        for( auto &currCU : cs.traverseCUs( CS::getArea( cs, ctuArea, CH_C ), CH_C ) )
+        if( y > 0 )
         {
-          xDeblockCU( currCU, EDGE_HOR );
+          m_ctuRowProgress[y - 1].waitFor( x + 1 );
         }
+        m_threadFilters[threadIdx]->xDeblockCtu( cs, x, y, EDGE_HOR, false );
+        m_ctuRowProgress[y].set( x + 1 );
       }
-    }
+    } );
   }
+  m_threadPool->waitForJobs();
 
-  DTRACE_PIC_COMP(D_REC_CB_LUMA_LF,   cs, cs.getRecoBuf(), COMPONENT_Y);
-  DTRACE_PIC_COMP(D_REC_CB_CHROMA_LF, cs, cs.getRecoBuf(), COMPONENT_Cb);
-  DTRACE_PIC_COMP(D_REC_CB_CHROMA_LF, cs, cs.getRecoBuf(), COMPONENT_Cr);
-
-  DTRACE    ( g_trace_ctx, D_CRC, "DeblockingFilter" );
-  DTRACE_CRC( g_trace_ctx, D_CRC, cs, cs.getRecoBuf() );
+  // leave the slice of the last CTU set, as done by the sequential processing
+  const Position lastCtuPos( ( pcv.widthInCtus - 1 ) << pcv.maxCUWidthLog2, ( pcv.heightInCtus - 1 ) << pcv.maxCUHeightLog2 );
+  cs.slice = cs.getCU( lastCtuPos, CH_L )->slice;
 }
 
 void DeblockingFilter::resetFilterLengths()
@@ -993,7 +1096,7 @@ void DeblockingFilter::xEdgeFilterLuma(const CodingUnit &cu, const DeblockEdgeDi
   const Slice   &slice    = *(cu.slice);
   const bool    spsPaletteEnabledFlag          = sps.getPLTMode();
   const int     bitDepthLuma                   = sps.getBitDepth(CHANNEL_TYPE_LUMA);
-  const ClpRng& clpRng( cu.cs->slice->clpRng(COMPONENT_Y) );
+  const ClpRng& clpRng( cu.slice->clpRng(COMPONENT_Y) );
 
   int      qp       = 0;
   unsigned numParts = (((edgeDir == EDGE_VER) ? lumaArea.height / pcv.minCUHeight : lumaArea.width / pcv.minCUWidth));
@@ -1176,12 +1279,9 @@ void DeblockingFilter::xEdgeFilterLuma(const CodingUnit &cu, const DeblockEdgeDi
             if (swL)
             {
               useLongtapFilter = true;
-              for (int i = 0; i < DEBLOCK_SMALLEST_BLOCK / 2; i++)
-              {
-                xPelFilterLuma(tmpSrc + srcStep * (idx * pelsInPart + blkIdx * 4 + i), offset, tc, swL, partPNoFilter,
-                               partQNoFilter, thrCut, filterP, filterQ, clpRng, sidePisLarge, sideQisLarge,
-                               maxFilterLengthP, maxFilterLengthQ);
-              }
+              m_filterLumaSegment(tmpSrc + srcStep * (idx * pelsInPart + blkIdx * 4), offset, srcStep, tc, swL,
+                                  partPNoFilter, partQNoFilter, thrCut, filterP, filterQ, clpRng, sidePisLarge,
+                                  sideQisLarge, maxFilterLengthP, maxFilterLengthQ);
             }
 
           }
@@ -1219,11 +1319,8 @@ void DeblockingFilter::xEdgeFilterLuma(const CodingUnit &cu, const DeblockEdgeDi
                    && xUseStrongFiltering(tmpSrc + srcStep * (idx * pelsInPart + blkIdx * 4 + 3), offset, 2 * d3, beta,
                                           tc);
             }
-            for (int i = 0; i < DEBLOCK_SMALLEST_BLOCK / 2; i++)
-            {
-              xPelFilterLuma(tmpSrc + srcStep * (idx * pelsInPart + blkIdx * 4 + i), offset, tc, sw, partPNoFilter,
-                             partQNoFilter, thrCut, bFilterP, bFilterQ, clpRng);
-            }
+            m_filterLumaSegment(tmpSrc + srcStep * (idx * pelsInPart + blkIdx * 4), offset, srcStep, tc, sw,
+                                partPNoFilter, partQNoFilter, thrCut, bFilterP, bFilterQ, clpRng, false, false, 7, 7);
           }
         }
       }
@@ -1369,7 +1466,7 @@ void DeblockingFilter::xEdgeFilterChroma(const CodingUnit &cu, const DeblockEdge
       {
         if ((bS[chromaIdx] == 2) || (largeBoundary && (bS[chromaIdx] == 1)))
         {
-          const ClpRng &clpRng(cu.cs->slice->clpRng(ComponentID(chromaIdx + 1)));
+          const ClpRng &clpRng(cu.slice->clpRng(ComponentID(chromaIdx + 1)));
           Pel *         tmpSrcChroma = (chromaIdx == 0) ? tmpSrcCb : tmpSrcCr;
 
           const TransformUnit &tuQ = *cuQ.cs->getTU(
@@ -1425,20 +1522,14 @@ void DeblockingFilter::xEdgeFilterChroma(const CodingUnit &cu, const DeblockEdge
                 && xUseStrongFiltering(tmpSrcChroma + srcStep * (idx * loopLength + ((subSamplingShift == 1) ? 1 : 3)),
                                        offset, 2 * d3, beta, tc, false, false, 7, 7, isChromaHorCTBBoundary);
 
-              for (unsigned step = 0; step < loopLength; step++)
-              {
-                xPelFilterChroma(tmpSrcChroma + srcStep * (step + idx * loopLength), offset, tc, sw, partPNoFilter,
-                                 partQNoFilter, clpRng, largeBoundary, isChromaHorCTBBoundary);
-              }
+              m_filterChromaSegment(tmpSrcChroma + srcStep * (idx * loopLength), offset, srcStep, loopLength, tc, sw,
+                                    partPNoFilter, partQNoFilter, clpRng, largeBoundary, isChromaHorCTBBoundary);
             }
           }
           if (!useLongFilter)
           {
-            for (unsigned step = 0; step < loopLength; step++)
-            {
-              xPelFilterChroma(tmpSrcChroma + srcStep * (step + idx * loopLength), offset, tc, false, partPNoFilter,
-                               partQNoFilter, clpRng, largeBoundary, isChromaHorCTBBoundary);
-            }
+            m_filterChromaSegment(tmpSrcChroma + srcStep * (idx * loopLength), offset, srcStep, loopLength, tc, false,
+                                  partPNoFilter, partQNoFilter, clpRng, largeBoundary, isChromaHorCTBBoundary);
           }
         }
       }
@@ -1446,7 +1537,7 @@ void DeblockingFilter::xEdgeFilterChroma(const CodingUnit &cu, const DeblockEdge
   }
 }
 
-inline void DeblockingFilter::xBilinearFilter(Pel* srcP, Pel* srcQ, int offset, int refMiddle, int refP, int refQ, int numberPSide, int numberQSide, const int* dbCoeffsP, const int* dbCoeffsQ, int tc) const
+inline void DeblockingFilter::xBilinearFilter(Pel* srcP, Pel* srcQ, int offset, int refMiddle, int refP, int refQ, int numberPSide, int numberQSide, const int* dbCoeffsP, const int* dbCoeffsQ, int tc)
 {
   const char tc7[7] = { 6, 5, 4, 3, 2, 1, 1 };
   const char tc3[3] = { 6, 4, 2 };
@@ -1470,7 +1561,7 @@ inline void DeblockingFilter::xBilinearFilter(Pel* srcP, Pel* srcQ, int offset,
   }
 }
 
-inline void DeblockingFilter::xFilteringPandQ(Pel* src, int offset, int numberPSide, int numberQSide, int tc) const
+inline void DeblockingFilter::xFilteringPandQ(Pel* src, int offset, int numberPSide, int numberQSide, int tc)
 {
   CHECK(numberPSide <= 3 && numberQSide <= 3, "Short filtering in long filtering function");
   Pel* srcP = src-offset;
@@ -1548,7 +1639,7 @@ inline void DeblockingFilter::xPelFilterLuma(Pel *src, const int offset, const i
                                              const bool partPNoFilter, const bool partQNoFilter, const int thrCut,
                                              const bool bFilterSecondP, const bool bFilterSecondQ, const ClpRng &clpRng,
                                              bool sidePisLarge, bool sideQisLarge, int maxFilterLengthP,
-                                             int maxFilterLengthQ) const
+                                             int maxFilterLengthQ)
 {
   int delta;
 
@@ -1641,7 +1732,7 @@ inline void DeblockingFilter::xPelFilterLuma(Pel *src, const int offset, const i
 
 inline void DeblockingFilter::xPelFilterChroma(Pel *src, const int offset, const int tc, const bool sw,
                                                const bool partPNoFilter, const bool partQNoFilter, const ClpRng &clpRng,
-                                               const bool largeBoundary, const bool isChromaHorCTBBoundary) const
+                                               const bool largeBoundary, const bool isChromaHorCTBBoundary)
 {
   int delta;
 
@@ -1700,6 +1791,31 @@ inline void DeblockingFilter::xPelFilterChroma(Pel *src, const int offset, const
   }
 }
 
+void DeblockingFilter::xFilterLumaSegment(Pel *src, const int offset, const int step, const int tc, const bool sw,
+                                          const bool partPNoFilter, const bool partQNoFilter, const int thrCut,
+                                          const bool bFilterSecondP, const bool bFilterSecondQ, const ClpRng &clpRng,
+                                          const bool sidePisLarge, const bool sideQisLarge, const int maxFilterLengthP,
+                                          const int maxFilterLengthQ)
+{
+  for (int i = 0; i < DEBLOCK_SMALLEST_BLOCK / 2; i++)
+  {
+    xPelFilterLuma(src + step * i, offset, tc, sw, partPNoFilter, partQNoFilter, thrCut, bFilterSecondP,
+                   bFilterSecondQ, clpRng, sidePisLarge, sideQisLarge, maxFilterLengthP, maxFilterLengthQ);
+  }
+}
+
+void DeblockingFilter::xFilterChromaSegment(Pel *src, const int offset, const int step, const int numLines,
+                                            const int tc, const bool sw, const bool partPNoFilter,
+                                            const bool partQNoFilter, const ClpRng &clpRng, const bool largeBoundary,
+                                            const bool isChromaHorCTBBoundary)
+{
+  for (int i = 0; i < numLines; i++)
+  {
+    xPelFilterChroma(src + step * i, offset, tc, sw, partPNoFilter, partQNoFilter, clpRng, largeBoundary,
+                     isChromaHorCTBBoundary);
+  }
+}
+
 inline bool DeblockingFilter::xUseStrongFiltering(Pel *src, const int offset, const int d, const int beta, const int tc,
                                                   bool sidePisLarge, bool sideQisLarge, int maxFilterLengthP,
                                                   int maxFilterLengthQ, bool isChromaHorCTBBoundary) const
@@ -41,6 +41,7 @@
 #include "CommonDef.h"
 #include "Unit.h"
 #include "Picture.h"
+#include "ThreadPool.h"
 
 //! \ingroup CommonLib
 //! \{
@@ -78,12 +79,21 @@ private:
 
   PelStorage                   m_encPicYuvBuffer;
   bool                         m_enc;
+
+  unsigned                     m_maxCUDepth;
+  ThreadPool*                  m_threadPool;
+  std::vector<DeblockingFilter*> m_threadFilters;     // per thread copies holding the CTU level filter state
+  std::unique_ptr<ProgressCounter[]> m_ctuRowProgress; // number of CTUs of each CTU row with finished horizontal edges
+  int                          m_numCtuRowProgress;
 private:
   void clearFilterLengthAndTransformEdge();
 
   // set / get functions
   void xSetDeblockingFilterParam        ( const CodingUnit& cu );
 
+  void xDeblockCtu                      ( CodingStructure& cs, const int ctuX, const int ctuY, const DeblockEdgeDir edgeDir, const bool setSlice );
+  void xDeblockPicParallel              ( CodingStructure& cs );
+
   // filtering functions
   unsigned
   xGetBoundaryStrengthSingle      ( const CodingUnit& cu, const DeblockEdgeDir edgeDir, const Position& localPos, const ChannelType chType  ) const;
@@ -98,15 +108,24 @@ private:
                                                const TransformUnit &currTU, const int firstComponent);
   void xSetMaxFilterLengthPQForCodingSubBlocks( const DeblockEdgeDir edgeDir, const CodingUnit& cu, const PredictionUnit& currPU, const bool& mvSubBlocks, const int& subBlockSize, const Area& areaPu );
 
-  inline void xBilinearFilter     ( Pel* srcP, Pel* srcQ, int offset, int refMiddle, int refP, int refQ, int numberPSide, int numberQSide, const int* dbCoeffsP, const int* dbCoeffsQ, int tc ) const;
-  inline void xFilteringPandQ     ( Pel* src, int offset, int numberPSide, int numberQSide, int tc ) const;
-  inline void xPelFilterLuma(Pel *src, const int offset, const int tc, const bool sw, const bool partPNoFilter,
-                             const bool partQNoFilter, const int thrCut, const bool bFilterSecondP,
-                             const bool bFilterSecondQ, const ClpRng &clpRng, bool sidePisLarge = false,
-                             bool sideQisLarge = false, int maxFilterLengthP = 7, int maxFilterLengthQ = 7) const;
-  inline void xPelFilterChroma(Pel *src, const int offset, const int tc, const bool sw, const bool partPNoFilter,
-                               const bool partQNoFilter, const ClpRng &clpRng, const bool largeBoundary,
-                               const bool isChromaHorCTBBoundary) const;
+  static inline void xBilinearFilter( Pel* srcP, Pel* srcQ, int offset, int refMiddle, int refP, int refQ, int numberPSide, int numberQSide, const int* dbCoeffsP, const int* dbCoeffsQ, int tc );
+  static inline void xFilteringPandQ( Pel* src, int offset, int numberPSide, int numberQSide, int tc );
+  static inline void xPelFilterLuma(Pel *src, const int offset, const int tc, const bool sw, const bool partPNoFilter,
+                                    const bool partQNoFilter, const int thrCut, const bool bFilterSecondP,
+                                    const bool bFilterSecondQ, const ClpRng &clpRng, bool sidePisLarge = false,
+                                    bool sideQisLarge = false, int maxFilterLengthP = 7, int maxFilterLengthQ = 7);
+  static inline void xPelFilterChroma(Pel *src, const int offset, const int tc, const bool sw, const bool partPNoFilter,
+                                      const bool partQNoFilter, const ClpRng &clpRng, const bool largeBoundary,
+                                      const bool isChromaHorCTBBoundary);
+
+  static void xFilterLumaSegment(Pel *src, const int offset, const int step, const int tc, const bool sw,
+                                 const bool partPNoFilter, const bool partQNoFilter, const int thrCut,
+                                 const bool bFilterSecondP, const bool bFilterSecondQ, const ClpRng &clpRng,
+                                 const bool sidePisLarge, const bool sideQisLarge, const int maxFilterLengthP,
+                                 const int maxFilterLengthQ);
+  static void xFilterChromaSegment(Pel *src, const int offset, const int step, const int numLines, const int tc,
+                                   const bool sw, const bool partPNoFilter, const bool partQNoFilter,
+                                   const ClpRng &clpRng, const bool largeBoundary, const bool isChromaHorCTBBoundary);
 
   inline bool xUseStrongFiltering(Pel *src, const int offset, const int d, const int beta, const int tc,
                                   bool sidePisLarge = false, bool sideQisLarge = false, int maxFilterLengthP = 7,
@@ -129,17 +148,38 @@ public:
   DeblockingFilter();
   ~DeblockingFilter();
 
+  // filters the DEBLOCK_SMALLEST_BLOCK / 2 lines of one luma edge segment, the lines are step samples apart
+  void (*m_filterLumaSegment)(Pel *src, const int offset, const int step, const int tc, const bool sw,
+                              const bool partPNoFilter, const bool partQNoFilter, const int thrCut,
+                              const bool bFilterSecondP, const bool bFilterSecondQ, const ClpRng &clpRng,
+                              const bool sidePisLarge, const bool sideQisLarge, const int maxFilterLengthP,
+                              const int maxFilterLengthQ);
+  // filters numLines lines of one chroma edge segment, the lines are step samples apart
+  void (*m_filterChromaSegment)(Pel *src, const int offset, const int step, const int numLines, const int tc,
+                                const bool sw, const bool partPNoFilter, const bool partQNoFilter,
+                                const ClpRng &clpRng, const bool largeBoundary, const bool isChromaHorCTBBoundary);
+
+#ifdef TARGET_SIMD_X86
+  void initDeblockingFilterX86();
+  template <X86_VEXT vext>
+  void _initDeblockingFilterX86();
+#endif
+
   /// CU-level deblocking function
   void xDeblockCU(CodingUnit& cu, const DeblockEdgeDir edgeDir);
   void  initEncPicYuvBuffer(ChromaFormat chromaFormat, const Size &size, const unsigned maxCUSize);
   PelStorage& getDbEncPicYuvBuffer() { return m_encPicYuvBuffer; }
   void  setEnc(bool b) { m_enc = b; }
+  /// picture-level deblocking processes CTU rows in parallel if the thread pool has worker threads
+  void  setThreadPool(ThreadPool* threadPool) { m_threadPool = threadPool; }
 
   void  create(const unsigned maxCUDepth);
   void  destroy                   ();
 
   /// picture-level deblocking filter
   void deblockingFilterPic        ( CodingStructure& cs );
+  /// deblocking filter of one complete CTU row, the CTU rows have to be filtered top to bottom
+  void deblockCtuRow              ( CodingStructure& cs, const int ctuY );
 
   static int getBeta              ( const int qp )
   {
@@ -90,7 +90,16 @@ void TCRCCalculatorLight::xInitTable()
       }
     }
 
-    m_table[value] = remainder;
+    m_table[0][value] = remainder & m_finalResultMask;
+  }
+
+  for (int k = 1; k < 4; k++)
+  {
+    for (uint32_t value = 0; value < 256; value++)
+    {
+      const uint32_t remainder = m_table[k - 1][value];
+      m_table[k][value] = ((remainder << 8) ^ m_table[0][(remainder >> (m_bits - 8)) & 0xff]) & m_finalResultMask;
+    }
   }
 }
 
@@ -100,137 +109,252 @@ void TCRCCalculatorLight::processData(unsigned char* curData, uint32_t dataLengt
   {
     unsigned char index = (m_remainder >> (m_bits - 8)) ^ curData[i];
     m_remainder <<= 8;
-    m_remainder ^= m_table[index];
+    m_remainder ^= m_table[0][index];
   }
 }
 
-
-TComHash::TComHash()
+uint32_t TCRCCalculatorLight::getCRC(const unsigned char* curData, uint32_t dataLength) const
 {
-  m_lookupTable   = nullptr;
-  tableHasContent = false;
-  for (int i = 0; i < 5; i++)
+  uint32_t remainder = 0;
+  uint32_t i = 0;
+
+  if (m_bits == 24)
   {
-    hashPic[i] = nullptr;
+    for (; i + 4 <= dataLength; i += 4)
+    {
+      remainder = m_table[3][((remainder >> 16) ^ curData[i]) & 0xff] ^ m_table[2][((remainder >> 8) ^ curData[i + 1]) & 0xff]
+                ^ m_table[1][(remainder ^ curData[i + 2]) & 0xff] ^ m_table[0][curData[i + 3]];
+    }
   }
-}
-
-TComHash::~TComHash()
-{
-  clearAll();
-  if (m_lookupTable != nullptr)
+  for (; i < dataLength; i++)
   {
-    delete[] m_lookupTable;
-    m_lookupTable = nullptr;
+    remainder = (remainder << 8) ^ m_table[0][((remainder >> (m_bits - 8)) ^ curData[i]) & 0xff];
   }
+  return remainder & m_finalResultMask;
 }
 
-void TComHash::create(int picWidth, int picHeight)
+
+TComHashPlanes::TComHashPlanes()
 {
-  if (m_lookupTable)
+  m_picWidth     = 0;
+  m_picHeight    = 0;
+  m_chromaFormat = CHROMA_400;
+  m_hasPrevious  = false;
+  for (int level = 0; level < NUM_LEVELS; level++)
   {
-    clearAll();
+    hash[level][0] = hash[level][1] = nullptr;
   }
-  if (!hashPic[0])
+  for (int i = 0; i < 2; i++)
   {
-    for (int k = 0; k < 5; k++)
+    for (int j = 0; j < 3; j++)
     {
-      hashPic[k] = new uint16_t[picWidth*picHeight];
+      sameInfo[i][j] = nullptr;
     }
+    changed[i] = nullptr;
   }
-  if (m_lookupTable)
+}
+
+TComHashPlanes::~TComHashPlanes()
+{
+  destroy();
+}
+
+void TComHashPlanes::create(const PelUnitBuf &curPicBuf, int picWidth, int picHeight)
+{
+  const ChromaFormat chromaFormat = curPicBuf.chromaFormat == CHROMA_444 ? CHROMA_444 : CHROMA_400;
+  if (hash[0][0] && m_picWidth == picWidth && m_picHeight == picHeight && m_chromaFormat == chromaFormat)
   {
     return;
   }
-  int maxAddr = 1 << (m_CRCBits + m_blockSizeBits);
-  m_lookupTable = new std::vector<BlockHash>*[maxAddr];
-  memset(m_lookupTable, 0, sizeof(std::vector<BlockHash>*) * maxAddr);
-  tableHasContent = false;
-}
+  destroy();
 
-void TComHash::clearAll()
-{
-  if (hashPic[0])
+  m_picWidth     = picWidth;
+  m_picHeight    = picHeight;
+  m_chromaFormat = chromaFormat;
+  for (int level = 0; level < NUM_LEVELS; level++)
   {
-    for (int k = 0; k < 5; k++)
+    hash[level][0] = new uint32_t[picWidth * picHeight];
+    hash[level][1] = new uint32_t[picWidth * picHeight];
+  }
+  for (int i = 0; i < 2; i++)
+  {
+    for (int j = 0; j < 3; j++)
     {
-      delete[] hashPic[k];
-      hashPic[k] = nullptr;
+      sameInfo[i][j] = new bool[picWidth * picHeight];
     }
+    changed[i] = new uint8_t[picWidth * picHeight];
   }
-  tableHasContent = false;
-  if (m_lookupTable == nullptr)
+  m_prevSamples.create(chromaFormat, Area(0, 0, picWidth, picHeight));
+}
+
+void TComHashPlanes::destroy()
+{
+  for (int level = 0; level < NUM_LEVELS; level++)
   {
-    return;
+    delete[] hash[level][0];
+    delete[] hash[level][1];
+    hash[level][0] = hash[level][1] = nullptr;
   }
-  int maxAddr = 1 << (m_CRCBits + m_blockSizeBits);
-  for (int i = 0; i < maxAddr; i++)
+  for (int i = 0; i < 2; i++)
   {
-    if (m_lookupTable[i] != nullptr)
+    for (int j = 0; j < 3; j++)
     {
-      delete m_lookupTable[i];
-      m_lookupTable[i] = nullptr;
+      delete[] sameInfo[i][j];
+      sameInfo[i][j] = nullptr;
     }
+    delete[] changed[i];
+    changed[i] = nullptr;
   }
+  m_prevSamples.destroy();
+  m_hasPrevious = false;
 }
 
-void TComHash::addToTable(uint32_t hashValue, const BlockHash& blockHash)
+// marks the samples that differ from the last picture in changed[0], returns false when there is no last picture
+bool TComHashPlanes::markChangedSamples(const PelUnitBuf &curPicBuf)
 {
-  if (m_lookupTable[hashValue] == nullptr)
+  if (!m_hasPrevious)
   {
-    m_lookupTable[hashValue] = new std::vector<BlockHash>;
-    m_lookupTable[hashValue]->push_back(blockHash);
+    return false;
   }
-  else
+
+  for (uint32_t comp = 0; comp < getNumberValidComponents(m_chromaFormat); comp++)
   {
-    m_lookupTable[hashValue]->push_back(blockHash);
+    const ComponentID compID = ComponentID(comp);
+    const CPelBuf     cur    = curPicBuf.get(compID);
+    const CPelBuf     prev   = m_prevSamples.get(compID);
+
+    for (int y = 0; y < m_picHeight; y++)
+    {
+      const Pel* curRow  = cur.bufAt(0, y);
+      const Pel* prevRow = prev.bufAt(0, y);
+      uint8_t*   dst     = changed[0] + y * m_picWidth;
+      if (comp == 0)
+      {
+        for (int x = 0; x < m_picWidth; x++)
+        {
+          dst[x] = curRow[x] != prevRow[x];
+        }
+      }
+      else
+      {
+        for (int x = 0; x < m_picWidth; x++)
+        {
+          dst[x] |= curRow[x] != prevRow[x];
+        }
+      }
+    }
   }
+  return true;
 }
 
-int TComHash::count(uint32_t hashValue)
+void TComHashPlanes::storeSamples(const PelUnitBuf &curPicBuf)
 {
-  if (m_lookupTable[hashValue] == nullptr)
+  for (uint32_t comp = 0; comp < getNumberValidComponents(m_chromaFormat); comp++)
   {
-    return 0;
+    m_prevSamples.get(ComponentID(comp)).copyFrom(curPicBuf.get(ComponentID(comp)));
   }
-  else
+  m_hasPrevious = true;
+}
+
+
+// a block changed when any of its four sub blocks (or samples) changed
+static void xMarkChangedBlocks(const uint8_t* srcChanged, uint8_t* dstChanged, int picWidth, int xEnd, int yEnd, int offsetX, int offsetY)
+{
+  for (int yPos = 0; yPos < yEnd; yPos++)
   {
-    return static_cast<int>(m_lookupTable[hashValue]->size());
+    const uint8_t* src = srcChanged + yPos * picWidth;
+    uint8_t*       dst = dstChanged + yPos * picWidth;
+    for (int xPos = 0; xPos < xEnd; xPos++)
+    {
+      dst[xPos] = src[xPos] | src[xPos + offsetX] | src[xPos + offsetY] | src[xPos + offsetY + offsetX];
+    }
   }
 }
 
-int TComHash::count(uint32_t hashValue) const
+static bool xAnyChanged(const uint8_t* changed, int num)
 {
-  if (m_lookupTable[hashValue] == nullptr)
+  for (int i = 0; i < num; i++)
   {
-    return 0;
+    if (changed[i])
+    {
+      return true;
+    }
   }
-  else
+  return false;
+}
+
+static const int HASH_ROW_CHUNK = 16;   // granularity at which unchanged blocks are skipped
+
+
+TComHash::TComHash()
+{
+  tableHasContent = false;
+  for (int i = 0; i < 5; i++)
   {
-    return static_cast<int>(m_lookupTable[hashValue]->size());
+    hashPic[i] = nullptr;
   }
+
+  m_hashBlock2x2 = xHashBlock2x2;
+  m_hashQuad     = xHashQuad;
+
+#if ENABLE_SIMD_OPT_HASH
+#ifdef TARGET_SIMD_X86
+  initHashX86();
+#endif
+#endif
 }
 
-MapIterator TComHash::getFirstIterator(uint32_t hashValue)
+TComHash::~TComHash()
 {
-  return m_lookupTable[hashValue]->begin();
+  clearAll();
 }
 
-const MapIterator TComHash::getFirstIterator(uint32_t hashValue) const
+void TComHash::create(int picWidth, int picHeight)
 {
-  return m_lookupTable[hashValue]->begin();
+  if (!hashPic[0])
+  {
+    for (int k = 0; k < 5; k++)
+    {
+      hashPic[k] = new uint16_t[picWidth*picHeight];
+    }
+  }
+  m_bucketStart.assign(xBucketIdx(1 << (m_CRCBits + m_blockSizeBits)), 0);
+  m_blockHashes.clear();
+  tableHasContent = false;
 }
 
-bool TComHash::hasExactMatch(uint32_t hashValue1, uint32_t hashValue2)
+void TComHash::clearAll()
 {
-  if (m_lookupTable[hashValue1] == nullptr)
+  if (hashPic[0])
   {
-    return false;
+    for (int k = 0; k < 5; k++)
+    {
+      delete[] hashPic[k];
+      hashPic[k] = nullptr;
+    }
   }
-  std::vector<BlockHash>::iterator it;
-  for (it = m_lookupTable[hashValue1]->begin(); it != m_lookupTable[hashValue1]->end(); it++)
+  tableHasContent = false;
+  std::vector<uint32_t>().swap(m_bucketStart);
+  std::vector<BlockHash>().swap(m_blockHashes);
+}
+
+int TComHash::count(uint32_t hashValue) const
+{
+  const int idx = xBucketIdx(hashValue);
+  return static_cast<int>(m_bucketStart[idx + 1] - m_bucketStart[idx]);
+}
+
+MapIterator TComHash::getFirstIterator(uint32_t hashValue) const
+{
+  return m_blockHashes.data() + m_bucketStart[xBucketIdx(hashValue)];
+}
+
+bool TComHash::hasExactMatch(uint32_t hashValue1, uint32_t hashValue2) const
+{
+  const int idx = xBucketIdx(hashValue1);
+  for (uint32_t i = m_bucketStart[idx]; i < m_bucketStart[idx + 1]; i++)
   {
-    if ((*it).hashValue2 == hashValue2)
+    if (m_blockHashes[i].hashValue2 == hashValue2)
     {
       return true;
     }
@@ -238,43 +362,77 @@ bool TComHash::hasExactMatch(uint32_t hashValue1, uint32_t hashValue2)
   return false;
 }
 
-void TComHash::generateBlock2x2HashValue(const PelUnitBuf &curPicBuf, int picWidth, int picHeight, const BitDepths bitDepths, uint32_t* picBlockHash[2], bool* picBlockSameInfo[3])
+void TComHash::generateBlock2x2HashValue(const PelUnitBuf &curPicBuf, int picWidth, int picHeight, const BitDepths bitDepths, uint32_t* picBlockHash[2], bool* picBlockSameInfo[3], const uint8_t* srcChanged, uint8_t* dstChanged)
 {
   const int width = 2;
   const int height = 2;
   int xEnd = picWidth - width + 1;
   int yEnd = picHeight - height + 1;
 
-  int length = width * 2;
-  bool includeChroma = false;
+  if (srcChanged)
+  {
+    xMarkChangedBlocks(srcChanged, dstChanged, picWidth, xEnd, yEnd, 1, picWidth);
+  }
+
   if ((curPicBuf).chromaFormat == CHROMA_444)
   {
-    length *= 3;
-    includeChroma = true;
+    int length = width * 2 * 3;
+    unsigned char p[width * 2 * 3];
+
+    int pos = 0;
+    for (int yPos = 0; yPos < yEnd; yPos++)
+    {
+      for (int xPos = 0; xPos < xEnd; xPos++)
+      {
+        TComHash::getPixelsIn1DCharArrayByBlock2x2(curPicBuf, p, xPos, yPos, bitDepths, true);
+        picBlockSameInfo[0][pos] = isBlock2x2RowSameValue(p, true);
+        picBlockSameInfo[1][pos] = isBlock2x2ColSameValue(p, true);
+
+        if (!srcChanged || dstChanged[pos])
+        {
+          picBlockHash[0][pos] = TComHash::getCRCValue1(p, length * sizeof(unsigned char));
+          picBlockHash[1][pos] = TComHash::getCRCValue2(p, length * sizeof(unsigned char));
+        }
+
+        pos++;
+      }
+      pos += width - 1;
+    }
+    return;
   }
-  unsigned char* p = new unsigned char[length];
 
-  int pos = 0;
+  const CPelBuf lumaBuf = curPicBuf.get(COMPONENT_Y);
+  const int     shift   = bitDepths.recon[CHANNEL_TYPE_LUMA] - 8;
+
   for (int yPos = 0; yPos < yEnd; yPos++)
   {
+    const Pel* src = lumaBuf.bufAt(0, yPos);
+    const int  pos = yPos * picWidth;
+
     for (int xPos = 0; xPos < xEnd; xPos++)
     {
-      TComHash::getPixelsIn1DCharArrayByBlock2x2(curPicBuf, p, xPos, yPos, bitDepths, includeChroma);
-      picBlockSameInfo[0][pos] = isBlock2x2RowSameValue(p, includeChroma);
-      picBlockSameInfo[1][pos] = isBlock2x2ColSameValue(p, includeChroma);
-
-      picBlockHash[0][pos] = TComHash::getCRCValue1(p, length * sizeof(unsigned char));
-      picBlockHash[1][pos] = TComHash::getCRCValue2(p, length * sizeof(unsigned char));
+      const unsigned char p0 = static_cast<unsigned char>(src[xPos] >> shift);
+      const unsigned char p1 = static_cast<unsigned char>(src[xPos + 1] >> shift);
+      const unsigned char p2 = static_cast<unsigned char>(src[lumaBuf.stride + xPos] >> shift);
+      const unsigned char p3 = static_cast<unsigned char>(src[lumaBuf.stride + xPos + 1] >> shift);
+      picBlockSameInfo[0][pos + xPos] = p0 == p1 && p2 == p3;
+      picBlockSameInfo[1][pos + xPos] = p0 == p2 && p1 == p3;
+    }
 
-      pos++;
+    for (int xPos = 0; xPos < xEnd; xPos += HASH_ROW_CHUNK)
+    {
+      const int num = std::min(HASH_ROW_CHUNK, xEnd - xPos);
+      if (srcChanged && !xAnyChanged(dstChanged + pos + xPos, num))
+      {
+        continue;
+      }
+      m_hashBlock2x2(src + xPos, lumaBuf.stride, shift, picBlockHash[0] + pos + xPos, picBlockHash[1] + pos + xPos, num,
+                     m_crcCalculator1, m_crcCalculator2);
     }
-    pos += width - 1;
   }
-
-  delete[] p;
 }
 
-void TComHash::generateBlockHashValue(int picWidth, int picHeight, int width, int height, uint32_t* srcPicBlockHash[2], uint32_t* dstPicBlockHash[2], bool* srcPicBlockSameInfo[3], bool* dstPicBlockSameInfo[3])
+void TComHash::generateBlockHashValue(int picWidth, int picHeight, int width, int height, uint32_t* srcPicBlockHash[2], uint32_t* dstPicBlockHash[2], bool* srcPicBlockSameInfo[3], bool* dstPicBlockSameInfo[3], const uint8_t* srcChanged, uint8_t* dstChanged)
 {
   int xEnd = picWidth - width + 1;
   int yEnd = picHeight - height + 1;
@@ -284,26 +442,31 @@ void TComHash::generateBlockHashValue(int picWidth, int picHeight, int width, in
   int srcHeight = height >> 1;
   int quadHeight = height >> 2;
 
-  int length = 4 * sizeof(uint32_t);
+  if (srcChanged)
+  {
+    xMarkChangedBlocks(srcChanged, dstChanged, picWidth, xEnd, yEnd, srcWidth, srcHeight * picWidth);
+  }
+
+  for (int yPos = 0; yPos < yEnd; yPos++)
+  {
+    const int pos = yPos * picWidth;
+    for (int xPos = 0; xPos < xEnd; xPos += HASH_ROW_CHUNK)
+    {
+      const int num = std::min(HASH_ROW_CHUNK, xEnd - xPos);
+      if (srcChanged && !xAnyChanged(dstChanged + pos + xPos, num))
+      {
+        continue;
+      }
+      m_hashQuad(srcPicBlockHash[0] + pos + xPos, srcWidth, srcHeight * picWidth, dstPicBlockHash[0] + pos + xPos, num, m_crcCalculator1);
+      m_hashQuad(srcPicBlockHash[1] + pos + xPos, srcWidth, srcHeight * picWidth, dstPicBlockHash[1] + pos + xPos, num, m_crcCalculator2);
+    }
+  }
 
-  uint32_t p[4];
   int pos = 0;
   for (int yPos = 0; yPos < yEnd; yPos++)
   {
     for (int xPos = 0; xPos < xEnd; xPos++)
     {
-      p[0] = srcPicBlockHash[0][pos];
-      p[1] = srcPicBlockHash[0][pos + srcWidth];
-      p[2] = srcPicBlockHash[0][pos + srcHeight * picWidth];
-      p[3] = srcPicBlockHash[0][pos + srcHeight * picWidth + srcWidth];
-      dstPicBlockHash[0][pos] = TComHash::getCRCValue1((unsigned char*)p, length);
-
-      p[0] = srcPicBlockHash[1][pos];
-      p[1] = srcPicBlockHash[1][pos + srcWidth];
-      p[2] = srcPicBlockHash[1][pos + srcHeight * picWidth];
-      p[3] = srcPicBlockHash[1][pos + srcHeight * picWidth + srcWidth];
-      dstPicBlockHash[1][pos] = TComHash::getCRCValue2((unsigned char*)p, length);
-
       dstPicBlockSameInfo[0][pos] = srcPicBlockSameInfo[0][pos] && srcPicBlockSameInfo[0][pos + quadWidth] && srcPicBlockSameInfo[0][pos + srcWidth]
         && srcPicBlockSameInfo[0][pos + srcHeight * picWidth] && srcPicBlockSameInfo[0][pos + srcHeight * picWidth + quadWidth] && srcPicBlockSameInfo[0][pos + srcHeight * picWidth + srcWidth];
 
@@ -331,6 +494,33 @@ void TComHash::generateBlockHashValue(int picWidth, int picHeight, int width, in
   }
 }
 
+void TComHash::xHashBlock2x2(const Pel* src, int stride, int shift, uint32_t* dstHash1, uint32_t* dstHash2, int num, const TCRCCalculatorLight& crc1, const TCRCCalculatorLight& crc2)
+{
+  unsigned char p[4];
+  for (int i = 0; i < num; i++)
+  {
+    p[0] = static_cast<unsigned char>(src[i] >> shift);
+    p[1] = static_cast<unsigned char>(src[i + 1] >> shift);
+    p[2] = static_cast<unsigned char>(src[stride + i] >> shift);
+    p[3] = static_cast<unsigned char>(src[stride + i + 1] >> shift);
+    dstHash1[i] = crc1.getCRC(p, 4);
+    dstHash2[i] = crc2.getCRC(p, 4);
+  }
+}
+
+void TComHash::xHashQuad(const uint32_t* src, int offsetX, int offsetY, uint32_t* dst, int num, const TCRCCalculatorLight& crc)
+{
+  uint32_t p[4];
+  for (int i = 0; i < num; i++)
+  {
+    p[0] = src[i];
+    p[1] = src[i + offsetX];
+    p[2] = src[i + offsetY];
+    p[3] = src[i + offsetY + offsetX];
+    dst[i] = crc.getCRC((unsigned char*)p, 4 * sizeof(uint32_t));
+  }
+}
+
 void TComHash::addToHashMapByRowWithPrecalData(uint32_t* picHash[2], bool* picIsSame, int picWidth, int picHeight, int width, int height)
 {
   int xEnd = picWidth - width + 1;
@@ -346,26 +536,50 @@ void TComHash::addToHashMapByRowWithPrecalData(uint32_t* picHash[2], bool* picIs
   crcMask -= 1;
   int blockIdx = floorLog2(width) - 2;
 
-  for (int xPos = 0; xPos < xEnd; xPos++)
+  // counting sort of the valid blocks into the buckets of this block size, count the blocks per hash value first
+  uint32_t* bucketStart = &m_bucketStart[xBucketIdx(addValue)];
+  std::fill(bucketStart, bucketStart + crcMask + 2, 0);
+
+  for (int yPos = 0; yPos < yEnd; yPos++)
   {
-    for (int yPos = 0; yPos < yEnd; yPos++)
+    for (int xPos = 0; xPos < xEnd; xPos++)
     {
       int pos = yPos * picWidth + xPos;
       hashPic[blockIdx][pos] = (uint16_t)(srcHash[1][pos] & crcMask);
       //valid data
       if (srcIsAdded[pos])
       {
-        BlockHash blockHash;
+        bucketStart[(srcHash[0][pos] & crcMask) + 1]++;
+      }
+    }
+  }
+
+  const uint32_t firstBlock = static_cast<uint32_t>(m_blockHashes.size());
+  uint32_t       numBlocks  = firstBlock;
+  for (int i = 0; i <= crcMask + 1; i++)
+  {
+    numBlocks += bucketStart[i];
+    bucketStart[i] = numBlocks;
+  }
+  m_blockHashes.resize(numBlocks);
+
+  // fill the buckets in the column-wise order of the blocks, the starts are advanced to the bucket ends on the way
+  for (int xPos = 0; xPos < xEnd; xPos++)
+  {
+    for (int yPos = 0; yPos < yEnd; yPos++)
+    {
+      int pos = yPos * picWidth + xPos;
+      if (srcIsAdded[pos])
+      {
+        BlockHash& blockHash = m_blockHashes[bucketStart[srcHash[0][pos] & crcMask]++];
         blockHash.x = xPos;
         blockHash.y = yPos;
-
-        uint32_t hashValue1 = (srcHash[0][pos] & crcMask) + addValue;
         blockHash.hashValue2 = srcHash[1][pos];
-
-        addToTable(hashValue1, blockHash);
       }
     }
   }
+  std::copy_backward(bucketStart, bucketStart + crcMask + 1, bucketStart + crcMask + 2);
+  bucketStart[0] = firstBlock;
 }
 
 void TComHash::getPixelsIn1DCharArrayByBlock2x2(const PelUnitBuf &curPicBuf, unsigned char* pixelsIn1D, int xStart, int yStart, const BitDepths& bitDepths, bool includeAllComponent)
@@ -551,19 +765,11 @@ bool TComHash::getBlockHashValue(const PelUnitBuf &curPicBuf, int width, int hei
     includeChroma = true;
   }
 
-  unsigned char* p = new unsigned char[length];
+  unsigned char p[4 * 3];
   uint32_t toHash[4];
 
-  int block2x2Num = (width*height) >> 2;
-
-  uint32_t* hashValueBuffer[2][2];
-  for (int i = 0; i < 2; i++)
-  {
-    for (int j = 0; j < 2; j++)
-    {
-      hashValueBuffer[i][j] = new uint32_t[block2x2Num];
-    }
-  }
+  // the block sizes of m_blockSizeToIndex are at most 64x64
+  uint32_t hashValueBuffer[2][2][(64 * 64) >> 2];
 
   //2x2 subblock hash values in current CU
   int subBlockInWidth = (width >> 1);
@@ -659,16 +865,6 @@ bool TComHash::getBlockHashValue(const PelUnitBuf &curPicBuf, int width, int hei
   hashValue1 = (hashValueBuffer[0][dstIdx][0] & crcMask) + addValue;
   hashValue2 = hashValueBuffer[1][dstIdx][0];
 
-  for (int i = 0; i < 2; i++)
-  {
-    for (int j = 0; j < 2; j++)
-    {
-      delete[] hashValueBuffer[i][j];
-    }
-  }
-
-  delete[] p;
-
   return true;
 }
 
@@ -691,15 +887,11 @@ void TComHash::initBlockSizeToIndex()
 
 uint32_t TComHash::getCRCValue1(unsigned char* p, int length)
 {
-  m_crcCalculator1.reset();
-  m_crcCalculator1.processData(p, length);
-  return m_crcCalculator1.getCRC();
+  return m_crcCalculator1.getCRC(p, length);
 }
 
 uint32_t TComHash::getCRCValue2(unsigned char* p, int length)
 {
-  m_crcCalculator2.reset();
-  m_crcCalculator2.processData(p, length);
-  return m_crcCalculator2.getCRC();
+  return m_crcCalculator2.getCRC(p, length);
 }
 //! \}
@@ -56,7 +56,8 @@ struct BlockHash
   uint32_t hashValue2;
 };
 
-typedef std::vector<BlockHash>::iterator MapIterator;
+typedef const BlockHash* MapIterator;
+typedef static_vector<BlockHash, HASH_ME_MAX_MATCHES> BlockHashList;   ///< best hash matches, sorted by cost
 
 // ====================================================================================================================
 // Class definitions
@@ -73,6 +74,8 @@ public:
   void processData(unsigned char* curData, uint32_t dataLength);
   void reset() { m_remainder = 0; }
   uint32_t getCRC() { return m_remainder & m_finalResultMask; }
+  uint32_t getCRC(const unsigned char* curData, uint32_t dataLength) const;
+  const uint32_t (*getTable() const)[256] { return m_table; }
 
 private:
   void xInitTable();
@@ -81,11 +84,39 @@ private:
   uint32_t m_remainder;
   uint32_t m_truncPoly;
   uint32_t m_bits;
-  uint32_t m_table[256];
+  uint32_t m_table[4][256];   // [k][i]: remainder of byte i followed by k zero bytes, for processing four bytes per step
   uint32_t m_finalResultMask;
 };
 
 
+// block hash planes (2x2 ~ 64x64) of the last picture added to a hash table, a block hash only depends on the samples
+// of the block, so the next picture takes over the hashes of all blocks without changed samples
+struct TComHashPlanes
+{
+public:
+  static const int NUM_LEVELS = 6;
+
+  TComHashPlanes();
+  ~TComHashPlanes();
+  void create(const PelUnitBuf &curPicBuf, int picWidth, int picHeight);
+  void destroy();
+  bool markChangedSamples(const PelUnitBuf &curPicBuf);
+  void storeSamples(const PelUnitBuf &curPicBuf);
+
+public:
+  uint32_t* hash[NUM_LEVELS][2];
+  bool*     sameInfo[2][3];
+  uint8_t*  changed[2];   // changed samples, then changed blocks of each level
+
+private:
+  int          m_picWidth;
+  int          m_picHeight;
+  ChromaFormat m_chromaFormat;
+  bool         m_hasPrevious;
+  PelStorage   m_prevSamples;   // samples hashed by the 2x2 blocks of the last picture
+};
+
+
 struct TComHash
 {
 public:
@@ -93,15 +124,12 @@ public:
   ~TComHash();
   void create(int picWidth, int picHeight);
   void clearAll();
-  void addToTable(uint32_t hashValue, const BlockHash& blockHash);
-  int count(uint32_t hashValue);
   int count(uint32_t hashValue) const;
-  MapIterator getFirstIterator(uint32_t hashValue);
-  const MapIterator getFirstIterator(uint32_t hashValue) const;
-  bool hasExactMatch(uint32_t hashValue1, uint32_t hashValue2);
+  MapIterator getFirstIterator(uint32_t hashValue) const;
+  bool hasExactMatch(uint32_t hashValue1, uint32_t hashValue2) const;
 
-  void generateBlock2x2HashValue(const PelUnitBuf &curPicBuf, int picWidth, int picHeight, const BitDepths bitDepths, uint32_t* picBlockHash[2], bool* picBlockSameInfo[3]);
-  void generateBlockHashValue(int picWidth, int picHeight, int width, int height, uint32_t* srcPicBlockHash[2], uint32_t* dstPicBlockHash[2], bool* srcPicBlockSameInfo[3], bool* dstPicBlockSameInfo[3]);
+  void generateBlock2x2HashValue(const PelUnitBuf &curPicBuf, int picWidth, int picHeight, const BitDepths bitDepths, uint32_t* picBlockHash[2], bool* picBlockSameInfo[3], const uint8_t* srcChanged = nullptr, uint8_t* dstChanged = nullptr);
+  void generateBlockHashValue(int picWidth, int picHeight, int width, int height, uint32_t* srcPicBlockHash[2], uint32_t* dstPicBlockHash[2], bool* srcPicBlockSameInfo[3], bool* dstPicBlockSameInfo[3], const uint8_t* srcChanged = nullptr, uint8_t* dstChanged = nullptr);
   void addToHashMapByRowWithPrecalData(uint32_t* srcHash[2], bool* srcIsSame, int picWidth, int picHeight, int width, int height);
   bool isInitial() { return tableHasContent; }
   void setInitial() { tableHasContent = true; }
@@ -119,8 +147,27 @@ public:
   static bool isHorizontalPerfectLuma(const Pel* srcPel, int stride, int width, int height);
   static bool isVerticalPerfectLuma(const Pel* srcPel, int stride, int width, int height);
 
+  // CRCs of the luma 2x2 blocks at num consecutive positions, samples are reduced to 8 bits by shift
+  void (*m_hashBlock2x2)(const Pel* src, int stride, int shift, uint32_t* dstHash1, uint32_t* dstHash2, int num, const TCRCCalculatorLight& crc1, const TCRCCalculatorLight& crc2);
+  // CRCs of the hash values (src[0], src[offsetX], src[offsetY], src[offsetY + offsetX]) at num consecutive positions
+  void (*m_hashQuad)(const uint32_t* src, int offsetX, int offsetY, uint32_t* dst, int num, const TCRCCalculatorLight& crc);
+
+#ifdef TARGET_SIMD_X86
+  void initHashX86();
+  template <X86_VEXT vext>
+  void _initHashX86();
+#endif
+
+private:
+  static void xHashBlock2x2(const Pel* src, int stride, int shift, uint32_t* dstHash1, uint32_t* dstHash2, int num, const TCRCCalculatorLight& crc1, const TCRCCalculatorLight& crc2);
+  static void xHashQuad(const uint32_t* src, int offsetX, int offsetY, uint32_t* dst, int num, const TCRCCalculatorLight& crc);
+  static int  xBucketIdx(uint32_t hashValue) { return hashValue + (hashValue >> m_CRCBits); }
+
 private:
-  std::vector<BlockHash>** m_lookupTable;
+  // all blocks of a picture are stored in one array, grouped by hash value in bucket order; the bucket of hashValue
+  // ranges from m_bucketStart[xBucketIdx(hashValue)] to the following start, each block size has an end entry
+  std::vector<uint32_t>  m_bucketStart;
+  std::vector<BlockHash> m_blockHashes;
   bool tableHasContent;
   uint16_t* hashPic[5];//4x4 ~ 64x64
 
@@ -43,6 +43,10 @@
 
 using namespace std;
 
+// the hashes of all blocks touching a changed tile of IBC_HASH_TILE_SIZE x IBC_HASH_TILE_SIZE luma samples are recomputed
+static const int IBC_HASH_TILE_LOG2 = 3;
+static const int IBC_HASH_TILE_SIZE = 1 << IBC_HASH_TILE_LOG2;
+
 //! \ingroup IbcHashMap
 //! \{
 
@@ -55,8 +59,11 @@ IbcHashMap::IbcHashMap()
   m_picWidth  = 0;
   m_picHeight = 0;
   m_pos2Hash  = nullptr;
+  m_prevPicValid = false;
+  m_tileStride   = 0;
 
   m_computeCrc32c = xxComputeCrc32c16bit;
+  m_calcBlockHash = xxCalcBlockHash;
 
 #if ENABLE_SIMD_OPT_IBC
 #ifdef TARGET_SIMD_X86
@@ -76,6 +83,11 @@ void IbcHashMap::init(const int picWidth, const int picHeight)
   {
     destroy();
   }
+  if (m_pos2Hash != nullptr)
+  {
+    // keep the hashes of the last picture for the incremental update
+    return;
+  }
 
   m_picWidth = picWidth;
   m_picHeight = picHeight;
@@ -85,6 +97,11 @@ void IbcHashMap::init(const int picWidth, const int picHeight)
   {
     m_pos2Hash[n] = m_pos2Hash[n - 1] + m_picWidth;
   }
+  m_pos2Bucket.resize(m_picWidth * m_picHeight);
+
+  m_tileStride = (m_picWidth + IBC_HASH_TILE_SIZE - 1) >> IBC_HASH_TILE_LOG2;
+  m_tileChanged.resize(m_tileStride * ((m_picHeight + IBC_HASH_TILE_SIZE - 1) >> IBC_HASH_TILE_LOG2));
+  m_prevPicValid = false;
 }
 
 void IbcHashMap::destroy()
@@ -98,6 +115,15 @@ void IbcHashMap::destroy()
     delete[] m_pos2Hash;
   }
   m_pos2Hash = nullptr;
+
+  std::vector<Position>().swap(m_bucketPos);
+  std::vector<uint32_t>().swap(m_bucketStart);
+  std::vector<uint32_t>().swap(m_pos2Bucket);
+  std::vector<uint64_t>().swap(m_sortBuf[0]);
+  std::vector<uint64_t>().swap(m_sortBuf[1]);
+  std::vector<uint8_t>().swap(m_tileChanged);
+  m_prevPic.destroy();
+  m_prevPicValid = false;
 }
 ////////////////////////////////////////////////////////
 // CRC32C calculation in C code, same results as SSE 4.2's implementation
@@ -184,21 +210,77 @@ uint32_t IbcHashMap::xxComputeCrc32c16bit(uint32_t crc, const Pel pel)
 // CRC calculation in C code
 ////////////////////////////////////////////////////////
 
-unsigned int IbcHashMap::xxCalcBlockHash(const Pel* pel, const int stride, const int width, const int height, unsigned int crc)
+uint32_t IbcHashMap::xxCalcBlockHash(const Pel* pel, const ptrdiff_t stride, const int width, const int height, uint32_t crc)
 {
   for (int y = 0; y < height; y++)
   {
     for (int x = 0; x < width; x++)
     {
-      crc = m_computeCrc32c(crc, pel[x]);
+      crc = xxComputeCrc32c16bit(crc, pel[x]);
     }
     pel += stride;
   }
   return crc;
 }
 
+bool IbcHashMap::xxMarkChangedTiles(const PelUnitBuf& pic)
+{
+  if (!m_prevPicValid || m_prevPic.chromaFormat != pic.chromaFormat)
+  {
+    m_prevPic.destroy();
+    m_prevPic.create(pic.chromaFormat, Area(0, 0, m_picWidth, m_picHeight));
+    m_prevPic.copyFrom(pic);
+    m_prevPicValid = true;
+    std::fill(m_tileChanged.begin(), m_tileChanged.end(), 1);
+    return true;
+  }
+
+  std::fill(m_tileChanged.begin(), m_tileChanged.end(), 0);
+  bool anyChanged = false;
+  for (uint32_t comp = 0; comp < getNumberValidComponents(pic.chromaFormat); comp++)
+  {
+    const ComponentID compID = ComponentID(comp);
+    const CPelBuf     cur    = pic.get(compID);
+    PelBuf            prev   = m_prevPic.get(compID);
+    const int         scaleX = getComponentScaleX(compID, pic.chromaFormat);
+    const int         scaleY = getComponentScaleY(compID, pic.chromaFormat);
+    const int         tileW  = IBC_HASH_TILE_SIZE >> scaleX;
+
+    for (int y = 0; y < cur.height; y++)
+    {
+      const Pel* curRow  = cur.bufAt(0, y);
+      Pel*       prevRow = prev.bufAt(0, y);
+      if (memcmp(curRow, prevRow, cur.width * sizeof(Pel)) == 0)
+      {
+        continue;
+      }
+      uint8_t* tileRow = &m_tileChanged[((y << scaleY) >> IBC_HASH_TILE_LOG2) * m_tileStride];
+      for (int x = 0; x < cur.width; x += tileW)
+      {
+        const int num = std::min<int>(tileW, cur.width - x);
+        tileRow[x / tileW] |= memcmp(curRow + x, prevRow + x, num * sizeof(Pel)) != 0;
+      }
+      memcpy(prevRow, curRow, cur.width * sizeof(Pel));
+      anyChanged = true;
+    }
+  }
+  return anyChanged;
+}
+
+bool IbcHashMap::xxBlockChanged(const int x, const int y) const
+{
+  // the chroma samples of a block lie in the tiles of its luma samples
+  const int tileX0 = x >> IBC_HASH_TILE_LOG2;
+  const int tileX1 = (x + MIN_PU_SIZE - 1) >> IBC_HASH_TILE_LOG2;
+  const int tileY0 = y >> IBC_HASH_TILE_LOG2;
+  const int tileY1 = (y + MIN_PU_SIZE - 1) >> IBC_HASH_TILE_LOG2;
+  const uint8_t* row0 = &m_tileChanged[tileY0 * m_tileStride];
+  const uint8_t* row1 = &m_tileChanged[tileY1 * m_tileStride];
+  return (row0[tileX0] | row0[tileX1] | row1[tileX0] | row1[tileX1]) != 0;
+}
+
 template<ChromaFormat chromaFormat>
-void IbcHashMap::xxBuildPicHashMap(const PelUnitBuf& pic)
+void IbcHashMap::xxBuildPicHashMap(const PelUnitBuf& pic, const bool incremental)
 {
   const int chromaScalingX = getChannelTypeScaleX(CHANNEL_TYPE_CHROMA, chromaFormat);
   const int chromaScalingY = getChannelTypeScaleY(CHANNEL_TYPE_CHROMA, chromaFormat);
@@ -223,49 +305,127 @@ void IbcHashMap::xxBuildPicHashMap(const PelUnitBuf& pic)
 
     for (pos.x = 0; pos.x + MIN_PU_SIZE <= pic.Y().width; pos.x++)
     {
+      if (incremental && !xxBlockChanged(pos.x, pos.y))
+      {
+        continue;
+      }
+
       // 0x1FF is just an initial value
       unsigned int hashValue = 0x1FF;
 
       // luma part
-      hashValue = xxCalcBlockHash(&pelY[pos.x], pic.Y().stride, MIN_PU_SIZE, MIN_PU_SIZE, hashValue);
+      hashValue = m_calcBlockHash(&pelY[pos.x], pic.Y().stride, MIN_PU_SIZE, MIN_PU_SIZE, hashValue);
 
       // chroma part
       if (chromaFormat != CHROMA_400)
       {
         int chromaX = pos.x >> chromaScalingX;
-        hashValue = xxCalcBlockHash(&pelCb[chromaX], pic.Cb().stride, chromaMinBlkWidth, chromaMinBlkHeight, hashValue);
-        hashValue = xxCalcBlockHash(&pelCr[chromaX], pic.Cr().stride, chromaMinBlkWidth, chromaMinBlkHeight, hashValue);
+        hashValue = m_calcBlockHash(&pelCb[chromaX], pic.Cb().stride, chromaMinBlkWidth, chromaMinBlkHeight, hashValue);
+        hashValue = m_calcBlockHash(&pelCr[chromaX], pic.Cr().stride, chromaMinBlkWidth, chromaMinBlkHeight, hashValue);
       }
 
-      // hash table
-      m_hash2Pos[hashValue].push_back(pos);
       m_pos2Hash[pos.y][pos.x] = hashValue;
     }
   }
 }
 
+void IbcHashMap::xxBuildHashIndex()
+{
+  const int    numX      = m_picWidth - MIN_PU_SIZE + 1;
+  const int    numY      = m_picHeight - MIN_PU_SIZE + 1;
+  const size_t numBlocks = size_t(numX) * numY;
+
+  m_sortBuf[0].resize(numBlocks);
+  m_sortBuf[1].resize(numBlocks);
+  uint64_t* src = m_sortBuf[0].data();
+  uint64_t* dst = m_sortBuf[1].data();
+
+  // hash value in the upper half, position in the lower half
+  size_t n = 0;
+  for (int y = 0; y < numY; y++)
+  {
+    for (int x = 0; x < numX; x++)
+    {
+      src[n++] = (uint64_t(m_pos2Hash[y][x]) << 32) | (uint32_t(y) << 16) | uint32_t(x);
+    }
+  }
+
+  // stable LSD radix sort by the hash value, the blocks of a hash value stay in raster order
+  static const int RADIX_BITS = 11;
+  static const int RADIX_SIZE = 1 << RADIX_BITS;
+  uint32_t count[RADIX_SIZE];
+  for (int shift = 32; shift < 64; shift += RADIX_BITS)
+  {
+    memset(count, 0, sizeof(count));
+    for (size_t i = 0; i < numBlocks; i++)
+    {
+      count[(src[i] >> shift) & (RADIX_SIZE - 1)]++;
+    }
+    uint32_t sum = 0;
+    for (int d = 0; d < RADIX_SIZE; d++)
+    {
+      const uint32_t num = count[d];
+      count[d] = sum;
+      sum += num;
+    }
+    for (size_t i = 0; i < numBlocks; i++)
+    {
+      dst[count[(src[i] >> shift) & (RADIX_SIZE - 1)]++] = src[i];
+    }
+    std::swap(src, dst);
+  }
+
+  m_bucketPos.resize(numBlocks);
+  m_bucketStart.clear();
+  m_bucketStart.reserve(numBlocks + 1);
+  uint32_t prevHash = 0;
+  for (size_t i = 0; i < numBlocks; i++)
+  {
+    const uint32_t hash = uint32_t(src[i] >> 32);
+    const int      x    = int(src[i] & 0xffff);
+    const int      y    = int((src[i] >> 16) & 0xffff);
+    if (i == 0 || hash != prevHash)
+    {
+      m_bucketStart.push_back(uint32_t(i));
+      prevHash = hash;
+    }
+    m_bucketPos[i] = Position(x, y);
+    m_pos2Bucket[y * m_picWidth + x] = uint32_t(m_bucketStart.size() - 1);
+  }
+  m_bucketStart.push_back(uint32_t(numBlocks));
+}
+
 void IbcHashMap::rebuildPicHashMap(const PelUnitBuf& pic)
 {
-  m_hash2Pos.clear();
+  CHECK(pic.Y().width != m_picWidth || pic.Y().height != m_picHeight, "picture size does not match the hash map");
+
+  // only the blocks touching changed tiles are hashed again, the index is kept for an unchanged picture
+  const bool incremental = m_prevPicValid && m_prevPic.chromaFormat == pic.chromaFormat;
+  if (!xxMarkChangedTiles(pic))
+  {
+    return;
+  }
 
   switch (pic.chromaFormat)
   {
   case CHROMA_400:
-    xxBuildPicHashMap<CHROMA_400>(pic);
+    xxBuildPicHashMap<CHROMA_400>(pic, incremental);
     break;
   case CHROMA_420:
-    xxBuildPicHashMap<CHROMA_420>(pic);
+    xxBuildPicHashMap<CHROMA_420>(pic, incremental);
     break;
   case CHROMA_422:
-    xxBuildPicHashMap<CHROMA_422>(pic);
+    xxBuildPicHashMap<CHROMA_422>(pic, incremental);
     break;
   case CHROMA_444:
-    xxBuildPicHashMap<CHROMA_444>(pic);
+    xxBuildPicHashMap<CHROMA_444>(pic, incremental);
     break;
   default:
     THROW("invalid chroma fomat");
     break;
   }
+
+  xxBuildHashIndex();
 }
 
 bool IbcHashMap::ibcHashMatch(const Area& lumaArea, std::vector<Position>& cand, const CodingStructure& cs, const int maxCand, const int searchRange4SmallBlk)
@@ -273,31 +433,30 @@ bool IbcHashMap::ibcHashMatch(const Area& lumaArea, std::vector<Position>& cand,
   cand.clear();
 
   // find the block with least candidates
-  size_t minSize = MAX_UINT;
-  unsigned int targetHashOneBlock = 0;
+  uint32_t minSize = MAX_UINT;
+  uint32_t targetBucket = 0;
   Position targetBlockOffsetInCu(0, 0);
   for (SizeType y = 0; y < lumaArea.height && minSize > 1; y += MIN_PU_SIZE)
   {
     for (SizeType x = 0; x < lumaArea.width && minSize > 1; x += MIN_PU_SIZE)
     {
-      unsigned int hash = m_pos2Hash[lumaArea.pos().y + y][lumaArea.pos().x + x];
-      if (m_hash2Pos[hash].size() < minSize)
+      const uint32_t bucket = m_pos2Bucket[(lumaArea.pos().y + y) * m_picWidth + lumaArea.pos().x + x];
+      if (xxBucketSize(bucket) < minSize)
       {
-        minSize = m_hash2Pos[hash].size();
-        targetHashOneBlock = hash;
+        minSize = xxBucketSize(bucket);
+        targetBucket = bucket;
         targetBlockOffsetInCu.repositionTo(Position(x, y));
       }
     }
   }
 
-  if (m_hash2Pos[targetHashOneBlock].size() > 1)
+  if (minSize > 1 && minSize != MAX_UINT)
   {
-    std::vector<Position>& candOneBlock = m_hash2Pos[targetHashOneBlock];
-
     // check whether whole block match
-    for (std::vector<Position>::iterator refBlockPos = candOneBlock.begin(); refBlockPos != candOneBlock.end(); refBlockPos++)
+    for (uint32_t n = m_bucketStart[targetBucket]; n < m_bucketStart[targetBucket + 1]; n++)
     {
-      Position topLeft = refBlockPos->offset(-targetBlockOffsetInCu.x, -targetBlockOffsetInCu.y);
+      const Position& refBlockPos = m_bucketPos[n];
+      Position topLeft = refBlockPos.offset(-targetBlockOffsetInCu.x, -targetBlockOffsetInCu.y);
       Position bottomRight = topLeft.offset(lumaArea.width - 1, lumaArea.height - 1);
       bool wholeBlockMatch = true;
       if (lumaArea.width > MIN_PU_SIZE || lumaArea.height > MIN_PU_SIZE)
@@ -317,7 +476,7 @@ bool IbcHashMap::ibcHashMatch(const Area& lumaArea, std::vector<Position>& cand,
       }
       else
       {
-        CHECK(topLeft != *refBlockPos, "4x4 target block should not have offset!");
+        CHECK(topLeft != refBlockPos, "4x4 target block should not have offset!");
         if (abs(topLeft.x - lumaArea.x) > searchRange4SmallBlk || abs(topLeft.y - lumaArea.y) > searchRange4SmallBlk || !cs.isDecomp(bottomRight, CHANNEL_TYPE_LUMA))
         {
           continue;
@@ -337,7 +496,7 @@ bool IbcHashMap::ibcHashMatch(const Area& lumaArea, std::vector<Position>& cand,
   return cand.size() > 0;
 }
 
-int IbcHashMap::getHashHitRatio(const Area& lumaArea)
+int IbcHashMap::getHashHitRatio(const Area& lumaArea) const
 {
   int maxX = std::min((int)(lumaArea.x + lumaArea.width), m_picWidth);
   int maxY = std::min((int)(lumaArea.y + lumaArea.height), m_picHeight);
@@ -346,15 +505,14 @@ int IbcHashMap::getHashHitRatio(const Area& lumaArea)
   {
     for (int x = lumaArea.x; x < maxX; x += MIN_PU_SIZE)
     {
-      const unsigned int hash = m_pos2Hash[y][x];
-      hit += (m_hash2Pos[hash].size() > 1);
+      hit += (xxBucketSize(x, y) > 1);
       total++;
     }
   }
   return 100 * hit / total;
 }
 
-int IbcHashMap::calHashBlkMatchPerc(const Area& lumaArea)
+int IbcHashMap::calHashBlkMatchPerc(const Area& lumaArea) const
 {
   int maxX = std::min((int)(lumaArea.x + lumaArea.width), m_picWidth);
   int maxY = std::min((int)(lumaArea.y + lumaArea.height), m_picHeight);
@@ -369,11 +527,13 @@ int IbcHashMap::calHashBlkMatchPerc(const Area& lumaArea)
     mostSelHash[i] = 0;
   }
 
-  for (std::unordered_map<unsigned int, std::vector<Position>>::iterator it = m_hash2Pos.begin(); it != m_hash2Pos.end(); ++it)
+  // buckets are visited in ascending hash order, so ties in the usage are resolved deterministically
+  const uint32_t numBuckets = uint32_t(m_bucketStart.size()) - 1;
+  for (uint32_t bucket = 0; bucket < numBuckets; bucket++)
   {
-    unsigned int hash = it->first;
-    int usage = (int)it->second.size();
-    assert(usage == m_hash2Pos[hash].size());
+    const Position& firstPos = m_bucketPos[m_bucketStart[bucket]];
+    unsigned int hash = m_pos2Hash[firstPos.y][firstPos.x];
+    int usage = (int)xxBucketSize(bucket);
 
     int insertPos = -1;
     for (insertPos = 0; insertPos < numExcludedHashValue; insertPos++)
@@ -418,7 +578,7 @@ int IbcHashMap::calHashBlkMatchPerc(const Area& lumaArea)
         continue;
       }
 
-      hit += (m_hash2Pos[hash].size() > 1);
+      hit += (xxBucketSize(x, y) > 1);
       total++;
     }
   }
@@ -46,7 +46,6 @@
 #include "CommonLib/Unit.h"
 #include "CommonLib/UnitPartitioner.h"
 
-#include <unordered_map>
 #include <vector>
 //! \ingroup EncoderLib
 //! \{
@@ -61,17 +60,35 @@ private:
   int     m_picWidth;
   int     m_picHeight;
   unsigned int**  m_pos2Hash;
-  std::unordered_map<unsigned int, std::vector<Position>> m_hash2Pos;
 
-  unsigned int xxCalcBlockHash(const Pel* pel, const int stride, const int width, const int height, unsigned int crc);
+  // hash index: the block positions grouped by hash value in ascending order, each bucket in raster order
+  std::vector<Position> m_bucketPos;
+  std::vector<uint32_t> m_bucketStart;     // first entry of each bucket in m_bucketPos, plus the end of the last one
+  std::vector<uint32_t> m_pos2Bucket;      // bucket of the block at each position, stride m_picWidth
+  std::vector<uint64_t> m_sortBuf[2];
+
+  // samples of the last hashed picture, the hashes of blocks in unchanged tiles are kept
+  PelStorage            m_prevPic;
+  bool                  m_prevPicValid;
+  std::vector<uint8_t>  m_tileChanged;
+  int                   m_tileStride;
+
+  uint32_t xxBucketSize(const uint32_t bucket) const { return m_bucketStart[bucket + 1] - m_bucketStart[bucket]; }
+  uint32_t xxBucketSize(const int x, const int y) const { return xxBucketSize(m_pos2Bucket[y * m_picWidth + x]); }
+
+  bool    xxMarkChangedTiles(const PelUnitBuf& pic);
+  bool    xxBlockChanged(const int x, const int y) const;
 
   template<ChromaFormat chromaFormat>
-  void    xxBuildPicHashMap(const PelUnitBuf& pic);
+  void    xxBuildPicHashMap(const PelUnitBuf& pic, const bool incremental);
+  void    xxBuildHashIndex();
 
   static  uint32_t xxComputeCrc32c16bit(uint32_t crc, const Pel pel);
+  static  uint32_t xxCalcBlockHash(const Pel* pel, const ptrdiff_t stride, const int width, const int height, uint32_t crc);
 
 public:
   uint32_t (*m_computeCrc32c) (uint32_t crc, const Pel pel);
+  uint32_t (*m_calcBlockHash) (const Pel* pel, const ptrdiff_t stride, const int width, const int height, uint32_t crc);
 
   IbcHashMap();
   virtual ~IbcHashMap();
@@ -80,9 +97,9 @@ public:
   void    destroy();
   void    rebuildPicHashMap(const PelUnitBuf& pic);
   bool    ibcHashMatch(const Area& lumaArea, std::vector<Position>& cand, const CodingStructure& cs, const int maxCand, const int searchRange4SmallBlk);
-  int     getHashHitRatio(const Area& lumaArea);
+  int     getHashHitRatio(const Area& lumaArea) const;
 
-  int     calHashBlkMatchPerc(const Area& lumaArea);
+  int     calHashBlkMatchPerc(const Area& lumaArea) const;
 
 #ifdef TARGET_SIMD_X86
   void    initIbcHashMapX86();
@@ -365,6 +365,9 @@ InterpolationFilter::InterpolationFilter()
   m_filterCopy[1][0]   = filterCopy<true, false>;
   m_filterCopy[1][1]   = filterCopy<true, true>;
 
+  m_filterHorBatch = xFilterHorBatch;
+  m_filterVerBatch = xFilterVerBatch;
+
   m_weightedGeoBlk = xWeightedGeoBlk;
 }
 
@@ -781,6 +784,121 @@ void InterpolationFilter::filterVer(const ComponentID compID, Pel const *src, co
   }
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// !!! NOTE !!!
+//
+//  This is the scalar version of the function.
+//  If you change the functionality here, consider to switch off the SIMD implementation of this function.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void InterpolationFilter::xFilterHorBatch(const ClpRng &clpRng, Pel const *src, const ptrdiff_t srcStride,
+                                          Pel *const *dst, const ptrdiff_t dstStride, int width, int height,
+                                          int numPhases, TFilterCoeff const *const *coeff)
+{
+  const int shift  = IF_FILTER_PREC - IF_INTERNAL_FRAC_BITS(clpRng.bd);
+  const int offset = -(IF_INTERNAL_OFFS << shift);
+
+  src -= NTAPS_LUMA / 2 - 1;
+
+  for (int row = 0; row < height; row++)
+  {
+    for (int k = 0; k < numPhases; k++)
+    {
+      const TFilterCoeff *c = coeff[k];
+      Pel                *d = dst[k] + row * dstStride;
+      for (int col = 0; col < width; col++)
+      {
+        int sum = 0;
+        for (int i = 0; i < NTAPS_LUMA; i++)
+        {
+          sum += src[col + i] * c[i];
+        }
+        d[col] = (sum + offset) >> shift;
+      }
+    }
+    src += srcStride;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// !!! NOTE !!!
+//
+//  This is the scalar version of the function.
+//  If you change the functionality here, consider to switch off the SIMD implementation of this function.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void InterpolationFilter::xFilterVerBatch(const ClpRng &clpRng, Pel const *src, const ptrdiff_t srcStride,
+                                          Pel *const *dst, const ptrdiff_t dstStride, int width, int height,
+                                          int numPhases, TFilterCoeff const *const *coeff, const int *rowOffset)
+{
+  const int shift  = IF_FILTER_PREC + IF_INTERNAL_FRAC_BITS(clpRng.bd);
+  const int offset = (1 << (shift - 1)) + (IF_INTERNAL_OFFS << IF_FILTER_PREC);
+
+  src -= (NTAPS_LUMA / 2 - 1) * srcStride;
+
+  for (int row = 0; row < height; row++)
+  {
+    for (int k = 0; k < numPhases; k++)
+    {
+      const TFilterCoeff *c = coeff[k];
+      const Pel          *s = src + rowOffset[k] * srcStride;
+      Pel                *d = dst[k] + row * dstStride;
+      for (int col = 0; col < width; col++)
+      {
+        int sum = 0;
+        for (int i = 0; i < NTAPS_LUMA; i++)
+        {
+          sum += s[col + i * srcStride] * c[i];
+        }
+        d[col] = ClipPel<int>((sum + offset) >> shift, clpRng);
+      }
+    }
+    src += srcStride;
+  }
+}
+
+TFilterCoeff const *InterpolationFilter::xGetLumaBatchFilter(const int frac, const Filter nFilterIdx)
+{
+  CHECK(frac < 0 || frac >= LUMA_INTERPOLATION_FILTER_SUB_SAMPLE_POSITIONS, "Invalid fraction");
+  CHECK(nFilterIdx != Filter::DEFAULT && nFilterIdx != Filter::HALFPEL_ALT, "Unsupported filter for batch filtering");
+
+  return frac == LUMA_INTERPOLATION_FILTER_SUB_SAMPLE_POSITIONS / 2 && nFilterIdx == Filter::HALFPEL_ALT
+           ? m_lumaAltHpelIFilter
+           : m_lumaFilter[frac];
+}
+
+void InterpolationFilter::filterHorBatch(Pel const *src, const ptrdiff_t srcStride, Pel *const *dst,
+                                         const ptrdiff_t dstStride, int width, int height, int numPhases,
+                                         const int *frac, const ClpRng &clpRng, Filter nFilterIdx)
+{
+  CHECK(numPhases < 1 || numPhases > IF_MAX_BATCH_PHASES, "Invalid number of phases");
+
+  TFilterCoeff const *coeff[IF_MAX_BATCH_PHASES];
+  for (int k = 0; k < numPhases; k++)
+  {
+    coeff[k] = xGetLumaBatchFilter(frac[k], nFilterIdx);
+  }
+  m_filterHorBatch(clpRng, src, srcStride, dst, dstStride, width, height, numPhases, coeff);
+}
+
+void InterpolationFilter::filterVerBatch(Pel const *src, const ptrdiff_t srcStride, Pel *const *dst,
+                                         const ptrdiff_t dstStride, int width, int height, int numPhases,
+                                         const int *frac, const int *rowOffset, const ClpRng &clpRng,
+                                         Filter nFilterIdx)
+{
+  CHECK(numPhases < 1 || numPhases > IF_MAX_BATCH_PHASES, "Invalid number of phases");
+
+  TFilterCoeff const *coeff[IF_MAX_BATCH_PHASES];
+  for (int k = 0; k < numPhases; k++)
+  {
+    CHECK(rowOffset[k] < 0 || rowOffset[k] > 1, "Invalid row offset");
+    coeff[k] = xGetLumaBatchFilter(frac[k], nFilterIdx);
+  }
+  m_filterVerBatch(clpRng, src, srcStride, dst, dstStride, width, height, numPhases, coeff, rowOffset);
+}
+
 void InterpolationFilter::weightedGeoBlk(const PredictionUnit &pu, const uint32_t width, const uint32_t height, const ComponentID compIdx, const uint8_t splitDir, PelUnitBuf& predDst, PelUnitBuf& predSrc0, PelUnitBuf& predSrc1)
 {
   m_weightedGeoBlk(pu, width, height, compIdx, splitDir, predDst, predSrc0, predSrc1);
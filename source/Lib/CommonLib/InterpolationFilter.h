@@ -51,6 +51,7 @@ static constexpr int IF_INTERNAL_OFFS = (1<<(IF_INTERNAL_PREC-1));  ///< Offset
 static constexpr int IF_INTERNAL_PREC_BILINEAR = 10;                ///< Number of bits for internal precision
 static constexpr int IF_FILTER_PREC_BILINEAR   = 4;                 ///< Bilinear filter coeff precision so that intermediate value will not exceed 16 bit for SIMD - bit exact
 static inline int IF_INTERNAL_FRAC_BITS(const int bd) { return std::max(2, IF_INTERNAL_PREC - bd); }
+static constexpr int IF_MAX_BATCH_PHASES = 4;                       ///< Maximum number of fractional phases filtered in one batch
 /**
  * \brief Interpolation filter class
  */
@@ -86,6 +87,12 @@ public:
   void filterVer(const ClpRng &clpRng, Pel const *src, ptrdiff_t srcStride, Pel *dst, ptrdiff_t dstStride, int width,
                  int height, bool isFirst, bool isLast, TFilterCoeff const *coeff);
 
+  static void xFilterHorBatch(const ClpRng &clpRng, Pel const *src, ptrdiff_t srcStride, Pel *const *dst,
+                              ptrdiff_t dstStride, int width, int height, int numPhases, TFilterCoeff const *const *coeff);
+  static void xFilterVerBatch(const ClpRng &clpRng, Pel const *src, ptrdiff_t srcStride, Pel *const *dst,
+                              ptrdiff_t dstStride, int width, int height, int numPhases, TFilterCoeff const *const *coeff,
+                              const int *rowOffset);
+
   static void xWeightedGeoBlk(const PredictionUnit &pu, const uint32_t width, const uint32_t height, const ComponentID compIdx, const uint8_t splitDir, PelUnitBuf& predDst, PelUnitBuf& predSrc0, PelUnitBuf& predSrc1);
   void weightedGeoBlk(const PredictionUnit &pu, const uint32_t width, const uint32_t height, const ComponentID compIdx, const uint8_t splitDir, PelUnitBuf& predDst, PelUnitBuf& predSrc0, PelUnitBuf& predSrc1);
 protected:
@@ -128,6 +135,11 @@ public:
                                            ptrdiff_t dstStride, int width, int height, TFilterCoeff const *coeff);
   void (*m_filterCopy[2][2])(const ClpRng &clpRng, Pel const *src, ptrdiff_t srcStride, Pel *dst, ptrdiff_t dstStride,
                              int width, int height, bool biMCForDMVR);
+  void (*m_filterHorBatch)(const ClpRng &clpRng, Pel const *src, ptrdiff_t srcStride, Pel *const *dst,
+                           ptrdiff_t dstStride, int width, int height, int numPhases, TFilterCoeff const *const *coeff);
+  void (*m_filterVerBatch)(const ClpRng &clpRng, Pel const *src, ptrdiff_t srcStride, Pel *const *dst,
+                           ptrdiff_t dstStride, int width, int height, int numPhases, TFilterCoeff const *const *coeff,
+                           const int *rowOffset);
   void( *m_weightedGeoBlk )(const PredictionUnit &pu, const uint32_t width, const uint32_t height, const ComponentID compIdx, const uint8_t splitDir, PelUnitBuf& predDst, PelUnitBuf& predSrc0, PelUnitBuf& predSrc1);
 
   void initInterpolationFilter( bool enable );
@@ -140,10 +152,21 @@ public:
                  int width, int height, int frac, bool isLast, const ClpRng &clpRng, Filter nFilterIdx);
   void filterVer(const ComponentID compID, Pel const *src, ptrdiff_t srcStride, Pel *dst, ptrdiff_t dstStride,
                  int width, int height, int frac, bool isFirst, bool isLast, const ClpRng &clpRng, Filter nFilterIdx);
+  // Luma 8-tap filtering of several fractional phases of one block in a single pass over the source. The horizontal
+  // batch is the first filter stage, the vertical batch the last one; vertical phase k reads its taps from
+  // src + rowOffset[k] * srcStride, rowOffset[k] being 0 or 1.
+  void filterHorBatch(Pel const *src, ptrdiff_t srcStride, Pel *const *dst, ptrdiff_t dstStride, int width, int height,
+                      int numPhases, const int *frac, const ClpRng &clpRng, Filter nFilterIdx);
+  void filterVerBatch(Pel const *src, ptrdiff_t srcStride, Pel *const *dst, ptrdiff_t dstStride, int width, int height,
+                      int numPhases, const int *frac, const int *rowOffset, const ClpRng &clpRng, Filter nFilterIdx);
 #if JVET_J0090_MEMORY_BANDWITH_MEASURE
   void cacheAssign( CacheModel *cache ) { m_cacheModel = cache; }
 #endif
 
+private:
+  static TFilterCoeff const *xGetLumaBatchFilter(const int frac, const Filter nFilterIdx);
+
+public:
   static TFilterCoeff const * const getChromaFilterTable(const int deltaFract) { return m_chromaFilter[deltaFract]; };
 };
 
@@ -1366,7 +1366,7 @@ void IntraPrediction::xGetLumaRecPixels(const PredictionUnit &pu, CompArea chrom
 
   ptrdiff_t recStride2 = recStride << logSubHeightC;
 
-  const CodingUnit& lumaCU = isChroma( pu.chType ) ? *pu.cs->picture->cs->getCU( lumaArea.pos(), CH_L ) : *pu.cu;
+  const CodingUnit& lumaCU = isChroma( pu.chType ) ? *pu.cs->getColLumaCS()->getCU( lumaArea.pos(), CH_L ) : *pu.cu;
   const CodingUnit&     cu = *pu.cu;
 
   const CompArea& area = isChroma( pu.chType ) ? chromaArea : lumaArea;
@@ -1838,6 +1838,14 @@ void IntraPrediction::initIntraMip( const PredictionUnit &pu, const CompArea &ar
                                         pu.cu->slice->getSPS()->getBitDepth(toChannelType(area.compID)), area.compID);
 }
 
+void IntraPrediction::initIntraMipAllModes( const PredictionUnit &pu, const CompArea &area )
+{
+  initIntraMip( pu, area );
+
+  // derive the reduced prediction of all modes at once, predIntraMip() then only upsamples
+  m_matrixIntraPred.predBlockAllModes( pu.cu->slice->getSPS()->getBitDepth( toChannelType( area.compID ) ), area.compID );
+}
+
 void IntraPrediction::predIntraMip( const ComponentID compId, PelBuf &piPred, const PredictionUnit &pu )
 {
   CHECK( piPred.width > MIP_MAX_WIDTH || piPred.height > MIP_MAX_HEIGHT, "Error: block size not supported for MIP" );
@@ -164,6 +164,7 @@ public:
 
   // Matrix-based intra prediction
   void initIntraMip               (const PredictionUnit &pu, const CompArea &area);
+  void initIntraMipAllModes       (const PredictionUnit &pu, const CompArea &area);
   void predIntraMip               (const ComponentID compId, PelBuf &piPred, const PredictionUnit &pu);
 
   void geneWeightedPred           (const ComponentID compId, PelBuf &pred, const PredictionUnit &pu, Pel *srcBuf);
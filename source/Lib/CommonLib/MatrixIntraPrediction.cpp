@@ -55,14 +55,24 @@ MatrixIntraPrediction::MatrixIntraPrediction():
   m_reducedBdrySize( 0 ),
   m_reducedPredSize( 0 ),
   m_upsmpFactorHor( 0 ),
-  m_upsmpFactorVer( 0 )
+  m_upsmpFactorVer( 0 ),
+  m_allModesValid( false )
 {
+  m_mipMatrixMul    = xMatrixMul;
+  m_mipUpsampling1D = predictionUpsampling1D;
+
+#if ENABLE_SIMD_OPT_MIP
+#ifdef TARGET_SIMD_X86
+  initMatrixIntraPredictionX86();
+#endif
+#endif
 }
 
 void MatrixIntraPrediction::prepareInputForPred(const CPelBuf &pSrc, const Area &block, const int bitDepth,
                                                 const ComponentID compId)
 {
-  m_component = compId;
+  m_component     = compId;
+  m_allModesValid = false;
 
   // Step 1: Save block size and calculate dependent values
   initPredBlockParams(block);
@@ -124,6 +134,21 @@ void MatrixIntraPrediction::predBlock(int *const result, const int modeIdx, cons
 
   const bool needUpsampling = ( m_upsmpFactorHor > 1 ) || ( m_upsmpFactorVer > 1 );
 
+  if( m_allModesValid )
+  {
+    const int        numSamples  = m_reducedPredSize * m_reducedPredSize;
+    const int* const reducedPred = m_reducedPredAllModes[transpose ? 1 : 0] + modeIdx * numSamples;
+    if( needUpsampling )
+    {
+      predictionUpsampling( result, reducedPred );
+    }
+    else
+    {
+      memcpy( result, reducedPred, numSamples * sizeof( int ) );
+    }
+    return;
+  }
+
   const uint8_t* matrix = getMatrixData(modeIdx);
 
   static_vector<int, MIP_MAX_REDUCED_OUTPUT_SAMPLES> bufReducedPred( m_reducedPredSize * m_reducedPredSize );
@@ -136,6 +161,42 @@ void MatrixIntraPrediction::predBlock(int *const result, const int modeIdx, cons
   }
 }
 
+void MatrixIntraPrediction::predBlockAllModes(const int bitDepth, const ComponentID compId)
+{
+  CHECK(m_component != compId, "Boundary has not been prepared for this component.");
+
+  // the matrices of all modes of one size class are stored consecutively, hence the reduced prediction of all modes
+  // is a single matrix-vector product sharing the downsampled boundary
+  const int numModes    = getNumModesMip( m_blockSize );
+  const int numSamples  = m_reducedPredSize * m_reducedPredSize;
+  const int inputSize   = 2 * m_reducedBdrySize;
+  const bool redSize    = (m_sizeId == 2);
+  const uint8_t* matrix = getMatrixData( 0 );
+  CHECK( numModes * numSamples > MIP_MAX_BATCH_OUTPUT_SAMPLES, "Too many MIP output samples" );
+
+  m_mipMatrixMul( m_reducedPredAllModes[0], m_reducedBoundary.data(), matrix, numModes * numSamples, inputSize,
+                  getMatrixOffset( m_reducedBoundary.data() ), m_inputOffset, redSize, bitDepth );
+
+  int resBufTransposed[MIP_MAX_BATCH_OUTPUT_SAMPLES];
+  m_mipMatrixMul( resBufTransposed, m_reducedBoundaryTransposed.data(), matrix, numModes * numSamples, inputSize,
+                  getMatrixOffset( m_reducedBoundaryTransposed.data() ), m_inputOffsetTransp, redSize, bitDepth );
+
+  for( int modeIdx = 0; modeIdx < numModes; modeIdx++ )
+  {
+    const int *src = resBufTransposed + modeIdx * numSamples;
+    int       *dst = m_reducedPredAllModes[1] + modeIdx * numSamples;
+    for( int y = 0; y < m_reducedPredSize; y++ )
+    {
+      for( int x = 0; x < m_reducedPredSize; x++ )
+      {
+        dst[ y * m_reducedPredSize + x ] = src[ x * m_reducedPredSize + y ];
+      }
+    }
+  }
+
+  m_allModesValid = true;
+}
+
 
 void MatrixIntraPrediction::initPredBlockParams(const Size& block)
 {
@@ -251,18 +312,18 @@ void MatrixIntraPrediction::predictionUpsampling( int* const dst, const int* con
     verSrc = horDst;
     verSrcStep *= m_upsmpFactorVer;
 
-    predictionUpsampling1D( horDst, src, m_refSamplesLeft.data(),
-                            m_reducedPredSize, m_reducedPredSize,
-                            1, m_reducedPredSize, 1, verSrcStep,
-                            m_upsmpFactorVer, m_upsmpFactorHor );
+    m_mipUpsampling1D( horDst, src, m_refSamplesLeft.data(),
+                       m_reducedPredSize, m_reducedPredSize,
+                       1, m_reducedPredSize, 1, verSrcStep,
+                       m_upsmpFactorVer, m_upsmpFactorHor );
   }
 
   if( m_upsmpFactorVer > 1 )
   {
-    predictionUpsampling1D( dst, verSrc, m_refSamplesTop.data(),
-                            m_reducedPredSize, m_blockSize.width,
-                            verSrcStep, 1, m_blockSize.width, 1,
-                            1, m_upsmpFactorVer );
+    m_mipUpsampling1D( dst, verSrc, m_refSamplesTop.data(),
+                       m_reducedPredSize, m_blockSize.width,
+                       verSrcStep, 1, m_blockSize.width, 1,
+                       1, m_upsmpFactorVer );
   }
 }
 
@@ -280,6 +341,15 @@ const uint8_t* MatrixIntraPrediction::getMatrixData(const int modeIdx) const
   }
 }
 
+int MatrixIntraPrediction::getMatrixOffset( const int* const input ) const
+{
+  const int inputSize = 2 * m_reducedBdrySize;
+
+  int sum = 0;
+  for( int i = 0; i < inputSize; i++ ) { sum += input[i]; }
+  return (1 << (MIP_SHIFT_MATRIX - 1)) - MIP_OFFSET_MATRIX * sum;
+}
+
 void MatrixIntraPrediction::computeReducedPred( int*const result, const int* const input,
                                                 const uint8_t* matrix,
                                                 const bool transpose, const int bitDepth )
@@ -290,37 +360,13 @@ void MatrixIntraPrediction::computeReducedPred( int*const result, const int* con
   static_vector<int, MIP_MAX_REDUCED_OUTPUT_SAMPLES> resBufTransposed( m_reducedPredSize * m_reducedPredSize );
   int*const resPtr = (transpose) ? resBufTransposed.data() : result;
 
-  int sum = 0;
-  for( int i = 0; i < inputSize; i++ ) { sum += input[i]; }
-  const int offset = (1 << (MIP_SHIFT_MATRIX - 1)) - MIP_OFFSET_MATRIX * sum;
+  const int offset = getMatrixOffset( input );
   CHECK( inputSize != 4 * (inputSize >> 2), "Error, input size not divisible by four" );
 
-  const uint8_t *weight = matrix;
   const int   inputOffset = transpose ? m_inputOffsetTransp : m_inputOffset;
 
   const bool redSize = (m_sizeId == 2);
-  int posRes = 0;
-  for( int y = 0; y < m_reducedPredSize; y++ )
-  {
-    for( int x = 0; x < m_reducedPredSize; x++ )
-    {
-      if( redSize ) weight -= 1;
-      int tmp0 = redSize ? 0 : (input[0] * weight[0]);
-      int tmp1 = input[1] * weight[1];
-      int tmp2 = input[2] * weight[2];
-      int tmp3 = input[3] * weight[3];
-      for (int i = 4; i < inputSize; i += 4)
-      {
-        tmp0 += input[i]     * weight[i];
-        tmp1 += input[i + 1] * weight[i + 1];
-        tmp2 += input[i + 2] * weight[i + 2];
-        tmp3 += input[i + 3] * weight[i + 3];
-      }
-      resPtr[posRes++] = ClipBD<int>(((tmp0 + tmp1 + tmp2 + tmp3 + offset) >> MIP_SHIFT_MATRIX) + inputOffset, bitDepth);
-
-      weight += inputSize;
-    }
-  }
+  m_mipMatrixMul( resPtr, input, matrix, m_reducedPredSize * m_reducedPredSize, inputSize, offset, inputOffset, redSize, bitDepth );
 
   if( transpose )
   {
@@ -333,3 +379,29 @@ void MatrixIntraPrediction::computeReducedPred( int*const result, const int* con
     }
   }
 }
+
+void MatrixIntraPrediction::xMatrixMul( int* const result, const int* const input, const uint8_t* matrix, const int numOutputs,
+                                        const int inputSize, const int offset, const int inputOffset, const bool redSize,
+                                        const int bitDepth )
+{
+  const uint8_t *weight = matrix;
+
+  for( int posRes = 0; posRes < numOutputs; posRes++ )
+  {
+    if( redSize ) weight -= 1;
+    int tmp0 = redSize ? 0 : (input[0] * weight[0]);
+    int tmp1 = input[1] * weight[1];
+    int tmp2 = input[2] * weight[2];
+    int tmp3 = input[3] * weight[3];
+    for (int i = 4; i < inputSize; i += 4)
+    {
+      tmp0 += input[i]     * weight[i];
+      tmp1 += input[i + 1] * weight[i + 1];
+      tmp2 += input[i + 2] * weight[i + 2];
+      tmp3 += input[i + 3] * weight[i + 3];
+    }
+    result[posRes] = ClipBD<int>(((tmp0 + tmp1 + tmp2 + tmp3 + offset) >> MIP_SHIFT_MATRIX) + inputOffset, bitDepth);
+
+    weight += inputSize;
+  }
+}
@@ -43,6 +43,7 @@
 
 static constexpr int MIP_MAX_INPUT_SIZE             =  8;
 static constexpr int MIP_MAX_REDUCED_OUTPUT_SAMPLES = 64;
+static constexpr int MIP_MAX_BATCH_OUTPUT_SAMPLES   = 6 * 64; // reduced prediction samples of all modes of one size class (mipSizeId 2)
 
 
 class MatrixIntraPrediction
@@ -53,6 +54,23 @@ public:
   void prepareInputForPred(const CPelBuf &pSrc, const Area &block, const int bitDepth, const ComponentID compId);
   void predBlock(int *const result, const int modeIdx, const bool transpose, const int bitDepth,
                  const ComponentID compId);
+  // computes the reduced prediction of all modes (both transposed and non-transposed) of the current size class in one
+  // pass, subsequent calls of predBlock() for the same boundary only perform the upsampling
+  void predBlockAllModes(const int bitDepth, const ComponentID compId);
+
+  void (*m_mipMatrixMul)(int *const result, const int *const input, const uint8_t *matrix, const int numOutputs,
+                         const int inputSize, const int offset, const int inputOffset, const bool redSize,
+                         const int bitDepth);
+  void (*m_mipUpsampling1D)(int *const dst, const int *const src, const int *const bndry,
+                            const SizeType srcSizeUpsmpDim, const SizeType srcSizeOrthDim, const SizeType srcStep,
+                            const SizeType srcStride, const SizeType dstStep, const SizeType dstStride,
+                            const SizeType bndryStep, const unsigned int upsmpFactor);
+
+#ifdef TARGET_SIMD_X86
+  void initMatrixIntraPredictionX86();
+  template <X86_VEXT vext>
+  void _initMatrixIntraPredictionX86();
+#endif
 
   private:
     ComponentID m_component;
@@ -71,11 +89,17 @@ public:
     unsigned int m_upsmpFactorHor;
     unsigned int m_upsmpFactorVer;
 
+    bool m_allModesValid;
+    int  m_reducedPredAllModes[2][MIP_MAX_BATCH_OUTPUT_SAMPLES];   // reduced prediction of all modes, [transpose][mode * samples]
+
     void initPredBlockParams(const Size& block);
 
     static void boundaryDownsampling1D(int* reducedDst, const int* const fullSrc, const SizeType srcLen, const SizeType dstLen);
 
     void predictionUpsampling( int* const dst, const int* const src ) const;
+    static void xMatrixMul( int* const result, const int* const input, const uint8_t* matrix, const int numOutputs,
+                            const int inputSize, const int offset, const int inputOffset, const bool redSize,
+                            const int bitDepth );
     static void predictionUpsampling1D( int* const dst, const int* const src, const int* const bndry,
                                         const SizeType srcSizeUpsmpDim, const SizeType srcSizeOrthDim,
                                         const SizeType srcStep, const SizeType srcStride,
@@ -84,6 +108,7 @@ public:
                                         const unsigned int upsmpFactor );
 
     const uint8_t* getMatrixData(const int modeIdx) const;
+    int            getMatrixOffset(const int* const input) const;
 
 
     void computeReducedPred( int*const result, const int* const input,
@@ -57,6 +57,7 @@ Picture::Picture()
   longTerm             = false;
   reconstructed        = false;
   neededForOutput      = false;
+  loopFilterPending    = false;
   referenced           = false;
   temporalId           = std::numeric_limits<uint32_t>::max();
   fieldPic             = false;
@@ -75,6 +76,7 @@ Picture::Picture()
   layerId = NOT_VALID;
   numSlices = 1;
   unscaledPic = nullptr;
+  m_mePyramidValid = false;
   m_isMctfFiltered      = false;
   m_grainCharacteristic = nullptr;
   m_grainBuf            = nullptr;
@@ -117,6 +119,7 @@ void Picture::create( const ChromaFormat &_chromaFormat, const Size &size, const
   m_ctuArea = UnitArea( _chromaFormat, Area( Position{ 0, 0 }, Size( _maxCUSize, _maxCUSize ) ) );
 #endif
   m_hashMap.clearAll();
+  m_mePyramidValid = false;
   
   ROIlist = (ROI*)malloc(MAX_ROIS * sizeof(ROI));
   noROIs = 0;
@@ -130,6 +133,11 @@ void Picture::destroy()
     M_BUFS(jId, t).destroy();
   }
   m_hashMap.clearAll();
+  for( int level = 0; level < ME_PYRAMID_LEVELS; level++ )
+  {
+    m_mePyramid[level].destroy();
+  }
+  m_mePyramidValid = false;
   if (cs)
   {
     cs->destroy();
@@ -1053,6 +1061,13 @@ void Picture::extendPicBorder( const PPS *pps )
     return;
   }
 
+  padPicBorder( pps );
+
+  m_extendedBorder = true;
+}
+
+void Picture::padPicBorder( const PPS *pps )
+{
   for(int comp=0; comp<getNumberValidComponents( cs->area.chromaFormat ); comp++)
   {
     ComponentID compID = ComponentID( comp );
@@ -1100,8 +1115,6 @@ void Picture::extendPicBorder( const PPS *pps )
       m_wrapAroundOffset = 0;
     }
   }
-
-  m_extendedBorder = true;
 }
 
 void Picture::extendWrapBorder( const PPS *pps )
@@ -1253,62 +1266,70 @@ bool Picture::getSpliceFull()
   return true;
 }
 
-void Picture::addPictureToHashMapForInter()
+void Picture::addPictureToHashMapForInter(TComHashPlanes& hashPlanes)
 {
   int picWidth = slices[0]->getPPS()->getPicWidthInLumaSamples();
   int picHeight = slices[0]->getPPS()->getPicHeightInLumaSamples();
-  uint32_t* blockHashValues[2][2];
-  bool     *isBlockSame[2][3];
+  const PelUnitBuf origBuf = getOrigBuf();
 
-  for (int i = 0; i < 2; i++)
-  {
-    for (int j = 0; j < 2; j++)
-    {
-      blockHashValues[i][j] = new uint32_t[picWidth*picHeight];
-    }
+  // the planes still hold the block hashes of the last hashed picture, only the blocks with changed samples are hashed
+  hashPlanes.create(origBuf, picWidth, picHeight);
+  const bool reuseHashes = hashPlanes.markChangedSamples(origBuf);
+  uint8_t* changed[2] = { reuseHashes ? hashPlanes.changed[0] : nullptr, reuseHashes ? hashPlanes.changed[1] : nullptr };
 
-    for (int j = 0; j < 3; j++)
-    {
-      isBlockSame[i][j] = new bool[picWidth * picHeight];
-    }
-  }
   m_hashMap.create(picWidth, picHeight);
-  m_hashMap.generateBlock2x2HashValue(getOrigBuf(), picWidth, picHeight, slices[0]->getSPS()->getBitDepths(),
-                                      blockHashValues[0], isBlockSame[0]);   // 2x2
-  m_hashMap.generateBlockHashValue(picWidth, picHeight, 4, 4, blockHashValues[0], blockHashValues[1], isBlockSame[0],
-                                   isBlockSame[1]);   // 4x4
-  m_hashMap.addToHashMapByRowWithPrecalData(blockHashValues[1], isBlockSame[1][2], picWidth, picHeight, 4, 4);
+  m_hashMap.generateBlock2x2HashValue(origBuf, picWidth, picHeight, slices[0]->getSPS()->getBitDepths(),
+                                      hashPlanes.hash[0], hashPlanes.sameInfo[0], changed[0], changed[1]);   // 2x2
 
-  m_hashMap.generateBlockHashValue(picWidth, picHeight, 8, 8, blockHashValues[1], blockHashValues[0], isBlockSame[1],
-                                   isBlockSame[0]);   // 8x8
-  m_hashMap.addToHashMapByRowWithPrecalData(blockHashValues[0], isBlockSame[0][2], picWidth, picHeight, 8, 8);
-
-  m_hashMap.generateBlockHashValue(picWidth, picHeight, 16, 16, blockHashValues[0], blockHashValues[1], isBlockSame[0],
-                                   isBlockSame[1]);   // 16x16
-  m_hashMap.addToHashMapByRowWithPrecalData(blockHashValues[1], isBlockSame[1][2], picWidth, picHeight, 16, 16);
-
-  m_hashMap.generateBlockHashValue(picWidth, picHeight, 32, 32, blockHashValues[1], blockHashValues[0], isBlockSame[1],
-                                   isBlockSame[0]);   // 32x32
-  m_hashMap.addToHashMapByRowWithPrecalData(blockHashValues[0], isBlockSame[0][2], picWidth, picHeight, 32, 32);
-
-  m_hashMap.generateBlockHashValue(picWidth, picHeight, 64, 64, blockHashValues[0], blockHashValues[1], isBlockSame[0],
-                                   isBlockSame[1]);   // 64x64
-  m_hashMap.addToHashMapByRowWithPrecalData(blockHashValues[1], isBlockSame[1][2], picWidth, picHeight, 64, 64);
+  // 4x4 ~ 64x64
+  for (int level = 1, blockSize = 4; level < TComHashPlanes::NUM_LEVELS; level++, blockSize <<= 1)
+  {
+    m_hashMap.generateBlockHashValue(picWidth, picHeight, blockSize, blockSize, hashPlanes.hash[level - 1], hashPlanes.hash[level],
+                                     hashPlanes.sameInfo[(level - 1) & 1], hashPlanes.sameInfo[level & 1], changed[level & 1], changed[(level + 1) & 1]);
+    m_hashMap.addToHashMapByRowWithPrecalData(hashPlanes.hash[level], hashPlanes.sameInfo[level & 1][2], picWidth, picHeight, blockSize, blockSize);
+  }
 
   m_hashMap.setInitial();
+  hashPlanes.storeSamples(origBuf);
+}
+
+/** builds the downsampled luma levels of the reconstruction for the hierarchical motion search
+ * Each level averages 2x2 samples of the level above, the borders are extended like the ones of the reconstruction.
+ */
+void Picture::createMotionSearchPyramid()
+{
+  CPelBuf src = getRecoBuf( COMPONENT_Y );
 
-  for (int i = 0; i < 2; i++)
+  for( int level = 1; level <= ME_PYRAMID_LEVELS; level++ )
   {
-    for (int j = 0; j < 2; j++)
+    PelStorage&    storage = m_mePyramid[level - 1];
+    const unsigned marginL = ( margin >> level ) + 1;
+    const Area     area( 0, 0, ( src.width + 1 ) >> 1, ( src.height + 1 ) >> 1 );
+
+    if( storage.bufs.empty() || storage.Y().width != area.width || storage.Y().height != area.height )
     {
-      delete[] blockHashValues[i][j];
+      storage.destroy();
+      storage.create( CHROMA_400, area, 0, marginL, MEMORY_ALIGN_DEF_SIZE );
     }
 
-    for (int j = 0; j < 3; j++)
+    PelBuf dst = storage.Y();
+    for( int y = 0; y < dst.height; y++ )
     {
-      delete[] isBlockSame[i][j];
+      const Pel* src0 = src.bufAt( 0, 2 * y );
+      const Pel* src1 = src.bufAt( 0, std::min( 2 * y + 1, (int) src.height - 1 ) );
+      Pel*       dstY = dst.bufAt( 0, y );
+      for( int x = 0; x < dst.width; x++ )
+      {
+        const int x1 = std::min( 2 * x + 1, (int) src.width - 1 );
+        dstY[x] = ( src0[2 * x] + src0[x1] + src1[2 * x] + src1[x1] + 2 ) >> 2;
+      }
     }
+    dst.extendBorderPel( marginL );
+
+    src = dst;
   }
+
+  m_mePyramidValid = true;
 }
 
 void Picture::createGrainSynthesizer(bool firstPictureInSequence, SEIFilmGrainSynthesizer *grainCharacteristics, PelStorage *grainBuf, int width, int height, ChromaFormat fmt, int bitDepth)
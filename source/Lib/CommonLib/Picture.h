@@ -58,6 +58,7 @@
 #include <stdlib.h>
 #include <fstream>
 #include "ROI.h"
+#include "ThreadPool.h"
 
 class SEI;
 class AQpLayer;
@@ -167,6 +168,7 @@ struct Picture : public UnitArea
 #endif
 
   void extendPicBorder( const PPS *pps );
+  void padPicBorder( const PPS *pps );
   void extendWrapBorder( const PPS *pps );
   void finalInit( const VPS* vps, const SPS& sps, const PPS& pps, PicHeader *picHeader, APS** alfApss, APS* lmcsAps, APS* scalingListAps );
 
@@ -233,6 +235,8 @@ public:
   bool referenced;
   bool reconstructed;
   bool neededForOutput;
+  bool loopFilterPending;                                       ///< SAO/ALF and border padding still run in the background
+  ProgressCounter filteredCtuRows;                              ///< CTU rows whose final samples can be referenced
   bool usedByCurr;
   bool longTerm;
   bool topField;
@@ -264,7 +268,14 @@ public:
   TComHash           m_hashMap;
   TComHash*          getHashMap() { return &m_hashMap; }
   const TComHash*    getHashMap() const { return &m_hashMap; }
-  void               addPictureToHashMapForInter();
+  void               addPictureToHashMapForInter(TComHashPlanes& hashPlanes);
+
+  PelStorage         m_mePyramid[ME_PYRAMID_LEVELS];   // luma reconstruction downsampled by 2^level, level 1..ME_PYRAMID_LEVELS
+  bool               m_mePyramidValid;
+  void               createMotionSearchPyramid();
+  void               invalidateMotionSearchPyramid()           { m_mePyramidValid = false; }
+  bool               hasMotionSearchPyramid() const            { return m_mePyramidValid; }
+  const CPelBuf      getMotionSearchPyramid( const int level ) const { return m_mePyramid[level - 1].Y(); }
 
   CodingStructure*   cs;
   std::deque<Slice*> slices;
@@ -325,6 +336,16 @@ public:
       std::fill( m_alfCtuEnableFlag[compIdx].begin(), m_alfCtuEnableFlag[compIdx].end(), 0 );
     }
   }
+  std::vector<uint8_t> m_ccAlfFilterControl[2];
+  uint8_t* getCcAlfFilterControl( int chromaIdx ) { return m_ccAlfFilterControl[chromaIdx].data(); }
+  void resizeCcAlfFilterControl( int numEntries )
+  {
+    for( int chromaIdx = 0; chromaIdx < 2; chromaIdx++ )
+    {
+      m_ccAlfFilterControl[chromaIdx].resize( numEntries );
+      std::fill( m_ccAlfFilterControl[chromaIdx].begin(), m_ccAlfFilterControl[chromaIdx].end(), 0 );
+    }
+  }
   std::vector<short> m_alfCtbFilterIndex;
   short* getAlfCtbFilterIndex() { return m_alfCtbFilterIndex.data(); }
   std::vector<short>& getAlfCtbFilterIndexVec() { return m_alfCtbFilterIndex; }
@@ -191,6 +191,8 @@ public:
     m_mvPredictor = rcMv;
   }
   void           setCostScale             ( int iCostScale )           { m_iCostScale = iCostScale; }
+  const Mv&      getPredictor             ()                     const { return m_mvPredictor; }
+  int            getCostScale             ()                     const { return m_iCostScale; }
   Distortion     getCost                  ( uint32_t b )                   { return Distortion( m_motionLambda * b ); }
   // for ibc
   void           getMotionCost(int add) { m_dCost = m_dLambdaMotionSAD + add; }
@@ -144,9 +144,9 @@ int  Reshape::calculateChromaAdjVpduNei(TransformUnit &tu, const CompArea &areaY
     const CodingUnit *cuAbove, *cuLeft;
     if (CS::isDualITree(cs) && cs.slice->getSliceType() == I_SLICE)
     {
-      topLeftLuma = tu.cs->picture->cs->getCU(topLeft, CHANNEL_TYPE_LUMA);
-      cuAbove = cs.picture->cs->getCURestricted(topLeftLuma->lumaPos().offset(0, -1), *topLeftLuma, CHANNEL_TYPE_LUMA);
-      cuLeft  = cs.picture->cs->getCURestricted(topLeftLuma->lumaPos().offset(-1, 0), *topLeftLuma, CHANNEL_TYPE_LUMA);
+      topLeftLuma = tu.cs->getColLumaCS()->getCU(topLeft, CHANNEL_TYPE_LUMA);
+      cuAbove = cs.getColLumaCS()->getCURestricted(topLeftLuma->lumaPos().offset(0, -1), *topLeftLuma, CHANNEL_TYPE_LUMA);
+      cuLeft  = cs.getColLumaCS()->getCURestricted(topLeftLuma->lumaPos().offset(-1, 0), *topLeftLuma, CHANNEL_TYPE_LUMA);
     }
     else
     {
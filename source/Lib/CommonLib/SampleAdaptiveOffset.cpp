@@ -111,12 +111,29 @@ const SAOBlkParam& SAOBlkParam::operator= (const SAOBlkParam& src)
 SampleAdaptiveOffset::SampleAdaptiveOffset()
 {
   m_numberOfComponents = 0;
+  m_threadPool         = nullptr;
+
+  m_offsetEOLines     = offsetEOLines;
+  m_offsetBOBlock     = offsetBOBlock;
+  m_calcEOStatsLines  = calcEOStatsLines;
+
+#if ENABLE_SIMD_OPT_SAO
+#ifdef TARGET_SIMD_X86
+  initSampleAdaptiveOffsetX86();
+#endif
+#endif
 }
 
 SampleAdaptiveOffset::~SampleAdaptiveOffset()
 {
   destroy();
 
+  for (auto &threadSAO : m_threadSAO)
+  {
+    delete threadSAO;
+  }
+  m_threadSAO.clear();
+
   m_signLineBuf1.clear();
   m_signLineBuf2.clear();
 }
@@ -292,6 +309,14 @@ void SampleAdaptiveOffset::offsetBlock(const int channelBitDepth, const ClpRng&
                                           , bool isCtuCrossedByVirtualBoundaries, int horVirBndryPos[], int verVirBndryPos[], int numHorVirBndry, int numVerVirBndry
   )
 {
+  if (!isCtuCrossedByVirtualBoundaries)
+  {
+    offsetBlockLines(channelBitDepth, clpRng, typeIdx, offset, srcBlk, resBlk, srcStride, resStride, width, height,
+                     isLeftAvail, isRightAvail, isAboveAvail, isBelowAvail, isAboveLeftAvail, isAboveRightAvail,
+                     isBelowLeftAvail, isBelowRightAvail);
+    return;
+  }
+
   int x,y, startX, startY, endX, endY, edgeType;
   int firstLineStartX, firstLineEndX, lastLineStartX, lastLineEndX;
   int8_t signLeft, signRight, signDown;
@@ -541,6 +566,126 @@ void SampleAdaptiveOffset::offsetBlock(const int channelBitDepth, const ClpRng&
   }
 }
 
+/** applies the offsets to a block which is not crossed by virtual boundaries
+ * The edge class of each sample is derived directly from the unmodified source samples, hence the sample ranges of the
+ * first and last lines of the diagonal classes can be processed independently by the line kernels.
+ */
+void SampleAdaptiveOffset::offsetBlockLines(const int channelBitDepth, const ClpRng& clpRng, int typeIdx, int* offset
+                                          , const Pel* srcBlk, Pel* resBlk, int srcStride, int resStride,  int width, int height
+                                          , bool isLeftAvail,  bool isRightAvail, bool isAboveAvail, bool isBelowAvail, bool isAboveLeftAvail, bool isAboveRightAvail, bool isBelowLeftAvail, bool isBelowRightAvail
+  )
+{
+  const int startX = isLeftAvail ? 0 : 1;
+  const int endX   = isRightAvail ? width : (width - 1);
+
+  const Pel* srcLastLine = srcBlk + (height - 1) * srcStride;
+        Pel* resLastLine = resBlk + (height - 1) * resStride;
+
+  switch(typeIdx)
+  {
+  case SAO_TYPE_EO_0:
+    {
+      m_offsetEOLines(srcBlk, resBlk, srcStride, resStride, startX, endX, height, -1, 1, offset, clpRng);
+    }
+    break;
+  case SAO_TYPE_EO_90:
+    {
+      const int startY = isAboveAvail ? 0 : 1;
+      const int endY   = isBelowAvail ? height : (height - 1);
+      m_offsetEOLines(srcBlk + startY * srcStride, resBlk + startY * resStride, srcStride, resStride, 0, width,
+                      endY - startY, -srcStride, srcStride, offset, clpRng);
+    }
+    break;
+  case SAO_TYPE_EO_135:
+    {
+      const int neighbourA = -srcStride - 1;
+      const int neighbourB =  srcStride + 1;
+      //1st line
+      m_offsetEOLines(srcBlk, resBlk, srcStride, resStride, isAboveLeftAvail ? 0 : 1, isAboveAvail ? endX : 1, 1,
+                      neighbourA, neighbourB, offset, clpRng);
+      //middle lines
+      m_offsetEOLines(srcBlk + srcStride, resBlk + resStride, srcStride, resStride, startX, endX, height - 2,
+                      neighbourA, neighbourB, offset, clpRng);
+      //last line
+      m_offsetEOLines(srcLastLine, resLastLine, srcStride, resStride, isBelowAvail ? startX : (width - 1),
+                      isBelowRightAvail ? width : (width - 1), 1, neighbourA, neighbourB, offset, clpRng);
+    }
+    break;
+  case SAO_TYPE_EO_45:
+    {
+      const int neighbourA = -srcStride + 1;
+      const int neighbourB =  srcStride - 1;
+      //1st line
+      m_offsetEOLines(srcBlk, resBlk, srcStride, resStride, isAboveAvail ? startX : (width - 1),
+                      isAboveRightAvail ? width : (width - 1), 1, neighbourA, neighbourB, offset, clpRng);
+      //middle lines
+      m_offsetEOLines(srcBlk + srcStride, resBlk + resStride, srcStride, resStride, startX, endX, height - 2,
+                      neighbourA, neighbourB, offset, clpRng);
+      //last line
+      m_offsetEOLines(srcLastLine, resLastLine, srcStride, resStride, isBelowLeftAvail ? 0 : 1, isBelowAvail ? endX : 1,
+                      1, neighbourA, neighbourB, offset, clpRng);
+    }
+    break;
+  case SAO_TYPE_BO:
+    {
+      m_offsetBOBlock(srcBlk, resBlk, srcStride, resStride, width, height, channelBitDepth - NUM_SAO_BO_CLASSES_LOG2,
+                      offset, clpRng);
+    }
+    break;
+  default:
+    {
+      THROW("Not a supported SAO types\n");
+    }
+  }
+}
+
+void SampleAdaptiveOffset::offsetEOLines(const Pel* srcLine, Pel* resLine, int srcStride, int resStride, int startX,
+                                         int endX, int numLines, int neighbourA, int neighbourB, const int* offset,
+                                         const ClpRng& clpRng)
+{
+  for (int y = 0; y < numLines; y++)
+  {
+    for (int x = startX; x < endX; x++)
+    {
+      const int edgeType = sgn(srcLine[x] - srcLine[x + neighbourA]) + sgn(srcLine[x] - srcLine[x + neighbourB]) + 2;
+      resLine[x] = ClipPel<int>(srcLine[x] + offset[edgeType], clpRng);
+    }
+    srcLine += srcStride;
+    resLine += resStride;
+  }
+}
+
+void SampleAdaptiveOffset::offsetBOBlock(const Pel* srcBlk, Pel* resBlk, int srcStride, int resStride, int width,
+                                         int height, int shiftBits, const int* offset, const ClpRng& clpRng)
+{
+  for (int y = 0; y < height; y++)
+  {
+    for (int x = 0; x < width; x++)
+    {
+      resBlk[x] = ClipPel<int>(srcBlk[x] + offset[srcBlk[x] >> shiftBits], clpRng);
+    }
+    srcBlk += srcStride;
+    resBlk += resStride;
+  }
+}
+
+void SampleAdaptiveOffset::calcEOStatsLines(const Pel* srcLine, const Pel* orgLine, int srcStride, int orgStride,
+                                            int startX, int endX, int numLines, int neighbourA, int neighbourB,
+                                            int64_t* diff, int64_t* count)
+{
+  for (int y = 0; y < numLines; y++)
+  {
+    for (int x = startX; x < endX; x++)
+    {
+      const int edgeType = sgn(srcLine[x] - srcLine[x + neighbourA]) + sgn(srcLine[x] - srcLine[x + neighbourB]) + 2;
+      diff [edgeType] += (orgLine[x] - srcLine[x]);
+      count[edgeType] ++;
+    }
+    srcLine += srcStride;
+    orgLine += orgStride;
+  }
+}
+
 void SampleAdaptiveOffset::offsetCTU( const UnitArea& area, const CPelUnitBuf& src, PelUnitBuf& res, SAOBlkParam& saoblkParam, CodingStructure& cs)
 {
   const uint32_t numberOfComponents = getNumberValidComponents( area.chromaFormat );
@@ -633,19 +778,61 @@ void SampleAdaptiveOffset::SAOProcess( CodingStructure& cs, SAOBlkParam* saoBlkP
 
   const PreCalcValues& pcv = *cs.pcv;
   PelUnitBuf rec = cs.getRecoBuf();
-  m_tempBuf.copyFrom( rec );
 
-  int ctuRsAddr = 0;
-  for( uint32_t yPos = 0; yPos < pcv.lumaHeight; yPos += pcv.maxCUHeight )
+  if( m_threadPool && m_threadPool->getNumThreads() > 0 )
+  {
+    while( m_threadSAO.size() < m_threadPool->getNumThreadSlots() )
+    {
+      m_threadSAO.push_back( new SampleAdaptiveOffset );
+    }
+
+    // all CTU rows are copied before any CTU is filtered, since a CTU reads the unfiltered samples of the CTU rows
+    // above and below
+    for( uint32_t yPos = 0; yPos < pcv.lumaHeight; yPos += pcv.maxCUHeight )
+    {
+      m_threadPool->addJob( [this, &cs, &pcv, &rec, yPos]( int )
+      {
+        const uint32_t height = std::min( pcv.maxCUHeight, pcv.lumaHeight - yPos );
+        const UnitArea rowArea( cs.area.chromaFormat, Area( 0, yPos, pcv.lumaWidth, height ) );
+        m_tempBuf.getBuf( rowArea ).copyFrom( rec.subBuf( rowArea ) );
+      } );
+    }
+    m_threadPool->waitForJobs();
+
+    for( uint32_t yPos = 0; yPos < pcv.lumaHeight; yPos += pcv.maxCUHeight )
+    {
+      m_threadPool->addJob( [this, &cs, &pcv, &rec, yPos]( int threadIdx )
+      {
+        int ctuRsAddr = ( yPos / pcv.maxCUHeight ) * pcv.widthInCtus;
+        for( uint32_t xPos = 0; xPos < pcv.lumaWidth; xPos += pcv.maxCUWidth )
+        {
+          const uint32_t width  = std::min( pcv.maxCUWidth,  pcv.lumaWidth  - xPos );
+          const uint32_t height = std::min( pcv.maxCUHeight, pcv.lumaHeight - yPos );
+          const UnitArea area( cs.area.chromaFormat, Area( xPos, yPos, width, height ) );
+
+          m_threadSAO[threadIdx]->offsetCTU( area, m_tempBuf, rec, cs.picture->getSAO()[ctuRsAddr], cs );
+          ctuRsAddr++;
+        }
+      } );
+    }
+    m_threadPool->waitForJobs();
+  }
+  else
   {
-    for( uint32_t xPos = 0; xPos < pcv.lumaWidth; xPos += pcv.maxCUWidth )
+    m_tempBuf.copyFrom( rec );
+
+    int ctuRsAddr = 0;
+    for( uint32_t yPos = 0; yPos < pcv.lumaHeight; yPos += pcv.maxCUHeight )
     {
-      const uint32_t width  = (xPos + pcv.maxCUWidth  > pcv.lumaWidth)  ? (pcv.lumaWidth - xPos)  : pcv.maxCUWidth;
-      const uint32_t height = (yPos + pcv.maxCUHeight > pcv.lumaHeight) ? (pcv.lumaHeight - yPos) : pcv.maxCUHeight;
-      const UnitArea area( cs.area.chromaFormat, Area(xPos , yPos, width, height) );
+      for( uint32_t xPos = 0; xPos < pcv.lumaWidth; xPos += pcv.maxCUWidth )
+      {
+        const uint32_t width  = (xPos + pcv.maxCUWidth  > pcv.lumaWidth)  ? (pcv.lumaWidth - xPos)  : pcv.maxCUWidth;
+        const uint32_t height = (yPos + pcv.maxCUHeight > pcv.lumaHeight) ? (pcv.lumaHeight - yPos) : pcv.maxCUHeight;
+        const UnitArea area( cs.area.chromaFormat, Area(xPos , yPos, width, height) );
 
-      offsetCTU( area, m_tempBuf, rec, cs.picture->getSAO()[ctuRsAddr], cs);
-      ctuRsAddr++;
+        offsetCTU( area, m_tempBuf, rec, cs.picture->getSAO()[ctuRsAddr], cs);
+        ctuRsAddr++;
+      }
     }
   }
 
@@ -41,6 +41,7 @@
 #include "CommonDef.h"
 #include "Unit.h"
 #include "Reshape.h"
+#include "ThreadPool.h"
 //! \ingroup CommonLib
 //! \{
 
@@ -71,7 +72,34 @@ public:
   void destroy();
   static int getMaxOffsetQVal(const int channelBitDepth) { return (1<<(std::min<int>(channelBitDepth,MAX_SAO_TRUNCATED_BITDEPTH)-5))-1; } //Table 9-32, inclusive
   void setReshaper(Reshape * p) { m_pcReshape = p; }
+  /// SAOProcess filters CTU rows in parallel if the thread pool has worker threads
+  void setThreadPool(ThreadPool* threadPool) { m_threadPool = threadPool; }
+
+  // EO: applies offset[edgeClass] to the samples [startX, endX) of numLines lines, the edge class (0..4) of a sample is
+  // derived from the source samples at the relative positions neighbourA and neighbourB
+  void (*m_offsetEOLines)(const Pel* srcLine, Pel* resLine, int srcStride, int resStride, int startX, int endX, int numLines,
+                          int neighbourA, int neighbourB, const int* offset, const ClpRng& clpRng);
+  // BO: applies offset[sample >> shiftBits] to all samples of the block
+  void (*m_offsetBOBlock)(const Pel* srcBlk, Pel* resBlk, int srcStride, int resStride, int width, int height,
+                          int shiftBits, const int* offset, const ClpRng& clpRng);
+  // EO statistics: accumulates the differences orgLine - srcLine and the number of samples per edge class
+  void (*m_calcEOStatsLines)(const Pel* srcLine, const Pel* orgLine, int srcStride, int orgStride, int startX, int endX,
+                             int numLines, int neighbourA, int neighbourB, int64_t* diff, int64_t* count);
+
+#ifdef TARGET_SIMD_X86
+  void initSampleAdaptiveOffsetX86();
+  template <X86_VEXT vext>
+  void _initSampleAdaptiveOffsetX86();
+#endif
+
 protected:
+  static void offsetEOLines(const Pel* srcLine, Pel* resLine, int srcStride, int resStride, int startX, int endX,
+                            int numLines, int neighbourA, int neighbourB, const int* offset, const ClpRng& clpRng);
+  static void offsetBOBlock(const Pel* srcBlk, Pel* resBlk, int srcStride, int resStride, int width, int height,
+                            int shiftBits, const int* offset, const ClpRng& clpRng);
+  static void calcEOStatsLines(const Pel* srcLine, const Pel* orgLine, int srcStride, int orgStride, int startX,
+                               int endX, int numLines, int neighbourA, int neighbourB, int64_t* diff, int64_t* count);
+
   void deriveLoopFilterBoundaryAvailibility(CodingStructure& cs, const Position &pos,
     bool& isLeftAvail,
     bool& isRightAvail,
@@ -87,6 +115,9 @@ protected:
                   , bool isLeftAvail, bool isRightAvail, bool isAboveAvail, bool isBelowAvail, bool isAboveLeftAvail, bool isAboveRightAvail, bool isBelowLeftAvail, bool isBelowRightAvail
                   , bool isCtuCrossedByVirtualBoundaries, int horVirBndryPos[], int verVirBndryPos[], int numHorVirBndry, int numVerVirBndry
     );
+  void offsetBlockLines(const int channelBitDepth, const ClpRng& clpRng, int typeIdx, int* offset, const Pel* srcBlk, Pel* resBlk, int srcStride, int resStride, int width, int height
+                       , bool isLeftAvail, bool isRightAvail, bool isAboveAvail, bool isBelowAvail, bool isAboveLeftAvail, bool isAboveRightAvail, bool isBelowLeftAvail, bool isBelowRightAvail
+    );
   void invertQuantOffsets(ComponentID compIdx, int typeIdc, int typeAuxInfo, int* dstOffsets, int* srcOffsets);
   void reconstructBlkSAOParam(SAOBlkParam& recParam, SAOBlkParam* mergeList[NUM_SAO_MERGE_TYPES]);
   int  getMergeList(CodingStructure& cs, int ctuRsAddr, SAOBlkParam* blkParams, SAOBlkParam* mergeList[NUM_SAO_MERGE_TYPES]);
@@ -122,6 +153,9 @@ protected:
 
   std::vector<int8_t> m_signLineBuf1;
   std::vector<int8_t> m_signLineBuf2;
+
+  ThreadPool* m_threadPool;
+  std::vector<SampleAdaptiveOffset*> m_threadSAO;   // per thread instances holding the sign line buffers
 private:
   bool m_picSAOEnabled[MAX_NUM_COMPONENT];
 };
@@ -0,0 +1,164 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2022, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     ThreadPool.cpp
+    \brief    simple thread pool and progress synchronisation helpers
+*/
+
+#include "ThreadPool.h"
+
+//! \ingroup CommonLib
+//! \{
+
+ThreadPool::ThreadPool()
+  : m_numPendingJobs( 0 )
+  , m_exit          ( false )
+{
+}
+
+ThreadPool::~ThreadPool()
+{
+  destroy();
+}
+
+void ThreadPool::create( const int numThreads )
+{
+  destroy();
+
+  m_exit = false;
+  for( int i = 0; i < numThreads; i++ )
+  {
+    m_threads.push_back( std::thread( &ThreadPool::threadProc, this, i ) );
+  }
+}
+
+void ThreadPool::destroy()
+{
+  if( m_threads.empty() )
+  {
+    return;
+  }
+
+  waitForJobs();
+  {
+    std::unique_lock<std::mutex> lock( m_mutex );
+    m_exit = true;
+  }
+  m_jobAvailable.notify_all();
+
+  for( auto &thread : m_threads )
+  {
+    thread.join();
+  }
+  m_threads.clear();
+}
+
+void ThreadPool::addJob( Job job )
+{
+  if( m_threads.empty() )
+  {
+    job( 0 );
+    return;
+  }
+
+  {
+    std::unique_lock<std::mutex> lock( m_mutex );
+    m_jobs.push_back( std::move( job ) );
+    m_numPendingJobs++;
+  }
+  m_jobAvailable.notify_one();
+}
+
+void ThreadPool::waitForJobs()
+{
+  std::unique_lock<std::mutex> lock( m_mutex );
+  m_jobsDone.wait( lock, [this] { return m_numPendingJobs == 0; } );
+}
+
+void ThreadPool::threadProc( const int threadIdx )
+{
+  while( true )
+  {
+    Job job;
+    {
+      std::unique_lock<std::mutex> lock( m_mutex );
+      m_jobAvailable.wait( lock, [this] { return m_exit || !m_jobs.empty(); } );
+      if( m_jobs.empty() )
+      {
+        return;
+      }
+      job = std::move( m_jobs.front() );
+      m_jobs.pop_front();
+    }
+
+    job( threadIdx );
+
+    {
+      std::unique_lock<std::mutex> lock( m_mutex );
+      m_numPendingJobs--;
+      if( m_numPendingJobs == 0 )
+      {
+        m_jobsDone.notify_all();
+      }
+    }
+  }
+}
+
+void ProgressCounter::reset( const int value )
+{
+  std::unique_lock<std::mutex> lock( m_mutex );
+  m_value = value;
+}
+
+void ProgressCounter::set( const int value )
+{
+  {
+    std::unique_lock<std::mutex> lock( m_mutex );
+    m_value = value;
+  }
+  m_cond.notify_all();
+}
+
+int ProgressCounter::get()
+{
+  std::unique_lock<std::mutex> lock( m_mutex );
+  return m_value;
+}
+
+void ProgressCounter::waitFor( const int value )
+{
+  std::unique_lock<std::mutex> lock( m_mutex );
+  m_cond.wait( lock, [&] { return m_value >= value; } );
+}
+
+//! \}
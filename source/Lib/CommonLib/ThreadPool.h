@@ -0,0 +1,112 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2022, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     ThreadPool.h
+    \brief    simple thread pool and progress synchronisation helpers (header)
+*/
+
+#ifndef __THREADPOOL__
+#define __THREADPOOL__
+
+#include "CommonDef.h"
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//! \ingroup CommonLib
+//! \{
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/// fixed size pool of worker threads processing a FIFO job queue
+class ThreadPool
+{
+public:
+  typedef std::function<void( int threadIdx )> Job;
+
+  ThreadPool();
+  ~ThreadPool();
+
+  void create ( const int numThreads );
+  void destroy();
+
+  /// number of worker threads, 0 if all jobs are executed by the calling thread
+  int  getNumThreads() const { return (int) m_threads.size(); }
+
+  /// number of distinct thread indices passed to jobs, i.e. the number of per-thread resources needed by a caller
+  int  getNumThreadSlots() const { return std::max( 1, getNumThreads() ); }
+
+  /// queues a job, without worker threads the job is executed immediately with thread index 0
+  void addJob       ( Job job );
+  /// blocks until all queued jobs have been finished
+  void waitForJobs  ();
+
+private:
+  void threadProc   ( const int threadIdx );
+
+  std::vector<std::thread> m_threads;
+  std::deque<Job>          m_jobs;
+  std::mutex               m_mutex;
+  std::condition_variable  m_jobAvailable;
+  std::condition_variable  m_jobsDone;
+  int                      m_numPendingJobs;
+  bool                     m_exit;
+};
+
+/// monotonically increasing progress value (e.g. the number of finished CTUs of a CTU row) other threads can wait for
+class ProgressCounter
+{
+public:
+  ProgressCounter() : m_value( 0 ) {}
+
+  void reset  ( const int value = 0 );
+  void set    ( const int value );
+  int  get    ();
+  void waitFor( const int value );
+
+private:
+  std::mutex              m_mutex;
+  std::condition_variable m_cond;
+  int                     m_value;
+};
+
+//! \}
+
+#endif // __THREADPOOL__
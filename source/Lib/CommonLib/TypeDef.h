@@ -194,6 +194,11 @@ typedef std::pair<int, int>  TrCost;
 #define ENABLE_SIMD_OPT_DIST                            ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization for the distortion calculations(SAD,SSE,HADAMARD), no impact on RD performance
 #define ENABLE_SIMD_OPT_AFFINE_ME                       ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization for affine ME, no impact on RD performance
 #define ENABLE_SIMD_OPT_ALF                             ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization for ALF
+#define ENABLE_SIMD_OPT_MIP                             ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization for matrix-based intra prediction, no impact on RD performance
+#define ENABLE_SIMD_OPT_DEBLOCK                         ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization for the deblocking filter, no impact on RD performance
+#define ENABLE_SIMD_OPT_SAO                             ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization for SAO, no impact on RD performance
+#define ENABLE_SIMD_OPT_HASH                            ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization for the block hashes of the hash-based motion estimation, no impact on RD performance
+#define ENABLE_SIMD_OPT_IBC                             ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization for the block hashes of the IBC hash search, no impact on RD performance
 #if ENABLE_SIMD_OPT_BUFFER
 #define ENABLE_SIMD_OPT_BCW                               1                                                 ///< SIMD optimization for Bcw
 #endif
@@ -561,7 +566,8 @@ enum MESearchMethod
   MESEARCH_DIAMOND           = 1,
   MESEARCH_SELECTIVE         = 2,
   MESEARCH_DIAMOND_ENHANCED  = 3,
-  MESEARCH_NUMBER_OF_METHODS = 4
+  MESEARCH_PYRAMID           = 4,
+  MESEARCH_NUMBER_OF_METHODS = 5
 };
 
 /// coefficient scanning type used in ACS
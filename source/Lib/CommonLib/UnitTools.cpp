@@ -785,7 +785,7 @@ const PredictionUnit &PU::getCoLocatedLumaPU(const PredictionUnit &pu)
   Position refPos =
     topLeftPos.offset(pu.blocks[pu.chType].lumaSize().width >> 1, pu.blocks[pu.chType].lumaSize().height >> 1);
 
-  const PredictionUnit &lumaPU = pu.cu->isSepTree() ? *pu.cs->picture->cs->getPU(refPos, CHANNEL_TYPE_LUMA)
+  const PredictionUnit &lumaPU = pu.cu->isSepTree() ? *pu.cs->getColLumaCS()->getPU(refPos, CHANNEL_TYPE_LUMA)
                                                     : *pu.cs->getPU(topLeftPos, CHANNEL_TYPE_LUMA);
 
   return lumaPU;
@@ -1676,9 +1676,57 @@ static void simdFilter7x7Blk(AlfClassifier **classifier, const PelUnitBuf &recDs
   }
 }
 #endif
+// each row starts at a multiple of numBins, the vector loops may run up to m_COV_ACC_STRIDE into the zero padding
+static_assert(AdaptiveLoopFilter::ALF_NUM_CLIP_VALS[CHANNEL_TYPE_LUMA] % 4 == 0
+                && AdaptiveLoopFilter::ALF_NUM_CLIP_VALS[CHANNEL_TYPE_CHROMA] % 4 == 0,
+              "the number of clipping values must be a multiple of 4");
+static_assert(AdaptiveLoopFilter::m_COV_ACC_STRIDE % 8 == 0
+                && AdaptiveLoopFilter::m_COV_ACC_STRIDE
+                     >= MAX_NUM_ALF_LUMA_COEFF * AdaptiveLoopFilter::MAX_ALF_NUM_CLIP_VALS,
+              "bad covariance accumulator stride");
+
+template<X86_VEXT vext>
+static void simdAccumulateCovariance(int *acc, const int16_t *ePair, const int numCoeff, const int numBins)
+{
+  const int size = numCoeff * numBins;
+
+  for (int f0 = 0; f0 < size; f0++)
+  {
+    // (e0, e1) of the row against the interleaved (e0, e1) of the columns gives e0 * e0' + e1 * e1' per 32-bit lane
+    const int32_t rowPair = (uint16_t) ePair[2 * f0] | ((uint32_t) (uint16_t) ePair[2 * f0 + 1] << 16);
+    int          *accRow  = acc + f0 * AdaptiveLoopFilter::m_COV_ACC_STRIDE;
+    int           f1      = f0 - f0 % numBins;
+
+#ifdef USE_AVX2
+    if (vext >= AVX2)
+    {
+      const __m256i row = _mm256_set1_epi32(rowPair);
+      for (; f1 < size; f1 += 8)
+      {
+        const __m256i col = _mm256_loadu_si256((const __m256i *) (ePair + 2 * f1));
+        const __m256i sum = _mm256_loadu_si256((const __m256i *) (accRow + f1));
+        _mm256_storeu_si256((__m256i *) (accRow + f1), _mm256_add_epi32(sum, _mm256_madd_epi16(row, col)));
+      }
+    }
+    else
+#endif
+    {
+      const __m128i row = _mm_set1_epi32(rowPair);
+      for (; f1 < size; f1 += 4)
+      {
+        const __m128i col = _mm_loadu_si128((const __m128i *) (ePair + 2 * f1));
+        const __m128i sum = _mm_loadu_si128((const __m128i *) (accRow + f1));
+        _mm_storeu_si128((__m128i *) (accRow + f1), _mm_add_epi32(sum, _mm_madd_epi16(row, col)));
+      }
+    }
+  }
+}
+
 template <X86_VEXT vext>
 void AdaptiveLoopFilter::_initAdaptiveLoopFilterX86()
 {
+  m_accumulateCovariance = simdAccumulateCovariance<vext>;
+
 #if RExt__HIGH_BIT_DEPTH_SUPPORT
   m_deriveClassificationBlk = simdDeriveClassificationBlk_HBD;
 #ifdef USE_AVX2
@@ -195,115 +195,203 @@ static void simdVerticalSobelFilter( Pel *const pPred, const int predStride, int
   memcpy( pDerivate + (height - 1) * derivateBufStride, pDerivate + (height - 2) * derivateBufStride, width * sizeof( pDerivate[0] ) );
 }
 
-template<X86_VEXT vext>
-static void simdEqualCoeffComputer( Pel *pResidue, int residueStride, int **ppDerivate, int derivateBufStride, int64_t( *pEqualCoeff )[7], int width, int height, bool b6Param )
+// Sums of d0*d0, d0*d1, d1*d1, d0*r and d1*r over one 4x4 block, each as two int32 partial sums per 64-bit lane half.
+// The gradients fit into 16 bits for internal bit depths up to 12, which is the limit without high bit depth support.
+static inline void simdEqualCoeffBlockSums( const Pel *pResidue, const int *pDerivate0, const int *pDerivate1, const int stride, __m128i *sums )
 {
-  __m128i mmFour;
-  __m128i mmTmp[4];
-  __m128i mmIntermediate[4];
-  __m128i mmIndxK, mmIndxJ;
-  __m128i mmResidue[2];
-  __m128i mmC[12];
+  for ( int i = 0; i < 5; i++ )
+  {
+    sums[i] = _mm_setzero_si128();
+  }
 
-  // Add directly to indexes to get new index
-  mmFour = _mm_set1_epi32(4);
-  mmIndxJ = _mm_set1_epi32(-2);
+  for ( int j = 0; j < 4; j += 2 )
+  {
+    const int idx0 = j * stride;
+    const int idx1 = idx0 + stride;
+
+    __m128i d0  = _mm_packs_epi32( _mm_loadu_si128( (const __m128i*)&pDerivate0[idx0] ), _mm_loadu_si128( (const __m128i*)&pDerivate0[idx1] ) );
+    __m128i d1  = _mm_packs_epi32( _mm_loadu_si128( (const __m128i*)&pDerivate1[idx0] ), _mm_loadu_si128( (const __m128i*)&pDerivate1[idx1] ) );
+    __m128i res = _mm_unpacklo_epi64( _mm_loadl_epi64( (const __m128i*)&pResidue[idx0] ), _mm_loadl_epi64( (const __m128i*)&pResidue[idx1] ) );
+
+    sums[0] = _mm_add_epi32( sums[0], _mm_madd_epi16( d0, d0 ) );
+    sums[1] = _mm_add_epi32( sums[1], _mm_madd_epi16( d0, d1 ) );
+    sums[2] = _mm_add_epi32( sums[2], _mm_madd_epi16( d1, d1 ) );
+    sums[3] = _mm_add_epi32( sums[3], _mm_madd_epi16( d0, res ) );
+    sums[4] = _mm_add_epi32( sums[4], _mm_madd_epi16( d1, res ) );
+  }
+}
 
+// Widens the four int32 partial sums of each 128-bit lane to 64 bits and adds them up
+static inline int64_t simdEqualCoeffHorSum( const __m128i sum )
+{
+  const __m128i sign = _mm_srai_epi32( sum, 31 );
+  __m128i       acc  = _mm_add_epi64( _mm_unpacklo_epi32( sum, sign ), _mm_unpackhi_epi32( sum, sign ) );
+  acc = _mm_add_epi64( acc, _mm_unpackhi_epi64( acc, acc ) );
 
-  int n = b6Param ? 6 : 4;
-  int idx1 = 0, idx2 = 0;
-  idx1 = -2 * derivateBufStride - 4;
-  idx2 = -derivateBufStride - 4;
+  int64_t res;
+  _mm_storel_epi64( (__m128i*)&res, acc );
+  return res;
+}
 
-  for ( int j = 0; j < height; j += 2 )
+template<X86_VEXT vext>
+static void simdEqualCoeffComputer( Pel *pResidue, int residueStride, int **ppDerivate, int derivateBufStride, int64_t( *pEqualCoeff )[7], int width, int height, bool b6Param )
+{
+  // The coefficients iC[] are linear in the two gradients with factors (1, cx, cy) that are constant within each 4x4
+  // block. The equation therefore only needs the block sums of d0*d0, d0*d1, d1*d1, d0*r and d1*r, weighted with the
+  // monomials of (cx, cy) and accumulated in 64 bit, which yields exactly the sums of the per-sample computation.
+  int64_t sumDD[3][6] = { { 0 } };   // [d0d0, d0d1, d1d1][1, cx, cy, cx*cx, cx*cy, cy*cy]
+  int64_t sumDR[2][3] = { { 0 } };   // [d0r, d1r][1, cx, cy]
+
+  for ( int j = 0; j < height; j += 4 )
   {
-    if (!(j & 3))
-      mmIndxJ = _mm_add_epi32(mmIndxJ, mmFour);
-    mmIndxK = _mm_set1_epi32(-2);
-    idx1 += (derivateBufStride << 1);
-    idx2 += (derivateBufStride << 1);
+    const int64_t cy = j + 2;
+    int64_t rowDD[3][3] = { { 0 } }; // [d0d0, d0d1, d1d1][1, cx, cx*cx]
+    int64_t rowDR[2][2] = { { 0 } }; // [d0r, d1r][1, cx]
 
-    for ( int k = 0; k < width; k += 4 )
-    {
-      idx1 += 4;
-      idx2 += 4;
-      mmIndxK = _mm_add_epi32( mmIndxK, mmFour );
+    const int *pDerivate0 = ppDerivate[0] + j * derivateBufStride;
+    const int *pDerivate1 = ppDerivate[1] + j * derivateBufStride;
+    const Pel *pRes       = pResidue + j * derivateBufStride;
 
-      if ( b6Param )
+    int k = 0;
+#if USE_AVX2
+    if ( vext >= AVX2 )
+    {
+      // two horizontally adjacent blocks, one per 128-bit lane
+      for ( ; k + 8 <= width; k += 8 )
       {
-        // mmC[0-5] for iC[0-5] of 1st row of pixels
-        mmC[0] = _mm_loadu_si128( (const __m128i*)&ppDerivate[0][idx1] );
-        mmC[2] = _mm_loadu_si128( (const __m128i*)&ppDerivate[1][idx1] );
-        mmC[1] = _mm_mullo_epi32( mmIndxK, mmC[0] );
-        mmC[3] = _mm_mullo_epi32( mmIndxK, mmC[2] );
-        mmC[4] = _mm_mullo_epi32(mmIndxJ, mmC[0]);
-        mmC[5] = _mm_mullo_epi32(mmIndxJ, mmC[2]);
-
-        // mmC[6-11] for iC[0-5] of 2nd row of pixels
-        mmC[6] = _mm_loadu_si128( (const __m128i*)&ppDerivate[0][idx2] );
-        mmC[8] = _mm_loadu_si128( (const __m128i*)&ppDerivate[1][idx2] );
-        mmC[7] = _mm_mullo_epi32( mmIndxK, mmC[6] );
-        mmC[9] = _mm_mullo_epi32( mmIndxK, mmC[8] );
-        mmC[10] = _mm_mullo_epi32(mmIndxJ, mmC[6]);
-        mmC[11] = _mm_mullo_epi32(mmIndxJ, mmC[8]);
+        __m256i sums[5];
+        for ( int i = 0; i < 5; i++ )
+        {
+          sums[i] = _mm256_setzero_si256();
+        }
+
+        for ( int i = 0; i < 4; i += 2 )
+        {
+          const int idx0 = i * derivateBufStride + k;
+          const int idx1 = idx0 + derivateBufStride;
+
+          __m256i d0   = _mm256_packs_epi32( _mm256_loadu_si256( (const __m256i*)&pDerivate0[idx0] ), _mm256_loadu_si256( (const __m256i*)&pDerivate0[idx1] ) );
+          __m256i d1   = _mm256_packs_epi32( _mm256_loadu_si256( (const __m256i*)&pDerivate1[idx0] ), _mm256_loadu_si256( (const __m256i*)&pDerivate1[idx1] ) );
+          __m128i res0 = _mm_loadu_si128( (const __m128i*)&pRes[idx0] );
+          __m128i res1 = _mm_loadu_si128( (const __m128i*)&pRes[idx1] );
+          __m256i res  = _mm256_inserti128_si256( _mm256_castsi128_si256( _mm_unpacklo_epi64( res0, res1 ) ), _mm_unpackhi_epi64( res0, res1 ), 1 );
+
+          sums[0] = _mm256_add_epi32( sums[0], _mm256_madd_epi16( d0, d0 ) );
+          sums[1] = _mm256_add_epi32( sums[1], _mm256_madd_epi16( d0, d1 ) );
+          sums[2] = _mm256_add_epi32( sums[2], _mm256_madd_epi16( d1, d1 ) );
+          sums[3] = _mm256_add_epi32( sums[3], _mm256_madd_epi16( d0, res ) );
+          sums[4] = _mm256_add_epi32( sums[4], _mm256_madd_epi16( d1, res ) );
+        }
+
+        const int64_t cx0 = k + 2;
+        const int64_t cx1 = k + 6;
+        for ( int i = 0; i < 5; i++ )
+        {
+          const int64_t s0 = simdEqualCoeffHorSum( _mm256_castsi256_si128( sums[i] ) );
+          const int64_t s1 = simdEqualCoeffHorSum( _mm256_extracti128_si256( sums[i], 1 ) );
+          if ( i < 3 )
+          {
+            rowDD[i][0] += s0 + s1;
+            rowDD[i][1] += cx0 * s0 + cx1 * s1;
+            rowDD[i][2] += cx0 * cx0 * s0 + cx1 * cx1 * s1;
+          }
+          else
+          {
+            rowDR[i - 3][0] += s0 + s1;
+            rowDR[i - 3][1] += cx0 * s0 + cx1 * s1;
+          }
+        }
       }
-      else
+    }
+#endif
+    for ( ; k < width; k += 4 )
+    {
+      __m128i sums[5];
+      simdEqualCoeffBlockSums( pRes + k, pDerivate0 + k, pDerivate1 + k, derivateBufStride, sums );
+
+      const int64_t cx = k + 2;
+      for ( int i = 0; i < 5; i++ )
       {
-        // mmC[0-3] for iC[0-3] of 1st row of pixels
-        mmC[0] = _mm_loadu_si128( (const __m128i*)&ppDerivate[0][idx1] );
-        mmC[2] = _mm_loadu_si128( (const __m128i*)&ppDerivate[1][idx1] );
-        mmC[1] = _mm_mullo_epi32( mmIndxK, mmC[0] );
-        mmC[3] = _mm_mullo_epi32(mmIndxJ, mmC[0]);
-        mmTmp[0] = _mm_mullo_epi32(mmIndxJ, mmC[2]);
-        mmTmp[1] = _mm_mullo_epi32( mmIndxK, mmC[2] );
-        mmC[1] = _mm_add_epi32( mmC[1], mmTmp[0] );
-        mmC[3] = _mm_sub_epi32( mmC[3], mmTmp[1] );
-
-        // mmC[4-7] for iC[0-3] of 1st row of pixels
-        mmC[4] = _mm_loadu_si128( (const __m128i*)&ppDerivate[0][idx2] );
-        mmC[6] = _mm_loadu_si128( (const __m128i*)&ppDerivate[1][idx2] );
-        mmC[5] = _mm_mullo_epi32( mmIndxK, mmC[4] );
-        mmC[7] = _mm_mullo_epi32(mmIndxJ, mmC[4]);
-        mmTmp[2] = _mm_mullo_epi32(mmIndxJ, mmC[6]);
-        mmTmp[3] = _mm_mullo_epi32( mmIndxK, mmC[6] );
-        mmC[5] = _mm_add_epi32( mmC[5], mmTmp[2] );
-        mmC[7] = _mm_sub_epi32( mmC[7], mmTmp[3] );
+        const int64_t s = simdEqualCoeffHorSum( sums[i] );
+        if ( i < 3 )
+        {
+          rowDD[i][0] += s;
+          rowDD[i][1] += cx * s;
+          rowDD[i][2] += cx * cx * s;
+        }
+        else
+        {
+          rowDR[i - 3][0] += s;
+          rowDR[i - 3][1] += cx * s;
+        }
       }
+    }
 
-      // Residue
-      mmResidue[0] = _mm_loadl_epi64( (const __m128i*)&pResidue[idx1] );
-      mmResidue[1] = _mm_loadl_epi64( (const __m128i*)&pResidue[idx2] );
-      mmResidue[0] = _mm_cvtepi16_epi32( mmResidue[0] );
-      mmResidue[1] = _mm_cvtepi16_epi32( mmResidue[1] );
-      mmResidue[0] = _mm_slli_epi32( mmResidue[0], 3 );
-      mmResidue[1] = _mm_slli_epi32( mmResidue[1], 3 );
+    for ( int i = 0; i < 3; i++ )
+    {
+      sumDD[i][0] += rowDD[i][0];
+      sumDD[i][1] += rowDD[i][1];
+      sumDD[i][2] += cy * rowDD[i][0];
+      sumDD[i][3] += rowDD[i][2];
+      sumDD[i][4] += cy * rowDD[i][1];
+      sumDD[i][5] += cy * cy * rowDD[i][0];
+    }
+    for ( int i = 0; i < 2; i++ )
+    {
+      sumDR[i][0] += rowDR[i][0];
+      sumDR[i][1] += rowDR[i][1];
+      sumDR[i][2] += cy * rowDR[i][0];
+    }
+  }
 
-      // Calculation of coefficient matrix
-      for ( int col = 0; col < n; col++ )
-      {
-        mmTmp[0] = _mm_srli_si128( mmC[0 + col], 4 );
-        mmTmp[1] = _mm_srli_si128( mmC[n + col], 4 );
-        CALC_EQUAL_COEFF_8PXLS( mmC[0 + col], mmC[n + col], mmC[0 + col], mmC[n + col], mmTmp[0], mmTmp[1], mmTmp[0], mmTmp[1], mmIntermediate[0], mmIntermediate[1], mmIntermediate[2], mmIntermediate[3], (const __m128i*)&pEqualCoeff[col + 1][col] );
-        _mm_storel_epi64( (__m128i*)&pEqualCoeff[col + 1][col], mmIntermediate[3] );
+  // iC[a] = sum over gradient v and factor u in (1, cx, cy) of coef[a][v][u] * u * dv
+  static const int coef4[4][2][3] = { { { 1, 0, 0 }, { 0, 0, 0 } }, { { 0, 1, 0 }, { 0, 0, 1 } },
+                                      { { 0, 0, 0 }, { 1, 0, 0 } }, { { 0, 0, 1 }, { 0, -1, 0 } } };
+  static const int coef6[6][2][3] = { { { 1, 0, 0 }, { 0, 0, 0 } }, { { 0, 1, 0 }, { 0, 0, 0 } },
+                                      { { 0, 0, 0 }, { 1, 0, 0 } }, { { 0, 0, 0 }, { 0, 1, 0 } },
+                                      { { 0, 0, 1 }, { 0, 0, 0 } }, { { 0, 0, 0 }, { 0, 0, 1 } } };
+  static const int monomial[3][3] = { { 0, 1, 2 }, { 1, 3, 4 }, { 2, 4, 5 } };
+
+  const int n = b6Param ? 6 : 4;
+  const int( *coef )[2][3] = b6Param ? coef6 : coef4;
 
-        for ( int row = col + 1; row < n; row++ )
+  for ( int col = 0; col < n; col++ )
+  {
+    for ( int row = 0; row < n; row++ )
+    {
+      int64_t sum = 0;
+      for ( int v = 0; v < 2; v++ )
+      {
+        for ( int u = 0; u < 3; u++ )
         {
-          mmTmp[2] = _mm_srli_si128( mmC[0 + row], 4 );
-          mmTmp[3] = _mm_srli_si128( mmC[n + row], 4 );
-          CALC_EQUAL_COEFF_8PXLS( mmC[0 + col], mmC[n + col], mmC[0 + row], mmC[n + row], mmTmp[0], mmTmp[1], mmTmp[2], mmTmp[3], mmIntermediate[0], mmIntermediate[1], mmIntermediate[2], mmIntermediate[3], (const __m128i*)&pEqualCoeff[col + 1][row] );
-          _mm_storel_epi64( (__m128i*)&pEqualCoeff[col + 1][row], mmIntermediate[3] );
-          _mm_storel_epi64( (__m128i*)&pEqualCoeff[row + 1][col], mmIntermediate[3] );
+          if ( !coef[col][v][u] )
+          {
+            continue;
+          }
+          for ( int w = 0; w < 2; w++ )
+          {
+            for ( int t = 0; t < 3; t++ )
+            {
+              if ( coef[row][w][t] )
+              {
+                sum += coef[col][v][u] * coef[row][w][t] * sumDD[v + w][monomial[u][t]];
+              }
+            }
+          }
         }
-
-        mmTmp[2] = _mm_srli_si128( mmResidue[0], 4 );
-        mmTmp[3] = _mm_srli_si128( mmResidue[1], 4 );
-        CALC_EQUAL_COEFF_8PXLS( mmC[0 + col], mmC[n + col], mmResidue[0], mmResidue[1], mmTmp[0], mmTmp[1], mmTmp[2], mmTmp[3], mmIntermediate[0], mmIntermediate[1], mmIntermediate[2], mmIntermediate[3], (const __m128i*)&pEqualCoeff[col + 1][n] );
-        _mm_storel_epi64( (__m128i*)&pEqualCoeff[col + 1][n], mmIntermediate[3] );
       }
+      pEqualCoeff[col + 1][row] += sum;
     }
 
-    idx1 -= (width);
-    idx2 -= (width);
+    int64_t sum = 0;
+    for ( int v = 0; v < 2; v++ )
+    {
+      for ( int u = 0; u < 3; u++ )
+      {
+        sum += coef[col][v][u] * sumDR[v][u];
+      }
+    }
+    pEqualCoeff[col + 1][n] += sum << 3;
   }
 }
 #if RExt__HIGH_BIT_DEPTH_SUPPORT
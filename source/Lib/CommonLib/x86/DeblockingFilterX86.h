@@ -0,0 +1,540 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2022, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/**
+ * \file
+ * \brief Implementation of DeblockingFilter class
+ */
+
+#include "CommonDefX86.h"
+#include "../DeblockingFilter.h"
+
+//! \ingroup CommonLib
+//! \{
+
+#ifdef TARGET_SIMD_X86
+
+#if !RExt__HIGH_BIT_DEPTH_SUPPORT
+// The samples of one edge segment are held in one vector per tap, p[i] = src[-(i+1)*offset] and q[i] = src[i*offset],
+// with one 32-bit lane per line, so that all lines of the segment are filtered at once.
+
+// transposes 4 rows of 8 samples into 8 vectors of 4 samples
+static inline void simdDbfTransposeLoad( const __m128i l0, const __m128i l1, const __m128i l2, const __m128i l3, __m128i* col )
+{
+  const __m128i a = _mm_unpacklo_epi16( l0, l1 );
+  const __m128i b = _mm_unpacklo_epi16( l2, l3 );
+  const __m128i c = _mm_unpackhi_epi16( l0, l1 );
+  const __m128i d = _mm_unpackhi_epi16( l2, l3 );
+
+  const __m128i e0 = _mm_unpacklo_epi32( a, b );
+  const __m128i e1 = _mm_unpackhi_epi32( a, b );
+  const __m128i e2 = _mm_unpacklo_epi32( c, d );
+  const __m128i e3 = _mm_unpackhi_epi32( c, d );
+
+  col[0] = _mm_cvtepi16_epi32( e0 );
+  col[1] = _mm_cvtepi16_epi32( _mm_srli_si128( e0, 8 ) );
+  col[2] = _mm_cvtepi16_epi32( e1 );
+  col[3] = _mm_cvtepi16_epi32( _mm_srli_si128( e1, 8 ) );
+  col[4] = _mm_cvtepi16_epi32( e2 );
+  col[5] = _mm_cvtepi16_epi32( _mm_srli_si128( e2, 8 ) );
+  col[6] = _mm_cvtepi16_epi32( e3 );
+  col[7] = _mm_cvtepi16_epi32( _mm_srli_si128( e3, 8 ) );
+}
+
+// transposes 8 vectors of 4 samples back into 4 rows of 8 samples
+static inline void simdDbfTransposeStore( const __m128i* col, __m128i* line )
+{
+  const __m128i a = _mm_packs_epi32( col[0], col[1] );
+  const __m128i b = _mm_packs_epi32( col[2], col[3] );
+  const __m128i c = _mm_packs_epi32( col[4], col[5] );
+  const __m128i d = _mm_packs_epi32( col[6], col[7] );
+
+  const __m128i abLo = _mm_unpacklo_epi16( a, b );
+  const __m128i abHi = _mm_unpackhi_epi16( a, b );
+  const __m128i cdLo = _mm_unpacklo_epi16( c, d );
+  const __m128i cdHi = _mm_unpackhi_epi16( c, d );
+
+  const __m128i g0 = _mm_unpacklo_epi16( abLo, abHi );
+  const __m128i g1 = _mm_unpackhi_epi16( abLo, abHi );
+  const __m128i h0 = _mm_unpacklo_epi16( cdLo, cdHi );
+  const __m128i h1 = _mm_unpackhi_epi16( cdLo, cdHi );
+
+  line[0] = _mm_unpacklo_epi64( g0, h0 );
+  line[1] = _mm_unpackhi_epi64( g0, h0 );
+  line[2] = _mm_unpacklo_epi64( g1, h1 );
+  line[3] = _mm_unpackhi_epi64( g1, h1 );
+}
+
+// loads the taps p[0..numP-1] and q[0..numQ-1] (numP, numQ: 4 or 8) of numLines (2 or 4) lines
+static inline void simdDbfLoadTaps( const Pel* src, const int offset, const int step, const int numLines, const int numP,
+                                    const int numQ, __m128i* p, __m128i* q )
+{
+  if( offset == 1 )
+  {
+    // vertical edge, the taps of one line are consecutive samples
+    // with two lines, the lines are duplicated to fill the vectors
+    __m128i lineP[4], lineQ[4];
+    for( int i = 0; i < 4; i++ )
+    {
+      const Pel* line = src + ( i % numLines ) * step;
+      lineP[i] = numP == 8 ? _mm_loadu_si128( ( const __m128i* ) ( line - 8 ) )
+                           : _mm_unpacklo_epi64( _mm_setzero_si128(), _mm_loadl_epi64( ( const __m128i* ) ( line - 4 ) ) );
+      lineQ[i] = numQ == 8 ? _mm_loadu_si128( ( const __m128i* ) line ) : _mm_loadl_epi64( ( const __m128i* ) line );
+    }
+
+    __m128i col[8];
+    simdDbfTransposeLoad( lineP[0], lineP[1], lineP[2], lineP[3], col );
+    for( int i = 0; i < 8; i++ )
+    {
+      p[i] = col[7 - i];
+    }
+    simdDbfTransposeLoad( lineQ[0], lineQ[1], lineQ[2], lineQ[3], q );
+  }
+  else
+  {
+    // horizontal edge, the lines of one tap are consecutive samples
+    CHECKD( step != 1, "Unexpected line step for a horizontal edge" );
+    for( int i = 0; i < numP; i++ )
+    {
+      const Pel* tap = src - ( i + 1 ) * offset;
+      p[i] = _mm_cvtepi16_epi32( numLines == 4 ? _mm_loadl_epi64( ( const __m128i* ) tap ) : _mm_cvtsi32_si128( *( const int32_t* ) tap ) );
+    }
+    for( int i = 0; i < numQ; i++ )
+    {
+      const Pel* tap = src + i * offset;
+      q[i] = _mm_cvtepi16_epi32( numLines == 4 ? _mm_loadl_epi64( ( const __m128i* ) tap ) : _mm_cvtsi32_si128( *( const int32_t* ) tap ) );
+    }
+  }
+}
+
+// stores the taps p[0..numP-1] and q[0..numQ-1], the P or Q side is skipped if the corresponding flag is set
+static inline void simdDbfStoreTaps( Pel* src, const int offset, const int step, const int numLines, const int numP,
+                                     const int numQ, const __m128i* p, const __m128i* q, const bool skipP, const bool skipQ )
+{
+  if( offset == 1 )
+  {
+    if( !skipP )
+    {
+      __m128i col[8], line[4];
+      for( int i = 0; i < 8; i++ )
+      {
+        col[i] = i < 8 - numP ? _mm_setzero_si128() : p[7 - i];
+      }
+      simdDbfTransposeStore( col, line );
+      for( int i = 0; i < numLines; i++ )
+      {
+        if( numP == 8 )
+        {
+          _mm_storeu_si128( ( __m128i* ) ( src + i * step - 8 ), line[i] );
+        }
+        else
+        {
+          _mm_storel_epi64( ( __m128i* ) ( src + i * step - 4 ), _mm_unpackhi_epi64( line[i], line[i] ) );
+        }
+      }
+    }
+    if( !skipQ )
+    {
+      __m128i col[8], line[4];
+      for( int i = 0; i < 8; i++ )
+      {
+        col[i] = i < numQ ? q[i] : _mm_setzero_si128();
+      }
+      simdDbfTransposeStore( col, line );
+      for( int i = 0; i < numLines; i++ )
+      {
+        if( numQ == 8 )
+        {
+          _mm_storeu_si128( ( __m128i* ) ( src + i * step ), line[i] );
+        }
+        else
+        {
+          _mm_storel_epi64( ( __m128i* ) ( src + i * step ), line[i] );
+        }
+      }
+    }
+  }
+  else
+  {
+    for( int side = 0; side < 2; side++ )
+    {
+      if( side == 0 ? skipP : skipQ )
+      {
+        continue;
+      }
+      const int      numTaps = side == 0 ? numP : numQ;
+      const __m128i* taps    = side == 0 ? p : q;
+      for( int i = 0; i < numTaps; i++ )
+      {
+        Pel*          tap = side == 0 ? src - ( i + 1 ) * offset : src + i * offset;
+        const __m128i val = _mm_packs_epi32( taps[i], taps[i] );
+        if( numLines == 4 )
+        {
+          _mm_storel_epi64( ( __m128i* ) tap, val );
+        }
+        else
+        {
+          *( int32_t* ) tap = _mm_cvtsi128_si32( val );
+        }
+      }
+    }
+  }
+}
+
+static inline __m128i simdDbfClip3( const __m128i minVal, const __m128i maxVal, const __m128i val )
+{
+  return _mm_min_epi32( maxVal, _mm_max_epi32( minVal, val ) );
+}
+
+// clips val to [org - range, org + range]
+static inline __m128i simdDbfClipDelta( const __m128i org, const __m128i range, const __m128i val )
+{
+  return simdDbfClip3( _mm_sub_epi32( org, range ), _mm_add_epi32( org, range ), val );
+}
+
+// (sum + round) >> shift
+static inline __m128i simdDbfRound( const __m128i sum, const int shift )
+{
+  return _mm_srai_epi32( _mm_add_epi32( sum, _mm_set1_epi32( 1 << ( shift - 1 ) ) ), shift );
+}
+
+static inline __m128i simdDbfAdd( const __m128i a, const __m128i b )
+{
+  return _mm_add_epi32( a, b );
+}
+
+static inline __m128i simdDbfMul( const __m128i a, const int b )
+{
+  return _mm_mullo_epi32( a, _mm_set1_epi32( b ) );
+}
+
+// long luma filter, see DeblockingFilter::xFilteringPandQ and DeblockingFilter::xBilinearFilter
+static inline void simdDbfFilteringPandQ( const __m128i* p, const __m128i* q, __m128i* pf, __m128i* qf, const int numberPSide,
+                                          const int numberQSide, const int tc )
+{
+  CHECKD( numberPSide <= 3 && numberQSide <= 3, "Short filtering in long filtering function" );
+
+  static const int dbCoeffs7[7] = { 59, 50, 41, 32, 23, 14, 5 };
+  static const int dbCoeffs3[3] = { 53, 32, 11 };
+  static const int dbCoeffs5[5] = { 58, 45, 32, 19, 6 };
+  static const int tc7[7]       = { 6, 5, 4, 3, 2, 1, 1 };
+  static const int tc3[3]       = { 6, 4, 2 };
+
+  const __m128i refP = simdDbfRound( simdDbfAdd( p[numberPSide - 1], p[numberPSide] ), 1 );
+  const __m128i refQ = simdDbfRound( simdDbfAdd( q[numberQSide - 1], q[numberQSide] ), 1 );
+  __m128i refMiddle;
+
+  if( numberPSide == numberQSide )
+  {
+    if( numberPSide == 5 )
+    {
+      __m128i sum = simdDbfAdd( simdDbfAdd( p[0], q[0] ), simdDbfAdd( simdDbfAdd( p[1], q[1] ), simdDbfAdd( p[2], q[2] ) ) );
+      sum         = simdDbfAdd( _mm_slli_epi32( sum, 1 ), simdDbfAdd( simdDbfAdd( p[3], q[3] ), simdDbfAdd( p[4], q[4] ) ) );
+      refMiddle   = simdDbfRound( sum, 4 );
+    }
+    else
+    {
+      __m128i sum = _mm_slli_epi32( simdDbfAdd( p[0], q[0] ), 1 );
+      for( int i = 1; i < 7; i++ )
+      {
+        sum = simdDbfAdd( sum, simdDbfAdd( p[i], q[i] ) );
+      }
+      refMiddle = simdDbfRound( sum, 4 );
+    }
+  }
+  else
+  {
+    const __m128i* pt       = p;
+    const __m128i* qt       = q;
+    int            newNumQ  = numberQSide;
+    int            newNumP  = numberPSide;
+    if( numberQSide > numberPSide )
+    {
+      std::swap( pt, qt );
+      newNumQ = numberPSide;
+      newNumP = numberQSide;
+    }
+
+    if( newNumP == 7 && newNumQ == 5 )
+    {
+      __m128i sum = _mm_slli_epi32( simdDbfAdd( simdDbfAdd( p[0], q[0] ), simdDbfAdd( p[1], q[1] ) ), 1 );
+      for( int i = 2; i < 6; i++ )
+      {
+        sum = simdDbfAdd( sum, simdDbfAdd( p[i], q[i] ) );
+      }
+      refMiddle = simdDbfRound( sum, 4 );
+    }
+    else if( newNumP == 7 && newNumQ == 3 )
+    {
+      __m128i sum = simdDbfAdd( _mm_slli_epi32( pt[0], 1 ), simdDbfMul( qt[0], 3 ) );
+      sum         = simdDbfAdd( sum, simdDbfMul( qt[1], 3 ) );
+      sum         = simdDbfAdd( sum, _mm_slli_epi32( qt[2], 1 ) );
+      for( int i = 1; i < 7; i++ )
+      {
+        sum = simdDbfAdd( sum, pt[i] );
+      }
+      refMiddle = simdDbfRound( sum, 4 );
+    }
+    else
+    {
+      __m128i sum = simdDbfAdd( p[0], q[0] );
+      for( int i = 1; i < 4; i++ )
+      {
+        sum = simdDbfAdd( sum, simdDbfAdd( p[i], q[i] ) );
+      }
+      refMiddle = simdDbfRound( sum, 3 );
+    }
+  }
+
+  const __m128i vRound = _mm_set1_epi32( 32 );
+  for( int side = 0; side < 2; side++ )
+  {
+    const int      numberSide = side == 0 ? numberPSide : numberQSide;
+    const int*     dbCoeffs   = numberSide == 7 ? dbCoeffs7 : numberSide == 5 ? dbCoeffs5 : dbCoeffs3;
+    const int*     tcSide     = numberSide == 3 ? tc3 : tc7;
+    const __m128i* org        = side == 0 ? p : q;
+    const __m128i  ref        = side == 0 ? refP : refQ;
+    __m128i*       dst        = side == 0 ? pf : qf;
+
+    for( int pos = 0; pos < numberSide; pos++ )
+    {
+      const __m128i range = _mm_set1_epi32( ( tc * tcSide[pos] ) >> 1 );
+      __m128i       val   = simdDbfAdd( simdDbfMul( refMiddle, dbCoeffs[pos] ), simdDbfMul( ref, 64 - dbCoeffs[pos] ) );
+      val                 = _mm_srai_epi32( _mm_add_epi32( val, vRound ), 6 );
+      dst[pos]            = simdDbfClipDelta( org[pos], range, val );
+    }
+  }
+}
+
+template<X86_VEXT vext>
+static void simdFilterLumaSegment( Pel* src, const int offset, const int step, const int tc, const bool sw,
+                                   const bool partPNoFilter, const bool partQNoFilter, const int thrCut,
+                                   const bool bFilterSecondP, const bool bFilterSecondQ, const ClpRng& clpRng,
+                                   const bool sidePisLarge, const bool sideQisLarge, const int maxFilterLengthP,
+                                   const int maxFilterLengthQ )
+{
+  const int numP = sidePisLarge ? 8 : 4;
+  const int numQ = sideQisLarge ? 8 : 4;
+
+  __m128i p[8], q[8];
+  simdDbfLoadTaps( src, offset, step, DEBLOCK_SMALLEST_BLOCK / 2, numP, numQ, p, q );
+
+  __m128i pf[8], qf[8];
+  for( int i = 0; i < 8; i++ )
+  {
+    pf[i] = p[i];
+    qf[i] = q[i];
+  }
+
+  if( sw )
+  {
+    if( sidePisLarge || sideQisLarge )
+    {
+      simdDbfFilteringPandQ( p, q, pf, qf, sidePisLarge ? maxFilterLengthP : 3, sideQisLarge ? maxFilterLengthQ : 3, tc );
+    }
+    else
+    {
+      const __m128i tc1 = _mm_set1_epi32( tc );
+      const __m128i tc2 = _mm_set1_epi32( 2 * tc );
+      const __m128i tc3 = _mm_set1_epi32( 3 * tc );
+
+      const __m128i p0q0 = simdDbfAdd( p[0], q[0] );
+      const __m128i sum  = simdDbfAdd( p0q0, simdDbfAdd( p[1], q[1] ) );
+
+      // p[2] + 2 * p[1] + 2 * p[0] + 2 * q[0] + q[1]
+      __m128i val = simdDbfAdd( simdDbfAdd( sum, simdDbfAdd( p[1], p0q0 ) ), p[2] );
+      pf[0]       = simdDbfClipDelta( p[0], tc3, simdDbfRound( val, 3 ) );
+      val         = simdDbfAdd( simdDbfAdd( sum, simdDbfAdd( q[1], p0q0 ) ), q[2] );
+      qf[0]       = simdDbfClipDelta( q[0], tc3, simdDbfRound( val, 3 ) );
+
+      val   = simdDbfAdd( simdDbfAdd( p[2], p[1] ), p0q0 );
+      pf[1] = simdDbfClipDelta( p[1], tc2, simdDbfRound( val, 2 ) );
+      val   = simdDbfAdd( simdDbfAdd( q[2], q[1] ), p0q0 );
+      qf[1] = simdDbfClipDelta( q[1], tc2, simdDbfRound( val, 2 ) );
+
+      val   = simdDbfAdd( simdDbfAdd( _mm_slli_epi32( p[3], 1 ), simdDbfMul( p[2], 3 ) ), simdDbfAdd( p[1], p0q0 ) );
+      pf[2] = simdDbfClipDelta( p[2], tc1, simdDbfRound( val, 3 ) );
+      val   = simdDbfAdd( simdDbfAdd( _mm_slli_epi32( q[3], 1 ), simdDbfMul( q[2], 3 ) ), simdDbfAdd( q[1], p0q0 ) );
+      qf[2] = simdDbfClipDelta( q[2], tc1, simdDbfRound( val, 3 ) );
+    }
+  }
+  else
+  {
+    // weak filter
+    const __m128i vMin = _mm_set1_epi32( clpRng.min );
+    const __m128i vMax = _mm_set1_epi32( clpRng.max );
+    const __m128i vTc  = _mm_set1_epi32( tc );
+    const __m128i vTc2 = _mm_set1_epi32( tc >> 1 );
+
+    __m128i delta = _mm_sub_epi32( simdDbfMul( _mm_sub_epi32( q[0], p[0] ), 9 ), simdDbfMul( _mm_sub_epi32( q[1], p[1] ), 3 ) );
+    delta         = _mm_srai_epi32( _mm_add_epi32( delta, _mm_set1_epi32( 8 ) ), 4 );
+
+    const __m128i mask = _mm_cmplt_epi32( _mm_abs_epi32( delta ), _mm_set1_epi32( thrCut ) );
+    if( !_mm_testz_si128( mask, mask ) )
+    {
+      delta = simdDbfClip3( _mm_sub_epi32( _mm_setzero_si128(), vTc ), vTc, delta );
+      pf[0] = _mm_blendv_epi8( p[0], simdDbfClip3( vMin, vMax, _mm_add_epi32( p[0], delta ) ), mask );
+      qf[0] = _mm_blendv_epi8( q[0], simdDbfClip3( vMin, vMax, _mm_sub_epi32( q[0], delta ) ), mask );
+
+      const __m128i vNegTc2 = _mm_sub_epi32( _mm_setzero_si128(), vTc2 );
+      if( bFilterSecondP )
+      {
+        __m128i delta1 = _mm_srai_epi32( simdDbfAdd( p[2], _mm_add_epi32( p[0], _mm_set1_epi32( 1 ) ) ), 1 );
+        delta1         = _mm_srai_epi32( _mm_add_epi32( _mm_sub_epi32( delta1, p[1] ), delta ), 1 );
+        delta1         = simdDbfClip3( vNegTc2, vTc2, delta1 );
+        pf[1]          = _mm_blendv_epi8( p[1], simdDbfClip3( vMin, vMax, _mm_add_epi32( p[1], delta1 ) ), mask );
+      }
+      if( bFilterSecondQ )
+      {
+        __m128i delta2 = _mm_srai_epi32( simdDbfAdd( q[2], _mm_add_epi32( q[0], _mm_set1_epi32( 1 ) ) ), 1 );
+        delta2         = _mm_srai_epi32( _mm_sub_epi32( _mm_sub_epi32( delta2, q[1] ), delta ), 1 );
+        delta2         = simdDbfClip3( vNegTc2, vTc2, delta2 );
+        qf[1]          = _mm_blendv_epi8( q[1], simdDbfClip3( vMin, vMax, _mm_add_epi32( q[1], delta2 ) ), mask );
+      }
+    }
+  }
+
+  // the unfiltered side is restored by not storing it
+  simdDbfStoreTaps( src, offset, step, DEBLOCK_SMALLEST_BLOCK / 2, numP, numQ, pf, qf, partPNoFilter, partQNoFilter );
+}
+
+template<X86_VEXT vext>
+static void simdFilterChromaSegment( Pel* src, const int offset, const int step, const int numLines, const int tc,
+                                     const bool sw, const bool partPNoFilter, const bool partQNoFilter,
+                                     const ClpRng& clpRng, const bool largeBoundary, const bool isChromaHorCTBBoundary )
+{
+  CHECKD( numLines != 2 && numLines != 4, "Unsupported number of chroma lines" );
+
+  __m128i p[8], q[8];
+  simdDbfLoadTaps( src, offset, step, numLines, 4, 4, p, q );
+
+  __m128i pf[8], qf[8];
+  for( int i = 0; i < 4; i++ )
+  {
+    pf[i] = p[i];
+    qf[i] = q[i];
+  }
+  for( int i = 4; i < 8; i++ )
+  {
+    pf[i] = qf[i] = _mm_setzero_si128();
+  }
+
+  if( sw )
+  {
+    const __m128i vTc  = _mm_set1_epi32( tc );
+    const __m128i p0q0 = simdDbfAdd( p[0], q[0] );
+    __m128i       val;
+
+    if( isChromaHorCTBBoundary )
+    {
+      // 3 * p1 + 2 * p0 + q0 + q1 + q2
+      val   = simdDbfAdd( simdDbfAdd( simdDbfMul( p[1], 3 ), simdDbfAdd( p[0], p0q0 ) ), simdDbfAdd( q[1], q[2] ) );
+      pf[0] = simdDbfClipDelta( p[0], vTc, simdDbfRound( val, 3 ) );
+      // 2 * p1 + p0 + 2 * q0 + q1 + q2 + q3
+      val   = simdDbfAdd( simdDbfAdd( _mm_slli_epi32( p[1], 1 ), simdDbfAdd( p0q0, q[0] ) ), simdDbfAdd( q[1], simdDbfAdd( q[2], q[3] ) ) );
+      qf[0] = simdDbfClipDelta( q[0], vTc, simdDbfRound( val, 3 ) );
+      // p1 + p0 + q0 + 2 * q1 + q2 + 2 * q3
+      val   = simdDbfAdd( simdDbfAdd( p[1], p0q0 ), simdDbfAdd( _mm_slli_epi32( simdDbfAdd( q[1], q[3] ), 1 ), q[2] ) );
+      qf[1] = simdDbfClipDelta( q[1], vTc, simdDbfRound( val, 3 ) );
+    }
+    else
+    {
+      // 3 * p3 + 2 * p2 + p1 + p0 + q0
+      val   = simdDbfAdd( simdDbfAdd( simdDbfMul( p[3], 3 ), _mm_slli_epi32( p[2], 1 ) ), simdDbfAdd( p[1], p0q0 ) );
+      pf[2] = simdDbfClipDelta( p[2], vTc, simdDbfRound( val, 3 ) );
+      // 2 * p3 + p2 + 2 * p1 + p0 + q0 + q1
+      val   = simdDbfAdd( simdDbfAdd( _mm_slli_epi32( simdDbfAdd( p[3], p[1] ), 1 ), p[2] ), simdDbfAdd( p0q0, q[1] ) );
+      pf[1] = simdDbfClipDelta( p[1], vTc, simdDbfRound( val, 3 ) );
+      // p3 + p2 + p1 + 2 * p0 + q0 + q1 + q2
+      val   = simdDbfAdd( simdDbfAdd( simdDbfAdd( p[3], p[2] ), simdDbfAdd( p[1], p[0] ) ), simdDbfAdd( p0q0, simdDbfAdd( q[1], q[2] ) ) );
+      pf[0] = simdDbfClipDelta( p[0], vTc, simdDbfRound( val, 3 ) );
+      // p2 + p1 + p0 + 2 * q0 + q1 + q2 + q3
+      val   = simdDbfAdd( simdDbfAdd( simdDbfAdd( p[2], p[1] ), simdDbfAdd( p0q0, q[0] ) ), simdDbfAdd( q[1], simdDbfAdd( q[2], q[3] ) ) );
+      qf[0] = simdDbfClipDelta( q[0], vTc, simdDbfRound( val, 3 ) );
+      // p1 + p0 + q0 + 2 * q1 + q2 + 2 * q3
+      val   = simdDbfAdd( simdDbfAdd( p[1], p0q0 ), simdDbfAdd( _mm_slli_epi32( simdDbfAdd( q[1], q[3] ), 1 ), q[2] ) );
+      qf[1] = simdDbfClipDelta( q[1], vTc, simdDbfRound( val, 3 ) );
+    }
+    // p0 + q0 + q1 + 2 * q2 + 3 * q3
+    val   = simdDbfAdd( simdDbfAdd( p0q0, q[1] ), simdDbfAdd( _mm_slli_epi32( q[2], 1 ), simdDbfMul( q[3], 3 ) ) );
+    qf[2] = simdDbfClipDelta( q[2], vTc, simdDbfRound( val, 3 ) );
+  }
+  else
+  {
+    const __m128i vTc = _mm_set1_epi32( tc );
+    __m128i delta     = simdDbfAdd( _mm_slli_epi32( _mm_sub_epi32( q[0], p[0] ), 2 ), _mm_sub_epi32( p[1], q[1] ) );
+    delta             = simdDbfClip3( _mm_sub_epi32( _mm_setzero_si128(), vTc ), vTc, simdDbfRound( delta, 3 ) );
+
+    const __m128i vMin = _mm_set1_epi32( clpRng.min );
+    const __m128i vMax = _mm_set1_epi32( clpRng.max );
+    pf[0]              = simdDbfClip3( vMin, vMax, _mm_add_epi32( p[0], delta ) );
+    qf[0]              = simdDbfClip3( vMin, vMax, _mm_sub_epi32( q[0], delta ) );
+  }
+
+  if( partPNoFilter )
+  {
+    pf[0] = p[0];
+    if( largeBoundary )
+    {
+      pf[1] = p[1];
+      pf[2] = p[2];
+    }
+  }
+  if( partQNoFilter )
+  {
+    qf[0] = q[0];
+    if( largeBoundary )
+    {
+      qf[1] = q[1];
+      qf[2] = q[2];
+    }
+  }
+
+  simdDbfStoreTaps( src, offset, step, numLines, 4, 4, pf, qf, false, false );
+}
+#endif
+
+template <X86_VEXT vext>
+void DeblockingFilter::_initDeblockingFilterX86()
+{
+#if !RExt__HIGH_BIT_DEPTH_SUPPORT
+  m_filterLumaSegment   = simdFilterLumaSegment<vext>;
+  m_filterChromaSegment = simdFilterChromaSegment<vext>;
+#endif
+}
+
+template void DeblockingFilter::_initDeblockingFilterX86<SIMDX86>();
+
+#endif //#ifdef TARGET_SIMD_X86
+//! \}
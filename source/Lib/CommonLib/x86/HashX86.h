@@ -0,0 +1,158 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2022, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/**
+ * \file
+ * \brief Implementation of the block hash kernels of TComHash
+ */
+
+#include "CommonDefX86.h"
+#include "../Unit.h"
+#include "../Hash.h"
+
+//! \ingroup CommonLib
+//! \{
+
+#ifdef TARGET_SIMD_X86
+
+#include <immintrin.h>
+
+#ifdef USE_AVX2
+// one four byte step of the 24 bit CRCs of eight lanes, the bytes of data are processed from the lowest one
+static inline __m256i simdCrc24Step( const __m256i remainder, const __m256i data, const uint32_t ( *table )[256] )
+{
+  const __m256i mask = _mm256_set1_epi32( 0xff );
+  // align the three remainder bytes with the first three data bytes
+  __m256i idx = _mm256_and_si256( _mm256_srli_epi32( remainder, 16 ), mask );
+  idx         = _mm256_or_si256( idx, _mm256_and_si256( remainder, _mm256_set1_epi32( 0xff00 ) ) );
+  idx         = _mm256_or_si256( idx, _mm256_slli_epi32( _mm256_and_si256( remainder, mask ), 16 ) );
+  idx         = _mm256_xor_si256( idx, data );
+
+  const __m256i crc3 = _mm256_i32gather_epi32( ( const int* ) table[3], _mm256_and_si256( idx, mask ), 4 );
+  const __m256i crc2 = _mm256_i32gather_epi32( ( const int* ) table[2], _mm256_and_si256( _mm256_srli_epi32( idx, 8 ), mask ), 4 );
+  const __m256i crc1 = _mm256_i32gather_epi32( ( const int* ) table[1], _mm256_and_si256( _mm256_srli_epi32( idx, 16 ), mask ), 4 );
+  const __m256i crc0 = _mm256_i32gather_epi32( ( const int* ) table[0], _mm256_srli_epi32( idx, 24 ), 4 );
+
+  return _mm256_xor_si256( _mm256_xor_si256( crc3, crc2 ), _mm256_xor_si256( crc1, crc0 ) );
+}
+#endif
+
+template<X86_VEXT vext>
+static void simdHashQuad( const uint32_t* src, int offsetX, int offsetY, uint32_t* dst, int num, const TCRCCalculatorLight& crc )
+{
+#ifdef USE_AVX2
+  if( vext >= AVX2 && num >= 8 )
+  {
+    const uint32_t ( *table )[256] = crc.getTable();
+
+    // the last group overlaps the previous one instead of leaving a scalar tail
+    for( int i = 0; i < num; i += 8 )
+    {
+      const int x = std::min( i, num - 8 );
+
+      __m256i remainder = _mm256_setzero_si256();
+      remainder = simdCrc24Step( remainder, _mm256_loadu_si256( ( const __m256i* ) ( src + x ) ), table );
+      remainder = simdCrc24Step( remainder, _mm256_loadu_si256( ( const __m256i* ) ( src + x + offsetX ) ), table );
+      remainder = simdCrc24Step( remainder, _mm256_loadu_si256( ( const __m256i* ) ( src + x + offsetY ) ), table );
+      remainder = simdCrc24Step( remainder, _mm256_loadu_si256( ( const __m256i* ) ( src + x + offsetY + offsetX ) ), table );
+      _mm256_storeu_si256( ( __m256i* ) ( dst + x ), remainder );
+    }
+    return;
+  }
+#endif
+
+  uint32_t p[4];
+  for( int i = 0; i < num; i++ )
+  {
+    p[0]   = src[i];
+    p[1]   = src[i + offsetX];
+    p[2]   = src[i + offsetY];
+    p[3]   = src[i + offsetY + offsetX];
+    dst[i] = crc.getCRC( ( unsigned char* ) p, 4 * sizeof( uint32_t ) );
+  }
+}
+
+#if !RExt__HIGH_BIT_DEPTH_SUPPORT
+template<X86_VEXT vext>
+static void simdHashBlock2x2( const Pel* src, int stride, int shift, uint32_t* dstHash1, uint32_t* dstHash2, int num, const TCRCCalculatorLight& crc1, const TCRCCalculatorLight& crc2 )
+{
+#ifdef USE_AVX2
+  if( vext >= AVX2 && num >= 8 )
+  {
+    const __m128i vshift = _mm_cvtsi32_si128( shift );
+    const __m256i mask   = _mm256_set1_epi32( 0xff );
+
+    for( int i = 0; i < num; i += 8 )
+    {
+      const int x = std::min( i, num - 8 );
+
+      // the four samples of each 2x2 block reduced to 8 bits, in the order of the first to the fourth CRC byte
+      __m256i data = _mm256_and_si256( _mm256_cvtepu16_epi32( _mm_sra_epi16( _mm_loadu_si128( ( const __m128i* ) ( src + x ) ), vshift ) ), mask );
+      data = _mm256_or_si256( data, _mm256_slli_epi32( _mm256_and_si256( _mm256_cvtepu16_epi32( _mm_sra_epi16( _mm_loadu_si128( ( const __m128i* ) ( src + x + 1 ) ), vshift ) ), mask ), 8 ) );
+      data = _mm256_or_si256( data, _mm256_slli_epi32( _mm256_and_si256( _mm256_cvtepu16_epi32( _mm_sra_epi16( _mm_loadu_si128( ( const __m128i* ) ( src + stride + x ) ), vshift ) ), mask ), 16 ) );
+      data = _mm256_or_si256( data, _mm256_slli_epi32( _mm256_cvtepu16_epi32( _mm_sra_epi16( _mm_loadu_si128( ( const __m128i* ) ( src + stride + x + 1 ) ), vshift ) ), 24 ) );
+
+      _mm256_storeu_si256( ( __m256i* ) ( dstHash1 + x ), simdCrc24Step( _mm256_setzero_si256(), data, crc1.getTable() ) );
+      _mm256_storeu_si256( ( __m256i* ) ( dstHash2 + x ), simdCrc24Step( _mm256_setzero_si256(), data, crc2.getTable() ) );
+    }
+    return;
+  }
+#endif
+
+  unsigned char p[4];
+  for( int i = 0; i < num; i++ )
+  {
+    p[0]        = static_cast<unsigned char>( src[i] >> shift );
+    p[1]        = static_cast<unsigned char>( src[i + 1] >> shift );
+    p[2]        = static_cast<unsigned char>( src[stride + i] >> shift );
+    p[3]        = static_cast<unsigned char>( src[stride + i + 1] >> shift );
+    dstHash1[i] = crc1.getCRC( p, 4 );
+    dstHash2[i] = crc2.getCRC( p, 4 );
+  }
+}
+#endif
+
+template <X86_VEXT vext>
+void TComHash::_initHashX86()
+{
+  m_hashQuad = simdHashQuad<vext>;
+#if !RExt__HIGH_BIT_DEPTH_SUPPORT
+  m_hashBlock2x2 = simdHashBlock2x2<vext>;
+#endif
+}
+
+template void TComHash::_initHashX86<SIMDX86>();
+
+#endif //#ifdef TARGET_SIMD_X86
+//! \}
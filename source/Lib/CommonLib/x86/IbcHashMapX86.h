@@ -49,10 +49,47 @@ static uint32_t simdComputeCrc32c16bit(uint32_t crc, const Pel pel)
   return _mm_crc32_u16(crc, pel);
 }
 
+template<X86_VEXT vext>
+static uint32_t simdCalcBlockHash(const Pel* pel, const ptrdiff_t stride, const int width, const int height, uint32_t crc)
+{
+#if !RExt__HIGH_BIT_DEPTH_SUPPORT
+  // the CRC of a row of 16-bit samples equals the CRC over its little-endian bytes
+  if (width == 4)
+  {
+    for (int y = 0; y < height; y++, pel += stride)
+    {
+      uint64_t row;
+      memcpy(&row, pel, sizeof(row));
+      crc = (uint32_t) _mm_crc32_u64(crc, row);
+    }
+    return crc;
+  }
+  if (width == 2)
+  {
+    for (int y = 0; y < height; y++, pel += stride)
+    {
+      uint32_t row;
+      memcpy(&row, pel, sizeof(row));
+      crc = _mm_crc32_u32(crc, row);
+    }
+    return crc;
+  }
+#endif
+  for (int y = 0; y < height; y++, pel += stride)
+  {
+    for (int x = 0; x < width; x++)
+    {
+      crc = _mm_crc32_u16(crc, pel[x]);
+    }
+  }
+  return crc;
+}
+
 template <X86_VEXT vext>
 void IbcHashMap::_initIbcHashMapX86()
 {
   m_computeCrc32c = simdComputeCrc32c16bit<vext>;
+  m_calcBlockHash = simdCalcBlockHash<vext>;
 }
 
 template void IbcHashMap::_initIbcHashMapX86<SIMDX86>();
@@ -50,6 +50,14 @@
 
 #include "CommonLib/IbcHashMap.h"
 
+#include "CommonLib/MatrixIntraPrediction.h"
+
+#include "CommonLib/DeblockingFilter.h"
+
+#include "CommonLib/SampleAdaptiveOffset.h"
+
+#include "CommonLib/Hash.h"
+
 #ifdef TARGET_SIMD_X86
 
 
@@ -167,6 +175,83 @@ void AdaptiveLoopFilter::initAdaptiveLoopFilterX86()
 }
 #endif
 
+#if ENABLE_SIMD_OPT_MIP
+void MatrixIntraPrediction::initMatrixIntraPredictionX86()
+{
+  auto vext = read_x86_extension_flags();
+  switch ( vext )
+  {
+  case AVX512:
+  case AVX2:
+    _initMatrixIntraPredictionX86<AVX2>();
+    break;
+  case AVX:
+  case SSE42:
+  case SSE41:
+    _initMatrixIntraPredictionX86<SSE41>();
+    break;
+  default:
+    break;
+  }
+}
+#endif
+
+#if ENABLE_SIMD_OPT_DEBLOCK
+void DeblockingFilter::initDeblockingFilterX86()
+{
+  auto vext = read_x86_extension_flags();
+  switch ( vext )
+  {
+  case AVX512:
+  case AVX2:
+  case AVX:
+  case SSE42:
+  case SSE41:
+    _initDeblockingFilterX86<SSE41>();
+    break;
+  default:
+    break;
+  }
+}
+#endif
+
+#if ENABLE_SIMD_OPT_SAO
+void SampleAdaptiveOffset::initSampleAdaptiveOffsetX86()
+{
+  auto vext = read_x86_extension_flags();
+  switch ( vext )
+  {
+  case AVX512:
+  case AVX2:
+    _initSampleAdaptiveOffsetX86<AVX2>();
+    break;
+  case AVX:
+  case SSE42:
+  case SSE41:
+    _initSampleAdaptiveOffsetX86<SSE41>();
+    break;
+  default:
+    break;
+  }
+}
+#endif
+
+#if ENABLE_SIMD_OPT_HASH
+void TComHash::initHashX86()
+{
+  auto vext = read_x86_extension_flags();
+  switch ( vext )
+  {
+  case AVX512:
+  case AVX2:
+    _initHashX86<AVX2>();
+    break;
+  default:
+    break;
+  }
+}
+#endif
+
 #if ENABLE_SIMD_OPT_IBC
 void IbcHashMap::initIbcHashMapX86()
 {
@@ -2444,6 +2444,337 @@ void xWeightedGeoBlk_SSE(const PredictionUnit &pu, const uint32_t width, const u
   }
 }
 
+#if !RExt__HIGH_BIT_DEPTH_SUPPORT
+// Batched luma filtering of several fractional phases. A width that is not a multiple of the vector size is completed
+// by one more vector overlapping the previous one, which writes some outputs twice with the same values.
+template<X86_VEXT vext>
+static void simdFilterHorBatch(const ClpRng &clpRng, Pel const *src, const ptrdiff_t srcStride, Pel *const *dst,
+                               const ptrdiff_t dstStride, int width, int height, int numPhases,
+                               TFilterCoeff const *const *coeff)
+{
+  if (width < 4)
+  {
+    InterpolationFilter::xFilterHorBatch(clpRng, src, srcStride, dst, dstStride, width, height, numPhases, coeff);
+    return;
+  }
+
+  const int shift  = IF_FILTER_PREC - IF_INTERNAL_FRAC_BITS(clpRng.bd);
+  const int offset = -(IF_INTERNAL_OFFS << shift);
+
+  src -= NTAPS_LUMA / 2 - 1;
+
+#ifdef USE_AVX2
+  if (vext >= AVX2 && width >= 8)
+  {
+    // the tap pairs of 8 outputs are shuffled once per position and shared by all phases
+    const __m256i shuffle0 = _mm256_broadcastsi128_si256(_mm_setr_epi8(0, 1, 2, 3, 2, 3, 4, 5, 4, 5, 6, 7, 6, 7, 8, 9));
+    const __m256i shuffle1 =
+      _mm256_broadcastsi128_si256(_mm_setr_epi8(4, 5, 6, 7, 6, 7, 8, 9, 8, 9, 10, 11, 10, 11, 12, 13));
+    const __m256i vOffset = _mm256_set1_epi32(offset);
+    const __m128i vShift  = _mm_cvtsi32_si128(shift);
+
+    __m256i coeffs[IF_MAX_BATCH_PHASES][NTAPS_LUMA / 2];
+    for (int k = 0; k < numPhases; k++)
+    {
+      const __m256i c = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *) coeff[k]));
+      coeffs[k][0]    = _mm256_shuffle_epi32(c, 0x00);
+      coeffs[k][1]    = _mm256_shuffle_epi32(c, 0x55);
+      coeffs[k][2]    = _mm256_shuffle_epi32(c, 0xaa);
+      coeffs[k][3]    = _mm256_shuffle_epi32(c, 0xff);
+    }
+
+    for (int row = 0; row < height; row++)
+    {
+      const Pel *s = src + row * srcStride;
+      for (int x = 0; x < width; x += 8)
+      {
+        const int     col  = std::min(x, width - 8);
+        const __m128i val0 = _mm_loadu_si128((const __m128i *) (s + col));
+        const __m128i val1 = _mm_loadu_si128((const __m128i *) (s + col + 4));
+        const __m128i val2 = _mm_loadu_si128((const __m128i *) (s + col + 8));
+        const __m256i v01  = _mm256_inserti128_si256(_mm256_castsi128_si256(val0), val1, 1);
+        const __m256i v12  = _mm256_inserti128_si256(_mm256_castsi128_si256(val1), val2, 1);
+        const __m256i t0   = _mm256_shuffle_epi8(v01, shuffle0);
+        const __m256i t1   = _mm256_shuffle_epi8(v01, shuffle1);
+        const __m256i t2   = _mm256_shuffle_epi8(v12, shuffle0);
+        const __m256i t3   = _mm256_shuffle_epi8(v12, shuffle1);
+
+        for (int k = 0; k < numPhases; k++)
+        {
+          __m256i vsum = _mm256_add_epi32(vOffset, _mm256_madd_epi16(t0, coeffs[k][0]));
+          vsum         = _mm256_add_epi32(vsum, _mm256_madd_epi16(t1, coeffs[k][1]));
+          vsum         = _mm256_add_epi32(vsum, _mm256_madd_epi16(t2, coeffs[k][2]));
+          vsum         = _mm256_add_epi32(vsum, _mm256_madd_epi16(t3, coeffs[k][3]));
+          vsum         = _mm256_sra_epi32(vsum, vShift);
+
+          const __m128i sum = _mm_packs_epi32(_mm256_castsi256_si128(vsum), _mm256_extracti128_si256(vsum, 1));
+          _mm_storeu_si128((__m128i *) (dst[k] + row * dstStride + col), sum);
+        }
+      }
+    }
+    return;
+  }
+#endif
+
+  const __m128i vOffset = _mm_set1_epi32(offset);
+  const __m128i vShift  = _mm_cvtsi32_si128(shift);
+
+  __m128i coeffs[IF_MAX_BATCH_PHASES][NTAPS_LUMA / 2];
+  for (int k = 0; k < numPhases; k++)
+  {
+    const __m128i c = _mm_loadu_si128((const __m128i *) coeff[k]);
+    coeffs[k][0]    = _mm_shuffle_epi32(c, 0x00);
+    coeffs[k][1]    = _mm_shuffle_epi32(c, 0x55);
+    coeffs[k][2]    = _mm_shuffle_epi32(c, 0xaa);
+    coeffs[k][3]    = _mm_shuffle_epi32(c, 0xff);
+  }
+
+  for (int row = 0; row < height; row++)
+  {
+    const Pel *s = src + row * srcStride;
+    for (int x = 0; x < width; x += 4)
+    {
+      // pairs of taps ( x + i, x + i + 1 ) of 4 outputs, shared by all phases
+      const int col = std::min(x, width - 4);
+      __m128i   t[NTAPS_LUMA / 2];
+      for (int i = 0; i < NTAPS_LUMA / 2; i++)
+      {
+        const __m128i a = _mm_loadl_epi64((const __m128i *) (s + col + 2 * i));
+        const __m128i b = _mm_loadl_epi64((const __m128i *) (s + col + 2 * i + 1));
+        t[i]            = _mm_unpacklo_epi16(a, b);
+      }
+
+      for (int k = 0; k < numPhases; k++)
+      {
+        __m128i vsum = vOffset;
+        for (int i = 0; i < NTAPS_LUMA / 2; i++)
+        {
+          vsum = _mm_add_epi32(vsum, _mm_madd_epi16(t[i], coeffs[k][i]));
+        }
+        vsum = _mm_sra_epi32(vsum, vShift);
+        _mm_storel_epi64((__m128i *) (dst[k] + row * dstStride + col), _mm_packs_epi32(vsum, vsum));
+      }
+    }
+  }
+}
+
+// vertical 8-tap filtering of one vector of outputs from a window of source rows, OFFSET selects the first tap row
+template<int OFFSET>
+static inline __m128i simdFilterVerBatchM4(const __m128i *rows, const __m128i *coeffs, const __m128i vOffset,
+                                           const __m128i vShift)
+{
+  __m128i sum = vOffset;
+  for (int i = 0; i < NTAPS_LUMA / 2; i++)
+  {
+    sum = _mm_add_epi32(sum, _mm_madd_epi16(_mm_unpacklo_epi16(rows[2 * i + OFFSET], rows[2 * i + OFFSET + 1]),
+                                            coeffs[i]));
+  }
+  sum = _mm_sra_epi32(sum, vShift);
+  return _mm_packs_epi32(sum, sum);
+}
+
+template<int OFFSET>
+static inline __m128i simdFilterVerBatchM8(const __m128i *rows, const __m128i *coeffs, const __m128i vOffset,
+                                           const __m128i vShift)
+{
+  __m128i sumLo = vOffset;
+  __m128i sumHi = vOffset;
+  for (int i = 0; i < NTAPS_LUMA / 2; i++)
+  {
+    const __m128i a = rows[2 * i + OFFSET];
+    const __m128i b = rows[2 * i + OFFSET + 1];
+    sumLo           = _mm_add_epi32(sumLo, _mm_madd_epi16(_mm_unpacklo_epi16(a, b), coeffs[i]));
+    sumHi           = _mm_add_epi32(sumHi, _mm_madd_epi16(_mm_unpackhi_epi16(a, b), coeffs[i]));
+  }
+  return _mm_packs_epi32(_mm_sra_epi32(sumLo, vShift), _mm_sra_epi32(sumHi, vShift));
+}
+
+#ifdef USE_AVX2
+// rows hold 8 samples duplicated as ( 0..3, 0..3, 4..7, 4..7 ), so one unpack covers all 8 outputs
+template<int OFFSET>
+static inline __m128i simdFilterVerBatchM8_AVX2(const __m256i *rows, const __m256i *coeffs, const __m256i vOffset,
+                                                const __m128i vShift)
+{
+  __m256i sum = vOffset;
+  for (int i = 0; i < NTAPS_LUMA / 2; i++)
+  {
+    sum = _mm256_add_epi32(
+      sum, _mm256_madd_epi16(_mm256_unpacklo_epi16(rows[2 * i + OFFSET], rows[2 * i + OFFSET + 1]), coeffs[i]));
+  }
+  sum = _mm256_sra_epi32(sum, vShift);
+  return _mm_packs_epi32(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+}
+
+template<int OFFSET>
+static inline __m256i simdFilterVerBatchM16(const __m256i *rows, const __m256i *coeffs, const __m256i vOffset,
+                                            const __m128i vShift)
+{
+  __m256i sumLo = vOffset;
+  __m256i sumHi = vOffset;
+  for (int i = 0; i < NTAPS_LUMA / 2; i++)
+  {
+    const __m256i a = rows[2 * i + OFFSET];
+    const __m256i b = rows[2 * i + OFFSET + 1];
+    sumLo           = _mm256_add_epi32(sumLo, _mm256_madd_epi16(_mm256_unpacklo_epi16(a, b), coeffs[i]));
+    sumHi           = _mm256_add_epi32(sumHi, _mm256_madd_epi16(_mm256_unpackhi_epi16(a, b), coeffs[i]));
+  }
+  return _mm256_packs_epi32(_mm256_sra_epi32(sumLo, vShift), _mm256_sra_epi32(sumHi, vShift));
+}
+#endif
+
+// slides a window of source rows, loaded once for all phases, down the column strip starting at col
+template<typename LoadRow, typename FilterPhase>
+static inline void simdFilterVerBatchStrip(Pel const *src, const ptrdiff_t srcStride, Pel *const *dst,
+                                           const ptrdiff_t dstStride, const int col, const int height,
+                                           const int numPhases, const bool extraRow, LoadRow loadRow,
+                                           FilterPhase filterPhase)
+{
+  decltype(loadRow(src)) rows[NTAPS_LUMA + 1];
+  for (int i = 0; i < NTAPS_LUMA - 1; i++)
+  {
+    rows[i] = loadRow(src + i * srcStride + col);
+  }
+
+  for (int row = 0; row < height; row++)
+  {
+    const Pel *s         = src + (row + NTAPS_LUMA - 1) * srcStride + col;
+    rows[NTAPS_LUMA - 1] = loadRow(s);
+    rows[NTAPS_LUMA]     = extraRow ? loadRow(s + srcStride) : rows[NTAPS_LUMA - 1];
+
+    for (int k = 0; k < numPhases; k++)
+    {
+      filterPhase(rows, k, dst[k] + row * dstStride + col);
+    }
+
+    for (int i = 0; i < NTAPS_LUMA - 1; i++)
+    {
+      rows[i] = rows[i + 1];
+    }
+  }
+}
+
+template<X86_VEXT vext>
+static void simdFilterVerBatch(const ClpRng &clpRng, Pel const *src, const ptrdiff_t srcStride, Pel *const *dst,
+                               const ptrdiff_t dstStride, int width, int height, int numPhases,
+                               TFilterCoeff const *const *coeff, const int *rowOffset)
+{
+  if (width < 4)
+  {
+    InterpolationFilter::xFilterVerBatch(clpRng, src, srcStride, dst, dstStride, width, height, numPhases, coeff,
+                                         rowOffset);
+    return;
+  }
+
+  const int shift  = IF_FILTER_PREC + IF_INTERNAL_FRAC_BITS(clpRng.bd);
+  const int offset = (1 << (shift - 1)) + (IF_INTERNAL_OFFS << IF_FILTER_PREC);
+
+  src -= (NTAPS_LUMA / 2 - 1) * srcStride;
+
+  // the window of source rows is one row taller when a phase is read one row further down
+  bool extraRow = false;
+  for (int k = 0; k < numPhases; k++)
+  {
+    extraRow |= rowOffset[k] > 0;
+  }
+
+#ifdef USE_AVX2
+  if (vext >= AVX2 && width >= 8)
+  {
+    const __m256i vOffset = _mm256_set1_epi32(offset);
+    const __m128i vShift  = _mm_cvtsi32_si128(shift);
+    const __m256i vMin    = _mm256_set1_epi16(clpRng.min);
+    const __m256i vMax    = _mm256_set1_epi16(clpRng.max);
+
+    __m256i coeffs[IF_MAX_BATCH_PHASES][NTAPS_LUMA / 2];
+    for (int k = 0; k < numPhases; k++)
+    {
+      for (int i = 0; i < NTAPS_LUMA / 2; i++)
+      {
+        coeffs[k][i] = _mm256_set1_epi32(*(const int32_t *) &coeff[k][2 * i]);
+      }
+    }
+
+    auto load16   = [](const Pel *s) { return _mm256_loadu_si256((const __m256i *) s); };
+    auto filter16 = [&](const __m256i *rows, const int k, Pel *d)
+    {
+      const __m256i sum = rowOffset[k] ? simdFilterVerBatchM16<1>(rows, coeffs[k], vOffset, vShift)
+                                       : simdFilterVerBatchM16<0>(rows, coeffs[k], vOffset, vShift);
+      _mm256_storeu_si256((__m256i *) d, _mm256_min_epi16(_mm256_max_epi16(sum, vMin), vMax));
+    };
+    auto load8 = [](const Pel *s)
+    {
+      return _mm256_permute4x64_epi64(_mm256_castsi128_si256(_mm_loadu_si128((const __m128i *) s)),
+                                      _MM_SHUFFLE(1, 1, 0, 0));
+    };
+    auto filter8 = [&](const __m256i *rows, const int k, Pel *d)
+    {
+      const __m128i sum = rowOffset[k] ? simdFilterVerBatchM8_AVX2<1>(rows, coeffs[k], vOffset, vShift)
+                                       : simdFilterVerBatchM8_AVX2<0>(rows, coeffs[k], vOffset, vShift);
+      _mm_storeu_si128((__m128i *) d, _mm_min_epi16(_mm_max_epi16(sum, _mm256_castsi256_si128(vMin)),
+                                                    _mm256_castsi256_si128(vMax)));
+    };
+
+    int x = 0;
+    for (; x + 16 <= width; x += 16)
+    {
+      simdFilterVerBatchStrip(src, srcStride, dst, dstStride, x, height, numPhases, extraRow, load16, filter16);
+    }
+    for (; x < width; x += 8)
+    {
+      simdFilterVerBatchStrip(src, srcStride, dst, dstStride, std::min(x, width - 8), height, numPhases, extraRow,
+                              load8, filter8);
+    }
+    return;
+  }
+#endif
+
+  const __m128i vOffset = _mm_set1_epi32(offset);
+  const __m128i vShift  = _mm_cvtsi32_si128(shift);
+  const __m128i vMin    = _mm_set1_epi16(clpRng.min);
+  const __m128i vMax    = _mm_set1_epi16(clpRng.max);
+
+  __m128i coeffs[IF_MAX_BATCH_PHASES][NTAPS_LUMA / 2];
+  for (int k = 0; k < numPhases; k++)
+  {
+    for (int i = 0; i < NTAPS_LUMA / 2; i++)
+    {
+      coeffs[k][i] = _mm_set1_epi32(*(const int32_t *) &coeff[k][2 * i]);
+    }
+  }
+
+  if (width >= 8)
+  {
+    auto load8   = [](const Pel *s) { return _mm_loadu_si128((const __m128i *) s); };
+    auto filter8 = [&](const __m128i *rows, const int k, Pel *d)
+    {
+      const __m128i sum = rowOffset[k] ? simdFilterVerBatchM8<1>(rows, coeffs[k], vOffset, vShift)
+                                       : simdFilterVerBatchM8<0>(rows, coeffs[k], vOffset, vShift);
+      _mm_storeu_si128((__m128i *) d, _mm_min_epi16(_mm_max_epi16(sum, vMin), vMax));
+    };
+    for (int x = 0; x < width; x += 8)
+    {
+      simdFilterVerBatchStrip(src, srcStride, dst, dstStride, std::min(x, width - 8), height, numPhases, extraRow,
+                              load8, filter8);
+    }
+  }
+  else
+  {
+    auto load4   = [](const Pel *s) { return _mm_loadl_epi64((const __m128i *) s); };
+    auto filter4 = [&](const __m128i *rows, const int k, Pel *d)
+    {
+      const __m128i sum = rowOffset[k] ? simdFilterVerBatchM4<1>(rows, coeffs[k], vOffset, vShift)
+                                       : simdFilterVerBatchM4<0>(rows, coeffs[k], vOffset, vShift);
+      _mm_storel_epi64((__m128i *) d, _mm_min_epi16(_mm_max_epi16(sum, vMin), vMax));
+    };
+    for (int x = 0; x < width; x += 4)
+    {
+      simdFilterVerBatchStrip(src, srcStride, dst, dstStride, std::min(x, width - 4), height, numPhases, extraRow,
+                              load4, filter4);
+    }
+  }
+}
+#endif
+
 template <X86_VEXT vext>
 void InterpolationFilter::_initInterpolationFilterX86()
 {
@@ -2500,6 +2831,9 @@ void InterpolationFilter::_initInterpolationFilterX86()
   m_filterCopy[1][0]   = simdFilterCopy<vext, true, false>;
   m_filterCopy[1][1]   = simdFilterCopy<vext, true, true>;
 
+  m_filterHorBatch = simdFilterHorBatch<vext>;
+  m_filterVerBatch = simdFilterVerBatch<vext>;
+
   m_weightedGeoBlk = xWeightedGeoBlk_SSE<vext>;
 #endif
 }
@@ -0,0 +1,305 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2022, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/**
+ * \file
+ * \brief Implementation of MatrixIntraPrediction class
+ */
+
+#include "CommonDefX86.h"
+#include "../MatrixIntraPrediction.h"
+#include "../MipData.h"
+
+//! \ingroup CommonLib
+//! \{
+
+#ifdef TARGET_SIMD_X86
+
+#if !RExt__HIGH_BIT_DEPTH_SUPPORT
+static inline __m128i simdMipClip( const __m128i sum, const __m128i vOffset, const __m128i vInputOffset, const __m128i vMax )
+{
+  __m128i res = _mm_srai_epi32( _mm_add_epi32( sum, vOffset ), MIP_SHIFT_MATRIX );
+  res         = _mm_add_epi32( res, vInputOffset );
+  return _mm_min_epi32( vMax, _mm_max_epi32( _mm_setzero_si128(), res ) );
+}
+
+// The boundary samples are packed to 16 bit and multiplied with the 8-bit weights using madd, i.e. each 16-bit vector
+// holds the weights of one (inputSize 8) or two (inputSize 4) output samples. For mipSizeId 2 the first input is
+// always zero and the matrices only store the remaining seven weights per output sample.
+template<X86_VEXT vext>
+static void simdMipMatrixMul( int* const result, const int* const input, const uint8_t* matrix, const int numOutputs,
+                              const int inputSize, const int offset, const int inputOffset, const bool redSize,
+                              const int bitDepth )
+{
+  CHECKD( numOutputs & 7, "Number of MIP output samples must be a multiple of 8" );
+
+  const __m128i vOffset      = _mm_set1_epi32( offset );
+  const __m128i vInputOffset = _mm_set1_epi32( inputOffset );
+  const __m128i vMax         = _mm_set1_epi32( ( 1 << bitDepth ) - 1 );
+
+  const uint8_t* weight = matrix;
+  int*           res    = result;
+
+  if( inputSize == 4 )
+  {
+    const __m128i vIn   = _mm_loadu_si128( ( const __m128i* ) input );
+    const __m128i vIn16 = _mm_packs_epi32( vIn, vIn );
+
+#ifdef USE_AVX2
+    if( vext >= AVX2 )
+    {
+      const __m256i vIn256        = _mm256_broadcastsi128_si256( vIn16 );
+      const __m256i vOffset256    = _mm256_set1_epi32( offset );
+      const __m256i vInOffset256  = _mm256_set1_epi32( inputOffset );
+      const __m256i vMax256       = _mm256_set1_epi32( ( 1 << bitDepth ) - 1 );
+
+      for( int i = 0; i < numOutputs; i += 8, weight += 32, res += 8 )
+      {
+        const __m256i w  = _mm256_loadu_si256( ( const __m256i* ) weight );
+        const __m256i m0 = _mm256_madd_epi16( _mm256_cvtepu8_epi16( _mm256_castsi256_si128( w ) ), vIn256 );
+        const __m256i m1 = _mm256_madd_epi16( _mm256_cvtepu8_epi16( _mm256_extracti128_si256( w, 1 ) ), vIn256 );
+        __m256i sum      = _mm256_permute4x64_epi64( _mm256_hadd_epi32( m0, m1 ), 0xD8 );
+
+        sum = _mm256_srai_epi32( _mm256_add_epi32( sum, vOffset256 ), MIP_SHIFT_MATRIX );
+        sum = _mm256_add_epi32( sum, vInOffset256 );
+        sum = _mm256_min_epi32( vMax256, _mm256_max_epi32( _mm256_setzero_si256(), sum ) );
+        _mm256_storeu_si256( ( __m256i* ) res, sum );
+      }
+      return;
+    }
+#endif
+
+    for( int i = 0; i < numOutputs; i += 4, weight += 16, res += 4 )
+    {
+      const __m128i w  = _mm_loadu_si128( ( const __m128i* ) weight );
+      const __m128i m0 = _mm_madd_epi16( _mm_cvtepu8_epi16( w ), vIn16 );
+      const __m128i m1 = _mm_madd_epi16( _mm_cvtepu8_epi16( _mm_srli_si128( w, 8 ) ), vIn16 );
+
+      _mm_storeu_si128( ( __m128i* ) res, simdMipClip( _mm_hadd_epi32( m0, m1 ), vOffset, vInputOffset, vMax ) );
+    }
+  }
+  else if( !redSize )
+  {
+    const __m128i vIn16 = _mm_packs_epi32( _mm_loadu_si128( ( const __m128i* ) input ), _mm_loadu_si128( ( const __m128i* ) ( input + 4 ) ) );
+
+#ifdef USE_AVX2
+    if( vext >= AVX2 )
+    {
+      const __m256i vIn256        = _mm256_broadcastsi128_si256( vIn16 );
+      const __m256i vOffset256    = _mm256_set1_epi32( offset );
+      const __m256i vInOffset256  = _mm256_set1_epi32( inputOffset );
+      const __m256i vMax256       = _mm256_set1_epi32( ( 1 << bitDepth ) - 1 );
+      const __m256i vPermute      = _mm256_setr_epi32( 0, 4, 1, 5, 2, 6, 3, 7 );
+
+      for( int i = 0; i < numOutputs; i += 8, weight += 64, res += 8 )
+      {
+        const __m256i w0 = _mm256_loadu_si256( ( const __m256i* ) weight );
+        const __m256i w1 = _mm256_loadu_si256( ( const __m256i* ) ( weight + 32 ) );
+        const __m256i m0 = _mm256_madd_epi16( _mm256_cvtepu8_epi16( _mm256_castsi256_si128( w0 ) ), vIn256 );
+        const __m256i m1 = _mm256_madd_epi16( _mm256_cvtepu8_epi16( _mm256_extracti128_si256( w0, 1 ) ), vIn256 );
+        const __m256i m2 = _mm256_madd_epi16( _mm256_cvtepu8_epi16( _mm256_castsi256_si128( w1 ) ), vIn256 );
+        const __m256i m3 = _mm256_madd_epi16( _mm256_cvtepu8_epi16( _mm256_extracti128_si256( w1, 1 ) ), vIn256 );
+        __m256i sum      = _mm256_hadd_epi32( _mm256_hadd_epi32( m0, m1 ), _mm256_hadd_epi32( m2, m3 ) );
+        sum              = _mm256_permutevar8x32_epi32( sum, vPermute );
+
+        sum = _mm256_srai_epi32( _mm256_add_epi32( sum, vOffset256 ), MIP_SHIFT_MATRIX );
+        sum = _mm256_add_epi32( sum, vInOffset256 );
+        sum = _mm256_min_epi32( vMax256, _mm256_max_epi32( _mm256_setzero_si256(), sum ) );
+        _mm256_storeu_si256( ( __m256i* ) res, sum );
+      }
+      return;
+    }
+#endif
+
+    for( int i = 0; i < numOutputs; i += 4, weight += 32, res += 4 )
+    {
+      const __m128i w0 = _mm_loadu_si128( ( const __m128i* ) weight );
+      const __m128i w1 = _mm_loadu_si128( ( const __m128i* ) ( weight + 16 ) );
+      const __m128i m0 = _mm_madd_epi16( _mm_cvtepu8_epi16( w0 ), vIn16 );
+      const __m128i m1 = _mm_madd_epi16( _mm_cvtepu8_epi16( _mm_srli_si128( w0, 8 ) ), vIn16 );
+      const __m128i m2 = _mm_madd_epi16( _mm_cvtepu8_epi16( w1 ), vIn16 );
+      const __m128i m3 = _mm_madd_epi16( _mm_cvtepu8_epi16( _mm_srli_si128( w1, 8 ) ), vIn16 );
+      const __m128i sum = _mm_hadd_epi32( _mm_hadd_epi32( m0, m1 ), _mm_hadd_epi32( m2, m3 ) );
+
+      _mm_storeu_si128( ( __m128i* ) res, simdMipClip( sum, vOffset, vInputOffset, vMax ) );
+    }
+  }
+  else
+  {
+    // drop the (zero) first input, the seven weights of each output are expanded to eight with a zero weight
+    const __m128i vIn16 = _mm_srli_si128( _mm_packs_epi32( _mm_loadu_si128( ( const __m128i* ) input ), _mm_loadu_si128( ( const __m128i* ) ( input + 4 ) ) ), 2 );
+    const __m128i vShufLo = _mm_setr_epi8( 0, 1, 2, 3, 4, 5, 6, -1, 7, 8, 9, 10, 11, 12, 13, -1 );
+    const __m128i vShufHi = _mm_setr_epi8( 2, 3, 4, 5, 6, 7, 8, -1, 9, 10, 11, 12, 13, 14, 15, -1 );
+
+    for( int i = 0; i < numOutputs; i += 4, weight += 28, res += 4 )
+    {
+      // two overlapping loads cover exactly the 28 weights of four outputs
+      const __m128i w0 = _mm_shuffle_epi8( _mm_loadu_si128( ( const __m128i* ) weight ), vShufLo );
+      const __m128i w1 = _mm_shuffle_epi8( _mm_loadu_si128( ( const __m128i* ) ( weight + 12 ) ), vShufHi );
+      const __m128i m0 = _mm_madd_epi16( _mm_cvtepu8_epi16( w0 ), vIn16 );
+      const __m128i m1 = _mm_madd_epi16( _mm_cvtepu8_epi16( _mm_srli_si128( w0, 8 ) ), vIn16 );
+      const __m128i m2 = _mm_madd_epi16( _mm_cvtepu8_epi16( w1 ), vIn16 );
+      const __m128i m3 = _mm_madd_epi16( _mm_cvtepu8_epi16( _mm_srli_si128( w1, 8 ) ), vIn16 );
+      const __m128i sum = _mm_hadd_epi32( _mm_hadd_epi32( m0, m1 ), _mm_hadd_epi32( m2, m3 ) );
+
+      _mm_storeu_si128( ( __m128i* ) res, simdMipClip( sum, vOffset, vInputOffset, vMax ) );
+    }
+  }
+}
+#endif
+
+static inline void simdMipInterpolate4( int* dst, const __m128i before, const __m128i diff, const __m128i vRound,
+                                        const int log2UpsmpFactor, const unsigned int upsmpFactor )
+{
+  __m128i pos = _mm_setr_epi32( 1, 2, 3, 4 );
+  for( unsigned int k = 0; k < upsmpFactor; k += 4 )
+  {
+    const __m128i res = _mm_add_epi32( before, _mm_srai_epi32( _mm_add_epi32( _mm_mullo_epi32( diff, pos ), vRound ), log2UpsmpFactor ) );
+    _mm_storeu_si128( ( __m128i* ) ( dst + k ), res );
+    pos = _mm_add_epi32( pos, _mm_set1_epi32( 4 ) );
+  }
+}
+
+// Only the two layouts used by MatrixIntraPrediction::predictionUpsampling() are supported: horizontal upsampling of
+// contiguous lines (srcStep = dstStep = 1) and vertical upsampling of contiguous rows (srcStride = dstStride = 1).
+// Each upsampled sample is computed as before + ((behind - before) * pos + round) >> log2UpsmpFactor, which is
+// identical to the weighted sum of the scalar implementation.
+template<X86_VEXT vext>
+static void simdMipUpsampling1D( int* const dst, const int* const src, const int* const bndry,
+                                 const SizeType srcSizeUpsmpDim, const SizeType srcSizeOrthDim,
+                                 const SizeType srcStep, const SizeType srcStride,
+                                 const SizeType dstStep, const SizeType dstStride,
+                                 const SizeType bndryStep,
+                                 const unsigned int upsmpFactor )
+{
+  const int     log2UpsmpFactor = floorLog2( upsmpFactor );
+  CHECKD( upsmpFactor <= 1, "Upsampling factor must be at least 2." );
+  CHECKD( srcSizeUpsmpDim & 3, "Reduced prediction size must be a multiple of 4." );
+  const int     roundingOffset  = 1 << ( log2UpsmpFactor - 1 );
+  const __m128i vRound          = _mm_set1_epi32( roundingOffset );
+
+  if( srcStep == 1 && dstStep == 1 )
+  {
+    const int* bndryLine = bndry + bndryStep - 1;
+    for( SizeType idxOrthDim = 0; idxOrthDim < srcSizeOrthDim; idxOrthDim++ )
+    {
+      const int* srcLine = src + idxOrthDim * srcStride;
+      int*       dstLine = dst + idxOrthDim * dstStride;
+
+      for( SizeType idxUpsmpDim = 0; idxUpsmpDim < srcSizeUpsmpDim; idxUpsmpDim += 4 )
+      {
+        const int     prev   = idxUpsmpDim == 0 ? *bndryLine : srcLine[idxUpsmpDim - 1];
+        const __m128i behind = _mm_loadu_si128( ( const __m128i* ) ( srcLine + idxUpsmpDim ) );
+        const __m128i before = _mm_alignr_epi8( behind, _mm_set1_epi32( prev ), 12 );
+        const __m128i diff   = _mm_sub_epi32( behind, before );
+        int*          dstPos = dstLine + ( idxUpsmpDim << log2UpsmpFactor );
+
+        if( upsmpFactor == 2 )
+        {
+          const __m128i mid = _mm_add_epi32( before, _mm_srai_epi32( _mm_add_epi32( diff, vRound ), 1 ) );
+          _mm_storeu_si128( ( __m128i* ) dstPos,       _mm_unpacklo_epi32( mid, behind ) );
+          _mm_storeu_si128( ( __m128i* ) ( dstPos + 4 ), _mm_unpackhi_epi32( mid, behind ) );
+        }
+        else
+        {
+          simdMipInterpolate4( dstPos,                   _mm_shuffle_epi32( before, 0x00 ), _mm_shuffle_epi32( diff, 0x00 ), vRound, log2UpsmpFactor, upsmpFactor );
+          simdMipInterpolate4( dstPos + upsmpFactor,     _mm_shuffle_epi32( before, 0x55 ), _mm_shuffle_epi32( diff, 0x55 ), vRound, log2UpsmpFactor, upsmpFactor );
+          simdMipInterpolate4( dstPos + 2 * upsmpFactor, _mm_shuffle_epi32( before, 0xAA ), _mm_shuffle_epi32( diff, 0xAA ), vRound, log2UpsmpFactor, upsmpFactor );
+          simdMipInterpolate4( dstPos + 3 * upsmpFactor, _mm_shuffle_epi32( before, 0xFF ), _mm_shuffle_epi32( diff, 0xFF ), vRound, log2UpsmpFactor, upsmpFactor );
+        }
+      }
+
+      bndryLine += bndryStep;
+    }
+  }
+  else
+  {
+    CHECKD( srcStride != 1 || dstStride != 1 || bndryStep != 1, "Unsupported MIP upsampling layout" );
+    CHECKD( srcSizeOrthDim & 3, "Block width must be a multiple of 4." );
+
+    // the source rows may be located inside the destination block, every row is read before it is (re)written
+    for( SizeType idxUpsmpDim = 0; idxUpsmpDim < srcSizeUpsmpDim; idxUpsmpDim++ )
+    {
+      const int* beforeRow = idxUpsmpDim == 0 ? bndry : src + ( idxUpsmpDim - 1 ) * srcStep;
+      const int* behindRow = src + idxUpsmpDim * srcStep;
+      int*       dstRow    = dst + ( idxUpsmpDim << log2UpsmpFactor ) * dstStep;
+
+      SizeType x = 0;
+#ifdef USE_AVX2
+      if( vext >= AVX2 )
+      {
+        const __m256i vRound256 = _mm256_set1_epi32( roundingOffset );
+        for( ; x + 8 <= srcSizeOrthDim; x += 8 )
+        {
+          const __m256i before = _mm256_loadu_si256( ( const __m256i* ) ( beforeRow + x ) );
+          const __m256i diff   = _mm256_sub_epi32( _mm256_loadu_si256( ( const __m256i* ) ( behindRow + x ) ), before );
+          __m256i       acc    = _mm256_setzero_si256();
+          for( unsigned int pos = 0; pos < upsmpFactor; pos++ )
+          {
+            acc = _mm256_add_epi32( acc, diff );
+            const __m256i res = _mm256_add_epi32( before, _mm256_srai_epi32( _mm256_add_epi32( acc, vRound256 ), log2UpsmpFactor ) );
+            _mm256_storeu_si256( ( __m256i* ) ( dstRow + pos * dstStep + x ), res );
+          }
+        }
+      }
+#endif
+      for( ; x < srcSizeOrthDim; x += 4 )
+      {
+        const __m128i before = _mm_loadu_si128( ( const __m128i* ) ( beforeRow + x ) );
+        const __m128i diff   = _mm_sub_epi32( _mm_loadu_si128( ( const __m128i* ) ( behindRow + x ) ), before );
+        __m128i       acc    = _mm_setzero_si128();
+        for( unsigned int pos = 0; pos < upsmpFactor; pos++ )
+        {
+          acc = _mm_add_epi32( acc, diff );
+          const __m128i res = _mm_add_epi32( before, _mm_srai_epi32( _mm_add_epi32( acc, vRound ), log2UpsmpFactor ) );
+          _mm_storeu_si128( ( __m128i* ) ( dstRow + pos * dstStep + x ), res );
+        }
+      }
+    }
+  }
+}
+
+template <X86_VEXT vext>
+void MatrixIntraPrediction::_initMatrixIntraPredictionX86()
+{
+#if !RExt__HIGH_BIT_DEPTH_SUPPORT
+  m_mipMatrixMul    = simdMipMatrixMul<vext>;
+#endif
+  m_mipUpsampling1D = simdMipUpsampling1D<vext>;
+}
+
+template void MatrixIntraPrediction::_initMatrixIntraPredictionX86<SIMDX86>();
+
+#endif //#ifdef TARGET_SIMD_X86
+//! \}
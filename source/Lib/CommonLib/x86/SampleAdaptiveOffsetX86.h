@@ -0,0 +1,363 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2022, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/**
+ * \file
+ * \brief Implementation of SampleAdaptiveOffset class
+ */
+
+#include "CommonDefX86.h"
+#include "../SampleAdaptiveOffset.h"
+
+//! \ingroup CommonLib
+//! \{
+
+#ifdef TARGET_SIMD_X86
+
+#if !RExt__HIGH_BIT_DEPTH_SUPPORT
+// edge class of 8 samples, sgn(c - a) + sgn(c - b) + 2
+static inline __m128i simdSaoEdgeClass( const __m128i c, const __m128i a, const __m128i b )
+{
+  const __m128i signA = _mm_sub_epi16( _mm_cmpgt_epi16( a, c ), _mm_cmpgt_epi16( c, a ) );
+  const __m128i signB = _mm_sub_epi16( _mm_cmpgt_epi16( b, c ), _mm_cmpgt_epi16( c, b ) );
+  return _mm_add_epi16( _mm_add_epi16( signA, signB ), _mm_set1_epi16( 2 ) );
+}
+
+// looks up the 16-bit offsets of the edge classes, the table holds the offsets of the 5 edge classes
+static inline __m128i simdSaoLookupOffset( const __m128i edgeClass, const __m128i offsetTbl )
+{
+  const __m128i idx = _mm_add_epi16( _mm_mullo_epi16( edgeClass, _mm_set1_epi16( 0x0202 ) ), _mm_set1_epi16( 0x0100 ) );
+  return _mm_shuffle_epi8( offsetTbl, idx );
+}
+
+static inline void simdSaoOffsetEO8( const Pel* src, Pel* res, int neighbourA, int neighbourB, const __m128i offsetTbl,
+                                     const __m128i vMin, const __m128i vMax )
+{
+  const __m128i c = _mm_loadu_si128( ( const __m128i* ) src );
+  const __m128i a = _mm_loadu_si128( ( const __m128i* ) ( src + neighbourA ) );
+  const __m128i b = _mm_loadu_si128( ( const __m128i* ) ( src + neighbourB ) );
+
+  const __m128i off = simdSaoLookupOffset( simdSaoEdgeClass( c, a, b ), offsetTbl );
+  _mm_storeu_si128( ( __m128i* ) res, _mm_min_epi16( _mm_max_epi16( _mm_adds_epi16( c, off ), vMin ), vMax ) );
+}
+
+#ifdef USE_AVX2
+static inline __m256i simdSaoEdgeClass( const __m256i c, const __m256i a, const __m256i b )
+{
+  const __m256i signA = _mm256_sub_epi16( _mm256_cmpgt_epi16( a, c ), _mm256_cmpgt_epi16( c, a ) );
+  const __m256i signB = _mm256_sub_epi16( _mm256_cmpgt_epi16( b, c ), _mm256_cmpgt_epi16( c, b ) );
+  return _mm256_add_epi16( _mm256_add_epi16( signA, signB ), _mm256_set1_epi16( 2 ) );
+}
+
+static inline void simdSaoOffsetEO16( const Pel* src, Pel* res, int neighbourA, int neighbourB, const __m256i offsetTbl,
+                                      const __m256i vMin, const __m256i vMax )
+{
+  const __m256i c = _mm256_loadu_si256( ( const __m256i* ) src );
+  const __m256i a = _mm256_loadu_si256( ( const __m256i* ) ( src + neighbourA ) );
+  const __m256i b = _mm256_loadu_si256( ( const __m256i* ) ( src + neighbourB ) );
+
+  const __m256i idx = _mm256_add_epi16( _mm256_mullo_epi16( simdSaoEdgeClass( c, a, b ), _mm256_set1_epi16( 0x0202 ) ),
+                                        _mm256_set1_epi16( 0x0100 ) );
+  const __m256i off = _mm256_shuffle_epi8( offsetTbl, idx );
+  _mm256_storeu_si256( ( __m256i* ) res,
+                       _mm256_min_epi16( _mm256_max_epi16( _mm256_adds_epi16( c, off ), vMin ), vMax ) );
+}
+#endif
+
+// the last vector of a line overlaps the previous one instead of falling back to the scalar code, this is valid
+// since the result only depends on the source samples and the source and result buffers are distinct
+template<X86_VEXT vext>
+static void simdOffsetEOLines( const Pel* srcLine, Pel* resLine, int srcStride, int resStride, int startX, int endX,
+                               int numLines, int neighbourA, int neighbourB, const int* offset, const ClpRng& clpRng )
+{
+  if( endX <= startX )
+  {
+    return;
+  }
+
+  const __m128i offsetTbl = _mm_setr_epi16( offset[0], offset[1], offset[2], offset[3], offset[4], 0, 0, 0 );
+  const __m128i vMin      = _mm_set1_epi16( clpRng.min );
+  const __m128i vMax      = _mm_set1_epi16( clpRng.max );
+#ifdef USE_AVX2
+  const __m256i offsetTbl256 = _mm256_broadcastsi128_si256( offsetTbl );
+  const __m256i vMin256      = _mm256_set1_epi16( clpRng.min );
+  const __m256i vMax256      = _mm256_set1_epi16( clpRng.max );
+#endif
+  const int width = endX - startX;
+
+  for( int y = 0; y < numLines; y++ )
+  {
+    int x = startX;
+#ifdef USE_AVX2
+    if( vext >= AVX2 && width >= 16 )
+    {
+      for( ; x + 16 <= endX; x += 16 )
+      {
+        simdSaoOffsetEO16( srcLine + x, resLine + x, neighbourA, neighbourB, offsetTbl256, vMin256, vMax256 );
+      }
+      if( x < endX )
+      {
+        simdSaoOffsetEO16( srcLine + endX - 16, resLine + endX - 16, neighbourA, neighbourB, offsetTbl256, vMin256, vMax256 );
+        x = endX;
+      }
+    }
+#endif
+    if( width >= 8 )
+    {
+      for( ; x + 8 <= endX; x += 8 )
+      {
+        simdSaoOffsetEO8( srcLine + x, resLine + x, neighbourA, neighbourB, offsetTbl, vMin, vMax );
+      }
+      if( x < endX )
+      {
+        simdSaoOffsetEO8( srcLine + endX - 8, resLine + endX - 8, neighbourA, neighbourB, offsetTbl, vMin, vMax );
+        x = endX;
+      }
+    }
+    for( ; x < endX; x++ )
+    {
+      const int edgeType = sgn( srcLine[x] - srcLine[x + neighbourA] ) + sgn( srcLine[x] - srcLine[x + neighbourB] ) + 2;
+      resLine[x] = ClipPel<int>( srcLine[x] + offset[edgeType], clpRng );
+    }
+    srcLine += srcStride;
+    resLine += resStride;
+  }
+}
+
+// only the (up to 4) bands with a non-zero offset are tested for each sample
+template<X86_VEXT vext>
+static void simdOffsetBOBlock( const Pel* srcBlk, Pel* resBlk, int srcStride, int resStride, int width, int height,
+                               int shiftBits, const int* offset, const ClpRng& clpRng )
+{
+  int bandIdx[NUM_SAO_BO_CLASSES];
+  int numBands = 0;
+  for( int i = 0; i < NUM_SAO_BO_CLASSES; i++ )
+  {
+    if( offset[i] != 0 )
+    {
+      bandIdx[numBands++] = i;
+    }
+  }
+
+  if( width < 8 )
+  {
+    for( int y = 0; y < height; y++ )
+    {
+      for( int x = 0; x < width; x++ )
+      {
+        resBlk[x] = ClipPel<int>( srcBlk[x] + offset[srcBlk[x] >> shiftBits], clpRng );
+      }
+      srcBlk += srcStride;
+      resBlk += resStride;
+    }
+    return;
+  }
+
+  const __m128i vShift = _mm_cvtsi32_si128( shiftBits );
+  const __m128i vMin   = _mm_set1_epi16( clpRng.min );
+  const __m128i vMax   = _mm_set1_epi16( clpRng.max );
+  __m128i vBand  [NUM_SAO_BO_CLASSES];
+  __m128i vOffset[NUM_SAO_BO_CLASSES];
+  for( int i = 0; i < numBands; i++ )
+  {
+    vBand  [i] = _mm_set1_epi16( bandIdx[i] );
+    vOffset[i] = _mm_set1_epi16( offset[bandIdx[i]] );
+  }
+
+#ifdef USE_AVX2
+  if( vext >= AVX2 && width >= 16 )
+  {
+    const __m256i vMin256 = _mm256_set1_epi16( clpRng.min );
+    const __m256i vMax256 = _mm256_set1_epi16( clpRng.max );
+    __m256i vBand256  [NUM_SAO_BO_CLASSES];
+    __m256i vOffset256[NUM_SAO_BO_CLASSES];
+    for( int i = 0; i < numBands; i++ )
+    {
+      vBand256  [i] = _mm256_set1_epi16( bandIdx[i] );
+      vOffset256[i] = _mm256_set1_epi16( offset[bandIdx[i]] );
+    }
+
+    for( int y = 0; y < height; y++ )
+    {
+      for( int x = 0; x < width; x += 16 )
+      {
+        const int      pos  = std::min( x, width - 16 );
+        const __m256i  src  = _mm256_loadu_si256( ( const __m256i* ) ( srcBlk + pos ) );
+        const __m256i  band = _mm256_sra_epi16( src, vShift );
+        __m256i        sum  = src;
+        for( int i = 0; i < numBands; i++ )
+        {
+          sum = _mm256_adds_epi16( sum, _mm256_and_si256( _mm256_cmpeq_epi16( band, vBand256[i] ), vOffset256[i] ) );
+        }
+        _mm256_storeu_si256( ( __m256i* ) ( resBlk + pos ), _mm256_min_epi16( _mm256_max_epi16( sum, vMin256 ), vMax256 ) );
+      }
+      srcBlk += srcStride;
+      resBlk += resStride;
+    }
+    return;
+  }
+#endif
+
+  for( int y = 0; y < height; y++ )
+  {
+    for( int x = 0; x < width; x += 8 )
+    {
+      const int      pos  = std::min( x, width - 8 );
+      const __m128i  src  = _mm_loadu_si128( ( const __m128i* ) ( srcBlk + pos ) );
+      const __m128i  band = _mm_sra_epi16( src, vShift );
+      __m128i        sum  = src;
+      for( int i = 0; i < numBands; i++ )
+      {
+        sum = _mm_adds_epi16( sum, _mm_and_si128( _mm_cmpeq_epi16( band, vBand[i] ), vOffset[i] ) );
+      }
+      _mm_storeu_si128( ( __m128i* ) ( resBlk + pos ), _mm_min_epi16( _mm_max_epi16( sum, vMin ), vMax ) );
+    }
+    srcBlk += srcStride;
+    resBlk += resStride;
+  }
+}
+
+// the differences are accumulated per edge class in 32-bit lanes and the counts in 16-bit lanes, which cannot
+// overflow for blocks of up to CTU size
+template<X86_VEXT vext>
+static void simdCalcEOStatsLines( const Pel* srcLine, const Pel* orgLine, int srcStride, int orgStride, int startX,
+                                  int endX, int numLines, int neighbourA, int neighbourB, int64_t* diff, int64_t* count )
+{
+  if( endX <= startX || numLines <= 0 )
+  {
+    return;
+  }
+
+  const __m128i ones = _mm_set1_epi16( 1 );
+  __m128i diffAcc [NUM_SAO_EO_CLASSES];
+  __m128i countAcc[NUM_SAO_EO_CLASSES];
+  for( int k = 0; k < NUM_SAO_EO_CLASSES; k++ )
+  {
+    diffAcc [k] = _mm_setzero_si128();
+    countAcc[k] = _mm_setzero_si128();
+  }
+#ifdef USE_AVX2
+  const __m256i ones256 = _mm256_set1_epi16( 1 );
+  __m256i diffAcc256 [NUM_SAO_EO_CLASSES];
+  __m256i countAcc256[NUM_SAO_EO_CLASSES];
+  for( int k = 0; k < NUM_SAO_EO_CLASSES; k++ )
+  {
+    diffAcc256 [k] = _mm256_setzero_si256();
+    countAcc256[k] = _mm256_setzero_si256();
+  }
+#endif
+
+  for( int y = 0; y < numLines; y++ )
+  {
+    int x = startX;
+#ifdef USE_AVX2
+    if( vext >= AVX2 )
+    {
+      for( ; x + 16 <= endX; x += 16 )
+      {
+        const __m256i c = _mm256_loadu_si256( ( const __m256i* ) ( srcLine + x ) );
+        const __m256i a = _mm256_loadu_si256( ( const __m256i* ) ( srcLine + x + neighbourA ) );
+        const __m256i b = _mm256_loadu_si256( ( const __m256i* ) ( srcLine + x + neighbourB ) );
+        const __m256i o = _mm256_loadu_si256( ( const __m256i* ) ( orgLine + x ) );
+
+        const __m256i edgeClass = simdSaoEdgeClass( c, a, b );
+        const __m256i d         = _mm256_sub_epi16( o, c );
+        for( int k = 0; k < NUM_SAO_EO_CLASSES; k++ )
+        {
+          const __m256i mask = _mm256_cmpeq_epi16( edgeClass, _mm256_set1_epi16( k ) );
+          diffAcc256 [k] = _mm256_add_epi32( diffAcc256[k], _mm256_madd_epi16( _mm256_and_si256( d, mask ), ones256 ) );
+          countAcc256[k] = _mm256_sub_epi16( countAcc256[k], mask );
+        }
+      }
+    }
+#endif
+    for( ; x + 8 <= endX; x += 8 )
+    {
+      const __m128i c = _mm_loadu_si128( ( const __m128i* ) ( srcLine + x ) );
+      const __m128i a = _mm_loadu_si128( ( const __m128i* ) ( srcLine + x + neighbourA ) );
+      const __m128i b = _mm_loadu_si128( ( const __m128i* ) ( srcLine + x + neighbourB ) );
+      const __m128i o = _mm_loadu_si128( ( const __m128i* ) ( orgLine + x ) );
+
+      const __m128i edgeClass = simdSaoEdgeClass( c, a, b );
+      const __m128i d         = _mm_sub_epi16( o, c );
+      for( int k = 0; k < NUM_SAO_EO_CLASSES; k++ )
+      {
+        const __m128i mask = _mm_cmpeq_epi16( edgeClass, _mm_set1_epi16( k ) );
+        diffAcc [k] = _mm_add_epi32( diffAcc[k], _mm_madd_epi16( _mm_and_si128( d, mask ), ones ) );
+        countAcc[k] = _mm_sub_epi16( countAcc[k], mask );
+      }
+    }
+    for( ; x < endX; x++ )
+    {
+      const int edgeType = sgn( srcLine[x] - srcLine[x + neighbourA] ) + sgn( srcLine[x] - srcLine[x + neighbourB] ) + 2;
+      diff [edgeType] += ( orgLine[x] - srcLine[x] );
+      count[edgeType] ++;
+    }
+    srcLine += srcStride;
+    orgLine += orgStride;
+  }
+
+  for( int k = 0; k < NUM_SAO_EO_CLASSES; k++ )
+  {
+#ifdef USE_AVX2
+    diffAcc [k] = _mm_add_epi32( diffAcc[k], _mm_add_epi32( _mm256_castsi256_si128( diffAcc256[k] ),
+                                                             _mm256_extracti128_si256( diffAcc256[k], 1 ) ) );
+    const __m256i cnt256 = _mm256_madd_epi16( countAcc256[k], ones256 );
+    __m128i       cnt    = _mm_add_epi32( _mm256_castsi256_si128( cnt256 ), _mm256_extracti128_si256( cnt256, 1 ) );
+    cnt = _mm_add_epi32( cnt, _mm_madd_epi16( countAcc[k], ones ) );
+#else
+    __m128i cnt = _mm_madd_epi16( countAcc[k], ones );
+#endif
+    __m128i sum = _mm_hadd_epi32( diffAcc[k], cnt );
+    sum         = _mm_hadd_epi32( sum, sum );
+    diff [k] += _mm_cvtsi128_si32( sum );
+    count[k] += _mm_extract_epi32( sum, 1 );
+  }
+}
+#endif
+
+template <X86_VEXT vext>
+void SampleAdaptiveOffset::_initSampleAdaptiveOffsetX86()
+{
+#if !RExt__HIGH_BIT_DEPTH_SUPPORT
+  m_offsetEOLines    = simdOffsetEOLines<vext>;
+  m_offsetBOBlock    = simdOffsetBOBlock<vext>;
+  m_calcEOStatsLines = simdCalcEOStatsLines<vext>;
+#endif
+}
+
+template void SampleAdaptiveOffset::_initSampleAdaptiveOffsetX86<SIMDX86>();
+
+#endif //#ifdef TARGET_SIMD_X86
+//! \}
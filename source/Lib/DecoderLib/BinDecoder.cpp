@@ -46,6 +46,9 @@
 
 #define CNT_OFFSET 0
 
+// m_Value keeps the 9 bit arithmetic offset at bits 62..54 and up to 54 bits read ahead below it, bit 63 is the
+// headroom for the doubling of the offset in bypass decoding
+static constexpr int VALUE_SHIFT = 54;
 
 
 template <class BinProbModel>
@@ -54,7 +57,7 @@ BinDecoderBase::BinDecoderBase( const BinProbModel* dummy )
   , m_Bitstream ( 0 )
   , m_Range     ( 0 )
   , m_Value     ( 0 )
-  , m_bitsNeeded( 0 )
+  , m_bitsAvail ( 0 )
 {}
 
 
@@ -70,6 +73,22 @@ void BinDecoderBase::uninit()
 }
 
 
+/** fills the free bits below the ones read ahead with up to 8 bytes of the bitstream at once
+ */
+inline void BinDecoderBase::xRefill()
+{
+  const int freeBits = VALUE_SHIFT - m_bitsAvail;
+  uint32_t  numBytes = freeBits >> 3;
+  const uint64_t bytes = m_Bitstream->readBytes( numBytes );
+  CHECK( m_bitsAvail + 8 * int( numBytes ) < 0, "FIFO exceeded" );
+  if( numBytes )
+  {
+    m_Value     |= bytes << ( freeBits - 8 * numBytes );
+    m_bitsAvail += 8 * numBytes;
+  }
+}
+
+
 void BinDecoderBase::start()
 {
   CHECK( m_Bitstream->getNumBitsUntilByteAligned(), "Bitstream is not byte aligned." );
@@ -77,16 +96,21 @@ void BinDecoderBase::start()
   CodingStatistics::UpdateCABACStat(STATS__CABAC_INITIALISATION, 512, 510, 0);
 #endif
   m_Range       = 510;
-  m_Value       = ( m_Bitstream->readByte() << 8 ) + m_Bitstream->readByte();
-  m_bitsNeeded  = -8;
+  m_Value       = 0;
+  m_bitsAvail   = -9;
+  xRefill();
 }
 
 
 void BinDecoderBase::finish()
 {
+  // hand the whole bytes that were read ahead back to the bitstream
+  m_Bitstream->unreadBytes( m_bitsAvail >> 3 );
+  m_bitsAvail &= 7;
+
   unsigned lastByte;
   m_Bitstream->peekPreviousByte( lastByte );
-  CHECK( ( ( lastByte << ( 8 + m_bitsNeeded ) ) & 0xff ) != 0x80,
+  CHECK( ( ( lastByte << ( 7 - m_bitsAvail ) ) & 0xff ) != 0x80,
         "No proper stop/alignment pattern at end of CABAC stream." );
 }
 
@@ -105,14 +129,13 @@ void BinDecoderBase::riceStatReset(int bitDepth, bool persistentRiceAdaptationEn
 unsigned BinDecoderBase::decodeBinEP()
 {
   m_Value            += m_Value;
-  if( ++m_bitsNeeded >= 0 )
+  if( --m_bitsAvail < 0 )
   {
-    m_Value          += m_Bitstream->readByte();
-    m_bitsNeeded      = -8;
+    xRefill();
   }
 
-  unsigned bin = 0;
-  unsigned SR  = m_Range << 7;
+  unsigned       bin = 0;
+  const uint64_t SR  = uint64_t( m_Range ) << VALUE_SHIFT;
   if( m_Value >= SR )
   {
     m_Value   -= SR;
@@ -126,6 +149,10 @@ unsigned BinDecoderBase::decodeBinEP()
 }
 
 
+/** decodes a run of bypass bins from the bits read ahead, short runs bin by bin, longer ones with one division:
+ *  doubling the offset and subtracting the range once per bin is the long division of the offset followed by the
+ *  next numBins bits by the range
+ */
 unsigned BinDecoderBase::decodeBinsEP( unsigned numBins )
 {
 #if ENABLE_TRACING
@@ -138,39 +165,38 @@ unsigned BinDecoderBase::decodeBinsEP( unsigned numBins )
   }
   unsigned remBins = numBins;
   unsigned bins    = 0;
-  while(   remBins > 8 )
+  while(   remBins > 0 )
   {
-    m_Value     = ( m_Value << 8 ) + ( m_Bitstream->readByte() << ( 8 + m_bitsNeeded ) );
-    unsigned SR =   m_Range << 15;
-    for( int i = 0; i < 8; i++ )
+    // the offset and the bins of a chunk fit into 32 bits
+    const unsigned n = std::min<unsigned>( remBins, 32 - 1 - 9 );
+    if( m_bitsAvail < int( n ) )
     {
-      bins += bins;
-      SR  >>= 1;
-      if( m_Value >= SR )
+      xRefill();
+      CHECK( m_bitsAvail < int( n ), "FIFO exceeded" );
+    }
+    if( n <= 8 )
+    {
+      const uint64_t SR = uint64_t( m_Range ) << VALUE_SHIFT;
+      for( unsigned i = 0; i < n; i++ )
       {
-        bins    ++;
-        m_Value -= SR;
+        m_Value += m_Value;
+        bins    += bins;
+        if( m_Value >= SR )
+        {
+          bins    ++;
+          m_Value -= SR;
+        }
       }
     }
-    remBins -= 8;
-  }
-  m_bitsNeeded   += remBins;
-  m_Value       <<= remBins;
-  if( m_bitsNeeded >= 0 )
-  {
-    m_Value      += m_Bitstream->readByte() << m_bitsNeeded;
-    m_bitsNeeded -= 8;
-  }
-  unsigned SR = m_Range << ( remBins + 7 );
-  for ( int i = 0; i < remBins; i++ )
-  {
-    bins += bins;
-    SR  >>= 1;
-    if( m_Value >= SR )
+    else
     {
-      bins    ++;
-      m_Value -= SR;
+      const uint32_t offset = uint32_t( m_Value >> ( VALUE_SHIFT - n ) );
+      const uint32_t quot   = offset / m_Range;
+      bins    = ( bins << n ) | quot;
+      m_Value = ( uint64_t( offset - quot * m_Range ) << VALUE_SHIFT ) | ( ( m_Value << ( 10 + n ) ) >> 10 );
     }
+    m_bitsAvail -= n;
+    remBins     -= n;
   }
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
   CodingStatistics::IncrementStatisticEP( *ptype, numBins, int(bins) );
@@ -188,13 +214,30 @@ unsigned BinDecoderBase::decodeRemAbsEP(unsigned goRicePar, unsigned cutoff, int
 {
   unsigned prefix = 0;
   {
+    // the unary prefix is decoded from the bits read ahead without a refill per bin
     const unsigned  maxPrefix = 32 - maxLog2TrDynamicRange;
+    if( m_bitsAvail < int( maxPrefix ) )
+    {
+      xRefill();
+    }
+    const uint64_t  SR       = uint64_t( m_Range ) << VALUE_SHIFT;
     unsigned        codeWord = 0;
     do
     {
       prefix++;
-      codeWord = decodeBinEP();
+      m_Value += m_Value;
+      codeWord = m_Value >= SR;
+      if( codeWord )
+      {
+        m_Value -= SR;
+      }
+#if RExt__DECODER_DEBUG_BIT_STATISTICS
+      CodingStatistics::IncrementStatisticEP( *ptype, 1, int(codeWord) );
+#endif
+      DTRACE( g_trace_ctx, D_CABAC, "%d" "  " "%d" "  EP=%d \n",  DTRACE_GET_COUNTER( g_trace_ctx, D_CABAC ), m_Range, codeWord );
     } while (codeWord && prefix < maxPrefix);
+    m_bitsAvail -= prefix;
+    CHECK( m_bitsAvail < 0, "FIFO exceeded" );
     prefix -= 1 - codeWord;
   }
 
@@ -216,13 +259,13 @@ unsigned BinDecoderBase::decodeRemAbsEP(unsigned goRicePar, unsigned cutoff, int
 
 unsigned BinDecoderBase::decodeBinTrm()
 {
-  m_Range    -= 2;
-  unsigned SR = m_Range << 7;
+  m_Range          -= 2;
+  const uint64_t SR = uint64_t( m_Range ) << VALUE_SHIFT;
   if( m_Value >= SR )
   {
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
     CodingStatistics::UpdateCABACStat     ( STATS__CABAC_TRM_BITS,       m_Range+2, 2, 1 );
-    CodingStatistics::IncrementStatisticEP( STATS__BYTE_ALIGNMENT_BITS, -m_bitsNeeded, 0 );
+    CodingStatistics::IncrementStatisticEP( STATS__BYTE_ALIGNMENT_BITS, ( m_bitsAvail & 7 ) + 1, 0 );
 #endif
     return 1;
   }
@@ -235,10 +278,9 @@ unsigned BinDecoderBase::decodeBinTrm()
     {
       m_Range += m_Range;
       m_Value += m_Value;
-      if( ++m_bitsNeeded == 0 )
+      if( --m_bitsAvail < 0 )
       {
-        m_Value      += m_Bitstream->readByte();
-        m_bitsNeeded  = -8;
+        xRefill();
       }
     }
     return 0;
@@ -266,26 +308,22 @@ unsigned BinDecoderBase::decodeAlignedBinsEP( unsigned numBins )
   unsigned bins    = 0;
   while(   remBins > 0 )
   {
-    // The MSB of m_Value is known to be 0 because range is 256. Therefore:
-    //   > The comparison against the symbol range of 128 is simply a test on the next-most-significant bit
-    //   > "Subtracting" the symbol range if the decoded bin is 1 simply involves clearing that bit.
-    //  As a result, the required bins are simply the <binsToRead> next-most-significant bits of m_Value
-    //  (m_Value is stored MSB-aligned in a 16-bit buffer - hence the shift of 15)
+    // With a range of 256 the offset has 8 bits and the division by the range of the general case is a shift:
+    // the bins are the offset followed by the next bits without its lower 8 bits, which remain as the offset
     //
-    //    m_Value = |0|V|V|V|V|V|V|V|V|B|B|B|B|B|B|B|        (V = usable bit, B = potential buffered bit (buffer refills when m_bitsNeeded >= 0))
+    //    m_Value = |0|0|O|O|O|O|O|O|O|O|B|B|B|B|...        (O = offset bit, B = bit read ahead)
     //
-    unsigned binsToRead = std::min<unsigned>( remBins, 8 ); //read bytes if able to take advantage of the system's byte-read function
-    unsigned binMask    = ( 1 << binsToRead ) - 1;
-    unsigned newBins    = ( m_Value >> (15 - binsToRead) ) & binMask;
-    bins                = ( bins    << binsToRead) | newBins;
-    m_Value             = ( m_Value << binsToRead) & 0x7FFF;
-    remBins            -= binsToRead;
-    m_bitsNeeded       += binsToRead;
-    if( m_bitsNeeded >= 0 )
+    const unsigned binsToRead = std::min<unsigned>( remBins, 32 );
+    if( m_bitsAvail < int( binsToRead ) )
     {
-      m_Value          |= m_Bitstream->readByte() << m_bitsNeeded;
-      m_bitsNeeded     -= 8;
+      xRefill();
+      CHECK( m_bitsAvail < int( binsToRead ), "FIFO exceeded" );
     }
+    const uint64_t offset = m_Value >> ( VALUE_SHIFT - binsToRead );
+    bins        = unsigned( ( uint64_t( bins ) << binsToRead ) | ( offset >> 8 ) );
+    m_Value     = ( ( offset & 0xff ) << VALUE_SHIFT ) | ( ( m_Value << ( 10 + binsToRead ) ) >> 10 );
+    m_bitsAvail-= binsToRead;
+    remBins    -= binsToRead;
   }
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
   CodingStatistics::IncrementStatisticEP( *ptype, numBins, int(bins) );
@@ -316,11 +354,11 @@ unsigned TBinDecoder<BinProbModel>::decodeBin( unsigned ctxId )
   unsigned      bin         = rcProbModel.mps();
   uint32_t      LPS         = rcProbModel.getLPS( m_Range );
 
-  DTRACE( g_trace_ctx, D_CABAC, "%d" " %d " "%d" "  " "[%d:%d]" "  " "%2d(MPS=%d)"  "  " , DTRACE_GET_COUNTER( g_trace_ctx, D_CABAC ), ctxId, m_Range, m_Range-LPS, LPS, ( unsigned int )( rcProbModel.state() ), m_Value < ( ( m_Range - LPS ) << 7 ) );
+  DTRACE( g_trace_ctx, D_CABAC, "%d" " %d " "%d" "  " "[%d:%d]" "  " "%2d(MPS=%d)"  "  " , DTRACE_GET_COUNTER( g_trace_ctx, D_CABAC ), ctxId, m_Range, m_Range-LPS, LPS, ( unsigned int )( rcProbModel.state() ), m_Value < ( uint64_t( m_Range - LPS ) << VALUE_SHIFT ) );
   //DTRACE( g_trace_ctx, D_CABAC, " %d " "%d" "  " "[%d:%d]" "  " "%2d(MPS=%d)"  "  ", DTRACE_GET_COUNTER( g_trace_ctx, D_CABAC ), m_Range, m_Range - LPS, LPS, (unsigned int)( rcProbModel.state() ), m_Value < ( ( m_Range - LPS ) << 7 ) );
 
   m_Range   -=  LPS;
-  uint32_t      SR          = m_Range << 7;
+  const uint64_t SR         = uint64_t( m_Range ) << VALUE_SHIFT;
   if( m_Value < SR )
   {
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
@@ -332,11 +370,10 @@ unsigned TBinDecoder<BinProbModel>::decodeBin( unsigned ctxId )
       int numBits   = rcProbModel.getRenormBitsRange( m_Range );
       m_Range     <<= numBits;
       m_Value     <<= numBits;
-      m_bitsNeeded += numBits;
-      if( m_bitsNeeded >= 0 )
+      m_bitsAvail  -= numBits;
+      if( m_bitsAvail < 0 )
       {
-        m_Value      += m_Bitstream->readByte() << m_bitsNeeded;
-        m_bitsNeeded -= 8;
+        xRefill();
       }
     }
   }
@@ -346,16 +383,14 @@ unsigned TBinDecoder<BinProbModel>::decodeBin( unsigned ctxId )
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
     CodingStatistics::UpdateCABACStat( *ptype, m_Range+LPS, LPS, int( bin ) );
 #endif
-    // LPS path
-    int numBits   = rcProbModel.getRenormBitsLPS( LPS );
-    m_Value      -= SR;
-    m_Value       = m_Value << numBits;
-    m_Range       = LPS     << numBits;
-    m_bitsNeeded += numBits;
-    if( m_bitsNeeded >= 0 )
+    // LPS path, renormalized to a range of at least 256 by the leading zero count of the LPS range
+    int numBits   = 8 - floorLog2( LPS );
+    m_Value       = ( m_Value - SR ) << numBits;
+    m_Range       = LPS << numBits;
+    m_bitsAvail  -= numBits;
+    if( m_bitsAvail < 0 )
     {
-      m_Value      += m_Bitstream->readByte() << m_bitsNeeded;
-      m_bitsNeeded -= 8;
+      xRefill();
     }
   }
   rcProbModel.update( bin );
@@ -367,4 +402,3 @@ unsigned TBinDecoder<BinProbModel>::decodeBin( unsigned ctxId )
 
 
 template class TBinDecoder<BinProbModel_Std>;
-
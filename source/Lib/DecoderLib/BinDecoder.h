@@ -75,14 +75,16 @@ public:
   unsigned          decodeRemAbsEP      ( unsigned goRicePar, unsigned cutoff, int maxLog2TrDynamicRange );
   unsigned          decodeBinTrm        ();
   void              align               ();
-  unsigned          getNumBitsRead      () { return m_Bitstream->getNumBitsRead() + m_bitsNeeded; }
+  unsigned          getNumBitsRead      () { return m_Bitstream->getNumBitsRead() - m_bitsAvail - 1; }
 private:
   unsigned          decodeAlignedBinsEP ( unsigned numBins  );
+protected:
+  void              xRefill             ();
 protected:
   InputBitstream*   m_Bitstream;
   uint32_t          m_Range;
-  uint32_t          m_Value;
-  int32_t           m_bitsNeeded;
+  uint64_t          m_Value;        ///< 9 bit arithmetic offset at bit VALUE_SHIFT, followed by the bits read ahead
+  int32_t           m_bitsAvail;    ///< number of bits read ahead below the offset
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
   const CodingStatisticsClassType* ptype;
 #endif
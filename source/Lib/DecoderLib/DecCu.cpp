@@ -606,8 +606,50 @@ void DecCu::xIntraRecACTQT(CodingUnit &cu)
 
 #include "CommonLib/dtrace_buffer.h"
 
+/** Blocks until the CTU rows of pending reference pictures that the CU predicts from are final
+ */
+void DecCu::xWaitForRefPics( const CodingUnit& cu )
+{
+  const Slice& slice    = *cu.slice;
+  const int    lastRow  = cu.cs->pcv->heightInCtus - 1;
+  const int    ctuShift = cu.cs->pcv->maxCUHeightLog2;
+  // sub-block and GEO motion is not known per PU up front, those wait for the whole picture
+  const bool   wholePic = cu.geoFlag || cu.affine || cu.firstPU->mergeType != MRG_TYPE_DEFAULT_N;
+
+  for( int l = 0; l < NUM_REF_PIC_LIST_01; l++ )
+  {
+    const RefPicList refList = RefPicList( l );
+    for( int refIdx = 0; refIdx < slice.getNumRefIdx( refList ); refIdx++ )
+    {
+      Picture* refPic = slice.getRefPic( refList, refIdx );
+      if( !refPic->loopFilterPending )
+      {
+        continue;
+      }
+      int row = cu.geoFlag ? lastRow : -1;
+      for( const auto &pu : CU::traversePUs( cu ) )
+      {
+        if( row < lastRow && pu.refIdx[refList] == refIdx )
+        {
+          const int bottom = pu.lumaPos().y + pu.lumaSize().height + ( pu.mv[refList].getVer() >> MV_FRACTIONAL_BITS_INTERNAL ) + MC_REF_ROW_MARGIN;
+          row = wholePic ? lastRow : std::max( row, Clip3( 0, lastRow, bottom >> ctuShift ) );
+        }
+      }
+      if( row >= 0 )
+      {
+        refPic->filteredCtuRows.waitFor( row + 1 );
+      }
+    }
+  }
+}
+
 void DecCu::xReconInter(CodingUnit &cu)
 {
+  if( !CU::isIBC( cu ) )
+  {
+    xWaitForRefPics( cu );
+  }
+
   if( cu.geoFlag )
   {
     m_pcInterPred->motionCompensationGeo( cu, m_geoMrgCtx );
@@ -79,6 +79,7 @@ protected:
   void xIntraRecACTQT(CodingUnit&      cu);
 
   void xReconInter        ( CodingUnit&      cu );
+  void xWaitForRefPics    ( const CodingUnit& cu );
   void xDecodeInterTexture( CodingUnit&      cu );
   void xReconIntraQT      ( CodingUnit&      cu );
 
@@ -428,6 +428,12 @@ DecLib::DecLib()
   , m_HLSReader()
   , m_seiReader()
   , m_deblockingFilter()
+  , m_frameParallelDecoding(false)
+  , m_loopFilterPic(nullptr)
+  , m_loopFilterPicFinished(false)
+  , m_loopFilterPicType(' ')
+  , m_loopFilterPicMsgl(INFO)
+  , m_loopFilterPcv(nullptr)
   , m_cSAO()
   , m_cReshaper()
 #if JVET_J0090_MEMORY_BANDWITH_MEASURE
@@ -542,7 +548,61 @@ void DecLib::destroy()
     m_opi = nullptr;
   }
 
+  finishLoopFilters();
+
   m_cSliceDecoder.destroy();
+  m_loopFilterThreadPool.destroy();
+  m_filterThreadPool.destroy();
+  m_threadPool.destroy();
+}
+
+void DecLib::setNumThreads( int numThreads )
+{
+  CHECK( numThreads < 0, "Invalid number of threads" );
+  m_threadPool.create( numThreads );
+  m_deblockingFilter.setThreadPool( &m_threadPool );
+  m_cSAO.setThreadPool( &m_threadPool );
+  m_cALF.setThreadPool( &m_threadPool );
+  m_cSliceDecoder.setThreadPool( &m_threadPool );
+}
+
+void DecLib::setFrameParallelDecoding( bool b )
+{
+  m_frameParallelDecoding = b && m_threadPool.getNumThreads() > 0;
+  if( m_frameParallelDecoding )
+  {
+    // SAO and ALF get their own workers, a wait of the stage on the shared pool would also wait for the next picture
+    m_filterThreadPool.create( m_threadPool.getNumThreads() );
+    m_loopFilterThreadPool.create( 1 );
+    m_cSAO.setThreadPool( &m_filterThreadPool );
+    m_cALF.setThreadPool( &m_filterThreadPool );
+  }
+}
+
+void DecLib::finishLoopFilters( const Picture* pic )
+{
+  if( m_loopFilterPic == nullptr || ( pic != nullptr && pic != m_loopFilterPic ) )
+  {
+    return;
+  }
+
+  m_loopFilterThreadPool.waitForJobs();
+
+  Picture* loopFilterPic = m_loopFilterPic;
+  m_loopFilterPic = nullptr;
+  loopFilterPic->loopFilterPending = false;
+  delete m_loopFilterPcv;
+  m_loopFilterPcv = nullptr;
+
+  if( m_loopFilterPicFinished )
+  {
+    xPrintPictureSummary( loopFilterPic, m_loopFilterPicType, m_loopFilterPicMsgl );
+
+    loopFilterPic->destroyTempBuffers();
+    loopFilterPic->cs->destroyCoeffs();
+    loopFilterPic->cs->releaseIntermediateData();
+    m_loopFilterPicFinished = false;
+  }
 }
 
 void DecLib::init(
@@ -551,7 +611,7 @@ void DecLib::init(
 #endif
 )
 {
-  m_cSliceDecoder.init( &m_CABACDecoder, &m_cCuDecoder );
+  m_cSliceDecoder.init( &m_CABACDecoder, &m_cCuDecoder, &m_cTrQuant, &m_deblockingFilter );
 #if JVET_J0090_MEMORY_BANDWITH_MEASURE
   m_cacheModel.create( cacheCfgFileName );
   m_cacheModel.clear( );
@@ -562,6 +622,8 @@ void DecLib::init(
 
 void DecLib::deletePicBuffer ( )
 {
+  finishLoopFilters();
+
   PicList::iterator  iterPic   = m_cListPic.begin();
   int                size      = int(m_cListPic.size());
 
@@ -644,6 +706,9 @@ Picture* DecLib::xGetNewPicBuffer( const SPS &sps, const PPS &pps, const uint32_
   }
   else
   {
+    // the reused picture may still be filtered in the background
+    finishLoopFilters( pcPic );
+
     if( !pcPic->Y().Size::operator==( Size( pps.getPicWidthInLumaSamples(), pps.getPicHeightInLumaSamples() ) ) || pps.pcv->maxCUWidth != sps.getMaxCUWidth() || pps.pcv->maxCUHeight != sps.getMaxCUHeight() || pcPic->layerId != layerId )
     {
       pcPic->destroy();
@@ -678,14 +743,20 @@ void DecLib::executeLoopFilters()
     return; // nothing to deblock
   }
 
+  // SAO and ALF of the previous picture use the same filter objects
+  finishLoopFilters();
+
   m_pcPic->cs->slice->startProcessingTimer();
 
   CodingStructure& cs = *m_pcPic->cs;
 
+  // the pipelined decoding of a single slice picture already applied the inverse mapping and the deblocking filter
+  const bool picDeblocked = m_cSliceDecoder.getPicDeblocked();
+
   if (cs.sps->getUseLmcs() && cs.picHeader->getLmcsEnabledFlag())
   {
     const PreCalcValues &pcv = *cs.pcv;
-    for (uint32_t yPos = 0; yPos < pcv.lumaHeight; yPos += pcv.maxCUHeight)
+    for (uint32_t yPos = 0; yPos < pcv.lumaHeight && !picDeblocked; yPos += pcv.maxCUHeight)
     {
       for (uint32_t xPos = 0; xPos < pcv.lumaWidth; xPos += pcv.maxCUWidth)
       {
@@ -703,16 +774,71 @@ void DecLib::executeLoopFilters()
     m_cSAO.setReshaper(&m_cReshaper);
   }
   // deblocking filter
-  m_deblockingFilter.deblockingFilterPic( cs );
+  if( !picDeblocked )
+  {
+    m_deblockingFilter.deblockingFilterPic( cs );
+  }
   CS::setRefinedMotionField(cs);
-  if( cs.sps->getSAOEnabledFlag() )
+
+  // in frame-parallel decoding SAO, ALF and the border padding run in the background, the next picture waits for
+  // the CTU rows it references; pictures whose references are rescaled, wrapped or padded per subpicture do not
+  const bool background = m_frameParallelDecoding && picDeblocked && !cs.pps->getWrapAroundEnabledFlag()
+                          && ( cs.vps == nullptr || cs.vps->getMaxLayers() == 1 );
+  if( background )
+  {
+    Picture* pic = m_pcPic;
+    pic->loopFilterPending = true;
+    pic->filteredCtuRows.reset();
+    pic->setBorderExtension( true );   // padded by the stage, not when the reference lists are constructed
+    m_loopFilterPic         = pic;
+    m_loopFilterPicFinished = false;
+
+    m_loopFilterThreadPool.addJob( [this, pic]( int )
+    {
+      CodingStructure& cs = *pic->cs;
+      xApplySaoAndAlf( cs );
+      pic->padPicBorder( cs.pps );
+      pic->filteredCtuRows.set( cs.pcv->heightInCtus );
+      pic->slices[0]->stopProcessingTimer();
+    } );
+    return;
+  }
+
+  xApplySaoAndAlf( cs );
+
+  m_pcPic->cs->slice->stopProcessingTimer();
+}
+
+/** applies SAO and ALF to the deblocked picture and masks the subpictures that are not decoded
+ */
+void DecLib::xApplySaoAndAlf( CodingStructure& cs )
+{
+  const SPS* sps = cs.sps;
+  const PPS* pps = cs.pps;
+
+  if( sps->getSAOEnabledFlag() )
   {
+    const int       maxDepth                 = floorLog2(sps->getMaxCUWidth()) - cs.pcv->minCUWidthLog2;
+    const uint32_t  log2SaoOffsetScaleLuma   = (uint32_t) std::max(0, sps->getBitDepth(CHANNEL_TYPE_LUMA  ) - MAX_SAO_TRUNCATED_BITDEPTH);
+    const uint32_t  log2SaoOffsetScaleChroma = (uint32_t) std::max(0, sps->getBitDepth(CHANNEL_TYPE_CHROMA) - MAX_SAO_TRUNCATED_BITDEPTH);
+    m_cSAO.create( pps->getPicWidthInLumaSamples(), pps->getPicHeightInLumaSamples(),
+                   sps->getChromaFormatIdc(),
+                   sps->getMaxCUWidth(), sps->getMaxCUHeight(),
+                   maxDepth,
+                   log2SaoOffsetScaleLuma, log2SaoOffsetScaleChroma );
     m_cSAO.SAOProcess( cs, cs.picture->getSAO() );
   }
 
-  if( cs.sps->getALFEnabledFlag() )
+  if( sps->getALFEnabledFlag() )
   {
+    const int maxDepth = floorLog2(sps->getMaxCUWidth()) - sps->getLog2MinCodingBlockSize();
+    m_cALF.create( pps->getPicWidthInLumaSamples(), pps->getPicHeightInLumaSamples(), sps->getChromaFormatIdc(), sps->getMaxCUWidth(), sps->getMaxCUHeight(), maxDepth, sps->getBitDepths().recon);
     m_cALF.getCcAlfFilterParam() = cs.slice->m_ccAlfFilterParam;
+    for( int chromaIdx = 0; chromaIdx < 2; chromaIdx++ )
+    {
+      const uint8_t* ccAlfFilterControl = cs.picture->getCcAlfFilterControl( chromaIdx );
+      std::copy( ccAlfFilterControl, ccAlfFilterControl + cs.pcv->sizeInCtus, m_cALF.getCcAlfControlIdc( ComponentID( COMPONENT_Cb + chromaIdx ) ) );
+    }
     // ALF decodes the differentially coded coefficients and stores them in the parameters structure.
     // Code could be restructured to do directly after parsing. So far we just pass a fresh non-const
     // copy in case the APS gets used more than once.
@@ -742,8 +868,6 @@ void DecLib::executeLoopFilters()
       }
     }
   }
-
-  m_pcPic->cs->slice->stopProcessingTimer();
 }
 
 void DecLib::finishPictureLight(int& poc, PicList*& rpcListPic )
@@ -787,31 +911,11 @@ void DecLib::finishPictureLight(int& poc, PicList*& rpcListPic )
   m_puCounter++;
 }
 
-void DecLib::finishPicture(int &poc, PicList *&rpcListPic, MsgLevel msgl, bool associatedWithNewClvs)
+/** prints the summary line of a decoded picture and checks its decoded picture hash
+ */
+void DecLib::xPrintPictureSummary( Picture* pic, char c, MsgLevel msgl )
 {
-#if RExt__DECODER_DEBUG_TOOL_STATISTICS
-  CodingStatistics::StatTool& s = CodingStatistics::GetStatisticTool( STATS__TOOL_TOTAL_FRAME );
-  s.count++;
-  s.pixels = s.count * m_pcPic->Y().width * m_pcPic->Y().height;
-#endif
-
-  Slice*  pcSlice = m_pcPic->cs->slice;
-  m_prevPicPOC = pcSlice->getPOC();
-
-  char c = (pcSlice->isIntra() ? 'I' : pcSlice->isInterP() ? 'P' : 'B');
-  if (!m_pcPic->referenced)
-  {
-    c += 32;  // tolower
-  }
-
-  if (pcSlice->isDRAP())
-  {
-    c = 'D';
-  }
-  if (pcSlice->getEdrapRapId() > 0)
-  {
-    c = 'E';
-  }
+  Slice* pcSlice = pic->cs->slice;
 
   //-- For time output for each slice
   msg( msgl, "POC %4d LId: %2d TId: %1d ( %s, %c-SLICE, QP%3d ) ", pcSlice->getPOC(), pcSlice->getPic()->layerId,
@@ -863,16 +967,16 @@ void DecLib::finishPicture(int &poc, PicList *&rpcListPic, MsgLevel msgl, bool a
   }
   if (m_decodedPictureHashSEIEnabled)
   {
-    SEIMessages pictureHashes = getSeisByType(m_pcPic->SEIs, SEI::DECODED_PICTURE_HASH );
+    SEIMessages pictureHashes = getSeisByType(pic->SEIs, SEI::DECODED_PICTURE_HASH );
     const SEIDecodedPictureHash *hash =
       (pictureHashes.size() > 0) ? (SEIDecodedPictureHash *) *(pictureHashes.begin()) : nullptr;
     if (pictureHashes.size() > 1)
     {
       msg( WARNING, "Warning: Got multiple decoded picture hash SEI messages. Using first.");
     }
-    m_numberOfChecksumErrorsDetected += calcAndPrintHashStatus(((const Picture*) m_pcPic)->getRecoBuf(), hash, pcSlice->getSPS()->getBitDepths(), msgl);
+    m_numberOfChecksumErrorsDetected += calcAndPrintHashStatus(((const Picture*) pic)->getRecoBuf(), hash, pcSlice->getSPS()->getBitDepths(), msgl);
 
-    SEIMessages scalableNestingSeis = getSeisByType(m_pcPic->SEIs, SEI::SCALABLE_NESTING );
+    SEIMessages scalableNestingSeis = getSeisByType(pic->SEIs, SEI::SCALABLE_NESTING );
     for (auto seiIt : scalableNestingSeis)
     {
       SEIScalableNesting *nestingSei = dynamic_cast<SEIScalableNesting*>(seiIt);
@@ -884,7 +988,7 @@ void DecLib::finishPicture(int &poc, PicList *&rpcListPic, MsgLevel msgl, bool a
         {
           const SubPic& subpic = pcSlice->getPPS()->getSubPic(subpicId);
           const UnitArea area = UnitArea(pcSlice->getSPS()->getChromaFormatIdc(), Area(subpic.getSubPicLeft(), subpic.getSubPicTop(), subpic.getSubPicWidthInLumaSample(), subpic.getSubPicHeightInLumaSample()));
-          PelUnitBuf recoBuf = m_pcPic->cs->getRecoBuf(area);
+          PelUnitBuf recoBuf = pic->cs->getRecoBuf(area);
           m_numberOfChecksumErrorsDetected += calcAndPrintHashStatus(recoBuf, dynamic_cast<SEIDecodedPictureHash*>(decPicHash), pcSlice->getSPS()->getBitDepths(), msgl);
         }
       }
@@ -892,6 +996,46 @@ void DecLib::finishPicture(int &poc, PicList *&rpcListPic, MsgLevel msgl, bool a
   }
 
   msg( msgl, "\n");
+}
+
+void DecLib::finishPicture(int &poc, PicList *&rpcListPic, MsgLevel msgl, bool associatedWithNewClvs)
+{
+#if RExt__DECODER_DEBUG_TOOL_STATISTICS
+  CodingStatistics::StatTool& s = CodingStatistics::GetStatisticTool( STATS__TOOL_TOTAL_FRAME );
+  s.count++;
+  s.pixels = s.count * m_pcPic->Y().width * m_pcPic->Y().height;
+#endif
+
+  // the background ALF of a single slice picture sets the slice of its coding structure
+  Slice*  pcSlice = m_pcPic->loopFilterPending ? m_pcPic->slices[0] : m_pcPic->cs->slice;
+  m_prevPicPOC = pcSlice->getPOC();
+
+  char c = (pcSlice->isIntra() ? 'I' : pcSlice->isInterP() ? 'P' : 'B');
+  if (!m_pcPic->referenced)
+  {
+    c += 32;  // tolower
+  }
+
+  if (pcSlice->isDRAP())
+  {
+    c = 'D';
+  }
+  if (pcSlice->getEdrapRapId() > 0)
+  {
+    c = 'E';
+  }
+
+  if( m_pcPic->loopFilterPending )
+  {
+    // printed with the hash check once the background in-loop filters finished
+    m_loopFilterPicType     = c;
+    m_loopFilterPicMsgl     = msgl;
+    m_loopFilterPicFinished = true;
+  }
+  else
+  {
+    xPrintPictureSummary( m_pcPic, c, msgl );
+  }
 
 #if JVET_J0090_MEMORY_BANDWITH_MEASURE
   m_cacheModel.reportFrame();
@@ -962,9 +1106,12 @@ void DecLib::finishPicture(int &poc, PicList *&rpcListPic, MsgLevel msgl, bool a
   m_maxDecSubPicIdx = 0;
   m_maxDecSliceAddrInSubPic = -1;
 
-  m_pcPic->destroyTempBuffers();
-  m_pcPic->cs->destroyCoeffs();
-  m_pcPic->cs->releaseIntermediateData();
+  if( !m_pcPic->loopFilterPending )
+  {
+    m_pcPic->destroyTempBuffers();
+    m_pcPic->cs->destroyCoeffs();
+    m_pcPic->cs->releaseIntermediateData();
+  }
 #if !GDR_ENABLED
   m_pcPic->cs->picHeader->initPicHeader();
 #endif
@@ -1007,6 +1154,8 @@ void DecLib::xUpdateRasInit(Slice* slice)
 void DecLib::xCreateLostPicture( int iLostPoc, const int layerId )
 {
   msg( INFO, "\ninserting lost poc : %d\n",iLostPoc);
+  // the lost picture is copied from a decoded one
+  finishLoopFilters();
   Picture *cFillPic = xGetNewPicBuffer( *( m_parameterSetManager.getFirstSPS() ), *( m_parameterSetManager.getFirstPPS() ), 0, layerId );
 
   CHECK( !cFillPic->slices.size(), "No slices in picture" );
@@ -1940,7 +2089,15 @@ void DecLib::xActivateParameterSets( const InputNALUnit nalu )
 
     if( nullptr != pps->pcv )
     {
-      delete m_parameterSetManager.getPPS( m_picHeader.getPPSId() )->pcv;
+      if( m_loopFilterPic && m_loopFilterPic->cs->pcv == pps->pcv )
+      {
+        // still used by the background in-loop filters, deleted once they finished
+        m_loopFilterPcv = pps->pcv;
+      }
+      else
+      {
+        delete m_parameterSetManager.getPPS( m_picHeader.getPPSId() )->pcv;
+      }
     }
     m_parameterSetManager.getPPS( m_picHeader.getPPSId() )->pcv = new PreCalcValues( *sps, *pps, false );
     m_parameterSetManager.clearSPSChangedFlag(sps->getSPSId());
@@ -2031,15 +2188,8 @@ void DecLib::xActivateParameterSets( const InputNALUnit nalu )
 
     m_pcPic->cs->pcv   = pps->pcv;
 
-    // Initialise the various objects for the new set of settings
+    // Initialise the various objects for the new set of settings, SAO and ALF are set up when they are applied
     const int maxDepth = floorLog2(sps->getMaxCUWidth()) - pps->pcv->minCUWidthLog2;
-    const uint32_t  log2SaoOffsetScaleLuma   = (uint32_t) std::max(0, sps->getBitDepth(CHANNEL_TYPE_LUMA  ) - MAX_SAO_TRUNCATED_BITDEPTH);
-    const uint32_t  log2SaoOffsetScaleChroma = (uint32_t) std::max(0, sps->getBitDepth(CHANNEL_TYPE_CHROMA) - MAX_SAO_TRUNCATED_BITDEPTH);
-    m_cSAO.create( pps->getPicWidthInLumaSamples(), pps->getPicHeightInLumaSamples(),
-                   sps->getChromaFormatIdc(),
-                   sps->getMaxCUWidth(), sps->getMaxCUHeight(),
-                   maxDepth,
-                   log2SaoOffsetScaleLuma, log2SaoOffsetScaleChroma );
     m_deblockingFilter.create(maxDepth);
     m_cIntraPred.init( sps->getChromaFormatIdc(), sps->getBitDepth( CHANNEL_TYPE_LUMA ) );
     m_cInterPred.init( &m_cRdCost, sps->getChromaFormatIdc(), sps->getMaxCUHeight() );
@@ -2097,11 +2247,10 @@ void DecLib::xActivateParameterSets( const InputNALUnit nalu )
 
     if( sps->getALFEnabledFlag() )
     {
-      const int maxDepth = floorLog2(sps->getMaxCUWidth()) - sps->getLog2MinCodingBlockSize();
-      m_cALF.create( pps->getPicWidthInLumaSamples(), pps->getPicHeightInLumaSamples(), sps->getChromaFormatIdc(), sps->getMaxCUWidth(), sps->getMaxCUHeight(), maxDepth, sps->getBitDepths().recon);
+      m_pcPic->resizeCcAlfFilterControl( pps->pcv->sizeInCtus );
     }
-    pSlice->m_ccAlfFilterControl[0] = m_cALF.getCcAlfControlIdc(COMPONENT_Cb);
-    pSlice->m_ccAlfFilterControl[1] = m_cALF.getCcAlfControlIdc(COMPONENT_Cr);
+    pSlice->m_ccAlfFilterControl[0] = m_pcPic->getCcAlfFilterControl(0);
+    pSlice->m_ccAlfFilterControl[1] = m_pcPic->getCcAlfFilterControl(1);
   }
   else
   {
@@ -2721,7 +2870,11 @@ bool DecLib::xDecodeSlice(InputNALUnit &nalu, int &iSkipFrame, int iPOCLastDispl
   }
 
   m_HLSReader.setBitstream( &nalu.getBitstream() );
-  m_apcSlicePilot->m_ccAlfFilterParam = m_cALF.getCcAlfFilterParam();
+  // the background ALF of the previous picture may still use its parameters, the slice header sets all used ones
+  if( m_loopFilterPic == nullptr )
+  {
+    m_apcSlicePilot->m_ccAlfFilterParam = m_cALF.getCcAlfFilterParam();
+  }
   m_HLSReader.parseSliceHeader( m_apcSlicePilot, &m_picHeader, &m_parameterSetManager, m_prevTid0POC, m_prevPicPOC );
 
   if (m_picHeader.getGdrOrIrapPicFlag() && m_bFirstSliceInPicture)
@@ -3117,6 +3270,12 @@ bool DecLib::xDecodeSlice(InputNALUnit &nalu, int &iSkipFrame, int iPOCLastDispl
   }
   pcSlice->getPic()->sliceSubpicIdx.push_back(pps->getSubPicIdxFromSubPicId(pcSlice->getSliceSubPicId()));
   pcSlice->checkCRA(pcSlice->getRPL0(), pcSlice->getRPL1(), m_pocCRA[nalu.m_nuhLayerId], m_cListPic);
+  // references that are wrapped around, rescaled or padded per subpicture are prepared from their final samples
+  if( m_loopFilterPic
+      && ( pps->getWrapAroundEnabledFlag() || pps->getNumSubPics() > 1 || m_loopFilterPic->layerId != m_pcPic->layerId || m_loopFilterPic->isRefScaled( pps ) ) )
+  {
+    finishLoopFilters();
+  }
   pcSlice->constructRefPicList(m_cListPic);
   pcSlice->setPrevGDRSubpicPOC(m_prevGDRSubpicPOC[nalu.m_nuhLayerId][currSubPicIdx]);
   pcSlice->setPrevIRAPSubpicPOC(m_prevIRAPSubpicPOC[nalu.m_nuhLayerId][currSubPicIdx]);
@@ -3581,6 +3740,12 @@ void DecLib::xDecodeAPS(InputNALUnit& nalu)
     m_accessUnitApsNals.pop_back();
   }
 
+  // an ALF APS used by the background in-loop filters must not be replaced while they run
+  if( aps->getAPSType() == ALF_APS && m_loopFilterPic && m_loopFilterPic->cs->alfApss[aps->getAPSId()] )
+  {
+    finishLoopFilters();
+  }
+
   // aps will be deleted if it was already stored (and did not changed),
   // thus, storing it must be last action.
   m_parameterSetManager.storeAPS(aps, nalu.getBitstream().getFifo());
@@ -3607,6 +3772,11 @@ bool DecLib::decode(InputNALUnit& nalu, int& iSkipFrame, int& iPOCLastDisplay, i
     m_accessUnitNals.push_back(auInfo);
     m_pictureUnitNals.push_back( nalu.m_nalUnitType );
   }
+  // parameter sets may replace the ones used by the background in-loop filters
+  if( nalu.m_nalUnitType == NAL_UNIT_VPS || nalu.m_nalUnitType == NAL_UNIT_SPS || nalu.m_nalUnitType == NAL_UNIT_PPS )
+  {
+    finishLoopFilters();
+  }
   switch (nalu.m_nalUnitType)
   {
   case NAL_UNIT_VPS:
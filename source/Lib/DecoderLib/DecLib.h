@@ -113,6 +113,15 @@ private:
   SeiCfgFileDump          m_seiCfgDump;
 #endif
   DeblockingFilter        m_deblockingFilter;
+  ThreadPool              m_threadPool;                   ///< worker threads shared by the in-loop filters
+  ThreadPool              m_filterThreadPool;             ///< worker threads of SAO and ALF in frame-parallel decoding
+  ThreadPool              m_loopFilterThreadPool;         ///< runs the SAO/ALF stage of a picture while the next one is decoded
+  bool                    m_frameParallelDecoding;
+  Picture*                m_loopFilterPic;                ///< picture whose SAO/ALF stage may still be running
+  bool                    m_loopFilterPicFinished;        ///< finishPicture() was called for m_loopFilterPic
+  char                    m_loopFilterPicType;            ///< slice type character of the deferred picture summary
+  MsgLevel                m_loopFilterPicMsgl;            ///< message level of the deferred picture summary
+  PreCalcValues*          m_loopFilterPcv;                ///< replaced values of a parameter set still used by m_loopFilterPic
   SampleAdaptiveOffset    m_cSAO;
   AdaptiveLoopFilter      m_cALF;
   Reshape                 m_cReshaper;                        ///< reshaper class
@@ -236,6 +245,14 @@ public:
   void  destroy ();
 
   void  setDecodedPictureHashSEIEnabled(int enabled) { m_decodedPictureHashSEIEnabled=enabled; }
+  /// sets the number of worker threads used for the picture level in-loop filtering
+  void  setNumThreads(int numThreads);
+  /// pipelines the parsing, reconstruction and deblocking of a slice on the worker threads
+  void  setPipelinedDecoding(bool b) { m_cSliceDecoder.setPipelinedDecoding(b); }
+  /// runs SAO and ALF of a picture in the background while the next picture is decoded (needs worker threads)
+  void  setFrameParallelDecoding(bool b);
+  /// waits for the background in-loop filters of the given picture (any picture if null) to finish
+  void  finishLoopFilters(const Picture* pic = nullptr);
 
   void  init(
 #if JVET_J0090_MEMORY_BANDWITH_MEASURE
@@ -331,6 +348,8 @@ protected:
   void  xUpdateRasInit(Slice* slice);
 
   Picture * xGetNewPicBuffer( const SPS &sps, const PPS &pps, const uint32_t temporalLayer, const int layerId );
+  void  xApplySaoAndAlf    ( CodingStructure& cs );
+  void  xPrintPictureSummary( Picture* pic, char c, MsgLevel msgl );
   void  xCreateLostPicture( int iLostPOC, const int layerId );
   void  xCreateUnavailablePicture( const PPS *pps, const int iUnavailablePoc, const bool longTermFlag, const int temporalId, const int layerId, const bool interLayerRefPicFlag );
   void  checkParameterSetsInclusionSEIconstraints(const InputNALUnit nalu);
@@ -49,6 +49,9 @@
 //////////////////////////////////////////////////////////////////////
 
 DecSlice::DecSlice()
+  : m_threadPool       ( nullptr )
+  , m_pipelinedDecoding( false )
+  , m_picDeblocked     ( false )
 {
 }
 
@@ -62,12 +65,16 @@ void DecSlice::create()
 
 void DecSlice::destroy()
 {
+  m_ctuDecoders.clear();
+  m_rowSegments.clear();
 }
 
-void DecSlice::init( CABACDecoder* cabacDecoder, DecCu* pcCuDecoder )
+void DecSlice::init( CABACDecoder* cabacDecoder, DecCu* pcCuDecoder, TrQuant* pcTrQuant, DeblockingFilter* pcDeblockingFilter )
 {
-  m_CABACDecoder    = cabacDecoder;
-  m_pcCuDecoder     = pcCuDecoder;
+  m_CABACDecoder       = cabacDecoder;
+  m_pcCuDecoder        = pcCuDecoder;
+  m_pcTrQuant          = pcTrQuant;
+  m_pcDeblockingFilter = pcDeblockingFilter;
 }
 
 void DecSlice::decompressSlice( Slice* slice, InputBitstream* bitstream, int debugCTU )
@@ -75,6 +82,8 @@ void DecSlice::decompressSlice( Slice* slice, InputBitstream* bitstream, int deb
   //-- For time output for each slice
   slice->startProcessingTimer();
 
+  m_picDeblocked = false;
+
   const SPS*     sps          = slice->getSPS();
   Picture*       pic          = slice->getPic();
   CABACReader&   cabacReader  = *m_CABACDecoder->getCABACReader( 0 );
@@ -117,6 +126,27 @@ void DecSlice::decompressSlice( Slice* slice, InputBitstream* bitstream, int deb
   const bool     wavefrontsEnabled           = cs.sps->getEntropyCodingSyncEnabledFlag();
   const bool     entryPointPresent           = cs.sps->getEntryPointsPresentFlag();
 
+  if( slice->getSliceType() != I_SLICE && slice->getRefPic( REF_PIC_LIST_0, 0 )->subPictures.size() > 1 )
+  {
+    clipMv = clipMvInSubpic;
+  }
+  else
+  {
+    clipMv = clipMvInPic;
+  }
+
+  if( xUseParallelDecoding( slice, numSubstreams, debugCTU ) )
+  {
+    xDecompressSliceParallel( slice, ppcSubstreams );
+
+    for( auto substr: ppcSubstreams )
+    {
+      delete substr;
+    }
+    slice->stopProcessingTimer();
+    return;
+  }
+
   cabacReader.initBitstream( ppcSubstreams[0] );
   cabacReader.initCtxModels( *slice );
 
@@ -127,14 +157,6 @@ void DecSlice::decompressSlice( Slice* slice, InputBitstream* bitstream, int deb
   DTRACE( g_trace_ctx, D_HEADER, "=========== POC: %d ===========\n", slice->getPOC() );
 
 
-  if( slice->getSliceType() != I_SLICE && slice->getRefPic( REF_PIC_LIST_0, 0 )->subPictures.size() > 1 )
-  {
-    clipMv = clipMvInSubpic;
-  }
-  else
-  {
-    clipMv = clipMvInPic;
-  }
   // for every CTU in the slice segment...
   unsigned subStrmId = 0;
   for( unsigned ctuIdx = 0; ctuIdx < slice->getNumCtuInSlice(); ctuIdx++ )
@@ -296,4 +318,391 @@ void DecSlice::decompressSlice( Slice* slice, InputBitstream* bitstream, int deb
   slice->stopProcessingTimer();
 }
 
+bool DecSlice::xUseParallelDecoding( const Slice* slice, const unsigned numSubstreams, const int debugCTU ) const
+{
+#if ENABLE_TRACING || JVET_J0090_MEMORY_BANDWITH_MEASURE
+  // traces and the cache model expect the CTUs in decoding order
+  return false;
+#else
+  if( !m_threadPool || m_threadPool->getNumThreads() == 0 || debugCTU >= 0 || g_mctsDecCheckEnabled )
+  {
+    return false;
+  }
+  // subpictures treated as pictures pad their reference pictures per slice
+  if( slice->getPPS()->getNumSubPics() >= 2 )
+  {
+    return false;
+  }
+  // every substream holds one job, a single substream is worth the parsing and reconstruction pipeline only
+  return numSubstreams > 1 ? slice->getSPS()->getEntryPointsPresentFlag() : m_pipelinedDecoding;
+#endif
+}
+
+/**
+ - substream parallel slice decoding
+ .
+ Every CTU row of a tile is decoded into a coding structure of its own. Without wavefronts, all rows of a tile are
+ decoded by one job. With wavefronts, every row is a job, which waits for the row above to be two CTUs ahead and starts
+ with the contexts stored after the first CTU of that row. Decoded rows are read through the parent chain of the row
+ coding structures, the reconstruction is written directly into the picture. After all jobs have finished, the rows are
+ moved into the picture coding structure in decoding order, which yields the units in the order of the sequential
+ decoding.
+
+ With pipelined decoding, every job is split into a parsing and a reconstruction job, so the parsing of a row only
+ waits for the parsing of the rows it depends on. For a slice covering the whole picture with a single tile, a
+ filter job additionally applies the inverse luma mapping and the deblocking filter to every row as soon as the row
+ below has been reconstructed, which leaves SAO and ALF to the picture-level loop filtering.
+ */
+void DecSlice::xDecompressSliceParallel( Slice* slice, std::vector<InputBitstream*>& substreams )
+{
+  const SPS*           sps                = slice->getSPS();
+  const PPS*           pps                = slice->getPPS();
+  CodingStructure&     cs                 = *slice->getPic()->cs;
+  const PreCalcValues& pcv                = *cs.pcv;
+  const ChromaFormat   chromaFormat       = sps->getChromaFormatIdc();
+  const bool           wavefrontsEnabled  = sps->getEntropyCodingSyncEnabledFlag();
+  const bool           entryPointsPresent = sps->getEntryPointsPresentFlag();
+
+  // set up the CTU decoding tools of every thread as the ones of the sequential decoding
+  while( m_ctuDecoders.size() < m_threadPool->getNumThreadSlots() )
+  {
+    m_ctuDecoders.emplace_back( new CtuDecoder );
+  }
+  for( auto &ctuDecoder : m_ctuDecoders )
+  {
+    ctuDecoder->intraPred.init( chromaFormat, sps->getBitDepth( CHANNEL_TYPE_LUMA ) );
+    ctuDecoder->interPred.init( &ctuDecoder->rdCost, chromaFormat, sps->getMaxCUHeight() );
+    ctuDecoder->trQuant.init( m_pcTrQuant->getQuant(), sps->getMaxTbSize(), false, false, false, false );
+    ctuDecoder->trQuant.getQuant()->setUseScalingList( m_pcTrQuant->getQuant()->getScalingListEnabled() );
+    ctuDecoder->rdCost.setCostMode( COST_STANDARD_LOSSY );
+    ctuDecoder->cuDecoder.init( &ctuDecoder->trQuant, &ctuDecoder->intraPred, &ctuDecoder->interPred );
+    if( sps->getUseLmcs() )
+    {
+      ctuDecoder->reshaper = *m_pcCuDecoder->getReshape();
+      ctuDecoder->reshaper.setVPDULoc( -1, -1 );
+      ctuDecoder->cuDecoder.initDecCuReshaper( &ctuDecoder->reshaper, chromaFormat );
+    }
+  }
+
+  // split the slice into CTU rows of tiles, slices always hold complete CTU rows of a tile
+  unsigned numSegs      = 0;
+  unsigned substreamIdx = 0;
+  for( unsigned ctuIdx = 0; ctuIdx < slice->getNumCtuInSlice(); ctuIdx++ )
+  {
+    const unsigned ctuRsAddr      = slice->getCtuAddrInSlice( ctuIdx );
+    const unsigned ctuXPosInCtus  = ctuRsAddr % pcv.widthInCtus;
+    const unsigned ctuYPosInCtus  = ctuRsAddr / pcv.widthInCtus;
+    const unsigned tileColIdx     = pps->ctuToTileCol( ctuXPosInCtus );
+    const unsigned tileXPosInCtus = pps->getTileColumnBd( tileColIdx );
+    const unsigned tileYPosInCtus = pps->getTileRowBd( pps->ctuToTileRow( ctuYPosInCtus ) );
+
+    if( ctuIdx > 0 && ctuXPosInCtus != tileXPosInCtus )
+    {
+      m_rowSegments[numSegs - 1]->numCtus++;
+      continue;
+    }
+
+    // without entry points, the tiles and wavefront rows of the slice share one substream
+    const bool tileStart      = ctuXPosInCtus == tileXPosInCtus && ctuYPosInCtus == tileYPosInCtus;
+    const bool substreamStart = ctuIdx > 0 && ( tileStart || wavefrontsEnabled ) && entryPointsPresent;
+    if( substreamStart )
+    {
+      substreamIdx++;
+    }
+    CHECK( substreamIdx >= substreams.size(), "Too few substreams for the tiles and CTU rows of the slice" );
+
+    if( numSegs == m_rowSegments.size() )
+    {
+      m_rowSegments.emplace_back( new CtuRowSegment );
+    }
+    CtuRowSegment& seg = *m_rowSegments[numSegs];
+    seg.firstCtuIdx    = ctuIdx;
+    seg.numCtus        = 1;
+    seg.substreamIdx   = substreamIdx;
+    seg.aboveSegIdx    = ctuIdx > 0 && !tileStart ? (int) numSegs - 1 : -1;
+    seg.laneStart      = ctuIdx == 0 || substreamStart;
+    seg.parsed.reset();
+    seg.reconstructed.reset();
+
+    // clipped to the picture like the picture coding structure, the parsing skips the parts outside of the structure
+    const Position segPos( ctuXPosInCtus * pcv.maxCUWidth, ctuYPosInCtus * pcv.maxCUHeight );
+    const Area     segArea( segPos, Size( std::min( pps->getTileColumnWidth( tileColIdx ) * pcv.maxCUWidth, pcv.lumaWidth - segPos.x ),
+                                          std::min( pcv.maxCUHeight, pcv.lumaHeight - segPos.y ) ) );
+    if( seg.cs.area.blocks.empty() || seg.cs.area.chromaFormat != chromaFormat || seg.cs.area.lumaSize() != segArea.size() || seg.pltMode != (bool) sps->getPLTMode() )
+    {
+      seg.cs.destroy();
+#if GDR_ENABLED
+      seg.cs.create( chromaFormat, Area( Position( 0, 0 ), segArea.size() ), false, (bool) sps->getPLTMode(), cs.isGdrEnabled() );
+#else
+      seg.cs.create( chromaFormat, Area( Position( 0, 0 ), segArea.size() ), false, (bool) sps->getPLTMode() );
+#endif
+      seg.pltMode = (bool) sps->getPLTMode();
+    }
+    cs.initSubStructure( seg.cs, CH_L, UnitArea( chromaFormat, segArea ), false );
+    seg.cs.parent = seg.aboveSegIdx >= 0 ? &m_rowSegments[seg.aboveSegIdx]->cs : &cs;
+    seg.cs.rebindPicRecoBuf();
+    seg.cs.chromaQpAdj = 0;
+    seg.cs.resetPrevPLT( seg.cs.prevPLT );
+
+    // the rows below access the units while the row is decoded, they must not be reallocated
+    const size_t maxNumUnits = 2 * ( segArea.area() >> ( 2 * MIN_CU_LOG2 ) );
+    seg.cs.cus.reserve( maxNumUnits );
+    seg.cs.pus.reserve( maxNumUnits );
+    seg.cs.tus.reserve( maxNumUnits );
+
+    numSegs++;
+  }
+  CHECK( substreamIdx + 1 != substreams.size(), "Substreams not matching the tiles and CTU rows of the slice" );
+
+  if( slice->getSliceType() == B_SLICE )
+  {
+    resetBcwCodingOrder( true, cs );
+  }
+
+  // the jobs are queued in decoding order, hence a job only waits for jobs which have already been started
+  for( unsigned segIdx = 0; segIdx < numSegs; )
+  {
+    unsigned numLaneSegs = 1;
+    while( segIdx + numLaneSegs < numSegs && !m_rowSegments[segIdx + numLaneSegs]->laneStart )
+    {
+      numLaneSegs++;
+    }
+    if( m_pipelinedDecoding )
+    {
+      m_threadPool->addJob( [this, slice, &substreams, segIdx, numLaneSegs]( int threadIdx )
+      {
+        int prevQP[MAX_NUM_CHANNEL_TYPE];
+        for( unsigned i = segIdx; i < segIdx + numLaneSegs; i++ )
+        {
+          xParseRowSegment( slice, substreams, i, *m_ctuDecoders[threadIdx]->cabacDecoder.getCABACReader( 0 ), prevQP );
+        }
+      } );
+      m_threadPool->addJob( [this, slice, segIdx, numLaneSegs]( int threadIdx )
+      {
+        for( unsigned i = segIdx; i < segIdx + numLaneSegs; i++ )
+        {
+          xReconstructRowSegment( slice, i, m_ctuDecoders[threadIdx]->cuDecoder );
+        }
+      } );
+    }
+    else
+    {
+      m_threadPool->addJob( [this, slice, &substreams, segIdx, numLaneSegs]( int threadIdx )
+      {
+        CtuDecoder& ctuDecoder = *m_ctuDecoders[threadIdx];
+        int         prevQP[MAX_NUM_CHANNEL_TYPE];
+        for( unsigned i = segIdx; i < segIdx + numLaneSegs; i++ )
+        {
+          xParseRowSegment( slice, substreams, i, *ctuDecoder.cabacDecoder.getCABACReader( 0 ), prevQP );
+          xReconstructRowSegment( slice, i, ctuDecoder.cuDecoder );
+        }
+      } );
+    }
+    segIdx += numLaneSegs;
+  }
+
+  // the row structures only link to the rows above within a tile, the deblocking needs the left neighbours as well
+  const bool filterRows = m_pipelinedDecoding && slice->getNumCtuInSlice() == pcv.sizeInCtus && pps->getNumTiles() == 1;
+  if( filterRows )
+  {
+    m_threadPool->addJob( [this, slice, numSegs]( int )
+    {
+      xFilterRowSegments( slice, numSegs );
+    } );
+  }
+  m_threadPool->waitForJobs();
+  m_picDeblocked = filterRows;
+
+  for( unsigned segIdx = 0; segIdx < numSegs; segIdx++ )
+  {
+    const CodingStructure& segCS = m_rowSegments[segIdx]->cs;
+    const size_t           cuBase = cs.cus.size();
+    cs.useSubStructure( segCS, CH_L, segCS.area, false, false, false, false, false );
+
+    // restore the per channel CU order the parser establishes for dual tree CTUs larger than 64x64
+    for( size_t i = 0; i < segCS.cus.size(); i++ )
+    {
+      if( segCS.cus[i]->next )
+      {
+        cs.cus[cuBase + i]->next = cs.cus[cuBase + segCS.cus[i]->next->idx - 1];
+      }
+    }
+  }
+}
+
+void DecSlice::xParseRowSegment( Slice* slice, std::vector<InputBitstream*>& substreams, const unsigned segIdx, CABACReader& cabacReader, int (&prevQP)[MAX_NUM_CHANNEL_TYPE] )
+{
+  const SPS*       sps               = slice->getSPS();
+  const PPS*       pps               = slice->getPPS();
+  const unsigned   widthInCtus       = pps->pcv->widthInCtus;
+  const unsigned   maxCUSize         = sps->getMaxCUWidth();
+  const bool       wavefrontsEnabled = sps->getEntropyCodingSyncEnabledFlag();
+  CtuRowSegment&   seg               = *m_rowSegments[segIdx];
+  CodingStructure& cs                = seg.cs;
+
+  if( seg.laneStart )
+  {
+    cabacReader.initBitstream( substreams[seg.substreamIdx] );
+    if( seg.firstCtuIdx == 0 )
+    {
+      cabacReader.initCtxModels( *slice );
+    }
+    prevQP[0] = prevQP[1] = slice->getSliceQp();
+  }
+  else
+  {
+    // the CTU rows of a substream continue the state of the row before
+    const CodingStructure& prevCS = m_rowSegments[segIdx - 1]->cs;
+    cs.prevPLT     = prevCS.prevPLT;
+    cs.chromaQpAdj = prevCS.chromaQpAdj;
+  }
+
+  for( unsigned i = 0; i < seg.numCtus; i++ )
+  {
+    const unsigned  ctuIdx          = seg.firstCtuIdx + i;
+    const unsigned  ctuRsAddr       = slice->getCtuAddrInSlice( ctuIdx );
+    const unsigned  ctuXPosInCtus   = ctuRsAddr % widthInCtus;
+    const unsigned  ctuYPosInCtus   = ctuRsAddr / widthInCtus;
+    const unsigned  tileColIdx      = pps->ctuToTileCol( ctuXPosInCtus );
+    const unsigned  tileRowIdx      = pps->ctuToTileRow( ctuYPosInCtus );
+    const unsigned  tileXPosInCtus  = pps->getTileColumnBd( tileColIdx );
+    const unsigned  tileYPosInCtus  = pps->getTileRowBd( tileRowIdx );
+    const unsigned  tileColWidth    = pps->getTileColumnWidth( tileColIdx );
+    const unsigned  tileRowHeight   = pps->getTileRowHeight( tileRowIdx );
+    const unsigned  tileIdx         = pps->getTileIdx( ctuXPosInCtus, ctuYPosInCtus );
+    Position pos( ctuXPosInCtus * maxCUSize, ctuYPosInCtus * maxCUSize );
+    UnitArea ctuArea( cs.area.chromaFormat, Area( pos.x, pos.y, maxCUSize, maxCUSize ) );
+
+    if( seg.aboveSegIdx >= 0 )
+    {
+      CtuRowSegment& aboveSeg = *m_rowSegments[seg.aboveSegIdx];
+      aboveSeg.parsed.waitFor( std::min( i + 2, aboveSeg.numCtus ) );
+    }
+
+    // set up CABAC contexts' state for this CTU
+    if( ctuXPosInCtus == tileXPosInCtus && ctuYPosInCtus == tileYPosInCtus )
+    {
+      if( ctuIdx != 0 ) // if it is the first CTU, then the entropy coder has already been reset
+      {
+        cabacReader.initCtxModels( *slice );
+        cs.resetPrevPLT( cs.prevPLT );
+      }
+      prevQP[0] = prevQP[1] = slice->getSliceQp();
+    }
+    else if( ctuXPosInCtus == tileXPosInCtus && wavefrontsEnabled )
+    {
+      // Synchronize cabac probabilities with top CTU if it's available and at the start of a line.
+      if( ctuIdx != 0 ) // if it is the first CTU, then the entropy coder has already been reset
+      {
+        cabacReader.initCtxModels( *slice );
+        cs.resetPrevPLT( cs.prevPLT );
+      }
+      if( cs.getCURestricted( pos.offset( 0, -1 ), pos, slice->getIndependentSliceIdx(), tileIdx, CH_L ) )
+      {
+        // Top is available, so use it.
+        const CtuRowSegment& aboveSeg = *m_rowSegments[seg.aboveSegIdx];
+        cabacReader.getCtx() = aboveSeg.syncCtxState;
+        cabacReader.getCtx().riceStatReset( sps->getBitDepth( CHANNEL_TYPE_LUMA ), sps->getSpsRangeExtension().getPersistentRiceAdaptationEnabledFlag() );
+        cs.setPrevPLT( aboveSeg.syncPLTState );
+      }
+      prevQP[0] = prevQP[1] = slice->getSliceQp();
+    }
+
+    cabacReader.coding_tree_unit( cs, ctuArea, prevQP, ctuRsAddr );
+
+    if( ctuXPosInCtus == tileXPosInCtus && wavefrontsEnabled )
+    {
+      seg.syncCtxState = cabacReader.getCtx();
+      cs.storePrevPLT( seg.syncPLTState );
+    }
+
+    if( ctuIdx == slice->getNumCtuInSlice() - 1 )
+    {
+      unsigned binVal = cabacReader.terminating_bit();
+      CHECK( !binVal, "Expecting a terminating bit" );
+#if DECODER_CHECK_SUBSTREAM_AND_SLICE_TRAILING_BYTES
+      cabacReader.remaining_bytes( false );
+#endif
+    }
+    else if( ( ctuXPosInCtus + 1 == tileXPosInCtus + tileColWidth ) &&
+             ( ctuYPosInCtus + 1 == tileYPosInCtus + tileRowHeight || wavefrontsEnabled ) )
+    {
+      // The sub-stream should be terminated after this CTU (end of tile, end of wavefront-CTU-row).
+      unsigned binVal = cabacReader.terminating_bit();
+      CHECK( !binVal, "Expecting a terminating bit" );
+#if DECODER_CHECK_SUBSTREAM_AND_SLICE_TRAILING_BYTES
+      if( sps->getEntryPointsPresentFlag() )
+      {
+        cabacReader.remaining_bytes( true );
+      }
+#endif
+    }
+
+    seg.parsed.set( i + 1 );
+  }
+}
+
+void DecSlice::xReconstructRowSegment( Slice* slice, const unsigned segIdx, DecCu& cuDecoder )
+{
+  const SPS*       sps         = slice->getSPS();
+  const PPS*       pps         = slice->getPPS();
+  const unsigned   widthInCtus = pps->pcv->widthInCtus;
+  const unsigned   maxCUSize   = sps->getMaxCUWidth();
+  CtuRowSegment&   seg         = *m_rowSegments[segIdx];
+  CodingStructure& cs          = seg.cs;
+
+  for( unsigned i = 0; i < seg.numCtus; i++ )
+  {
+    const unsigned ctuRsAddr      = slice->getCtuAddrInSlice( seg.firstCtuIdx + i );
+    const unsigned ctuXPosInCtus  = ctuRsAddr % widthInCtus;
+    const unsigned ctuYPosInCtus  = ctuRsAddr / widthInCtus;
+    const unsigned tileXPosInCtus = pps->getTileColumnBd( pps->ctuToTileCol( ctuXPosInCtus ) );
+    const UnitArea ctuArea( cs.area.chromaFormat, Area( ctuXPosInCtus * maxCUSize, ctuYPosInCtus * maxCUSize, maxCUSize, maxCUSize ) );
+
+    // the neighbours to the right of the CTU are looked up as well, hence the CTU after it has to be parsed
+    seg.parsed.waitFor( std::min( i + 2, seg.numCtus ) );
+    if( seg.aboveSegIdx >= 0 )
+    {
+      CtuRowSegment& aboveSeg = *m_rowSegments[seg.aboveSegIdx];
+      aboveSeg.reconstructed.waitFor( std::min( i + 2, aboveSeg.numCtus ) );
+    }
+
+    if( ( slice->getSliceType() != I_SLICE || sps->getIBCFlag() ) && ctuXPosInCtus == tileXPosInCtus )
+    {
+      cs.motionLut.lut.resize( 0 );
+      cs.motionLut.lutIbc.resize( 0 );
+      cs.resetIBCBuffer = true;
+    }
+
+    cuDecoder.decompressCtu( cs, ctuArea );
+
+    seg.reconstructed.set( i + 1 );
+  }
+}
+
+void DecSlice::xFilterRowSegments( Slice* slice, const unsigned numSegs )
+{
+  const SPS* sps         = slice->getSPS();
+  const bool invReshape  = sps->getUseLmcs() && slice->getPicHeader()->getLmcsEnabledFlag() && slice->getLmcsEnabledFlag();
+  const int  maxCUHeight = sps->getMaxCUHeight();
+
+  for( unsigned segIdx = 0; segIdx < numSegs; segIdx++ )
+  {
+    CtuRowSegment& seg = *m_rowSegments[segIdx];
+
+    // the intra prediction and the chroma residual scaling of the row below read the unfiltered samples of the row
+    seg.reconstructed.waitFor( seg.numCtus );
+    if( segIdx + 1 < numSegs )
+    {
+      m_rowSegments[segIdx + 1]->reconstructed.waitFor( m_rowSegments[segIdx + 1]->numCtus );
+    }
+
+    if( invReshape )
+    {
+      seg.cs.getRecoBuf( seg.cs.area ).get( COMPONENT_Y ).rspSignal( m_pcCuDecoder->getReshape()->getInvLUT() );
+    }
+    m_pcDeblockingFilter->deblockCtuRow( seg.cs, seg.cs.area.lumaPos().y / maxCUHeight );
+  }
+}
+
 //! \}
@@ -44,9 +44,13 @@
 
 #include "CommonLib/CommonDef.h"
 #include "CommonLib/BitStream.h"
+#include "CommonLib/DeblockingFilter.h"
+#include "CommonLib/ThreadPool.h"
 #include "DecCu.h"
 #include "CABACReader.h"
 
+#include <memory>
+
 //! \ingroup DecoderLib
 //! \{
 
@@ -58,20 +62,74 @@
 class DecSlice
 {
 private:
+  /// CTU decoding tools of one thread of the parallel slice decoding
+  struct CtuDecoder
+  {
+    ~CtuDecoder() { cuDecoder.destoryDecCuReshaprBuf(); }
+
+    CABACDecoder    cabacDecoder;
+    DecCu           cuDecoder;
+    TrQuant         trQuant;
+    IntraPrediction intraPred;
+    InterPrediction interPred;
+    RdCost          rdCost;
+    Reshape         reshaper;
+  };
+
+  /// CTUs of one CTU row within one tile of the slice, decoded into a coding structure of its own
+  struct CtuRowSegment
+  {
+    CtuRowSegment() : cs( cuCache, puCache, tuCache ), pltMode( false ) {}
+    ~CtuRowSegment() { cs.destroy(); }
+
+    CUCache         cuCache;
+    PUCache         puCache;
+    TUCache         tuCache;
+    CodingStructure cs;
+    ProgressCounter parsed;         ///< number of parsed CTUs
+    ProgressCounter reconstructed;  ///< number of reconstructed CTUs
+    Ctx             syncCtxState;   ///< contexts after the first CTU, for the wavefront synchronisation of the row below
+    PLTBuf          syncPLTState;   ///< palette predictor after the first CTU
+
+    unsigned        firstCtuIdx;    ///< index of the first CTU within the slice
+    unsigned        numCtus;
+    unsigned        substreamIdx;
+    int             aboveSegIdx;    ///< segment of the CTU row above in the same tile and slice, -1 if none
+    bool            laneStart;      ///< first segment of a job
+    bool            pltMode;        ///< palette mode the coding structure has been created for
+  };
+
   // access channel
   CABACDecoder*   m_CABACDecoder;
   DecCu*          m_pcCuDecoder;
+  TrQuant*        m_pcTrQuant;
+  DeblockingFilter* m_pcDeblockingFilter;
 
   Ctx             m_entropyCodingSyncContextState;      ///< context storage for state of contexts at the wavefront/WPP/entropy-coding-sync second CTU of tile-row
   PLTBuf          m_palettePredictorSyncState;      /// palette predictor storage at wavefront/WPP
 
+  ThreadPool*                                 m_threadPool;
+  bool                                        m_pipelinedDecoding;
+  bool                                        m_picDeblocked;   // picture deblocked by the pipeline of its only slice
+  std::vector<std::unique_ptr<CtuDecoder>>    m_ctuDecoders;    // per thread CTU decoding tools
+  std::vector<std::unique_ptr<CtuRowSegment>> m_rowSegments;
+
+  bool  xUseParallelDecoding  ( const Slice* slice, const unsigned numSubstreams, const int debugCTU ) const;
+  void  xDecompressSliceParallel( Slice* slice, std::vector<InputBitstream*>& substreams );
+  void  xParseRowSegment      ( Slice* slice, std::vector<InputBitstream*>& substreams, const unsigned segIdx, CABACReader& cabacReader, int (&prevQP)[MAX_NUM_CHANNEL_TYPE] );
+  void  xReconstructRowSegment( Slice* slice, const unsigned segIdx, DecCu& cuDecoder );
+  void  xFilterRowSegments    ( Slice* slice, const unsigned numSegs );
+
 public:
   DecSlice();
   virtual ~DecSlice();
 
-  void  init              ( CABACDecoder* cabacDecoder, DecCu* pcMbDecoder );
+  void  init              ( CABACDecoder* cabacDecoder, DecCu* pcMbDecoder, TrQuant* pcTrQuant, DeblockingFilter* pcDeblockingFilter );
   void  create            ();
   void  destroy           ();
+  void  setThreadPool     ( ThreadPool* threadPool ) { m_threadPool = threadPool; }
+  void  setPipelinedDecoding( bool b )                 { m_pipelinedDecoding = b; }
+  bool  getPicDeblocked   () const                     { return m_picDeblocked; }
 
   void  decompressSlice   ( Slice* slice, InputBitstream* bitstream, int debugCTU );
 };
@@ -576,6 +576,13 @@ void EncAdaptiveLoopFilter::create( const EncCfg* encCfg, const int picWidth, co
   m_buf                   = new PelBuf( m_bufOrigin, picWidth >> getComponentScaleX(COMPONENT_Cb,chromaFormatIDC), picWidth >> getComponentScaleX(COMPONENT_Cb,chromaFormatIDC), picHeight >> getComponentScaleY(COMPONENT_Cb,chromaFormatIDC) );
   m_lumaSwingGreaterThanThresholdCount = new uint64_t[m_numCTUsInPic];
   m_chromaSampleCountNearMidPoint = new uint64_t[m_numCTUsInPic];
+
+  for( int channelIdx = 0; channelIdx < MAX_NUM_CHANNEL_TYPE; channelIdx++ )
+  {
+    m_intCovariance[channelIdx] = internalBitDepth[channelIdx] <= 10;
+    m_frameStatsKey[channelIdx].clear();
+  }
+  m_covarianceAcc.push_back( new AlfCovarianceAcc() );
 }
 
 void EncAdaptiveLoopFilter::destroy()
@@ -786,6 +793,12 @@ void EncAdaptiveLoopFilter::destroy()
     m_chromaSampleCountNearMidPoint = nullptr;
   }
 
+  for (auto &covAcc: m_covarianceAcc)
+  {
+    delete covAcc;
+  }
+  m_covarianceAcc.clear();
+
   AdaptiveLoopFilter::destroy();
 }
 
@@ -2060,6 +2073,26 @@ void EncAdaptiveLoopFilter::getFrameStats(ChannelType channel, int shapeIdx)
 {
   int numClasses = isLuma( channel ) ? MAX_NUM_ALF_CLASSES : 1;
   int numAlternatives = isLuma( channel ) ? 1 : m_alfParamTemp.numAlternativesChroma;
+
+  // The filter derivation trials often collect the stats for unchanged CTU decisions, e.g. all CTUs on for the linear
+  // and the non-linear filters or the last iterations of the CTU decision, the previous sums are reused then
+  std::vector<uint8_t> statsKey{ uint8_t( shapeIdx ), uint8_t( numAlternatives ) };
+  const ComponentID firstComp = isLuma( channel ) ? COMPONENT_Y : COMPONENT_Cb;
+  const ComponentID lastComp  = isLuma( channel ) ? COMPONENT_Y : COMPONENT_Cr;
+  for( int compIdx = firstComp; compIdx <= lastComp; compIdx++ )
+  {
+    statsKey.insert( statsKey.end(), m_ctuEnableFlag[compIdx], m_ctuEnableFlag[compIdx] + m_numCTUsInPic );
+    if( isChroma( channel ) )
+    {
+      statsKey.insert( statsKey.end(), m_ctuAlternative[compIdx], m_ctuAlternative[compIdx] + m_numCTUsInPic );
+    }
+  }
+  if( statsKey == m_frameStatsKey[channel] )
+  {
+    return;
+  }
+  m_frameStatsKey[channel].swap( statsKey );
+
   // When calling this function m_ctuEnableFlag shall be set to 0 for CTUs using alternative APS
   // Here we compute frame stats for building new alternative filters
   for( int altIdx = 0; altIdx < numAlternatives; ++altIdx )
@@ -2103,7 +2136,6 @@ void EncAdaptiveLoopFilter::getFrameStat( AlfCovariance* frameCov, AlfCovariance
 
 void EncAdaptiveLoopFilter::deriveStatsForFiltering( PelUnitBuf& orgYuv, PelUnitBuf& recYuv, CodingStructure& cs )
 {
-  int ctuRsAddr = 0;
   const int numberOfComponents = getNumberValidComponents( m_chromaFormat );
 
   // init CTU stats buffers
@@ -2145,143 +2177,173 @@ void EncAdaptiveLoopFilter::deriveStatsForFiltering( PelUnitBuf& orgYuv, PelUnit
     }
   }
 
+  // frame stats collected by getFrameStats are invalid now
+  for( int channelIdx = 0; channelIdx < numberOfChannels; channelIdx++ )
+  {
+    m_frameStatsKey[channelIdx].clear();
+  }
+
   const PreCalcValues& pcv = *cs.pcv;
-  bool clipTop = false, clipBottom = false, clipLeft = false, clipRight = false;
-  int numHorVirBndry = 0, numVerVirBndry = 0;
-  int horVirBndryPos[] = { 0, 0, 0 };
-  int verVirBndryPos[] = { 0, 0, 0 };
 
-  for( int yPos = 0; yPos < m_picHeight; yPos += m_maxCUHeight )
+  auto deriveCtuStats = [&]( const int xPos, const int yPos, const int ctuRsAddr, PelStorage& tempBuf, AlfCovarianceAcc& covAcc )
   {
-    for( int xPos = 0; xPos < m_picWidth; xPos += m_maxCUWidth )
+    bool clipTop = false, clipBottom = false, clipLeft = false, clipRight = false;
+    int numHorVirBndry = 0, numVerVirBndry = 0;
+    int horVirBndryPos[] = { 0, 0, 0 };
+    int verVirBndryPos[] = { 0, 0, 0 };
+
+    const int width = ( xPos + m_maxCUWidth > m_picWidth ) ? ( m_picWidth - xPos ) : m_maxCUWidth;
+    const int height = ( yPos + m_maxCUHeight > m_picHeight ) ? ( m_picHeight - yPos ) : m_maxCUHeight;
+    int rasterSliceAlfPad = 0;
+    if( isCrossedByVirtualBoundaries( cs, xPos, yPos, width, height, clipTop, clipBottom, clipLeft, clipRight, numHorVirBndry, numVerVirBndry, horVirBndryPos, verVirBndryPos, rasterSliceAlfPad ) )
     {
-      const int width = ( xPos + m_maxCUWidth > m_picWidth ) ? ( m_picWidth - xPos ) : m_maxCUWidth;
-      const int height = ( yPos + m_maxCUHeight > m_picHeight ) ? ( m_picHeight - yPos ) : m_maxCUHeight;
-      int rasterSliceAlfPad = 0;
-      if( isCrossedByVirtualBoundaries( cs, xPos, yPos, width, height, clipTop, clipBottom, clipLeft, clipRight, numHorVirBndry, numVerVirBndry, horVirBndryPos, verVirBndryPos, rasterSliceAlfPad ) )
+      int yStart = yPos;
+      for( int i = 0; i <= numHorVirBndry; i++ )
       {
-        int yStart = yPos;
-        for( int i = 0; i <= numHorVirBndry; i++ )
+        const int yEnd = i == numHorVirBndry ? yPos + height : horVirBndryPos[i];
+        const int h = yEnd - yStart;
+        const bool clipT = ( i == 0 && clipTop ) || ( i > 0 ) || ( yStart == 0 );
+        const bool clipB = ( i == numHorVirBndry && clipBottom ) || ( i < numHorVirBndry ) || ( yEnd == pcv.lumaHeight );
+        int xStart = xPos;
+        for( int j = 0; j <= numVerVirBndry; j++ )
         {
-          const int yEnd = i == numHorVirBndry ? yPos + height : horVirBndryPos[i];
-          const int h = yEnd - yStart;
-          const bool clipT = ( i == 0 && clipTop ) || ( i > 0 ) || ( yStart == 0 );
-          const bool clipB = ( i == numHorVirBndry && clipBottom ) || ( i < numHorVirBndry ) || ( yEnd == pcv.lumaHeight );
-          int xStart = xPos;
-          for( int j = 0; j <= numVerVirBndry; j++ )
+          const int xEnd = j == numVerVirBndry ? xPos + width : verVirBndryPos[j];
+          const int w = xEnd - xStart;
+          const bool clipL = ( j == 0 && clipLeft ) || ( j > 0 ) || ( xStart == 0 );
+          const bool clipR = ( j == numVerVirBndry && clipRight ) || ( j < numVerVirBndry ) || ( xEnd == pcv.lumaWidth );
+          const int wBuf = w + (clipL ? 0 : MAX_ALF_PADDING_SIZE) + (clipR ? 0 : MAX_ALF_PADDING_SIZE);
+          const int hBuf = h + (clipT ? 0 : MAX_ALF_PADDING_SIZE) + (clipB ? 0 : MAX_ALF_PADDING_SIZE);
+          PelUnitBuf recBuf = tempBuf.subBuf( UnitArea( cs.area.chromaFormat, Area( 0, 0, wBuf, hBuf ) ) );
+          recBuf.copyFrom( recYuv.subBuf( UnitArea( cs.area.chromaFormat, Area( xStart - (clipL ? 0 : MAX_ALF_PADDING_SIZE), yStart - (clipT ? 0 : MAX_ALF_PADDING_SIZE), wBuf, hBuf ) ) ) );
+          // pad top-left unavailable samples for raster slice
+          if ( xStart == xPos && yStart == yPos && ( rasterSliceAlfPad & 1 ) )
           {
-            const int xEnd = j == numVerVirBndry ? xPos + width : verVirBndryPos[j];
-            const int w = xEnd - xStart;
-            const bool clipL = ( j == 0 && clipLeft ) || ( j > 0 ) || ( xStart == 0 );
-            const bool clipR = ( j == numVerVirBndry && clipRight ) || ( j < numVerVirBndry ) || ( xEnd == pcv.lumaWidth );
-            const int wBuf = w + (clipL ? 0 : MAX_ALF_PADDING_SIZE) + (clipR ? 0 : MAX_ALF_PADDING_SIZE);
-            const int hBuf = h + (clipT ? 0 : MAX_ALF_PADDING_SIZE) + (clipB ? 0 : MAX_ALF_PADDING_SIZE);
-            PelUnitBuf recBuf = m_tempBuf2.subBuf( UnitArea( cs.area.chromaFormat, Area( 0, 0, wBuf, hBuf ) ) );
-            recBuf.copyFrom( recYuv.subBuf( UnitArea( cs.area.chromaFormat, Area( xStart - (clipL ? 0 : MAX_ALF_PADDING_SIZE), yStart - (clipT ? 0 : MAX_ALF_PADDING_SIZE), wBuf, hBuf ) ) ) );
-            // pad top-left unavailable samples for raster slice
-            if ( xStart == xPos && yStart == yPos && ( rasterSliceAlfPad & 1 ) )
-            {
-              recBuf.padBorderPel( MAX_ALF_PADDING_SIZE, 1 );
-            }
+            recBuf.padBorderPel( MAX_ALF_PADDING_SIZE, 1 );
+          }
 
-            // pad bottom-right unavailable samples for raster slice
-            if ( xEnd == xPos + width && yEnd == yPos + height && ( rasterSliceAlfPad & 2 ) )
-            {
-              recBuf.padBorderPel( MAX_ALF_PADDING_SIZE, 2 );
-            }
-            recBuf.extendBorderPel( MAX_ALF_PADDING_SIZE );
-            recBuf = recBuf.subBuf( UnitArea ( cs.area.chromaFormat, Area( clipL ? 0 : MAX_ALF_PADDING_SIZE, clipT ? 0 : MAX_ALF_PADDING_SIZE, w, h ) ) );
+          // pad bottom-right unavailable samples for raster slice
+          if ( xEnd == xPos + width && yEnd == yPos + height && ( rasterSliceAlfPad & 2 ) )
+          {
+            recBuf.padBorderPel( MAX_ALF_PADDING_SIZE, 2 );
+          }
+          recBuf.extendBorderPel( MAX_ALF_PADDING_SIZE );
+          recBuf = recBuf.subBuf( UnitArea ( cs.area.chromaFormat, Area( clipL ? 0 : MAX_ALF_PADDING_SIZE, clipT ? 0 : MAX_ALF_PADDING_SIZE, w, h ) ) );
 
-            const UnitArea area( m_chromaFormat, Area( 0, 0, w, h ) );
-            const UnitArea areaDst( m_chromaFormat, Area( xStart, yStart, w, h ) );
-            for( int compIdx = 0; compIdx < numberOfComponents; compIdx++ )
-            {
-              const ComponentID compID = ComponentID( compIdx );
-              const CompArea& compArea = area.block( compID );
+          const UnitArea area( m_chromaFormat, Area( 0, 0, w, h ) );
+          const UnitArea areaDst( m_chromaFormat, Area( xStart, yStart, w, h ) );
+          for( int compIdx = 0; compIdx < numberOfComponents; compIdx++ )
+          {
+            const ComponentID compID = ComponentID( compIdx );
+            const CompArea& compArea = area.block( compID );
 
-              int  recStride = recBuf.get( compID ).stride;
-              Pel* rec = recBuf.get( compID ).bufAt( compArea );
+            int  recStride = recBuf.get( compID ).stride;
+            Pel* rec = recBuf.get( compID ).bufAt( compArea );
 
-              int  orgStride = orgYuv.get(compID).stride;
-              Pel* org = orgYuv.get(compID).bufAt(xStart >> ::getComponentScaleX(compID, m_chromaFormat), yStart >> ::getComponentScaleY(compID, m_chromaFormat));
+            int  orgStride = orgYuv.get(compID).stride;
+            Pel* org = orgYuv.get(compID).bufAt(xStart >> ::getComponentScaleX(compID, m_chromaFormat), yStart >> ::getComponentScaleY(compID, m_chromaFormat));
 
-              ptrdiff_t orgLumaStride = orgYuv.get(COMPONENT_Y).stride;
-              Pel      *orgLuma       = orgYuv.get(COMPONENT_Y).bufAt(xStart, yStart);
+            ptrdiff_t orgLumaStride = orgYuv.get(COMPONENT_Y).stride;
+            Pel      *orgLuma       = orgYuv.get(COMPONENT_Y).bufAt(xStart, yStart);
 
-              ChannelType chType = toChannelType( compID );
+            ChannelType chType = toChannelType( compID );
 
-              for( int shape = 0; shape != m_filterShapes[chType].size(); shape++ )
-              {
-                const CompArea &compAreaDst = areaDst.block(compID);
-                getBlkStats(m_alfCovariance[compIdx][shape][ctuRsAddr], m_filterShapes[chType][shape],
-                            compIdx ? nullptr : m_classifier, org, orgStride, orgLuma, orgLumaStride, rec, recStride,
-                            compAreaDst, compArea, chType,
-                            ((compIdx == 0) ? m_alfVBLumaCTUHeight : m_alfVBChmaCTUHeight),
-                            (compIdx == 0) ? m_alfVBLumaPos : m_alfVBChmaPos);
-              }
+            for( int shape = 0; shape != m_filterShapes[chType].size(); shape++ )
+            {
+              const CompArea &compAreaDst = areaDst.block(compID);
+              getBlkStats(m_alfCovariance[compIdx][shape][ctuRsAddr], m_filterShapes[chType][shape],
+                          compIdx ? nullptr : m_classifier, org, orgStride, orgLuma, orgLumaStride, rec, recStride,
+                          compAreaDst, compArea, chType,
+                          ((compIdx == 0) ? m_alfVBLumaCTUHeight : m_alfVBChmaCTUHeight),
+                          (compIdx == 0) ? m_alfVBLumaPos : m_alfVBChmaPos, covAcc);
             }
-
-            xStart = xEnd;
           }
 
-          yStart = yEnd;
+          xStart = xEnd;
         }
 
-        for( int compIdx = 0; compIdx < numberOfComponents; compIdx++ )
-        {
-          const ComponentID compID = ComponentID( compIdx );
-
-          ChannelType chType = toChannelType( compID );
-
-          for( int shape = 0; shape != m_filterShapes[chType].size(); shape++ )
-          {
-            const int numClasses = isLuma( compID ) ? MAX_NUM_ALF_CLASSES : 1;
-
-            for( int classIdx = 0; classIdx < numClasses; classIdx++ )
-            {
-              m_alfCovarianceFrame[chType][shape][isLuma( compID ) ? classIdx : 0] += m_alfCovariance[compIdx][shape][ctuRsAddr][classIdx];
-            }
-          }
-        }
+        yStart = yEnd;
       }
-      else
+    }
+    else
+    {
+      const UnitArea area(m_chromaFormat, Area(xPos, yPos, width, height));
+
+      for (int compIdx = 0; compIdx < numberOfComponents; compIdx++)
       {
-        const UnitArea area(m_chromaFormat, Area(xPos, yPos, width, height));
+        const ComponentID compID   = ComponentID(compIdx);
+        const CompArea &  compArea = area.block(compID);
 
-        for (int compIdx = 0; compIdx < numberOfComponents; compIdx++)
-        {
-          const ComponentID compID   = ComponentID(compIdx);
-          const CompArea &  compArea = area.block(compID);
+        int  recStride = recYuv.get(compID).stride;
+        Pel *rec       = recYuv.get(compID).bufAt(compArea);
 
-          int  recStride = recYuv.get(compID).stride;
-          Pel *rec       = recYuv.get(compID).bufAt(compArea);
+        int  orgStride = orgYuv.get(compID).stride;
+        Pel *org       = orgYuv.get(compID).bufAt(compArea);
 
-          int  orgStride = orgYuv.get(compID).stride;
-          Pel *org       = orgYuv.get(compID).bufAt(compArea);
+        ptrdiff_t orgLumaStride = orgYuv.get(COMPONENT_Y).stride;
+        Pel      *orgLuma       = orgYuv.get(COMPONENT_Y).bufAt(area.block(COMPONENT_Y));
 
-          ptrdiff_t orgLumaStride = orgYuv.get(COMPONENT_Y).stride;
-          Pel      *orgLuma       = orgYuv.get(COMPONENT_Y).bufAt(area.block(COMPONENT_Y));
+        ChannelType chType = toChannelType(compID);
 
-          ChannelType chType = toChannelType(compID);
+        for (int shape = 0; shape != m_filterShapes[chType].size(); shape++)
+        {
+          getBlkStats(m_alfCovariance[compIdx][shape][ctuRsAddr], m_filterShapes[chType][shape],
+                      compIdx ? nullptr : m_classifier, org, orgStride, orgLuma, orgLumaStride, rec, recStride,
+                      compArea, compArea, chType, ((compIdx == 0) ? m_alfVBLumaCTUHeight : m_alfVBChmaCTUHeight),
+                      (compIdx == 0) ? m_alfVBLumaPos : m_alfVBChmaPos, covAcc);
+        }
+      }
+    }
+  };
 
-          for (int shape = 0; shape != m_filterShapes[chType].size(); shape++)
-          {
-            getBlkStats(m_alfCovariance[compIdx][shape][ctuRsAddr], m_filterShapes[chType][shape],
-                        compIdx ? nullptr : m_classifier, org, orgStride, orgLuma, orgLumaStride, rec, recStride,
-                        compArea, compArea, chType, ((compIdx == 0) ? m_alfVBLumaCTUHeight : m_alfVBChmaCTUHeight),
-                        (compIdx == 0) ? m_alfVBLumaPos : m_alfVBChmaPos);
+  // the CTU stats are independent, CTU rows are collected in parallel if the thread pool has worker threads
+  if( m_threadPool && m_threadPool->getNumThreads() > 0 )
+  {
+    createThreadBufs();
+    while( m_covarianceAcc.size() < m_threadPool->getNumThreadSlots() )
+    {
+      m_covarianceAcc.push_back( new AlfCovarianceAcc() );
+    }
+    for( int yPos = 0, ctuRsAddr = 0; yPos < m_picHeight; yPos += m_maxCUHeight, ctuRsAddr += m_numCTUsInWidth )
+    {
+      m_threadPool->addJob( [this, &deriveCtuStats, yPos, ctuRsAddr]( int threadIdx )
+      {
+        for( int xPos = 0, ctuIdx = ctuRsAddr; xPos < m_picWidth; xPos += m_maxCUWidth, ctuIdx++ )
+        {
+          deriveCtuStats( xPos, yPos, ctuIdx, m_threadBufs[threadIdx]->tempBuf, *m_covarianceAcc[threadIdx] );
+        }
+      } );
+    }
+    m_threadPool->waitForJobs();
+  }
+  else
+  {
+    int ctuRsAddr = 0;
+    for( int yPos = 0; yPos < m_picHeight; yPos += m_maxCUHeight )
+    {
+      for( int xPos = 0; xPos < m_picWidth; xPos += m_maxCUWidth )
+      {
+        deriveCtuStats( xPos, yPos, ctuRsAddr, m_tempBuf2, *m_covarianceAcc[0] );
+        ctuRsAddr++;
+      }
+    }
+  }
 
-            const int numClasses = isLuma(compID) ? MAX_NUM_ALF_CLASSES : 1;
+  // frame stats are summed up in CTU raster scan order independent of the CTU processing order
+  for( int ctuRsAddr = 0; ctuRsAddr < m_numCTUsInPic; ctuRsAddr++ )
+  {
+    for( int compIdx = 0; compIdx < numberOfComponents; compIdx++ )
+    {
+      const ComponentID compID = ComponentID( compIdx );
+      const ChannelType chType = toChannelType( compID );
+      const int numClasses = isLuma( compID ) ? MAX_NUM_ALF_CLASSES : 1;
 
-            for (int classIdx = 0; classIdx < numClasses; classIdx++)
-            {
-              m_alfCovarianceFrame[chType][shape][isLuma(compID) ? classIdx : 0] +=
-                m_alfCovariance[compIdx][shape][ctuRsAddr][classIdx];
-            }
-          }
+      for( int shape = 0; shape != m_filterShapes[chType].size(); shape++ )
+      {
+        for( int classIdx = 0; classIdx < numClasses; classIdx++ )
+        {
+          m_alfCovarianceFrame[chType][shape][isLuma( compID ) ? classIdx : 0] += m_alfCovariance[compIdx][shape][ctuRsAddr][classIdx];
         }
       }
-      ctuRsAddr++;
     }
   }
 }
@@ -2290,7 +2352,7 @@ void EncAdaptiveLoopFilter::getBlkStats(AlfCovariance *alfCovariance, const AlfF
                                         AlfClassifier **classifier, Pel *org, const int orgStride, const Pel *orgLuma,
                                         const ptrdiff_t orgLumaStride, Pel *rec, const int recStride,
                                         const CompArea &areaDst, const CompArea &area, const ChannelType channel,
-                                        int vbCTUHeight, int vbPos)
+                                        int vbCTUHeight, int vbPos, AlfCovarianceAcc &covAcc)
 {
   Pel ELocal[MAX_NUM_ALF_LUMA_COEFF][MAX_ALF_NUM_CLIP_VALS];
 
@@ -2300,60 +2362,125 @@ void EncAdaptiveLoopFilter::getBlkStats(AlfCovariance *alfCovariance, const AlfF
     isLuma(channel) ? m_encCfg->getALFStrengthTargetLuma() : m_encCfg->getALFStrengthTargetChroma();
   const double invStrength = strength != 0.0 ? 1.0 / strength : 0.0;
 
-  for( int i = 0; i < area.height; i++ )
+  if (m_intCovariance[channel] && !m_alfWSSD && invStrength == 1.0)
   {
-    const int vbDistance = ((areaDst.y + i) % vbCTUHeight) - vbPos;
-    for( int j = 0; j < area.width; j++ )
-    {
-      std::fill_n(ELocal[0], MAX_NUM_ALF_LUMA_COEFF * MAX_ALF_NUM_CLIP_VALS, 0);
+    // Without weighting and scaling all products are integers, E is accumulated exactly in 32 bits for two
+    // horizontally adjacent samples of the same class at a time and added to the double precision stats in time
+    const int numCoeff = shape.numCoeff;
+    int16_t   ePair[2 * m_COV_ACC_STRIDE] = { 0 };
 
-      int transposeIdx = 0;
-      int classIdx     = 0;
-      if( classifier )
+    for (int i = 0; i < area.height; i++)
+    {
+      const int vbDistance = ((areaDst.y + i) % vbCTUHeight) - vbPos;
+      for (int j = 0; j < area.width;)
       {
-        AlfClassifier& cl = classifier[areaDst.y + i][areaDst.x + j];
-        transposeIdx = cl.transposeIdx;
-        classIdx = cl.classIdx;
-      }
+        const int classIdx = classifier ? classifier[areaDst.y + i][areaDst.x + j].classIdx : 0;
+        const int numSamples =
+          j + 1 < area.width && (!classifier || classifier[areaDst.y + i][areaDst.x + j + 1].classIdx == classIdx) ? 2
+                                                                                                                    : 1;
 
-      calcCovariance(ELocal, rec + j, recStride, shape, transposeIdx, channel, vbDistance);
+        for (int s = 0; s < numSamples; s++)
+        {
+          std::fill_n(ELocal[0], MAX_NUM_ALF_LUMA_COEFF * MAX_ALF_NUM_CLIP_VALS, 0);
 
-      const ComponentID compID  = channel == CHANNEL_TYPE_LUMA ? COMPONENT_Y : COMPONENT_Cb;
-      const Pel        *lumaPtr = orgLuma + (i << ::getComponentScaleY(compID, m_chromaFormat)) * orgLumaStride
-                           + (j << ::getComponentScaleX(compID, m_chromaFormat));
-      const double weight = m_alfWSSD ? m_lumaLevelToWeightPLUT[*lumaPtr] : 1.0;
-      const double yLocal = org[j] - rec[j];
+          const int transposeIdx = classifier ? classifier[areaDst.y + i][areaDst.x + j + s].transposeIdx : 0;
+          calcCovariance(ELocal, rec + j + s, recStride, shape, transposeIdx, channel, vbDistance);
 
-      double e[MAX_ALF_NUM_CLIP_VALS][MAX_NUM_ALF_LUMA_COEFF];
+          const int yLocal = org[j + s] - rec[j + s];
+          for (int k = 0; k < numCoeff; k++)
+          {
+            for (int b = 0; b < numBins; b++)
+            {
+              ePair[2 * (k * numBins + b) + s] = ELocal[k][b];
+              alfCovariance[classIdx].y[b][k] += ELocal[k][b] * yLocal;
+            }
+          }
+          alfCovariance[classIdx].pixAcc += yLocal * yLocal;
+        }
+        if (numSamples == 1)
+        {
+          for (int f = 0; f < numCoeff * numBins; f++)
+          {
+            ePair[2 * f + 1] = 0;
+          }
+        }
 
-      for (int b = 0; b < numBins; b++)
-      {
-        for (int k = 0; k < shape.numCoeff; k++)
+        m_accumulateCovariance(covAcc.E[classIdx], ePair, numCoeff, numBins);
+        if (++covAcc.numPairs[classIdx] == AlfCovarianceAcc::MAX_NUM_PAIRS)
         {
-          e[b][k] = invStrength * ELocal[k][b];
+          flushCovarianceAcc(alfCovariance[classIdx], covAcc, classIdx, numCoeff, numBins);
         }
+        j += numSamples;
       }
+      org += orgStride;
+      rec += recStride;
+    }
 
-      for (int b0 = 0; b0 < numBins; b0++)
+    for (int classIdx = 0; classIdx < (classifier ? MAX_NUM_ALF_CLASSES : 1); classIdx++)
+    {
+      if (covAcc.numPairs[classIdx] > 0)
       {
-        for (int k = 0; k < shape.numCoeff; k++)
+        flushCovarianceAcc(alfCovariance[classIdx], covAcc, classIdx, numCoeff, numBins);
+      }
+    }
+  }
+  else
+  {
+    for (int i = 0; i < area.height; i++)
+    {
+      const int vbDistance = ((areaDst.y + i) % vbCTUHeight) - vbPos;
+      for (int j = 0; j < area.width; j++)
+      {
+        std::fill_n(ELocal[0], MAX_NUM_ALF_LUMA_COEFF * MAX_ALF_NUM_CLIP_VALS, 0);
+
+        int transposeIdx = 0;
+        int classIdx     = 0;
+        if (classifier)
         {
-          const double we = weight * e[b0][k];
+          AlfClassifier &cl = classifier[areaDst.y + i][areaDst.x + j];
+          transposeIdx      = cl.transposeIdx;
+          classIdx          = cl.classIdx;
+        }
 
-          for (int b1 = 0; b1 < numBins; b1++)
+        calcCovariance(ELocal, rec + j, recStride, shape, transposeIdx, channel, vbDistance);
+
+        const ComponentID compID  = channel == CHANNEL_TYPE_LUMA ? COMPONENT_Y : COMPONENT_Cb;
+        const Pel        *lumaPtr = orgLuma + (i << ::getComponentScaleY(compID, m_chromaFormat)) * orgLumaStride
+                             + (j << ::getComponentScaleX(compID, m_chromaFormat));
+        const double weight = m_alfWSSD ? m_lumaLevelToWeightPLUT[*lumaPtr] : 1.0;
+        const double yLocal = org[j] - rec[j];
+
+        double e[MAX_ALF_NUM_CLIP_VALS][MAX_NUM_ALF_LUMA_COEFF];
+
+        for (int b = 0; b < numBins; b++)
+        {
+          for (int k = 0; k < shape.numCoeff; k++)
+          {
+            e[b][k] = invStrength * ELocal[k][b];
+          }
+        }
+
+        for (int b0 = 0; b0 < numBins; b0++)
+        {
+          for (int k = 0; k < shape.numCoeff; k++)
           {
-            for (int l = k; l < shape.numCoeff; l++)
+            const double we = weight * e[b0][k];
+
+            for (int b1 = 0; b1 < numBins; b1++)
             {
-              alfCovariance[classIdx].E[b0][b1][k][l] += we * e[b1][l];
+              for (int l = k; l < shape.numCoeff; l++)
+              {
+                alfCovariance[classIdx].E[b0][b1][k][l] += we * e[b1][l];
+              }
             }
+            alfCovariance[classIdx].y[b0][k] += we * yLocal;
           }
-          alfCovariance[classIdx].y[b0][k] += we * yLocal;
         }
+        alfCovariance[classIdx].pixAcc += weight * yLocal * yLocal;
       }
-      alfCovariance[classIdx].pixAcc += weight * yLocal * yLocal;
+      org += orgStride;
+      rec += recStride;
     }
-    org += orgStride;
-    rec += recStride;
   }
 
   const int numClasses = classifier ? MAX_NUM_ALF_CLASSES : 1;
@@ -2375,6 +2502,27 @@ void EncAdaptiveLoopFilter::getBlkStats(AlfCovariance *alfCovariance, const AlfF
   }
 }
 
+void EncAdaptiveLoopFilter::flushCovarianceAcc(AlfCovariance &alfCovariance, AlfCovarianceAcc &covAcc,
+                                               const int classIdx, const int numCoeff, const int numBins)
+{
+  for (int k = 0; k < numCoeff; k++)
+  {
+    for (int b0 = 0; b0 < numBins; b0++)
+    {
+      int *accRow = covAcc.E[classIdx] + (k * numBins + b0) * m_COV_ACC_STRIDE;
+      for (int l = k; l < numCoeff; l++)
+      {
+        for (int b1 = 0; b1 < numBins; b1++)
+        {
+          alfCovariance.E[b0][b1][k][l] += accRow[l * numBins + b1];
+        }
+      }
+      std::fill_n(accRow, m_COV_ACC_STRIDE, 0);
+    }
+  }
+  covAcc.numPairs[classIdx] = 0;
+}
+
 void EncAdaptiveLoopFilter::calcCovariance(Pel ELocal[MAX_NUM_ALF_LUMA_COEFF][MAX_ALF_NUM_CLIP_VALS], const Pel *rec,
                                            const int stride, const AlfFilterShape &shape, const int transposeIdx,
                                            const ChannelType channel, int vbDistance)
@@ -3139,145 +3287,9 @@ void EncAdaptiveLoopFilter::alfReconstructor(CodingStructure& cs, const PelUnitB
   }
   reconstructCoeffAPSs(cs, true, cs.slice->getAlfEnabledFlag(COMPONENT_Cb) || cs.slice->getAlfEnabledFlag(COMPONENT_Cr), false);
   short* alfCtuFilterIndex = cs.slice->getPic()->getAlfCtbFilterIndex();
-  PelUnitBuf& recBuf = cs.getRecoBufRef();
-  const PreCalcValues& pcv = *cs.pcv;
-
-  int ctuIdx = 0;
-  bool clipTop = false, clipBottom = false, clipLeft = false, clipRight = false;
-  int numHorVirBndry = 0, numVerVirBndry = 0;
-  int horVirBndryPos[] = { 0, 0, 0 };
-  int verVirBndryPos[] = { 0, 0, 0 };
-  for (int yPos = 0; yPos < pcv.lumaHeight; yPos += pcv.maxCUHeight)
-  {
-    for (int xPos = 0; xPos < pcv.lumaWidth; xPos += pcv.maxCUWidth)
-    {
-      const int width = (xPos + pcv.maxCUWidth > pcv.lumaWidth) ? (pcv.lumaWidth - xPos) : pcv.maxCUWidth;
-      const int height = (yPos + pcv.maxCUHeight > pcv.lumaHeight) ? (pcv.lumaHeight - yPos) : pcv.maxCUHeight;
-
-      bool ctuEnableFlag = m_ctuEnableFlag[COMPONENT_Y][ctuIdx];
-      for (int compIdx = 1; compIdx < MAX_NUM_COMPONENT; compIdx++)
-      {
-        ctuEnableFlag |= m_ctuEnableFlag[compIdx][ctuIdx] > 0;
-      }
-      int rasterSliceAlfPad = 0;
-      if ( ctuEnableFlag && isCrossedByVirtualBoundaries( cs, xPos, yPos, width, height, clipTop, clipBottom, clipLeft, clipRight, numHorVirBndry, numVerVirBndry, horVirBndryPos, verVirBndryPos, rasterSliceAlfPad ) )
-      {
-        int yStart = yPos;
-        for (int i = 0; i <= numHorVirBndry; i++)
-        {
-          const int yEnd = i == numHorVirBndry ? yPos + height : horVirBndryPos[i];
-          const int h = yEnd - yStart;
-          const bool clipT = (i == 0 && clipTop) || (i > 0) || (yStart == 0);
-          const bool clipB = (i == numHorVirBndry && clipBottom) || (i < numHorVirBndry ) || (yEnd == pcv.lumaHeight);
-          int xStart = xPos;
-          for (int j = 0; j <= numVerVirBndry; j++)
-          {
-            const int xEnd = j == numVerVirBndry ? xPos + width : verVirBndryPos[j];
-            const int w = xEnd - xStart;
-            const bool clipL = (j == 0 && clipLeft) || (j > 0) || (xStart == 0);
-            const bool clipR = (j == numVerVirBndry && clipRight) || (j < numVerVirBndry ) || (xEnd == pcv.lumaWidth);
-            const int wBuf = w + (clipL ? 0 : MAX_ALF_PADDING_SIZE) + (clipR ? 0 : MAX_ALF_PADDING_SIZE);
-            const int hBuf = h + (clipT ? 0 : MAX_ALF_PADDING_SIZE) + (clipB ? 0 : MAX_ALF_PADDING_SIZE);
-            PelUnitBuf buf = m_tempBuf2.subBuf(UnitArea(cs.area.chromaFormat, Area(0, 0, wBuf, hBuf)));
-            buf.copyFrom(recExtBuf.subBuf(UnitArea(cs.area.chromaFormat, Area(xStart - (clipL ? 0 : MAX_ALF_PADDING_SIZE), yStart - (clipT ? 0 : MAX_ALF_PADDING_SIZE), wBuf, hBuf))));
-            // pad top-left unavailable samples for raster slice
-            if ( xStart == xPos && yStart == yPos && ( rasterSliceAlfPad & 1 ) )
-            {
-              buf.padBorderPel( MAX_ALF_PADDING_SIZE, 1 );
-            }
-
-            // pad bottom-right unavailable samples for raster slice
-            if ( xEnd == xPos + width && yEnd == yPos + height && ( rasterSliceAlfPad & 2 ) )
-            {
-              buf.padBorderPel( MAX_ALF_PADDING_SIZE, 2 );
-            }
-            buf.extendBorderPel(MAX_ALF_PADDING_SIZE);
-            buf = buf.subBuf(UnitArea(cs.area.chromaFormat, Area(clipL ? 0 : MAX_ALF_PADDING_SIZE, clipT ? 0 : MAX_ALF_PADDING_SIZE, w, h)));
-
-            if (m_ctuEnableFlag[COMPONENT_Y][ctuIdx])
-            {
-              const Area blkSrc(0, 0, w, h);
-              const Area blkDst(xStart, yStart, w, h);
-              short filterSetIndex = alfCtuFilterIndex[ctuIdx];
-              short *coeff;
-              Pel *clip;
-              if (filterSetIndex >= NUM_FIXED_FILTER_SETS)
-              {
-                coeff = m_coeffApsLuma[filterSetIndex - NUM_FIXED_FILTER_SETS];
-                clip = m_clippApsLuma[filterSetIndex - NUM_FIXED_FILTER_SETS];
-              }
-              else
-              {
-                coeff = m_fixedFilterSetCoeffDec[filterSetIndex];
-                clip = m_clipDefault;
-              }
-              m_filter7x7Blk(m_classifier, recBuf, buf, blkDst, blkSrc, COMPONENT_Y, coeff, clip,
-                             m_clpRngs.comp[COMPONENT_Y], cs, m_alfVBLumaCTUHeight, m_alfVBLumaPos);
-            }
 
-            for (int compIdx = 1; compIdx < MAX_NUM_COMPONENT; compIdx++)
-            {
-              ComponentID compID = ComponentID(compIdx);
-              const int chromaScaleX = getComponentScaleX(compID, recBuf.chromaFormat);
-              const int chromaScaleY = getComponentScaleY(compID, recBuf.chromaFormat);
-              if (m_ctuEnableFlag[compIdx][ctuIdx])
-              {
-                const Area blkSrc(0, 0, w >> chromaScaleX, h >> chromaScaleY);
-                const Area blkDst(xStart >> chromaScaleX, yStart >> chromaScaleY, w >> chromaScaleX, h >> chromaScaleY);
-                const int alt_num = m_ctuAlternative[compID][ctuIdx];
-                m_filter5x5Blk(m_classifier, recBuf, buf, blkDst, blkSrc, compID, m_chromaCoeffFinal[alt_num],
-                               m_chromaClippFinal[alt_num], m_clpRngs.comp[compIdx], cs, m_alfVBChmaCTUHeight,
-                               m_alfVBChmaPos);
-              }
-            }
-
-            xStart = xEnd;
-          }
-
-          yStart = yEnd;
-        }
-      }
-      else
-      {
-        const UnitArea area(cs.area.chromaFormat, Area(xPos, yPos, width, height));
-        if (m_ctuEnableFlag[COMPONENT_Y][ctuIdx])
-        {
-          Area   blk(xPos, yPos, width, height);
-          short  filterSetIndex = alfCtuFilterIndex[ctuIdx];
-          short *coeff;
-          Pel *clip;
-          if (filterSetIndex >= NUM_FIXED_FILTER_SETS)
-          {
-            coeff = m_coeffApsLuma[filterSetIndex - NUM_FIXED_FILTER_SETS];
-            clip  = m_clippApsLuma[filterSetIndex - NUM_FIXED_FILTER_SETS];
-          }
-          else
-          {
-            coeff = m_fixedFilterSetCoeffDec[filterSetIndex];
-            clip  = m_clipDefault;
-          }
-          m_filter7x7Blk(m_classifier, recBuf, recExtBuf, blk, blk, COMPONENT_Y, coeff, clip,
-                         m_clpRngs.comp[COMPONENT_Y], cs, m_alfVBLumaCTUHeight, m_alfVBLumaPos);
-        }
-
-        for (int compIdx = 1; compIdx < MAX_NUM_COMPONENT; compIdx++)
-        {
-          ComponentID compID       = ComponentID(compIdx);
-          const int   chromaScaleX = getComponentScaleX(compID, recBuf.chromaFormat);
-          const int   chromaScaleY = getComponentScaleY(compID, recBuf.chromaFormat);
-          if (m_ctuEnableFlag[compIdx][ctuIdx])
-          {
-            Area      blk(xPos >> chromaScaleX, yPos >> chromaScaleY, width >> chromaScaleX, height >> chromaScaleY);
-            const int alt_num = m_ctuAlternative[compID][ctuIdx];
-            m_filter5x5Blk(m_classifier, recBuf, recExtBuf, blk, blk, compID, m_chromaCoeffFinal[alt_num],
-                           m_chromaClippFinal[alt_num], m_clpRngs.comp[compIdx], cs, m_alfVBChmaCTUHeight,
-                           m_alfVBChmaPos);
-          }
-        }
-      }
-      ctuIdx++;
-    }
-  }
+  // the classification has already been derived for the whole picture, CC-ALF is applied separately
+  filterCTURows(cs, cs.getRecoBufRef(), recExtBuf, alfCtuFilterIndex, false, false, nullptr);
 }
 
 void EncAdaptiveLoopFilter::copyCtuAlternativeChroma( uint8_t* ctuAltsDst[MAX_NUM_COMPONENT], uint8_t* ctuAltsSrc[MAX_NUM_COMPONENT] )
@@ -228,6 +228,15 @@ public:
   void setLumaLevelWeightTable(const std::vector<double> &weightTable) { m_lumaLevelToWeightPLUT = weightTable; }
 
 private:
+  // integer accumulators of the unweighted block statistics, one set is used per thread
+  struct AlfCovarianceAcc
+  {
+    static constexpr int MAX_NUM_PAIRS = 128;   // pair updates before the 32-bit sums of up to 10-bit samples overflow
+
+    int E[MAX_NUM_ALF_CLASSES][m_COV_ACC_STRIDE * m_COV_ACC_STRIDE];
+    int numPairs[MAX_NUM_ALF_CLASSES];
+  };
+
   bool                m_alfWSSD{ false };
   std::vector<double> m_lumaLevelToWeightPLUT;
 
@@ -239,6 +248,9 @@ private:
   uint8_t*               m_ctuAlternativeTmp[MAX_NUM_COMPONENT];
   AlfCovariance***       m_alfCovarianceCcAlf[2];           // [compIdx-1][shapeIdx][filterIdx][ctbAddr]
   AlfCovariance**        m_alfCovarianceFrameCcAlf[2];      // [compIdx-1][shapeIdx][filterIdx]
+  bool                   m_intCovariance[MAX_NUM_CHANNEL_TYPE];     // sample range allows the integer accumulators
+  std::vector<AlfCovarianceAcc*> m_covarianceAcc;
+  std::vector<uint8_t>   m_frameStatsKey[MAX_NUM_CHANNEL_TYPE];     // CTU decisions of the current frame stats
 
   //for RDO
   AlfParam               m_alfParamTemp;
@@ -321,7 +333,9 @@ private:
   void   getBlkStats(AlfCovariance *alfCovariace, const AlfFilterShape &shape, AlfClassifier **classifier, Pel *org,
                      const int orgStride, const Pel *orgLuma, const ptrdiff_t orgLumaStride, Pel *rec,
                      const int recStride, const CompArea &areaDst, const CompArea &area, const ChannelType channel,
-                     int vbCTUHeight, int vbPos);
+                     int vbCTUHeight, int vbPos, AlfCovarianceAcc &covAcc);
+  void   flushCovarianceAcc(AlfCovariance &alfCovariance, AlfCovarianceAcc &covAcc, const int classIdx,
+                            const int numCoeff, const int numBins);
   void   calcCovariance(Pel ELocal[MAX_NUM_ALF_LUMA_COEFF][MAX_ALF_NUM_CLIP_VALS], const Pel *rec, const int stride,
                         const AlfFilterShape &shape, const int transposeIdx, const ChannelType channel, int vbDistance);
   void   deriveStatsForCcAlfFiltering(const PelUnitBuf &orgYuv, const PelUnitBuf &recYuv, const int compIdx,
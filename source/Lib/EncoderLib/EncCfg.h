@@ -350,6 +350,7 @@ protected:
   bool      m_Affine;
   bool      m_AffineType;
   bool      m_adaptBypassAffineMe;
+  bool      m_affineMeEarlyTerm;
   bool      m_PROF;
   bool      m_BIO;
 
@@ -412,6 +413,8 @@ protected:
   bool      m_MRL;
   bool      m_MIP;
   bool      m_useFastMIP;
+  bool      m_fastIntraGradHist;
+  bool      m_fastIntraCandReuse;
   int       m_fastLocalDualTreeMode;
   int       m_fastAdaptCostPredMode;
   bool      m_disableFastDecisionTT;
@@ -548,6 +551,9 @@ protected:
   bool      m_entropyCodingSyncEnabledFlag;
   bool      m_entryPointPresentFlag;                           ///< flag for the presence of entry points
 
+  int       m_numThreads;                                      ///< number of worker threads, 0: single threaded
+  int       m_parallelMeMinArea;                               ///< minimum PU area for the parallel motion search, 0: disabled
+
   HashType  m_decodedPictureHashSEIType;
   HashType  m_subpicDecodedPictureHashType;
   bool      m_bufferingPeriodSEIEnabled;
@@ -1319,6 +1325,8 @@ public:
   bool      getAffineType()                            const { return m_AffineType; }
   void      setAdaptBypassAffineMe(bool b)                   { m_adaptBypassAffineMe = b;}
   bool      getAdaptBypassAffineMe()                   const { return m_adaptBypassAffineMe; }
+  void      setAffineMeEarlyTerm(bool b)                     { m_affineMeEarlyTerm = b; }
+  bool      getAffineMeEarlyTerm()                     const { return m_affineMeEarlyTerm; }
   void      setPROF                         (bool b)         { m_PROF = b; }
   bool      getPROF                         ()         const { return m_PROF; }
   void      setBIO(bool b)                                   { m_BIO = b; }
@@ -1463,6 +1471,10 @@ public:
   bool      getUseMIP                       () const         { return m_MIP; }
   void      setUseFastMIP                   ( bool b )       { m_useFastMIP = b; }
   bool      getUseFastMIP                   () const         { return m_useFastMIP; }
+  void      setFastIntraGradHist            ( bool b )       { m_fastIntraGradHist = b; }
+  bool      getFastIntraGradHist            () const         { return m_fastIntraGradHist; }
+  void      setFastIntraCandReuse           ( bool b )       { m_fastIntraCandReuse = b; }
+  bool      getFastIntraCandReuse           () const         { return m_fastIntraCandReuse; }
   void      setFastLocalDualTreeMode        ( int i )        { m_fastLocalDualTreeMode = i; }
   int       getFastLocalDualTreeMode        () const         { return m_fastLocalDualTreeMode; }
   void      setFastAdaptCostPredMode        (int i)          { m_fastAdaptCostPredMode = i; }
@@ -1761,6 +1773,10 @@ public:
   bool  getSaoGreedyMergeEnc           ()                            { return m_saoGreedyMergeEnc; }
   void  setEntropyCodingSyncEnabledFlag(bool b)                      { m_entropyCodingSyncEnabledFlag = b; }
   bool  getEntropyCodingSyncEnabledFlag() const                      { return m_entropyCodingSyncEnabledFlag; }
+  void  setNumThreads                  (int i)                       { m_numThreads = i; }
+  int   getNumThreads                  () const                      { return m_numThreads; }
+  void  setParallelMeMinArea           (int i)                       { m_parallelMeMinArea = i; }
+  int   getParallelMeMinArea           () const                      { return m_parallelMeMinArea; }
   void  setEntryPointPresentFlag(bool b)                             { m_entryPointPresentFlag = b; }
   void  setDecodedPictureHashSEIType(HashType m)                     { m_decodedPictureHashSEIType = m; }
   HashType getDecodedPictureHashSEIType() const                      { return m_decodedPictureHashSEIType; }
@@ -70,6 +70,236 @@ EncCu::EncCu() : m_GeoModeTest
 }
 {}
 
+MergePredCache::Key MergePredCache::xGetKey( const PredictionUnit &pu, const bool chroma, const bool predWOBIO )
+{
+  Key key;
+  key.area           = pu.Y();
+  for( int l = 0; l < NUM_REF_PIC_LIST_01; l++ )
+  {
+    key.refIdx[l]    = pu.refIdx[l] < 0 ? NOT_VALID : pu.refIdx[l];
+    key.mv[l]        = pu.refIdx[l] < 0 ? Mv() : pu.mv[l];
+  }
+  key.interDir       = pu.interDir;
+  key.bcwIdx         = pu.cu->bcwIdx;
+  key.imv            = pu.cu->imv;
+  key.mmvdEncOptMode = pu.mmvdEncOptMode;
+  key.mmvd           = pu.mmvdMergeFlag;
+  key.chroma         = chroma;
+  key.predWOBIO      = predWOBIO;
+  return key;
+}
+
+void MergePredCache::reset()
+{
+  m_entries.clear();
+  m_samples.clear();
+  m_dmvrMvds.clear();
+}
+
+bool MergePredCache::load( PredictionUnit &pu, const bool chroma, PelUnitBuf &pred, PelUnitBuf *predWOBIO, Distortion &dist )
+{
+  m_numLookups++;
+
+  if( pu.mergeType != MRG_TYPE_DEFAULT_N )
+  {
+    return false;
+  }
+
+  const auto it = m_entries.find( xGetKey( pu, chroma, predWOBIO != nullptr ) );
+  if( it == m_entries.end() )
+  {
+    return false;
+  }
+
+  const Entry &entry = it->second;
+  const Pel   *src   = m_samples.data() + entry.sampleOffset;
+  for( int pass = 0; pass < ( predWOBIO ? 2 : 1 ); pass++ )
+  {
+    PelUnitBuf &dst = pass ? *predWOBIO : pred;
+    if( pass && !entry.separateWOBIO )
+    {
+      src = m_samples.data() + entry.sampleOffset;
+    }
+    for( uint32_t i = 0; i < ( chroma ? dst.bufs.size() : 1 ); i++ )
+    {
+      dst.bufs[i].copyFrom( CPelBuf( src, dst.bufs[i].width, dst.bufs[i].height ) );
+      src += dst.bufs[i].area();
+    }
+  }
+  std::copy_n( m_dmvrMvds.data() + entry.mvdOffset, entry.numMvd, pu.mvdL0SubPu );
+  dist = entry.dist;
+
+  m_numHits++;
+  return true;
+}
+
+void MergePredCache::store( const PredictionUnit &pu, const bool chroma, const PelUnitBuf &pred, const PelUnitBuf *predWOBIO, const Distortion dist )
+{
+  if( pu.mergeType != MRG_TYPE_DEFAULT_N )
+  {
+    return;
+  }
+
+  // without BDOF the prediction before BDOF is the prediction itself and only stored once
+  const uint32_t numComp       = chroma ? uint32_t( pred.bufs.size() ) : 1;
+  bool           separateWOBIO = false;
+  size_t         numSamples    = 0;
+  for( uint32_t i = 0; i < numComp; i++ )
+  {
+    numSamples += pred.bufs[i].area();
+    for( int y = 0; predWOBIO && !separateWOBIO && y < pred.bufs[i].height; y++ )
+    {
+      separateWOBIO = memcmp( pred.bufs[i].bufAt( 0, y ), predWOBIO->bufs[i].bufAt( 0, y ), pred.bufs[i].width * sizeof( Pel ) ) != 0;
+    }
+  }
+  numSamples *= separateWOBIO ? 2 : 1;
+
+  if( m_samples.size() + numSamples > MRG_PRED_CACHE_MAX_SAMPLES )
+  {
+    return;
+  }
+
+  // the DMVR refinement of the sub-blocks is an output of the motion compensation as well
+  int numMvd = 0;
+  if( pu.mvRefine && PU::checkDMVRCondition( pu ) )
+  {
+    const int dy = std::min<int>( pu.lumaSize().height, DMVR_SUBCU_HEIGHT );
+    const int dx = std::min<int>( pu.lumaSize().width, DMVR_SUBCU_WIDTH );
+    numMvd       = ( pu.lumaSize().height / dy ) * ( pu.lumaSize().width / dx );
+  }
+
+  const Entry entry = { m_samples.size(), m_dmvrMvds.size(), numMvd, separateWOBIO, dist };
+  if( !m_entries.emplace( xGetKey( pu, chroma, predWOBIO != nullptr ), entry ).second )
+  {
+    return;
+  }
+
+  m_samples.resize( m_samples.size() + numSamples );
+  Pel *dst = m_samples.data() + entry.sampleOffset;
+  for( int pass = 0; pass < ( separateWOBIO ? 2 : 1 ); pass++ )
+  {
+    const PelUnitBuf &src = pass ? *predWOBIO : pred;
+    for( uint32_t i = 0; i < numComp; i++ )
+    {
+      PelBuf( dst, src.bufs[i].width, src.bufs[i].height ).copyFrom( src.bufs[i] );
+      dst += src.bufs[i].area();
+    }
+  }
+  m_dmvrMvds.insert( m_dmvrMvds.end(), pu.mvdL0SubPu, pu.mvdL0SubPu + numMvd );
+}
+
+const Pel* GeoSadRegions::getMask( const int splitDir, const int wIdx, const int hIdx, const int width, int &maskStride, int &maskStride2, int &stepX )
+{
+  const int16_t angle   = g_GeoParams[splitDir][0];
+  const Pel    *mask    = g_globalGeoEncSADmask[g_angle2mask[angle]];
+  const int     offsetX = g_weightOffset[splitDir][hIdx][wIdx][0];
+  const int     offsetY = g_weightOffset[splitDir][hIdx][wIdx][1];
+
+  stepX = 1;
+  if( g_angle2mirror[angle] == 2 )
+  {
+    maskStride  = -GEO_WEIGHT_MASK_SIZE;
+    maskStride2 = -width;
+    return &mask[( GEO_WEIGHT_MASK_SIZE - 1 - offsetY ) * GEO_WEIGHT_MASK_SIZE + offsetX];
+  }
+  else if( g_angle2mirror[angle] == 1 )
+  {
+    stepX       = -1;
+    maskStride2 = width;
+    maskStride  = GEO_WEIGHT_MASK_SIZE;
+    return &mask[offsetY * GEO_WEIGHT_MASK_SIZE + ( GEO_WEIGHT_MASK_SIZE - 1 - offsetX )];
+  }
+  maskStride  = GEO_WEIGHT_MASK_SIZE;
+  maskStride2 = -width;
+  return &mask[offsetY * GEO_WEIGHT_MASK_SIZE + offsetX];
+}
+
+void GeoSadRegions::xInitRuns( const int wIdx, const int hIdx )
+{
+  const int width  = 1 << ( wIdx + GEO_MIN_CU_LOG2 );
+  const int height = 1 << ( hIdx + GEO_MIN_CU_LOG2 );
+
+  std::vector<uint8_t> &runs    = m_runs[hIdx][wIdx];
+  std::vector<bool>    &hasRuns = m_hasRuns[hIdx][wIdx];
+  runs.resize( GEO_NUM_PARTITION_MODE * height * 2 );
+  hasRuns.resize( GEO_NUM_PARTITION_MODE );
+
+  for( int splitDir = 0; splitDir < GEO_NUM_PARTITION_MODE; splitDir++ )
+  {
+    int maskStride, maskStride2, stepX;
+    const Pel *mask = getMask( splitDir, wIdx, hIdx, width, maskStride, maskStride2, stepX );
+
+    // walk the mask the same way as the masked SAD does
+    bool single = true;
+    for( int y = 0; y < height; y++ )
+    {
+      int begin = 0, end = 0;
+      for( int x = 0; x < width; x++, mask += stepX )
+      {
+        if( *mask )
+        {
+          if( begin == end )
+          {
+            begin = x;
+          }
+          else if( end != x )
+          {
+            single = false;
+          }
+          end = x + 1;
+        }
+      }
+      mask += maskStride + maskStride2;
+
+      runs[( splitDir * height + y ) * 2]     = begin;
+      runs[( splitDir * height + y ) * 2 + 1] = end;
+    }
+    hasRuns[splitDir] = single;
+  }
+}
+
+bool GeoSadRegions::hasRuns( const int splitDir, const int wIdx, const int hIdx )
+{
+  if( m_hasRuns[hIdx][wIdx].empty() )
+  {
+    xInitRuns( wIdx, hIdx );
+  }
+  return m_hasRuns[hIdx][wIdx][splitDir];
+}
+
+void GeoSadRegions::initCand( const int cand, const CPelBuf &org, const CPelBuf &pred, const int bitDepth )
+{
+  m_width    = org.width;
+  m_height   = org.height;
+  m_bitDepth = bitDepth;
+
+  uint32_t *rowSums = m_rowSums[cand];
+  for( int y = 0; y < m_height; y++, rowSums += m_width + 1 )
+  {
+    const Pel *pOrg  = org.bufAt( 0, y );
+    const Pel *pPred = pred.bufAt( 0, y );
+
+    rowSums[0] = 0;
+    for( int x = 0; x < m_width; x++ )
+    {
+      rowSums[x + 1] = rowSums[x] + abs( pOrg[x] - pPred[x] );
+    }
+  }
+}
+
+Distortion GeoSadRegions::getSad( const int splitDir, const int wIdx, const int hIdx, const int cand ) const
+{
+  const uint8_t  *runs    = &m_runs[hIdx][wIdx][splitDir * m_height * 2];
+  const uint32_t *rowSums = m_rowSums[cand];
+
+  Distortion sum = 0;
+  for( int y = 0; y < m_height; y++, runs += 2, rowSums += m_width + 1 )
+  {
+    sum += rowSums[runs[1]] - rowSums[runs[0]];
+  }
+  return sum >> DISTORTION_PRECISION_ADJUSTMENT( m_bitDepth );
+}
+
 void EncCu::create( EncCfg* encCfg )
 {
   unsigned      uiMaxWidth    = encCfg->getMaxCUWidth();
@@ -229,6 +459,13 @@ void EncCu::destroy()
   {
     m_acGeoWeightedBuffer[ui].destroy();
   }
+
+  if (m_mergePredCache.getNumLookups() > 0)
+  {
+    msg(DETAILS, "Merge prediction cache: %llu of %llu lookups hit\n", (unsigned long long) m_mergePredCache.getNumHits(),
+        (unsigned long long) m_mergePredCache.getNumLookups());
+  }
+  m_mergePredCache.reset();
 }
 
 EncCu::~EncCu()
@@ -287,6 +524,9 @@ void EncCu::compressCtu( CodingStructure& cs, const UnitArea& area, const unsign
     m_ctuIbcSearchRangeX = m_pcEncCfg->getIBCLocalSearchRangeX();
     m_ctuIbcSearchRangeY = m_pcEncCfg->getIBCLocalSearchRangeY();
   }
+  m_mergePredCache.reset();
+  m_pcInterSearch->resetAffinePredCache();
+  m_pcIntraSearch->resetIntraCandCache();
   if (m_pcEncCfg->getIBCMode() && m_pcEncCfg->getIBCHashSearch() && (m_pcEncCfg->getIBCFastMethod() & IBC_FAST_METHOD_ADAPTIVE_SEARCHRANGE))
   {
     const int hashHitRatio = m_ibcHashMap.getHashHitRatio(area.Y()); // in percent
@@ -2390,7 +2630,13 @@ void EncCu::xCheckRDCostMerge2Nx2N( CodingStructure *&tempCS, CodingStructure *&
         pu.mvRefine = true;
         distParam.cur = singleMergeTempBuffer->Y();
         acMergeTmpBuffer[uiMergeCand] = m_acMergeTmpBuffer[uiMergeCand].getBuf(localUnitArea);
-        m_pcInterSearch->motionCompensation(pu, *singleMergeTempBuffer, REF_PIC_LIST_X, true, true, &(acMergeTmpBuffer[uiMergeCand]));
+        Distortion uiSad;
+        if (!m_mergePredCache.load(pu, true, *singleMergeTempBuffer, &(acMergeTmpBuffer[uiMergeCand]), uiSad))
+        {
+          m_pcInterSearch->motionCompensation(pu, *singleMergeTempBuffer, REF_PIC_LIST_X, true, true, &(acMergeTmpBuffer[uiMergeCand]));
+          uiSad = distParam.distFunc(distParam);
+          m_mergePredCache.store(pu, true, *singleMergeTempBuffer, &(acMergeTmpBuffer[uiMergeCand]), uiSad);
+        }
         acMergeBuffer[uiMergeCand] = m_acRealMergeBuffer[uiMergeCand].getBuf(localUnitArea);
         acMergeBuffer[uiMergeCand].copyFrom(*singleMergeTempBuffer);
         pu.mvRefine = false;
@@ -2416,7 +2662,6 @@ void EncCu::xCheckRDCostMerge2Nx2N( CodingStructure *&tempCS, CodingStructure *&
           }
         }
 
-        Distortion uiSad = distParam.distFunc(distParam);
         m_CABACEstimator->getCtx() = ctxStart;
         uint64_t fracBits = m_pcInterSearch->xCalcPuMeBits(pu);
         double cost = (double)uiSad + (double)fracBits * sqrtLambdaForFirstPassIntra;
@@ -2609,10 +2854,15 @@ void EncCu::xCheckRDCostMerge2Nx2N( CodingStructure *&tempCS, CodingStructure *&
           pu.mmvdEncOptMode = (refineStep > 2 ? 2 : 1);
           CHECK(!pu.mmvdMergeFlag, "MMVD merge should be set");
           // Don't do chroma MC here
-          m_pcInterSearch->motionCompensation(pu, *singleMergeTempBuffer, REF_PIC_LIST_X, true, false);
+          Distortion uiSad;
+          if (!m_mergePredCache.load(pu, false, *singleMergeTempBuffer, nullptr, uiSad))
+          {
+            m_pcInterSearch->motionCompensation(pu, *singleMergeTempBuffer, REF_PIC_LIST_X, true, false);
+            uiSad = distParam.distFunc(distParam);
+            m_mergePredCache.store(pu, false, *singleMergeTempBuffer, nullptr, uiSad);
+          }
           pu.mmvdEncOptMode = 0;
           pu.mvRefine = false;
-          Distortion uiSad = distParam.distFunc(distParam);
 
           m_CABACEstimator->getCtx() = ctxStart;
           uint64_t fracBits = m_pcInterSearch->xCalcPuMeBits(pu);
@@ -3075,6 +3325,7 @@ void EncCu::xCheckRDCostMergeGeo2Nx2N(CodingStructure *&tempCS, CodingStructure
     distParamWholeBlk.cur.buf = geoTempBuf[mergeCand].Y().buf;
     distParamWholeBlk.cur.stride = geoTempBuf[mergeCand].Y().stride;
     sadWholeBlk[mergeCand] = distParamWholeBlk.distFunc(distParamWholeBlk);
+    m_geoSadRegions.initCand(mergeCand, tempCS->getOrgBuf().Y(), geoTempBuf[mergeCand].Y(), sps.getBitDepth(CHANNEL_TYPE_LUMA));
 #if GDR_ENABLED
     bool allOk = (sadWholeBlk[mergeCand] < bestWholeBlkSad);
     if (isEncodeGdrClean)
@@ -3111,27 +3362,17 @@ void EncCu::xCheckRDCostMergeGeo2Nx2N(CodingStructure *&tempCS, CodingStructure
   {
     int maskStride = 0, maskStride2 = 0;
     int stepX = 1;
-    Pel* SADmask;
-    int16_t angle = g_GeoParams[splitDir][0];
-    if (g_angle2mirror[angle] == 2)
-    {
-      maskStride = -GEO_WEIGHT_MASK_SIZE;
-      maskStride2 = -(int)cu.lwidth();
-      SADmask = &g_globalGeoEncSADmask[g_angle2mask[g_GeoParams[splitDir][0]]][(GEO_WEIGHT_MASK_SIZE - 1 - g_weightOffset[splitDir][hIdx][wIdx][1]) * GEO_WEIGHT_MASK_SIZE + g_weightOffset[splitDir][hIdx][wIdx][0]];
-    }
-    else if (g_angle2mirror[angle] == 1)
-    {
-      stepX = -1;
-      maskStride2 = cu.lwidth();
-      maskStride = GEO_WEIGHT_MASK_SIZE;
-      SADmask = &g_globalGeoEncSADmask[g_angle2mask[g_GeoParams[splitDir][0]]][g_weightOffset[splitDir][hIdx][wIdx][1] * GEO_WEIGHT_MASK_SIZE + (GEO_WEIGHT_MASK_SIZE - 1 - g_weightOffset[splitDir][hIdx][wIdx][0])];
-    }
-    else
+    const Pel *SADmask = GeoSadRegions::getMask(splitDir, wIdx, hIdx, cu.lwidth(), maskStride, maskStride2, stepX);
+    const bool useRuns = m_geoSadRegions.hasRuns(splitDir, wIdx, hIdx);
+    auto getMaskedSad = [&](const int mergeCand) -> Distortion
     {
-      maskStride = GEO_WEIGHT_MASK_SIZE;
-      maskStride2 = -(int)cu.lwidth();
-      SADmask = &g_globalGeoEncSADmask[g_angle2mask[g_GeoParams[splitDir][0]]][g_weightOffset[splitDir][hIdx][wIdx][1] * GEO_WEIGHT_MASK_SIZE + g_weightOffset[splitDir][hIdx][wIdx][0]];
-    }
+      if (useRuns)
+      {
+        return m_geoSadRegions.getSad(splitDir, wIdx, hIdx, mergeCand);
+      }
+      m_pcRdCost->setDistParam(distParam, tempCS->getOrgBuf().Y(), geoTempBuf[mergeCand].Y().buf, geoTempBuf[mergeCand].Y().stride, SADmask, maskStride, stepX, maskStride2, sps.getBitDepth(CHANNEL_TYPE_LUMA), COMPONENT_Y);
+      return distParam.distFunc(distParam);
+    };
     Distortion sadSmall = 0, sadLarge = 0;
     for (uint8_t mergeCand = 0; mergeCand < maxNumMergeCandidates; mergeCand++)
     {
@@ -3141,8 +3382,7 @@ void EncCu::xCheckRDCostMergeGeo2Nx2N(CodingStructure *&tempCS, CodingStructure
       {
         double cost0, cost1;
 
-        m_pcRdCost->setDistParam(distParam, tempCS->getOrgBuf().Y(), geoTempBuf[mergeCand].Y().buf, geoTempBuf[mergeCand].Y().stride, SADmask, maskStride, stepX, maskStride2, sps.getBitDepth(CHANNEL_TYPE_LUMA), COMPONENT_Y);
-        sadLarge = distParam.distFunc(distParam);
+        sadLarge = getMaskedSad(mergeCand);
         sadSmall = sadWholeBlk[mergeCand] - sadLarge;
 
         if (MrgSolid[mergeCand] && MrgValid[mergeCand])
@@ -3161,15 +3401,13 @@ void EncCu::xCheckRDCostMergeGeo2Nx2N(CodingStructure *&tempCS, CodingStructure
       }
       else
       {
-        m_pcRdCost->setDistParam(distParam, tempCS->getOrgBuf().Y(), geoTempBuf[mergeCand].Y().buf, geoTempBuf[mergeCand].Y().stride, SADmask, maskStride, stepX, maskStride2, sps.getBitDepth(CHANNEL_TYPE_LUMA), COMPONENT_Y);
-        sadLarge = distParam.distFunc(distParam);
+        sadLarge = getMaskedSad(mergeCand);
         m_GeoCostList.insert(splitDir, 0, mergeCand, (double)sadLarge + (double)bitsCand * sqrtLambdaForFirstPass);
         sadSmall = sadWholeBlk[mergeCand] - sadLarge;
         m_GeoCostList.insert(splitDir, 1, mergeCand, (double)sadSmall + (double)bitsCand * sqrtLambdaForFirstPass);
       }
 #else
-      m_pcRdCost->setDistParam(distParam, tempCS->getOrgBuf().Y(), geoTempBuf[mergeCand].Y().buf, geoTempBuf[mergeCand].Y().stride, SADmask, maskStride, stepX, maskStride2, sps.getBitDepth(CHANNEL_TYPE_LUMA), COMPONENT_Y);
-      sadLarge = distParam.distFunc(distParam);
+      sadLarge = getMaskedSad(mergeCand);
       m_GeoCostList.insert(splitDir, 0, mergeCand, (double)sadLarge + (double)bitsCand * sqrtLambdaForFirstPass);
       sadSmall = sadWholeBlk[mergeCand] - sadLarge;
       m_GeoCostList.insert(splitDir, 1, mergeCand, (double)sadSmall + (double)bitsCand * sqrtLambdaForFirstPass);
@@ -148,6 +148,98 @@ public:
   int numGeoTemplatesInitialized;
 };
 
+/// masked SADs of the GEO split modes from row prefix sums of the absolute residual of each merge candidate: the
+/// encoder SAD mask of a split is a half plane, so it covers one run of samples per row
+class GeoSadRegions
+{
+public:
+  GeoSadRegions() : m_width( 0 ), m_height( 0 ), m_bitDepth( 0 ) {}
+
+  void        initCand   ( const int cand, const CPelBuf &org, const CPelBuf &pred, const int bitDepth );
+  bool        hasRuns    ( const int splitDir, const int wIdx, const int hIdx );
+  Distortion  getSad     ( const int splitDir, const int wIdx, const int hIdx, const int cand ) const;
+
+  static const Pel* getMask( const int splitDir, const int wIdx, const int hIdx, const int width, int &maskStride, int &maskStride2, int &stepX );
+
+private:
+  void        xInitRuns  ( const int wIdx, const int hIdx );
+
+  std::vector<uint8_t>  m_runs     [GEO_NUM_CU_SIZE][GEO_NUM_CU_SIZE]; ///< [splitDir][row][begin, end]
+  std::vector<bool>     m_hasRuns  [GEO_NUM_CU_SIZE][GEO_NUM_CU_SIZE]; ///< [splitDir] false if a row is not one run
+  uint32_t              m_rowSums  [GEO_MAX_NUM_UNI_CANDS][GEO_MAX_CU_SIZE * ( GEO_MAX_CU_SIZE + 1 )];
+  int                   m_width;
+  int                   m_height;
+  int                   m_bitDepth;
+};
+
+/// per-CTU cache of the merge and MMVD candidate predictions and their SATD used in the merge candidate pre-selection,
+/// the same motion on the same block recurs across the split paths of a CTU
+class MergePredCache
+{
+public:
+  MergePredCache() : m_numLookups( 0 ), m_numHits( 0 ) {}
+
+  void      reset();
+  bool      load ( PredictionUnit &pu, const bool chroma, PelUnitBuf &pred, PelUnitBuf *predWOBIO, Distortion &dist );
+  void      store( const PredictionUnit &pu, const bool chroma, const PelUnitBuf &pred, const PelUnitBuf *predWOBIO, const Distortion dist );
+
+  uint64_t  getNumLookups() const { return m_numLookups; }
+  uint64_t  getNumHits()    const { return m_numHits; }
+
+private:
+  struct Key
+  {
+    Area      area;
+    Mv        mv[NUM_REF_PIC_LIST_01];
+    int8_t    refIdx[NUM_REF_PIC_LIST_01];
+    uint8_t   interDir;
+    uint8_t   bcwIdx;
+    uint8_t   imv;
+    uint8_t   mmvdEncOptMode;
+    bool      mmvd;
+    bool      chroma;
+    bool      predWOBIO;
+
+    bool operator==( const Key &other ) const
+    {
+      return area == other.area && mv[0] == other.mv[0] && mv[1] == other.mv[1] && refIdx[0] == other.refIdx[0]
+             && refIdx[1] == other.refIdx[1] && interDir == other.interDir && bcwIdx == other.bcwIdx && imv == other.imv
+             && mmvdEncOptMode == other.mmvdEncOptMode && mmvd == other.mmvd && chroma == other.chroma
+             && predWOBIO == other.predWOBIO;
+    }
+  };
+  struct KeyHash
+  {
+    size_t operator()( const Key &key ) const
+    {
+      size_t hash = std::hash<Position>()( key.area.pos() ) ^ ( std::hash<Size>()( key.area.size() ) << 1 );
+      hash ^= std::hash<Mv>()( key.mv[0] ) + 0x9e3779b9 + ( hash << 6 ) + ( hash >> 2 );
+      hash ^= std::hash<Mv>()( key.mv[1] ) + 0x9e3779b9 + ( hash << 6 ) + ( hash >> 2 );
+      hash ^= ( size_t( uint8_t( key.refIdx[0] ) ) | ( size_t( uint8_t( key.refIdx[1] ) ) << 8 ) | ( size_t( key.interDir ) << 16 )
+                | ( size_t( key.bcwIdx ) << 24 ) | ( size_t( key.imv ) << 32 ) | ( size_t( key.mmvdEncOptMode ) << 40 )
+                | ( size_t( key.mmvd ) << 48 ) | ( size_t( key.chroma ) << 49 ) | ( size_t( key.predWOBIO ) << 50 ) )
+              * 0x9e3779b97f4a7c15ull;
+      return hash;
+    }
+  };
+  struct Entry
+  {
+    size_t      sampleOffset;
+    size_t      mvdOffset;
+    int         numMvd;
+    bool        separateWOBIO;
+    Distortion  dist;
+  };
+
+  static Key  xGetKey( const PredictionUnit &pu, const bool chroma, const bool predWOBIO );
+
+  std::unordered_map<Key, Entry, KeyHash> m_entries;
+  std::vector<Pel>                        m_samples;
+  std::vector<Mv>                         m_dmvrMvds;
+  uint64_t                                m_numLookups;
+  uint64_t                                m_numHits;
+};
+
 class EncCu
   : DecCu
 {
@@ -189,8 +281,10 @@ private:
   PelStorage            m_acMergeBuffer[MMVD_MRG_MAX_RD_BUF_NUM];
   PelStorage            m_acRealMergeBuffer[MRG_MAX_NUM_CANDS];
   PelStorage            m_acMergeTmpBuffer[MRG_MAX_NUM_CANDS];
+  MergePredCache        m_mergePredCache;
   PelStorage            m_acGeoWeightedBuffer[GEO_MAX_TRY_WEIGHTED_SAD]; // to store weighted prediction pixles
   FastGeoCostList       m_GeoCostList;
+  GeoSadRegions         m_geoSadRegions;
   double                m_AFFBestSATDCost;
   double                m_mergeBestSATDCost;
   MotionInfo            m_SubPuMiBuf      [( MAX_CU_SIZE * MAX_CU_SIZE ) >> ( MIN_CU_LOG2 << 1 )];
@@ -1847,6 +1847,25 @@ void trySkipOrDecodePicture( bool& decPic, bool& encPic, const EncCfg& cfg, Pict
   }
 }
 
+void EncGOP::xPicInitMotionSearchPyramid( Picture *pic, PicList &rcListPic )
+{
+  // the picture buffer may be reused, drop the levels of its previous content
+  pic->invalidateMotionSearchPyramid();
+
+  if( m_pcCfg->getMotionEstimationSearchMethod() != MESEARCH_PYRAMID )
+  {
+    return;
+  }
+
+  for( Picture* refPic : rcListPic )
+  {
+    if( refPic->poc != pic->poc && refPic->referenced && refPic->reconstructed && !refPic->hasMotionSearchPyramid() )
+    {
+      refPic->createMotionSearchPyramid();
+    }
+  }
+}
+
 void EncGOP::xPicInitHashME( Picture *pic, const PPS *pps, PicList &rcListPic )
 {
   if (! m_pcCfg->getUseHashME())
@@ -1913,7 +1932,7 @@ void EncGOP::xPicInitHashME( Picture *pic, const PPS *pps, PicList &rcListPic )
             break;
           }
         }
-        refPic->addPictureToHashMapForInter();
+        refPic->addPictureToHashMapForInter(m_hashPlanes);
       }
     }
   }
@@ -2712,6 +2731,7 @@ void EncGOP::compressGOP(int pocLast, int numPicRcvd, PicList &rcListPic, std::l
     }
 
     xPicInitHashME( pcPic, pcSlice->getPPS(), rcListPic );
+    xPicInitMotionSearchPyramid( pcPic, rcListPic );
 
     if( m_pcCfg->getUseAMaxBT() )
     {
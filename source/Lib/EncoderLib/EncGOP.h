@@ -190,6 +190,8 @@ private:
   uint32_t                m_prevISlicePoc;
   bool                    m_initAMaxBt;
 
+  TComHashPlanes          m_hashPlanes;   ///< block hashes of the last picture added to a hash table for hash-based ME
+
   AUWriterIf*             m_AUWriterIf;
 #if GDR_ENABLED
   int                     m_lastGdrIntervalPoc;  
@@ -278,6 +280,7 @@ protected:
 protected:
   void  xInitGOP(int pocLast, int numPicRcvd, bool isField, bool isEncodeLtRef);
   void  xPicInitHashME( Picture *pic, const PPS *pps, PicList &rcListPic );
+  void  xPicInitMotionSearchPyramid( Picture *pic, PicList &rcListPic );
   void  xPicInitRateControl(int &estimatedBits, int gopId, double &lambda, Picture *pic, Slice *slice);
   void  xPicInitLMCS       (Picture *pic, PicHeader *picHeader, Slice *slice);
   void  xGetBuffer(PicList &rcListPic, std::list<PelUnitBuf *> &rcListPicYuvRecOut, int numPicRcvd, int timeOffset,
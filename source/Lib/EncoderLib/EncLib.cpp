@@ -106,6 +106,9 @@ void EncLib::create( const int layerId )
 #endif
 
   m_deblockingFilter.create(floorLog2(m_maxCUWidth) - MIN_CU_LOG2);
+  m_threadPool.create(m_numThreads);
+  m_deblockingFilter.setThreadPool(&m_threadPool);
+  m_cEncALF.setThreadPool(&m_threadPool);
 
   if (!m_deblockingFilterDisable && m_encDbOpt)
   {
@@ -137,6 +140,7 @@ void EncLib::destroy ()
   m_cEncSAO.            destroyEncData();
   m_cEncSAO.            destroy();
   m_deblockingFilter.   destroy();
+  m_threadPool.         destroy();
   m_cRateCtrl.          destroy();
   m_cReshaper.          destroy();
   m_cInterSearch.       destroy();
@@ -332,6 +336,7 @@ void EncLib::init(AUWriterIf *auWriterIf)
 
   // link temporary buffets from intra search with inter search to avoid unneccessary memory overhead
   m_cInterSearch.setTempBuffers( m_cIntraSearch.getSplitCSBuf(), m_cIntraSearch.getFullCSBuf(), m_cIntraSearch.getSaveCSBuf() );
+  m_cInterSearch.setThreadPool( &m_threadPool );
 
   m_maxRefPicNum = 0;
 
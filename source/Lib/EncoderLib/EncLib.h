@@ -84,6 +84,7 @@ private:
   // coding tool
   TrQuant                   m_cTrQuant;                           ///< transform & quantization class
   DeblockingFilter          m_deblockingFilter;                   ///< deblocking filter class
+  ThreadPool                m_threadPool;                         ///< worker threads shared by the in-loop filters
   EncSampleAdaptiveOffset   m_cEncSAO;                            ///< sample adaptive offset class
   EncAdaptiveLoopFilter     m_cEncALF;
   HLSWriter                 m_HLSWriter;                          ///< CAVLC encoder
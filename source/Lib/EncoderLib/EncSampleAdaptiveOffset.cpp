@@ -1150,6 +1150,14 @@ void EncSampleAdaptiveOffset::getBlkStats(const ComponentID compIdx, const int c
     SAOStatData& statsData= statsDataTypes[typeIdx];
     statsData.reset();
 
+    if (typeIdx != SAO_TYPE_BO && !isCtuCrossedByVirtualBoundaries)
+    {
+      getBlkEOStatsLines(compIdx, typeIdx, statsData, srcBlk, orgBlk, srcStride, orgStride, width, height, isLeftAvail,
+                         isRightAvail, isAboveAvail, isBelowAvail, isAboveLeftAvail, isAboveRightAvail,
+                         isCalculatePreDeblockSamples);
+      continue;
+    }
+
     srcLine = srcBlk;
     orgLine = orgBlk;
     diff    = statsData.diff;
@@ -1547,6 +1555,119 @@ void EncSampleAdaptiveOffset::getBlkStats(const ComponentID compIdx, const int c
   }
 }
 
+/** collects the edge offset statistics of a block which is not crossed by virtual boundaries
+ * The sample ranges are identical to the ones of getBlkStats, the edge class of each sample is derived directly from the
+ * source samples, so that each range can be processed by the line kernel.
+ */
+void EncSampleAdaptiveOffset::getBlkEOStatsLines(const ComponentID compIdx, int typeIdx, SAOStatData& statsData
+                        , const Pel* srcBlk, const Pel* orgBlk, int srcStride, int orgStride, int width, int height
+                        , bool isLeftAvail,  bool isRightAvail, bool isAboveAvail, bool isBelowAvail, bool isAboveLeftAvail, bool isAboveRightAvail
+                        , bool isCalculatePreDeblockSamples
+                        )
+{
+  const int skipLinesR = m_skipLinesR[compIdx][typeIdx];
+  const int skipLinesB = m_skipLinesB[compIdx][typeIdx];
+  int64_t*  diff       = statsData.diff;
+  int64_t*  count      = statsData.count;
+
+  int neighbourA, neighbourB, startX, endX, startY, endY;
+  switch(typeIdx)
+  {
+  case SAO_TYPE_EO_0:
+    neighbourA = -1;
+    neighbourB =  1;
+    break;
+  case SAO_TYPE_EO_90:
+    neighbourA = -srcStride;
+    neighbourB =  srcStride;
+    break;
+  case SAO_TYPE_EO_135:
+    neighbourA = -srcStride - 1;
+    neighbourB =  srcStride + 1;
+    break;
+  case SAO_TYPE_EO_45:
+    neighbourA = -srcStride + 1;
+    neighbourB =  srcStride - 1;
+    break;
+  default:
+    THROW("Not a supported SAO type");
+  }
+
+  if (typeIdx == SAO_TYPE_EO_90)
+  {
+    startX = (!isCalculatePreDeblockSamples) ? 0
+                                             : (isRightAvail ? (width - skipLinesR) : width)
+                                             ;
+    endX   = (!isCalculatePreDeblockSamples) ? (isRightAvail ? (width - skipLinesR) : width)
+                                             : width
+                                             ;
+  }
+  else
+  {
+    startX = (!isCalculatePreDeblockSamples) ? (isLeftAvail  ? 0 : 1)
+                                             : (isRightAvail ? (width - skipLinesR) : (width - 1))
+                                             ;
+    endX   = (!isCalculatePreDeblockSamples) ? (isRightAvail ? (width - skipLinesR) : (width - 1))
+                                             : (isRightAvail ? width : (width - 1))
+                                             ;
+  }
+
+  if (typeIdx == SAO_TYPE_EO_0)
+  {
+    startY = 0;
+    endY   = isBelowAvail ? (height - skipLinesB) : height;
+  }
+  else if (typeIdx == SAO_TYPE_EO_90)
+  {
+    startY = isAboveAvail ? 0 : 1;
+    endY   = isBelowAvail ? (height - skipLinesB) : (height - 1);
+  }
+  else
+  {
+    //1st line
+    int firstLineStartX, firstLineEndX;
+    if (typeIdx == SAO_TYPE_EO_135)
+    {
+      firstLineStartX = (!isCalculatePreDeblockSamples) ? (isAboveLeftAvail ? 0    : 1) : startX;
+      firstLineEndX   = (!isCalculatePreDeblockSamples) ? (isAboveAvail     ? endX : 1) : endX;
+    }
+    else
+    {
+      firstLineStartX = (!isCalculatePreDeblockSamples) ? (isAboveAvail ? startX : endX)
+                                                        : startX
+                                                        ;
+      firstLineEndX   = (!isCalculatePreDeblockSamples) ? ((!isRightAvail && isAboveRightAvail) ? width : endX)
+                                                        : endX
+                                                        ;
+    }
+    m_calcEOStatsLines(srcBlk, orgBlk, srcStride, orgStride, firstLineStartX, firstLineEndX, 1, neighbourA, neighbourB,
+                       diff, count);
+    startY = 1;
+    endY   = isBelowAvail ? (height - skipLinesB) : (height - 1);
+  }
+
+  //remaining lines
+  m_calcEOStatsLines(srcBlk + startY * srcStride, orgBlk + startY * orgStride, srcStride, orgStride, startX, endX,
+                     endY - startY, neighbourA, neighbourB, diff, count);
+
+  if (isCalculatePreDeblockSamples && isBelowAvail)
+  {
+    const int preDeblockY = std::max(startY, endY);
+    if (typeIdx == SAO_TYPE_EO_90)
+    {
+      startX = 0;
+      endX   = width;
+    }
+    else
+    {
+      startX = isLeftAvail  ? 0 : 1;
+      endX   = isRightAvail ? width : (width - 1);
+    }
+    m_calcEOStatsLines(srcBlk + preDeblockY * srcStride, orgBlk + preDeblockY * orgStride, srcStride, orgStride, startX,
+                       endX, skipLinesB, neighbourA, neighbourB, diff, count);
+  }
+}
+
 void EncSampleAdaptiveOffset::deriveLoopFilterBoundaryAvailibility(CodingStructure& cs, const Position &pos, bool& isLeftAvail, bool& isAboveAvail, bool& isAboveLeftAvail) const
 {
   bool isLoopFiltAcrossSlicePPS = cs.pps->getLoopFilterAcrossSlicesEnabledFlag();
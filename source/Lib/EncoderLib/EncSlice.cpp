@@ -703,7 +703,6 @@ void EncSlice::initEncSlice(Picture *pcPic, const int pocLast, const int pocCurr
 
   if( ( m_pcCfg->getIBCHashSearch() && m_pcCfg->getIBCMode() ) || m_pcCfg->getAllowDisFracMMVD() )
   {
-    m_pcCuEncoder->getIbcHashMap().destroy();
     m_pcCuEncoder->getIbcHashMap().init( pcPic->cs->pps->getPicWidthInLumaSamples(), pcPic->cs->pps->getPicHeightInLumaSamples() );
   }
 #if GDR_ENABLED
@@ -1653,19 +1652,9 @@ void EncSlice::encodeCtus( Picture* pcPic, const bool bCompressEntireSlice, cons
     }
     if ((pcSlice->getSPS()->getSpsRangeExtension().getTSRCRicePresentFlag()) && (m_pcGOPEncoder->getPreQP() != pcSlice->getSliceQp()) && (pcPic->cs->pps->getNumSlicesInPic() == 1) && (pcSlice->get_tsrc_index() > 0) && (pcSlice->getSPS()->getBitDepth(CHANNEL_TYPE_LUMA) <= 12))
     {
-      uint32_t totalCtu  = 0;
-      uint32_t hashRatio = 0;
-      for (uint32_t ctuIdx = 0; ctuIdx < pcSlice->getNumCtuInSlice(); ctuIdx++)
-      {
-        const uint32_t ctuRsAddr     = pcSlice->getCtuAddrInSlice(ctuIdx);
-        const uint32_t ctuXPosInCtus = ctuRsAddr % widthInCtus;
-        const uint32_t ctuYPosInCtus = ctuRsAddr / widthInCtus;
-        const Position pos(ctuXPosInCtus * pcv.maxCUWidth, ctuYPosInCtus * pcv.maxCUHeight);
-        const UnitArea ctuArea(cs.area.chromaFormat, Area(pos.x, pos.y, pcv.maxCUWidth, pcv.maxCUHeight));
-
-        hashRatio += m_pcCuEncoder->getIbcHashMap().calHashBlkMatchPerc(cs.area.Y());
-        totalCtu++;
-      }
+      // the hit percentage of the whole picture is counted once for every CTU of the slice
+      const uint32_t totalCtu  = pcSlice->getNumCtuInSlice();
+      const uint32_t hashRatio = totalCtu * m_pcCuEncoder->getIbcHashMap().calHashBlkMatchPerc(cs.area.Y());
       if (totalCtu > 0)
       {
         if ((hashRatio < 4200) || (hashRatio < (41 * totalCtu)))
@@ -98,6 +98,10 @@ InterSearch::InterSearch()
   , m_CtxCache(nullptr)
   , m_pTempPel(nullptr)
   , m_isInitialized(false)
+  , m_threadPool(nullptr)
+  , m_parallelMeMinArea(0)
+  , m_affPredCacheSize(0)
+  , m_affPredCacheNext(0)
 {
   for (int i=0; i<MAX_NUM_REF_LIST_ADAPT_SR; i++)
   {
@@ -147,14 +151,6 @@ void InterSearch::destroy()
   {
     delete[] m_tmpAffiError;
   }
-  if (m_tmpAffiDeri[0] != nullptr)
-  {
-    delete[] m_tmpAffiDeri[0];
-  }
-  if (m_tmpAffiDeri[1] != nullptr)
-  {
-    delete[] m_tmpAffiDeri[1];
-  }
   if (m_affMVList)
   {
     delete[] m_affMVList;
@@ -177,9 +173,46 @@ void InterSearch::destroy()
   }
   m_uniMvListIdx = 0;
   m_uniMvListSize = 0;
+
+  for (size_t i = 0; i < m_meWorkers.size(); i++)
+  {
+    delete m_meWorkers[i];
+    delete m_meWorkerRdCost[i];
+  }
+  m_meWorkers.clear();
+  m_meWorkerRdCost.clear();
+  m_threadPool = nullptr;
+
   m_isInitialized = false;
 }
 
+void InterSearch::setThreadPool( ThreadPool* threadPool )
+{
+  CHECK( !m_isInitialized, "Not initialized" );
+  m_threadPool        = threadPool;
+  m_parallelMeMinArea = m_pcEncCfg->getParallelMeMinArea();
+
+  if( m_parallelMeMinArea <= 0 || threadPool->getNumThreads() == 0 || !m_meWorkers.empty() )
+  {
+    return;
+  }
+
+  // each worker owns its RD cost, interpolation and search buffers
+  const uint32_t maxCUWidth  = m_pcEncCfg->getMaxCUWidth();
+  const uint32_t maxCUHeight = m_pcEncCfg->getMaxCUHeight();
+  for( int i = 0; i < threadPool->getNumThreadSlots(); i++ )
+  {
+    RdCost*      rdCost = new RdCost;
+    InterSearch* worker = new InterSearch;
+    worker->init( m_pcEncCfg, m_pcTrQuant, m_searchRange, m_bipredSearchRange, m_motionEstimationSearchMethod,
+                  m_useCompositeRef, maxCUWidth, maxCUHeight,
+                  floorLog2( maxCUWidth ) - m_pcEncCfg->getLog2MinCodingBlockSize(), rdCost, m_CABACEstimator,
+                  m_CtxCache, m_pcReshape );
+    m_meWorkers     .push_back( worker );
+    m_meWorkerRdCost.push_back( rdCost );
+  }
+}
+
 void InterSearch::setTempBuffers( CodingStructure ****pSplitCS, CodingStructure ****pFullCS, CodingStructure **pSaveCS )
 {
   m_pSplitCS = pSplitCS;
@@ -251,8 +284,6 @@ void InterSearch::init(EncCfg *pcEncCfg, TrQuant *pcTrQuant, int searchRange, in
   m_tmpStorageLCU.create( UnitArea( cform, Area( 0, 0, MAX_CU_SIZE, MAX_CU_SIZE ) ) );
   m_tmpAffiStorage.create( UnitArea( cform, Area( 0, 0, MAX_CU_SIZE, MAX_CU_SIZE ) ) );
   m_tmpAffiError = new Pel[MAX_CU_SIZE * MAX_CU_SIZE];
-  m_tmpAffiDeri[0] = new int[MAX_CU_SIZE * MAX_CU_SIZE];
-  m_tmpAffiDeri[1] = new int[MAX_CU_SIZE * MAX_CU_SIZE];
   m_pTempPel = new Pel[maxCUWidth*maxCUHeight];
   m_affMVListMaxSize = pcEncCfg->getIsLowDelay() ? AFFINE_ME_LIST_SIZE_LD : AFFINE_ME_LIST_SIZE;
   if (!m_affMVList)
@@ -1857,10 +1888,10 @@ void InterSearch::xxIBCHashSearch(PredictionUnit& pu, Mv* mvPred, int numMvPred,
 }
 
 
-void InterSearch::addToSortList(std::list<BlockHash>& listBlockHash, std::list<int>& listCost, int cost, const BlockHash& blockHash)
+void InterSearch::addToSortList(BlockHashList& listBlockHash, static_vector<int, HASH_ME_MAX_MATCHES>& listCost, int cost, const BlockHash& blockHash)
 {
-  std::list<BlockHash>::iterator itBlockHash = listBlockHash.begin();
-  std::list<int>::iterator itCost = listCost.begin();
+  BlockHashList::iterator itBlockHash = listBlockHash.begin();
+  static_vector<int, HASH_ME_MAX_MATCHES>::iterator itCost = listCost.begin();
 
   while (itCost != listCost.end())
   {
@@ -1879,12 +1910,12 @@ void InterSearch::addToSortList(std::list<BlockHash>& listBlockHash, std::list<i
   listBlockHash.push_back(blockHash);
 }
 
-void InterSearch::selectMatchesInter(const MapIterator& itBegin, int count, std::list<BlockHash>& listBlockHash, const BlockHash& currBlockHash)
+void InterSearch::selectMatchesInter(const MapIterator& itBegin, int count, BlockHashList& listBlockHash, const BlockHash& currBlockHash)
 {
-  const int maxReturnNumber = 5;
+  const int maxReturnNumber = HASH_ME_MAX_MATCHES;
 
   listBlockHash.clear();
-  std::list<int> listCost;
+  static_vector<int, HASH_ME_MAX_MATCHES> listCost;
   listCost.clear();
 
   MapIterator it = itBegin;
@@ -1910,15 +1941,15 @@ void InterSearch::selectMatchesInter(const MapIterator& itBegin, int count, std:
     }
   }
 }
-void InterSearch::selectRectangleMatchesInter(const MapIterator& itBegin, int count, std::list<BlockHash>& listBlockHash, const BlockHash& currBlockHash, int width, int height, int idxNonSimple, unsigned int* &hashValues, int baseNum, int picWidth, int picHeight, bool isHorizontal, uint16_t* curHashPic)
+void InterSearch::selectRectangleMatchesInter(const MapIterator& itBegin, int count, BlockHashList& listBlockHash, const BlockHash& currBlockHash, int width, int height, int idxNonSimple, unsigned int* &hashValues, int baseNum, int picWidth, int picHeight, bool isHorizontal, uint16_t* curHashPic)
 {
-  const int maxReturnNumber = 5;
+  const int maxReturnNumber = HASH_ME_MAX_MATCHES;
   int baseSize = min(width, height);
   unsigned int crcMask = 1 << 16;
   crcMask -= 1;
 
   listBlockHash.clear();
-  std::list<int> listCost;
+  static_vector<int, HASH_ME_MAX_MATCHES> listCost;
   listCost.clear();
 
   MapIterator it = itBegin;
@@ -2090,7 +2121,7 @@ bool InterSearch::xRectHashInterEstimation(PredictionUnit& pu, RefPicList& bestR
           continue;
         }
 
-        list<BlockHash> listBlockHash;
+        BlockHashList listBlockHash;
         selectRectangleMatchesInter(pu.cu->slice->getRefPic(eRefPicList, refIdx)->getHashMap()->getFirstIterator(hashValue1s[idxNonSimple]), count, listBlockHash, currBlockHash, width, height, idxNonSimple, hashValue2s, baseNum, picWidth, picHeight, isHorizontal, pu.cu->slice->getRefPic(eRefPicList, refIdx)->getHashMap()->getHashPic(baseSize));
 
         m_numHashMVStoreds[eRefPicList][refIdx] = int(listBlockHash.size());
@@ -2142,7 +2173,7 @@ bool InterSearch::xRectHashInterEstimation(PredictionUnit& pu, RefPicList& bestR
         m_pcRdCost->selectMotionLambda( );
         m_pcRdCost->setCostScale(0);
 
-        list<BlockHash>::iterator it;
+        BlockHashList::iterator it;
         int countMV = 0;
         for (it = listBlockHash.begin(); it != listBlockHash.end(); ++it)
         {
@@ -2387,7 +2418,7 @@ bool InterSearch::xHashInterEstimation(PredictionUnit& pu, RefPicList& bestRefPi
           continue;
         }
 
-        list<BlockHash> listBlockHash;
+        BlockHashList listBlockHash;
         selectMatchesInter(pu.cu->slice->getRefPic(eRefPicList, refIdx)->getHashMap()->getFirstIterator(hashValue1), count, listBlockHash, currBlockHash);
         m_numHashMVStoreds[eRefPicList][refIdx] = (int)listBlockHash.size();
         if (listBlockHash.empty())
@@ -2454,7 +2485,7 @@ bool InterSearch::xHashInterEstimation(PredictionUnit& pu, RefPicList& bestRefPi
         m_pcRdCost->selectMotionLambda( );
         m_pcRdCost->setCostScale(0);
 
-        list<BlockHash>::iterator it;
+        BlockHashList::iterator it;
         int countMV = 0;
         for (it = listBlockHash.begin(); it != listBlockHash.end(); ++it)
         {
@@ -2901,12 +2932,65 @@ void InterSearch::predInterSearch(CodingUnit& cu, Partitioner& partitioner)
     unsigned imvShift = pu.cu->imv == IMV_HPEL ? 1 : (pu.cu->imv << 1);
     if ( checkNonAffine )
     {
+      // the searches of the reference pictures are independent of each other, for large PUs they run as parallel
+      // tasks and their results are applied below in the serial order
+      bool parallelMe = !m_meWorkers.empty() && pu.lumaSize().area() >= m_parallelMeMinArea;
+#if GDR_ENABLED
+      parallelMe = parallelMe && !isEncodeGdrClean;
+#endif
+      int numMeTasks = 0;
+      if (parallelMe)
+      {
+        int numSearches = 0;
+        for (int refList = 0; refList < iNumPredDir; refList++)
+        {
+          RefPicList eRefPicList = (refList ? REF_PIC_LIST_1 : REF_PIC_LIST_0);
+          for (int refIdxTemp = 0; refIdxTemp < cs.slice->getNumRefIdx(eRefPicList); refIdxTemp++)
+          {
+            MotionSearchTask &task = m_meTasks[numMeTasks++];
+            task.refList     = eRefPicList;
+            task.refIdx      = refIdxTemp;
+            task.bi          = false;
+            task.estimateMvp = true;
+            task.search      = !(m_pcEncCfg->getFastMEForGenBLowDelayEnabled() && refList == 1
+                            && cs.slice->getList1IdxToList0Idx(refIdxTemp) >= 0);
+            task.amvp        = amvp[eRefPicList];
+            task.biPDist     = std::numeric_limits<Distortion>::max();
+            task.bits        = mbBits[refList];
+            if (cs.slice->getNumRefIdx(eRefPicList) > 1)
+            {
+              task.bits += refIdxTemp + 1;
+              if (refIdxTemp == cs.slice->getNumRefIdx(eRefPicList) - 1)
+              {
+                task.bits--;
+              }
+            }
+#if GDR_ENABLED
+            task.mvSolid        = cMvTempSolid[refList][refIdxTemp];
+            task.cleanCandExist = false;
+#endif
+            numSearches += task.search ? 1 : 0;
+          }
+        }
+        if (numSearches > 1)
+        {
+          xRunMotionSearchTasks(pu, origBuf, numMeTasks);
+        }
+        else
+        {
+          numMeTasks = 0;
+        }
+      }
+
       //  Uni-directional prediction
+      int meTaskIdx = 0;
       for (int refList = 0; refList < iNumPredDir; refList++)
       {
         RefPicList eRefPicList = (refList ? REF_PIC_LIST_1 : REF_PIC_LIST_0);
         for (int refIdxTemp = 0; refIdxTemp < cs.slice->getNumRefIdx(eRefPicList); refIdxTemp++)
         {
+          const MotionSearchTask *meTask = numMeTasks > 0 ? &m_meTasks[meTaskIdx++] : nullptr;
+
           bitsTemp = mbBits[refList];
           if ( cs.slice->getNumRefIdx(eRefPicList) > 1 )
           {
@@ -2916,8 +3000,22 @@ void InterSearch::predInterSearch(CodingUnit& cu, Partitioner& partitioner)
               bitsTemp--;
             }
           }
-          xEstimateMvPredAMVP(pu, origBuf, eRefPicList, refIdxTemp, cMvPred[refList][refIdxTemp], amvp[eRefPicList],
-                              false, &biPDistTemp);
+          if (meTask)
+          {
+            cMvPred[refList][refIdxTemp] = meTask->mvPredEst;
+            amvp[eRefPicList]            = meTask->amvp;
+            pu.mvpIdx[eRefPicList]       = meTask->mvpIdxEst;
+            pu.mvpNum[eRefPicList]       = meTask->amvp.numCand;
+            if (meTask->amvp.numCand > 0)
+            {
+              biPDistTemp = meTask->biPDist;
+            }
+          }
+          else
+          {
+            xEstimateMvPredAMVP(pu, origBuf, eRefPicList, refIdxTemp, cMvPred[refList][refIdxTemp],
+                                amvp[eRefPicList], false, &biPDistTemp);
+          }
 
           aaiMvpIdx[refList][refIdxTemp] = pu.mvpIdx[eRefPicList];
           aaiMvpNum[refList][refIdxTemp] = pu.mvpNum[eRefPicList];
@@ -3002,13 +3100,30 @@ void InterSearch::predInterSearch(CodingUnit& cu, Partitioner& partitioner)
             {
 #if GDR_ENABLED
               bCleanCandExist = false;
-              xMotionEstimation(pu, origBuf, eRefPicList, cMvPred[refList][refIdxTemp], refIdxTemp,
-                                cMvTemp[refList][refIdxTemp], cMvTempSolid[refList][refIdxTemp],
-                                aaiMvpIdx[refList][refIdxTemp], bitsTemp, costTemp, amvp[eRefPicList], bCleanCandExist);
+              if (meTask)
+              {
+                xApplyMotionSearchTask(*meTask, cMvPred[refList][refIdxTemp], cMvTemp[refList][refIdxTemp],
+                                       cMvTempSolid[refList][refIdxTemp], aaiMvpIdx[refList][refIdxTemp], bitsTemp, costTemp,
+                                       bCleanCandExist);
+              }
+              else
+              {
+                xMotionEstimation(pu, origBuf, eRefPicList, cMvPred[refList][refIdxTemp], refIdxTemp,
+                                  cMvTemp[refList][refIdxTemp], cMvTempSolid[refList][refIdxTemp],
+                                  aaiMvpIdx[refList][refIdxTemp], bitsTemp, costTemp, amvp[eRefPicList], bCleanCandExist);
+              }
 #else
-              xMotionEstimation(pu, origBuf, eRefPicList, cMvPred[refList][refIdxTemp], refIdxTemp,
-                                cMvTemp[refList][refIdxTemp], aaiMvpIdx[refList][refIdxTemp], bitsTemp, costTemp,
-                                amvp[eRefPicList]);
+              if (meTask)
+              {
+                xApplyMotionSearchTask(*meTask, cMvPred[refList][refIdxTemp], cMvTemp[refList][refIdxTemp],
+                                       aaiMvpIdx[refList][refIdxTemp], bitsTemp, costTemp);
+              }
+              else
+              {
+                xMotionEstimation(pu, origBuf, eRefPicList, cMvPred[refList][refIdxTemp], refIdxTemp,
+                                  cMvTemp[refList][refIdxTemp], aaiMvpIdx[refList][refIdxTemp], bitsTemp, costTemp,
+                                  amvp[eRefPicList]);
+              }
 #endif
 
 #if GDR_ENABLED
@@ -3037,13 +3152,30 @@ void InterSearch::predInterSearch(CodingUnit& cu, Partitioner& partitioner)
           {
 #if GDR_ENABLED
             bCleanCandExist = false;
-            xMotionEstimation(pu, origBuf, eRefPicList, cMvPred[refList][refIdxTemp], refIdxTemp,
-                              cMvTemp[refList][refIdxTemp], cMvTempSolid[refList][refIdxTemp],
-                              aaiMvpIdx[refList][refIdxTemp], bitsTemp, costTemp, amvp[eRefPicList], bCleanCandExist);
+            if (meTask)
+            {
+              xApplyMotionSearchTask(*meTask, cMvPred[refList][refIdxTemp], cMvTemp[refList][refIdxTemp],
+                                     cMvTempSolid[refList][refIdxTemp], aaiMvpIdx[refList][refIdxTemp], bitsTemp, costTemp,
+                                     bCleanCandExist);
+            }
+            else
+            {
+              xMotionEstimation(pu, origBuf, eRefPicList, cMvPred[refList][refIdxTemp], refIdxTemp,
+                                cMvTemp[refList][refIdxTemp], cMvTempSolid[refList][refIdxTemp],
+                                aaiMvpIdx[refList][refIdxTemp], bitsTemp, costTemp, amvp[eRefPicList], bCleanCandExist);
+            }
 #else
-            xMotionEstimation(pu, origBuf, eRefPicList, cMvPred[refList][refIdxTemp], refIdxTemp,
-                              cMvTemp[refList][refIdxTemp], aaiMvpIdx[refList][refIdxTemp], bitsTemp, costTemp,
-                              amvp[eRefPicList]);
+            if (meTask)
+            {
+              xApplyMotionSearchTask(*meTask, cMvPred[refList][refIdxTemp], cMvTemp[refList][refIdxTemp],
+                                     aaiMvpIdx[refList][refIdxTemp], bitsTemp, costTemp);
+            }
+            else
+            {
+              xMotionEstimation(pu, origBuf, eRefPicList, cMvPred[refList][refIdxTemp], refIdxTemp,
+                                cMvTemp[refList][refIdxTemp], aaiMvpIdx[refList][refIdxTemp], bitsTemp, costTemp,
+                                amvp[eRefPicList]);
+            }
 #endif
 
 #if GDR_ENABLED
@@ -3413,6 +3545,62 @@ void InterSearch::predInterSearch(CodingUnit& cu, Partitioner& partitioner)
 
             iRefStart = 0;
             iRefEnd   = cs.slice->getNumRefIdx(eRefPicList) - 1;
+
+            // within one iteration the searches only depend on the fixed prediction of the other list
+            int numBiTasks = 0;
+            if (parallelMe)
+            {
+              for (int refIdxTemp = iRefStart; refIdxTemp <= iRefEnd; refIdxTemp++)
+              {
+                if (m_pcEncCfg->getUseBcwFast() && (bcwIdx != BCW_DEFAULT)
+                    && (pu.cu->slice->getRefPic(eRefPicList, refIdxTemp)->getPOC()
+                        == pu.cu->slice->getRefPic(RefPicList(1 - refList), pu.refIdx[1 - refList])->getPOC())
+                    && (!pu.cu->imv && pu.cu->slice->getTLayer() > 1))
+                {
+                  continue;
+                }
+                MotionSearchTask &task = m_meTasks[numBiTasks++];
+                task.refList     = eRefPicList;
+                task.refIdx      = refIdxTemp;
+                task.bi          = true;
+                task.estimateMvp = false;
+                task.search      = true;
+                task.amvp        = aacAMVPInfo[refList][refIdxTemp];
+                task.mvPred      = cMvPredBi[refList][refIdxTemp];
+                task.mvpIdx      = aaiMvpIdxBi[refList][refIdxTemp];
+                task.mv          = cMvTemp[refList][refIdxTemp];
+                task.bits        = mbBits[2] + motBits[1 - refList];
+                task.bits += ((cs.slice->getSPS()->getUseBcw() == true) ? getWeightIdxBits(bcwIdx) : 0);
+                if (cs.slice->getNumRefIdx(eRefPicList) > 1)
+                {
+                  task.bits += refIdxTemp + 1;
+                  if (refIdxTemp == cs.slice->getNumRefIdx(eRefPicList) - 1)
+                  {
+                    task.bits--;
+                  }
+                }
+                task.bits += m_auiMVPIdxCost[aaiMvpIdxBi[refList][refIdxTemp]][AMVP_MAX_NUM_CANDS];
+                if (cs.slice->getBiDirPred())
+                {
+                  task.bits += 1;   // add one bit for symmetrical MVD mode
+                }
+#if GDR_ENABLED
+                task.mvSolid        = cMvTempSolid[refList][refIdxTemp];
+                task.cleanCandExist = false;
+#endif
+              }
+              if (numBiTasks > 1)
+              {
+                xRunMotionSearchTasks(pu, origBuf, numBiTasks);
+              }
+              else
+              {
+                numBiTasks = 0;
+              }
+            }
+            int  biTaskIdx   = 0;
+            bool predChanged = false;
+
             for (int refIdxTemp = iRefStart; refIdxTemp <= iRefEnd; refIdxTemp++)
             {
               if (m_pcEncCfg->getUseBcwFast() && (bcwIdx != BCW_DEFAULT)
@@ -3422,6 +3610,8 @@ void InterSearch::predInterSearch(CodingUnit& cu, Partitioner& partitioner)
               {
                 continue;
               }
+              const MotionSearchTask *meTask = numBiTasks > 0 ? &m_meTasks[biTaskIdx++] : nullptr;
+
               bitsTemp = mbBits[2] + motBits[1 - refList];
               bitsTemp += ((cs.slice->getSPS()->getUseBcw() == true) ? getWeightIdxBits(bcwIdx) : 0);
               if (cs.slice->getNumRefIdx(eRefPicList) > 1)
@@ -3441,14 +3631,31 @@ void InterSearch::predInterSearch(CodingUnit& cu, Partitioner& partitioner)
               xCopyAMVPInfo(&aacAMVPInfo[refList][refIdxTemp], &amvp[eRefPicList]);
 #if GDR_ENABLED
               bCleanCandExist = false;
-              xMotionEstimation(pu, origBuf, eRefPicList, cMvPredBi[refList][refIdxTemp], refIdxTemp,
-                                cMvTemp[refList][refIdxTemp], cMvTempSolid[refList][refIdxTemp],
-                                aaiMvpIdxBi[refList][refIdxTemp], bitsTemp, costTemp, amvp[eRefPicList],
-                                bCleanCandExist, true);
+              if (meTask)
+              {
+                xApplyMotionSearchTask(*meTask, cMvPredBi[refList][refIdxTemp], cMvTemp[refList][refIdxTemp],
+                                       cMvTempSolid[refList][refIdxTemp], aaiMvpIdxBi[refList][refIdxTemp], bitsTemp,
+                                       costTemp, bCleanCandExist);
+              }
+              else
+              {
+                xMotionEstimation(pu, origBuf, eRefPicList, cMvPredBi[refList][refIdxTemp], refIdxTemp,
+                                  cMvTemp[refList][refIdxTemp], cMvTempSolid[refList][refIdxTemp],
+                                  aaiMvpIdxBi[refList][refIdxTemp], bitsTemp, costTemp, amvp[eRefPicList],
+                                  bCleanCandExist, true);
+              }
 #else
-              xMotionEstimation(pu, origBuf, eRefPicList, cMvPredBi[refList][refIdxTemp], refIdxTemp,
-                                cMvTemp[refList][refIdxTemp], aaiMvpIdxBi[refList][refIdxTemp], bitsTemp, costTemp,
-                                amvp[eRefPicList], true);
+              if (meTask)
+              {
+                xApplyMotionSearchTask(*meTask, cMvPredBi[refList][refIdxTemp], cMvTemp[refList][refIdxTemp],
+                                       aaiMvpIdxBi[refList][refIdxTemp], bitsTemp, costTemp);
+              }
+              else
+              {
+                xMotionEstimation(pu, origBuf, eRefPicList, cMvPredBi[refList][refIdxTemp], refIdxTemp,
+                                  cMvTemp[refList][refIdxTemp], aaiMvpIdxBi[refList][refIdxTemp], bitsTemp, costTemp,
+                                  amvp[eRefPicList], true);
+              }
 #endif
 #if GDR_ENABLED
               if (isEncodeGdrClean)
@@ -3552,11 +3759,24 @@ void InterSearch::predInterSearch(CodingUnit& cu, Partitioner& partitioner)
                     pu.mvValid[eRefPicList] = cs.isClean(pu.Y().bottomRight(), pu.mv[eRefPicList], (RefPicList)eRefPicList, pu.refIdx[eRefPicList]);
                   }
 #endif
-                  PelUnitBuf predBufTmp = m_tmpPredStorage[refList].getBuf(UnitAreaRelative(cu, pu));
-                  motionCompensation(pu, predBufTmp, eRefPicList);
+                  if (meTask)
+                  {
+                    // only the prediction of the final best reference is needed by the next iteration
+                    predChanged = true;
+                  }
+                  else
+                  {
+                    PelUnitBuf predBufTmp = m_tmpPredStorage[refList].getBuf(UnitAreaRelative(cu, pu));
+                    motionCompensation(pu, predBufTmp, eRefPicList);
+                  }
                 }
               }
             }   // for loop-refIdxTemp
+            if (predChanged)
+            {
+              PelUnitBuf predBufTmp = m_tmpPredStorage[refList].getBuf(UnitAreaRelative(cu, pu));
+              motionCompensation(pu, predBufTmp, eRefPicList);
+            }
 
             if (!changed)
             {
@@ -4892,6 +5112,91 @@ Distortion InterSearch::xGetAffineTemplateCost(PredictionUnit &pu, PelUnitBuf &o
   return uiCost;
 }
 
+void InterSearch::xRunMotionSearchTasks(const PredictionUnit &pu, PelUnitBuf &origBuf, const int numTasks)
+{
+  for (int i = 0; i < numTasks; i++)
+  {
+    MotionSearchTask *task = &m_meTasks[i];
+    m_threadPool->addJob([this, task, &pu, &origBuf](int threadIdx)
+                         { m_meWorkers[threadIdx]->xExecMotionSearchTask(*this, pu, origBuf, *task); });
+  }
+  m_threadPool->waitForJobs();
+}
+
+void InterSearch::xExecMotionSearchTask(const InterSearch &master, const PredictionUnit &pu, PelUnitBuf &origBuf,
+                                        MotionSearchTask &task)
+{
+  // take over the search state of the calling instance, which is blocked until all tasks are finished
+  *m_pcRdCost       = *master.m_pcRdCost;
+  m_cDistParam      = master.m_cDistParam;
+  m_modeCtrl        = master.m_modeCtrl;
+  m_lumaClpRng      = master.m_lumaClpRng;
+  m_clipMvInSubPic  = master.m_clipMvInSubPic;
+  m_maxCompIDToPred = master.m_maxCompIDToPred;
+  memcpy(m_adaptSR, master.m_adaptSR, sizeof(m_adaptSR));
+  memcpy(m_numHashMVStoreds, master.m_numHashMVStoreds, sizeof(m_numHashMVStoreds));
+  memcpy(m_hashMVStoreds, master.m_hashMVStoreds, sizeof(m_hashMVStoreds));
+  std::copy(master.m_uniMvList, master.m_uniMvList + m_uniMvListMaxSize, m_uniMvList);
+  m_uniMvListIdx  = master.m_uniMvListIdx;
+  m_uniMvListSize = master.m_uniMvListSize;
+  if (pu.cu->bcwIdx != BCW_DEFAULT)
+  {
+    m_uniMotions = master.m_uniMotions;
+  }
+  if (task.bi)
+  {
+    const UnitArea relArea = UnitAreaRelative(*pu.cu, pu);
+    m_tmpPredStorage[1 - task.refList].getBuf(relArea).copyFrom(master.m_tmpPredStorage[1 - task.refList].getBuf(relArea));
+  }
+
+  // the AMVP estimation stores the selected candidate in the prediction unit
+  PredictionUnit taskPu = pu;
+
+  if (task.estimateMvp)
+  {
+    xEstimateMvPredAMVP(taskPu, origBuf, task.refList, task.refIdx, task.mvPred, task.amvp, false, &task.biPDist);
+    task.mvPredEst = task.mvPred;
+    task.mvpIdxEst = taskPu.mvpIdx[task.refList];
+    task.mvpIdx    = task.mvpIdxEst;
+    task.bits += m_auiMVPIdxCost[task.mvpIdx][AMVP_MAX_NUM_CANDS];
+  }
+  if (task.search)
+  {
+#if GDR_ENABLED
+    xMotionEstimation(taskPu, origBuf, task.refList, task.mvPred, task.refIdx, task.mv, task.mvSolid, task.mvpIdx,
+                      task.bits, task.cost, task.amvp, task.cleanCandExist, task.bi);
+#else
+    xMotionEstimation(taskPu, origBuf, task.refList, task.mvPred, task.refIdx, task.mv, task.mvpIdx, task.bits,
+                      task.cost, task.amvp, task.bi);
+#endif
+    task.rdPredictor = m_pcRdCost->getPredictor();
+    task.rdCostScale = m_pcRdCost->getCostScale();
+  }
+}
+
+#if GDR_ENABLED
+void InterSearch::xApplyMotionSearchTask(const MotionSearchTask &task, Mv &rcMvPred, Mv &rcMv, bool &rcMvSolid,
+                                         int &riMVPIdx, uint32_t &ruiBits, Distortion &ruiCost, bool &rbCleanCandExist)
+#else
+void InterSearch::xApplyMotionSearchTask(const MotionSearchTask &task, Mv &rcMvPred, Mv &rcMv, int &riMVPIdx,
+                                         uint32_t &ruiBits, Distortion &ruiCost)
+#endif
+{
+  rcMvPred = task.mvPred;
+  rcMv     = task.mv;
+  riMVPIdx = task.mvpIdx;
+  ruiBits  = task.bits;
+  ruiCost  = task.cost;
+#if GDR_ENABLED
+  rcMvSolid        = task.mvSolid;
+  rbCleanCandExist = task.cleanCandExist;
+#endif
+
+  // leave the motion cost state as xMotionEstimation() would, the following bit estimations depend on it
+  m_pcRdCost->setPredictor(task.rdPredictor);
+  m_pcRdCost->setCostScale(task.rdCostScale);
+}
+
 #if GDR_ENABLED
 void InterSearch::xMotionEstimation(PredictionUnit &pu, PelUnitBuf &origBuf, RefPicList eRefPicList, Mv &rcMvPred,
                                     int refIdxPred, Mv &rcMv, bool &rcMvSolid, int &riMVPIdx, uint32_t &ruiBits,
@@ -5300,6 +5605,10 @@ void InterSearch::xPatternSearchFast(const PredictionUnit &pu, RefPicList eRefPi
     xTZSearch(pu, eRefPicList, refIdxPred, cStruct, rcMv, ruiSAD, pIntegerMv2Nx2NPred, true);
     break;
 
+  case MESEARCH_PYRAMID:
+    xPyramidSearch(pu, eRefPicList, refIdxPred, cStruct, rcMv, ruiSAD, pIntegerMv2Nx2NPred);
+    break;
+
   case MESEARCH_FULL: // shouldn't get here.
   default:
     break;
@@ -5874,6 +6183,214 @@ void InterSearch::xTZSearchSelective(const PredictionUnit &pu, RefPicList eRefPi
   ruiSAD = cStruct.uiBestSad - m_pcRdCost->getCostOfVectorWithPredictor( cStruct.iBestX, cStruct.iBestY, cStruct.imvShift );
 }
 
+void InterSearch::xPyramidSearch(const PredictionUnit &pu, RefPicList eRefPicList, int refIdxPred,
+                                 IntTZSearchStruct &cStruct, Mv &rcMv, Distortion &ruiSAD,
+                                 const Mv *const pIntegerMv2Nx2NPred)
+{
+  const Picture *refPic   = pu.cu->slice->getRefPic( eRefPicList, refIdxPred );
+  const int      width    = pu.lumaSize().width;
+  const int      height   = pu.lumaSize().height;
+  const int      minSize  = std::min( width, height );
+
+  // the downsampled levels are only worth it (and only valid) for larger blocks searching the plain reconstruction
+  if( minSize < 16 || cStruct.inCtuSearch || !refPic->hasMotionSearchPyramid() || refPic->isWrapAroundEnabled( pu.cs->pps )
+      || m_cDistParam.applyWeight || m_pcEncCfg->getMCTSEncConstraint()
+#if GDR_ENABLED
+      || m_pcEncCfg->getGdrEnabled()
+#endif
+    )
+  {
+    xTZSearch( pu, eRefPicList, refIdxPred, cStruct, rcMv, ruiSAD, pIntegerMv2Nx2NPred, false );
+    return;
+  }
+
+  const int numLevels = ME_PYRAMID_LEVELS;
+
+  clipMv( rcMv, pu.cu->lumaPos(), pu.cu->lumaSize(), *pu.cs->sps, *pu.cs->pps );
+  rcMv.changePrecision( MV_PRECISION_INTERNAL, MV_PRECISION_QUARTER );
+  rcMv.divideByPowerOf2( 2 );
+
+  // init TZSearchStruct
+  cStruct.uiBestSad = std::numeric_limits<Distortion>::max();
+  cStruct.iBestX = 0;
+  cStruct.iBestY = 0;
+
+  m_cDistParam.maximumDistortionForEarlyExit = cStruct.uiBestSad;
+  m_pcRdCost->setDistParam( m_cDistParam, *cStruct.pcPatternKey, cStruct.piRefY, cStruct.iRefStride, m_lumaClpRng.bd, COMPONENT_Y, cStruct.subShiftMode );
+
+  // the predictors are checked at full resolution, they bound the cost the pyramid candidate has to beat
+  xTZSearchHelp( cStruct, rcMv.getHor(), rcMv.getVer(), 0, 0 );
+  xTZSearchHelp( cStruct, 0, 0, 0, 0 );
+
+  if( pIntegerMv2Nx2NPred != 0 )
+  {
+    Mv integerMv2Nx2NPred = *pIntegerMv2Nx2NPred;
+    integerMv2Nx2NPred.changePrecision( MV_PRECISION_INT, MV_PRECISION_INTERNAL );
+    clipMv( integerMv2Nx2NPred, pu.cu->lumaPos(), pu.cu->lumaSize(), *pu.cs->sps, *pu.cs->pps );
+    integerMv2Nx2NPred.changePrecision( MV_PRECISION_INTERNAL, MV_PRECISION_QUARTER );
+    integerMv2Nx2NPred.divideByPowerOf2( 2 );
+
+    xTZSearchHelp( cStruct, integerMv2Nx2NPred.getHor(), integerMv2Nx2NPred.getVer(), 0, 0 );
+  }
+
+  for( int i = 0; i < m_uniMvListSize; i++ )
+  {
+    BlkUniMvInfo* curMvInfo = m_uniMvList + ( ( m_uniMvListIdx - 1 - i + m_uniMvListMaxSize ) % ( m_uniMvListMaxSize ) );
+
+    int j = 0;
+    for( ; j < i; j++ )
+    {
+      BlkUniMvInfo *prevMvInfo = m_uniMvList + ( ( m_uniMvListIdx - 1 - j + m_uniMvListMaxSize ) % ( m_uniMvListMaxSize ) );
+      if( curMvInfo->uniMvs[eRefPicList][refIdxPred] == prevMvInfo->uniMvs[eRefPicList][refIdxPred] )
+      {
+        break;
+      }
+    }
+    if( j < i )
+    {
+      continue;
+    }
+
+    Mv cTmpMv = curMvInfo->uniMvs[eRefPicList][refIdxPred];
+    clipMv( cTmpMv, pu.cu->lumaPos(), pu.cu->lumaSize(), *pu.cs->sps, *pu.cs->pps );
+    cTmpMv.changePrecision( MV_PRECISION_INTERNAL, MV_PRECISION_INT );
+    xTZSearchHelp( cStruct, cTmpMv.hor, cTmpMv.ver, 0, 0 );
+  }
+
+  SearchRange& sr = cStruct.searchRange;
+  {
+    Mv currBestMv( cStruct.iBestX, cStruct.iBestY );
+    currBestMv <<= MV_FRACTIONAL_BITS_INTERNAL;
+#if GDR_ENABLED
+    xSetSearchRange( pu, currBestMv, m_searchRange, sr, cStruct, eRefPicList, refIdxPred );
+#else
+    xSetSearchRange( pu, currBestMv, m_searchRange, sr, cStruct );
+#endif
+  }
+
+  // small neighbourhood of the best predictor, the coarse levels can not resolve it
+  {
+    const int iStartX = cStruct.iBestX;
+    const int iStartY = cStruct.iBestY;
+    xTZ8PointDiamondSearch( cStruct, iStartX, iStartY, 1, false );
+    xTZ8PointDiamondSearch( cStruct, iStartX, iStartY, 2, false );
+  }
+
+  // downsample the search pattern in the same way as the reference levels
+  CPelBuf pattern[ME_PYRAMID_LEVELS + 1];
+  pattern[0] = *cStruct.pcPatternKey;
+  for( int level = 1; level <= numLevels; level++ )
+  {
+    const CPelBuf& src = pattern[level - 1];
+    PelBuf         dst( m_pyramidPattern[level - 1], src.width >> 1, src.height >> 1 );
+    for( int y = 0; y < dst.height; y++ )
+    {
+      const Pel* src0 = src.bufAt( 0, 2 * y );
+      const Pel* src1 = src.bufAt( 0, 2 * y + 1 );
+      Pel*       dstY = dst.bufAt( 0, y );
+      for( int x = 0; x < dst.width; x++ )
+      {
+        dstY[x] = ( src0[2 * x] + src0[2 * x + 1] + src1[2 * x] + src1[2 * x + 1] + 2 ) >> 2;
+      }
+    }
+    pattern[level] = dst;
+  }
+
+  const Position lumaPos = pu.lumaPos();
+  DistParam      distParam;
+
+  // exhaustive search of the whole (scaled) search range at the coarsest level, then +-1 refinement per level
+  int bestX = cStruct.iBestX >> numLevels;
+  int bestY = cStruct.iBestY >> numLevels;
+  for( int level = numLevels; level > 0; level-- )
+  {
+    const CPelBuf refBuf    = refPic->getMotionSearchPyramid( level );
+    const Pel*    refOrigin = refBuf.bufAt( 0, 0 ) + ( lumaPos.y >> level ) * refBuf.stride + ( lumaPos.x >> level );
+    const int     left      = -( ( -sr.left ) >> level );
+    const int     top       = -( ( -sr.top ) >> level );
+    const int     right     = sr.right >> level;
+    const int     bottom    = sr.bottom >> level;
+    const int     centerX   = Clip3( left, right, level == numLevels ? bestX : 2 * bestX );
+    const int     centerY   = Clip3( top, bottom, level == numLevels ? bestY : 2 * bestY );
+    const int     startX    = level == numLevels ? left : std::max( left, centerX - 1 );
+    const int     endX      = level == numLevels ? right : std::min( right, centerX + 1 );
+    const int     startY    = level == numLevels ? top : std::max( top, centerY - 1 );
+    const int     endY      = level == numLevels ? bottom : std::min( bottom, centerY + 1 );
+
+    m_pcRdCost->setDistParam( distParam, pattern[level], refOrigin, refBuf.stride, m_lumaClpRng.bd, COMPONENT_Y );
+
+    Distortion bestCost = std::numeric_limits<Distortion>::max();
+    auto checkPoint = [&]( const int x, const int y )
+    {
+      // skip the distortion if the motion cost alone can not beat the best candidate
+      const Distortion bitCost = m_pcRdCost->getCostOfVectorWithPredictor( x << level, y << level, cStruct.imvShift );
+      if( bitCost >= bestCost )
+      {
+        return;
+      }
+
+      distParam.cur.buf = refOrigin + y * refBuf.stride + x;
+
+      const Distortion cost = ( distParam.distFunc( distParam ) << ( 2 * level ) ) + bitCost;
+      if( cost < bestCost )
+      {
+        bestCost = cost;
+        bestX    = x;
+        bestY    = y;
+      }
+    };
+
+    // start at the center, it bounds the cost of the distant candidates
+    checkPoint( centerX, centerY );
+    for( int y = startY; y <= endY; y++ )
+    {
+      for( int x = startX; x <= endX; x++ )
+      {
+        if( x != centerX || y != centerY )
+        {
+          checkPoint( x, y );
+        }
+      }
+    }
+  }
+
+  // full-pel refinement around the pyramid candidate
+  const int centerX = 2 * bestX;
+  const int centerY = 2 * bestY;
+  for( int y = std::max( sr.top, centerY - 1 ); y <= std::min( sr.bottom, centerY + 1 ); y++ )
+  {
+    for( int x = std::max( sr.left, centerX - 1 ); x <= std::min( sr.right, centerX + 1 ); x++ )
+    {
+      xTZSearchHelp( cStruct, x, y, 0, 1 );
+    }
+  }
+
+  cStruct.uiBestDistance = 1;
+  while( cStruct.uiBestDistance > 0 )
+  {
+    const int iStartX = cStruct.iBestX;
+    const int iStartY = cStruct.iBestY;
+    cStruct.uiBestDistance = 0;
+    cStruct.ucPointNr = 0;
+    xTZ8PointDiamondSearch( cStruct, iStartX, iStartY, 1, false );
+    xTZ8PointDiamondSearch( cStruct, iStartX, iStartY, 2, false );
+
+    // calculate only 2 missing points instead 8 points if cStrukt.uiBestDistance == 1
+    if( cStruct.uiBestDistance == 1 )
+    {
+      cStruct.uiBestDistance = 0;
+      if( cStruct.ucPointNr != 0 )
+      {
+        xTZ2PointSearch( cStruct );
+      }
+    }
+  }
+
+  // write out best match
+  rcMv.set( cStruct.iBestX, cStruct.iBestY );
+  ruiSAD = cStruct.uiBestSad - m_pcRdCost->getCostOfVectorWithPredictor( cStruct.iBestX, cStruct.iBestY, cStruct.imvShift );
+}
+
 #if GDR_ENABLED
 void InterSearch::xPatternSearchIntRefine(PredictionUnit &pu, IntTZSearchStruct &cStruct, Mv &rcMv, Mv &rcMvPred,
                                           int &riMVPIdx, uint32_t &ruiBits, Distortion &ruiCost,
@@ -8274,6 +8791,86 @@ void InterSearch::xCheckBestAffineMVP( PredictionUnit &pu, AffineAMVPInfo &affin
   }
 }
 
+int InterSearch::xPredAffineLumaCached( const PredictionUnit &pu, const Picture *refPic, const Mv mv[3], PelUnitBuf &predBuf )
+{
+  const Area &area  = pu.Y();
+  const int   mvNum = pu.cu->affineType == AFFINEMODEL_6PARAM ? 3 : 2;
+
+  for( int i = 0; i < m_affPredCacheSize; i++ )
+  {
+    const AffinePredCacheEntry &entry = m_affPredCache[i];
+    if( entry.area == area && entry.refPic == refPic && entry.affineType == pu.cu->affineType
+        && entry.interDir == pu.interDir && entry.skipProf == m_skipProf && entry.skipProfCond == m_skipProfCond
+        && entry.biPredSearch == m_biPredSearchAffine && std::equal( mv, mv + mvNum, entry.mv ) )
+    {
+      predBuf.Y().copyFrom( CPelBuf( entry.pred.data(), area.width, area.height ) );
+      return i;
+    }
+  }
+
+  const int cacheIdx = m_affPredCacheNext;
+  m_affPredCacheNext = ( m_affPredCacheNext + 1 ) % AFFINE_ME_PRED_CACHE_SIZE;
+  m_affPredCacheSize = std::max( m_affPredCacheSize, cacheIdx + 1 );
+
+  AffinePredCacheEntry &entry = m_affPredCache[cacheIdx];
+  entry.area         = area;
+  entry.refPic       = refPic;
+  entry.affineType   = pu.cu->affineType;
+  entry.interDir     = pu.interDir;
+  entry.skipProf     = m_skipProf;
+  entry.skipProfCond = m_skipProfCond;
+  entry.biPredSearch = m_biPredSearchAffine;
+  entry.gradValid    = false;
+  std::copy( mv, mv + 3, entry.mv );
+
+#if GDR_ENABLED
+  entry.yyOk = xPredAffineBlk( COMPONENT_Y, pu, refPic, mv, predBuf, false, pu.cu->slice->clpRng( COMPONENT_Y ) );
+#else
+  xPredAffineBlk( COMPONENT_Y, pu, refPic, mv, predBuf, false, pu.cu->slice->clpRng( COMPONENT_Y ) );
+#endif
+
+  if( entry.pred.empty() )
+  {
+    entry.pred.resize( MAX_CU_SIZE * MAX_CU_SIZE );
+  }
+  PelBuf( entry.pred.data(), area.width, area.height ).copyFrom( predBuf.Y() );
+
+  return cacheIdx;
+}
+
+void InterSearch::xGetAffineGradients( const int cacheIdx, const CPelBuf &pred, int *gradients[2] )
+{
+  AffinePredCacheEntry &entry = m_affPredCache[cacheIdx];
+  const int width  = entry.area.width;
+  const int height = entry.area.height;
+
+  if( !entry.gradValid )
+  {
+    if( entry.grad[0].empty() )
+    {
+      entry.grad[0].resize( MAX_CU_SIZE * MAX_CU_SIZE );
+      entry.grad[1].resize( MAX_CU_SIZE * MAX_CU_SIZE );
+    }
+
+    // sobel x direction
+    // -1 0 1
+    // -2 0 2
+    // -1 0 1
+    m_HorizontalSobelFilter( const_cast<Pel*>( pred.buf ), pred.stride, entry.grad[0].data(), width, width, height );
+
+    // sobel y direction
+    // -1 -2 -1
+    //  0  0  0
+    //  1  2  1
+    m_VerticalSobelFilter( const_cast<Pel*>( pred.buf ), pred.stride, entry.grad[1].data(), width, width, height );
+
+    entry.gradValid = true;
+  }
+
+  gradients[0] = entry.grad[0].data();
+  gradients[1] = entry.grad[1].data();
+}
+
 #if GDR_ENABLED
 void InterSearch::xAffineMotionEstimation(PredictionUnit &pu, PelUnitBuf &origBuf, RefPicList eRefPicList,
                                           Mv acMvPred[3], int refIdxPred, Mv acMv[3], bool acMvSolid[3],
@@ -8351,8 +8948,6 @@ void InterSearch::xAffineMotionEstimation(PredictionUnit &pu, PelUnitBuf &origBu
   int64_t  i64EqualCoeff[7][7];
   Pel    *piError = m_tmpAffiError;
   int    *pdDerivate[2];
-  pdDerivate[0] = m_tmpAffiDeri[0];
-  pdDerivate[1] = m_tmpAffiDeri[1];
 
   Distortion uiCostBest = std::numeric_limits<Distortion>::max();
   uint32_t uiBitsBest = 0;
@@ -8390,10 +8985,9 @@ void InterSearch::xAffineMotionEstimation(PredictionUnit &pu, PelUnitBuf &origBu
   {
     acMvTemp[2].roundAffinePrecInternal2Amvr(pu.cu->imv);
   }
+  int predCacheIdx = xPredAffineLumaCached( pu, refPic, acMvTemp, predBuf );
 #if GDR_ENABLED
-  bool YYOk = xPredAffineBlk(COMPONENT_Y, pu, refPic, acMvTemp, predBuf, false, pu.cs->slice->clpRng(COMPONENT_Y));
-#else
-  xPredAffineBlk( COMPONENT_Y, pu, refPic, acMvTemp, predBuf, false, pu.cs->slice->clpRng( COMPONENT_Y ) );
+  bool YYOk = m_affPredCache[predCacheIdx].yyOk;
 #endif
 
   // get error
@@ -8444,6 +9038,7 @@ void InterSearch::xAffineMotionEstimation(PredictionUnit &pu, PelUnitBuf &origBu
   const int predBufStride = predBuf.Y().stride;
   Mv prevIterMv[7][3];
   int iIterTime;
+  int numItersNoGain = 0;
   if ( pu.cu->affineType == AFFINEMODEL_6PARAM )
   {
     iIterTime = bBi ? 3 : 4;
@@ -8476,18 +9071,8 @@ void InterSearch::xAffineMotionEstimation(PredictionUnit &pu, PelUnitBuf &origBu
       pPred += predBufStride;
     }
 
-    // sobel x direction
-    // -1 0 1
-    // -2 0 2
-    // -1 0 1
-    pPred = predBuf.Y().buf;
-    m_HorizontalSobelFilter( pPred, predBufStride, pdDerivate[0], width, width, height );
-
-    // sobel y direction
-    // -1 -2 -1
-    //  0  0  0
-    //  1  2  1
-    m_VerticalSobelFilter( pPred, predBufStride, pdDerivate[1], width, width, height );
+    // gradients of the prediction, computed once per cached prediction
+    xGetAffineGradients( predCacheIdx, predBuf.Y(), pdDerivate );
 
     // solve delta x and y
     for ( int row = 0; row < iParaNum; row++ )
@@ -8608,10 +9193,9 @@ void InterSearch::xAffineMotionEstimation(PredictionUnit &pu, PelUnitBuf &origBu
       }
     }
 
+    predCacheIdx = xPredAffineLumaCached( pu, refPic, acMvTemp, predBuf );
 #if GDR_ENABLED
-    bool YYOk = xPredAffineBlk(COMPONENT_Y, pu, refPic, acMvTemp, predBuf, false, pu.cu->slice->clpRng(COMPONENT_Y));
-#else
-    xPredAffineBlk( COMPONENT_Y, pu, refPic, acMvTemp, predBuf, false, pu.cu->slice->clpRng( COMPONENT_Y ) );
+    bool YYOk = m_affPredCache[predCacheIdx].yyOk;
 #endif
 
     // get error
@@ -8683,15 +9267,21 @@ void InterSearch::xAffineMotionEstimation(PredictionUnit &pu, PelUnitBuf &origBu
       uiBitsBest = bitsTemp;
       memcpy( acMv, acMvTemp, sizeof(Mv) * 3 );
       mvpIdx = bestMvpIdx;
+      numItersNoGain = 0;
+    }
+    else if ( m_pcEncCfg->getAffineMeEarlyTerm() && ++numItersNoGain >= 2 )
+    {
+      break;
     }
   }
 
   auto checkCPMVRdCost = [&](Mv ctrlPtMv[3])
   {
+    const int cacheIdx = xPredAffineLumaCached(pu, refPic, ctrlPtMv, predBuf);
 #if GDR_ENABLED
-    bool YYOk = xPredAffineBlk(COMPONENT_Y, pu, refPic, ctrlPtMv, predBuf, false, pu.cu->slice->clpRng(COMPONENT_Y));
+    bool YYOk = m_affPredCache[cacheIdx].yyOk;
 #else
-    xPredAffineBlk(COMPONENT_Y, pu, refPic, ctrlPtMv, predBuf, false, pu.cu->slice->clpRng(COMPONENT_Y));
+    (void) cacheIdx;
 #endif
 
 #if GDR_ENABLED
@@ -8828,10 +9418,11 @@ void InterSearch::xAffineMotionEstimation(PredictionUnit &pu, PelUnitBuf &origBu
             acMvTemp[j].set(centerMv[j].getHor() + testPos[i][0] * (1 << mvShift),
                             centerMv[j].getVer() + testPos[i][1] * (1 << mvShift));
             clipMv( acMvTemp[j], pu.cu->lumaPos(), pu.cu->lumaSize(), *pu.cs->sps, *pu.cs->pps );
+            const int cacheIdx = xPredAffineLumaCached(pu, refPic, acMvTemp, predBuf);
 #if GDR_ENABLED
-            bool YYOk = xPredAffineBlk(COMPONENT_Y, pu, refPic, acMvTemp, predBuf, false, pu.cu->slice->clpRng(COMPONENT_Y));
+            bool YYOk = m_affPredCache[cacheIdx].yyOk;
 #else
-            xPredAffineBlk(COMPONENT_Y, pu, refPic, acMvTemp, predBuf, false, pu.cu->slice->clpRng(COMPONENT_Y));
+            (void) cacheIdx;
 #endif
 
 #if GDR_ENABLED
@@ -9051,12 +9642,18 @@ void InterSearch::xExtDIFUpSamplingH(CPelBuf* pattern, bool useAltHpelIf)
 
   const auto filterIdx = useAltHpelIf ? InterpolationFilter::Filter::HALFPEL_ALT : InterpolationFilter::Filter::DEFAULT;
 
-  m_if.filterHor(COMPONENT_Y, srcPtr, srcStride, m_filteredBlockTmp[0][0], intStride, width + 1, height + filterSize,
-                 0 << MV_FRACTIONAL_BITS_DIFF, false, clpRng, filterIdx);
-  if (!m_skipFracME)
+  if (m_skipFracME)
+  {
+    m_if.filterHor(COMPONENT_Y, srcPtr, srcStride, m_filteredBlockTmp[0][0], intStride, width + 1,
+                   height + filterSize, 0 << MV_FRACTIONAL_BITS_DIFF, false, clpRng, filterIdx);
+  }
+  else
   {
-    m_if.filterHor(COMPONENT_Y, srcPtr, srcStride, m_filteredBlockTmp[2][0], intStride, width + 1, height + filterSize,
-                   2 << MV_FRACTIONAL_BITS_DIFF, false, clpRng, filterIdx);
+    // the integer and the half-sample horizontal phases share the source rows, both cover ( -1, -halfFilterSize )
+    Pel *const horBlocks[2] = { m_filteredBlockTmp[0][0], m_filteredBlockTmp[2][0] };
+    const int  horFrac[2]   = { 0 << MV_FRACTIONAL_BITS_DIFF, 2 << MV_FRACTIONAL_BITS_DIFF };
+    m_if.filterHorBatch(srcPtr, srcStride, horBlocks, intStride, width + 1, height + filterSize, 2, horFrac, clpRng,
+                        filterIdx);
   }
 
   intPtr = m_filteredBlockTmp[0][0] + halfFilterSize * intStride + 1;
@@ -9068,10 +9665,13 @@ void InterSearch::xExtDIFUpSamplingH(CPelBuf* pattern, bool useAltHpelIf)
     return;
   }
 
+  const int verFrac   = 2 << MV_FRACTIONAL_BITS_DIFF;
+  const int rowOffset = 0;
+
   intPtr = m_filteredBlockTmp[0][0] + (halfFilterSize - 1) * intStride + 1;
   dstPtr = m_filteredBlock[2][0][0];
-  m_if.filterVer(COMPONENT_Y, intPtr, intStride, dstPtr, dstStride, width + 0, height + 1, 2 << MV_FRACTIONAL_BITS_DIFF,
-                 false, true, clpRng, filterIdx);
+  m_if.filterVerBatch(intPtr, intStride, &dstPtr, dstStride, width + 0, height + 1, 1, &verFrac, &rowOffset, clpRng,
+                      filterIdx);
 
   intPtr = m_filteredBlockTmp[2][0] + halfFilterSize * intStride;
   dstPtr = m_filteredBlock[0][2][0];
@@ -9080,17 +9680,21 @@ void InterSearch::xExtDIFUpSamplingH(CPelBuf* pattern, bool useAltHpelIf)
 
   intPtr = m_filteredBlockTmp[2][0] + (halfFilterSize - 1) * intStride;
   dstPtr = m_filteredBlock[2][2][0];
-  m_if.filterVer(COMPONENT_Y, intPtr, intStride, dstPtr, dstStride, width + 1, height + 1, 2 << MV_FRACTIONAL_BITS_DIFF,
-                 false, true, clpRng, filterIdx);
+  m_if.filterVerBatch(intPtr, intStride, &dstPtr, dstStride, width + 1, height + 1, 1, &verFrac, &rowOffset, clpRng,
+                      filterIdx);
 }
 
 
 /**
 * \brief Generate quarter-sample interpolated blocks
 *
+* The eight quarter-sample positions around the half-sample position are interpolated with one batched horizontal
+* pass for the 1/4 and 3/4 phases and one batched vertical pass per horizontal phase. All horizontal intermediates
+* cover the area from ( -1, -halfFilterSize ) like the ones of xExtDIFUpSamplingH, whose integer and half-sample
+* intermediates are reused.
+*
 * \param pattern    Reference picture ROI
 * \param halfPelRef Half-pel mv
-* \param biPred     Flag indicating whether block is for biprediction
 */
 void InterSearch::xExtDIFUpSamplingQ( CPelBuf* pattern, Mv halfPelRef )
 {
@@ -9099,166 +9703,55 @@ void InterSearch::xExtDIFUpSamplingQ( CPelBuf* pattern, Mv halfPelRef )
   int height     = pattern->height;
   int srcStride  = pattern->stride;
 
-  Pel const* srcPtr;
   int intStride = width + 1;
   int dstStride = width + 1;
-  Pel *intPtr;
-  Pel *dstPtr;
   int filterSize = NTAPS_LUMA;
 
   int halfFilterSize = (filterSize>>1);
 
-  int extHeight = (halfPelRef.getVer() == 0) ? height + filterSize : height + filterSize-1;
+  const int cx = halfPelRef.getHor() * 2;
+  const int cy = halfPelRef.getVer() * 2;
 
-  // Horizontal filter 1/4
-  srcPtr = pattern->buf - halfFilterSize * srcStride - 1;
-  intPtr = m_filteredBlockTmp[1][0];
-  if (halfPelRef.getVer() > 0)
-  {
-    srcPtr += srcStride;
-  }
-  if (halfPelRef.getHor() >= 0)
-  {
-    srcPtr += 1;
-  }
-  m_if.filterHor(COMPONENT_Y, srcPtr, srcStride, intPtr, intStride, width, extHeight, 1 << MV_FRACTIONAL_BITS_DIFF,
-                 false, clpRng, InterpolationFilter::Filter::DEFAULT);
-
-  // Horizontal filter 3/4
-  srcPtr = pattern->buf - halfFilterSize*srcStride - 1;
-  intPtr = m_filteredBlockTmp[3][0];
-  if (halfPelRef.getVer() > 0)
-  {
-    srcPtr += srcStride;
-  }
-  if (halfPelRef.getHor() > 0)
-  {
-    srcPtr += 1;
-  }
-  m_if.filterHor(COMPONENT_Y, srcPtr, srcStride, intPtr, intStride, width, extHeight, 3 << MV_FRACTIONAL_BITS_DIFF,
-                 false, clpRng, InterpolationFilter::Filter::DEFAULT);
-
-  // Generate @ 1,1
-  intPtr = m_filteredBlockTmp[1][0] + (halfFilterSize-1) * intStride;
-  dstPtr = m_filteredBlock[1][1][0];
-  if (halfPelRef.getVer() == 0)
-  {
-    intPtr += intStride;
-  }
-  m_if.filterVer(COMPONENT_Y, intPtr, intStride, dstPtr, dstStride, width, height, 1 << MV_FRACTIONAL_BITS_DIFF, false,
-                 true, clpRng, InterpolationFilter::Filter::DEFAULT);
-
-  // Generate @ 3,1
-  intPtr = m_filteredBlockTmp[1][0] + (halfFilterSize-1) * intStride;
-  dstPtr = m_filteredBlock[3][1][0];
-  m_if.filterVer(COMPONENT_Y, intPtr, intStride, dstPtr, dstStride, width, height, 3 << MV_FRACTIONAL_BITS_DIFF, false,
-                 true, clpRng, InterpolationFilter::Filter::DEFAULT);
-
-  if (halfPelRef.getVer() != 0)
-  {
-    // Generate @ 2,1
-    intPtr = m_filteredBlockTmp[1][0] + (halfFilterSize - 1) * intStride;
-    dstPtr = m_filteredBlock[2][1][0];
-    if (halfPelRef.getVer() == 0)
-    {
-      intPtr += intStride;
-    }
-    m_if.filterVer(COMPONENT_Y, intPtr, intStride, dstPtr, dstStride, width, height, 2 << MV_FRACTIONAL_BITS_DIFF,
-                   false, true, clpRng, InterpolationFilter::Filter::DEFAULT);
-
-    // Generate @ 2,3
-    intPtr = m_filteredBlockTmp[3][0] + (halfFilterSize - 1) * intStride;
-    dstPtr = m_filteredBlock[2][3][0];
-    if (halfPelRef.getVer() == 0)
-    {
-      intPtr += intStride;
-    }
-    m_if.filterVer(COMPONENT_Y, intPtr, intStride, dstPtr, dstStride, width, height, 2 << MV_FRACTIONAL_BITS_DIFF,
-                   false, true, clpRng, InterpolationFilter::Filter::DEFAULT);
-  }
-  else
-  {
-    // Generate @ 0,1
-    intPtr = m_filteredBlockTmp[1][0] + halfFilterSize * intStride;
-    dstPtr = m_filteredBlock[0][1][0];
-    m_if.filterVer(COMPONENT_Y, intPtr, intStride, dstPtr, dstStride, width, height, 0 << MV_FRACTIONAL_BITS_DIFF,
-                   false, true, clpRng, InterpolationFilter::Filter::DEFAULT);
+  // Horizontal filter 1/4 and 3/4, the extra column and row are only needed around a zero half-sample offset
+  const int colStart  = halfPelRef.getHor() > 0 ? 1 : 0;
+  const int rowStart  = halfPelRef.getVer() > 0 ? 1 : 0;
+  const int extWidth  = halfPelRef.getHor() == 0 ? width + 1 : width;
+  const int extHeight = halfPelRef.getVer() == 0 ? height + filterSize : height + filterSize - 1;
+  const int intOffset = rowStart * intStride + colStart;
 
-    // Generate @ 0,3
-    intPtr = m_filteredBlockTmp[3][0] + halfFilterSize * intStride;
-    dstPtr = m_filteredBlock[0][3][0];
-    m_if.filterVer(COMPONENT_Y, intPtr, intStride, dstPtr, dstStride, width, height, 0 << MV_FRACTIONAL_BITS_DIFF,
-                   false, true, clpRng, InterpolationFilter::Filter::DEFAULT);
-  }
+  const Pel *srcPtr       = pattern->buf - halfFilterSize * srcStride - 1 + rowStart * srcStride + colStart;
+  Pel *const horBlocks[2] = { m_filteredBlockTmp[1][0] + intOffset, m_filteredBlockTmp[3][0] + intOffset };
+  const int  horFrac[2]   = { 1 << MV_FRACTIONAL_BITS_DIFF, 3 << MV_FRACTIONAL_BITS_DIFF };
+  m_if.filterHorBatch(srcPtr, srcStride, horBlocks, intStride, extWidth, extHeight, 2, horFrac, clpRng,
+                      InterpolationFilter::Filter::DEFAULT);
 
-  if (halfPelRef.getHor() != 0)
-  {
-    // Generate @ 1,2
-    intPtr = m_filteredBlockTmp[2][0] + (halfFilterSize - 1) * intStride;
-    dstPtr = m_filteredBlock[1][2][0];
-    if (halfPelRef.getHor() > 0)
-    {
-      intPtr += 1;
-    }
-    if (halfPelRef.getVer() >= 0)
-    {
-      intPtr += intStride;
-    }
-    m_if.filterVer(COMPONENT_Y, intPtr, intStride, dstPtr, dstStride, width, height, 1 << MV_FRACTIONAL_BITS_DIFF,
-                   false, true, clpRng, InterpolationFilter::Filter::DEFAULT);
-
-    // Generate @ 3,2
-    intPtr = m_filteredBlockTmp[2][0] + (halfFilterSize - 1) * intStride;
-    dstPtr = m_filteredBlock[3][2][0];
-    if (halfPelRef.getHor() > 0)
-    {
-      intPtr += 1;
-    }
-    if (halfPelRef.getVer() > 0)
-    {
-      intPtr += intStride;
-    }
-    m_if.filterVer(COMPONENT_Y, intPtr, intStride, dstPtr, dstStride, width, height, 3 << MV_FRACTIONAL_BITS_DIFF,
-                   false, true, clpRng, InterpolationFilter::Filter::DEFAULT);
-  }
-  else
+  // Vertical filtering of the positions ( x, y ) = halfPelRef * 2 + ( dx, dy ), one batch per horizontal phase
+  const int rowBase = ((cy - 1) >> 2) + 1;
+  for (int dx = -1; dx <= 1; dx++)
   {
-    // Generate @ 1,0
-    intPtr = m_filteredBlockTmp[0][0] + (halfFilterSize - 1) * intStride + 1;
-    dstPtr = m_filteredBlock[1][0][0];
-    if (halfPelRef.getVer() >= 0)
-    {
-      intPtr += intStride;
-    }
-    m_if.filterVer(COMPONENT_Y, intPtr, intStride, dstPtr, dstStride, width, height, 1 << MV_FRACTIONAL_BITS_DIFF,
-                   false, true, clpRng, InterpolationFilter::Filter::DEFAULT);
+    const int x = cx + dx;
 
-    // Generate @ 3,0
-    intPtr = m_filteredBlockTmp[0][0] + (halfFilterSize - 1) * intStride + 1;
-    dstPtr = m_filteredBlock[3][0][0];
-    if (halfPelRef.getVer() > 0)
+    Pel *dst[3];
+    int  verFrac[3];
+    int  rowOffset[3];
+    int  numPhases = 0;
+    for (int dy = -1; dy <= 1; dy++)
     {
-      intPtr += intStride;
+      if (dx == 0 && dy == 0)
+      {
+        continue;
+      }
+      const int y          = cy + dy;
+      dst[numPhases]       = m_filteredBlock[y & 3][x & 3][0];
+      verFrac[numPhases]   = (y & 3) << MV_FRACTIONAL_BITS_DIFF;
+      rowOffset[numPhases] = (y >> 2) + 1 - rowBase;
+      numPhases++;
     }
-    m_if.filterVer(COMPONENT_Y, intPtr, intStride, dstPtr, dstStride, width, height, 3 << MV_FRACTIONAL_BITS_DIFF,
-                   false, true, clpRng, InterpolationFilter::Filter::DEFAULT);
-  }
 
-  // Generate @ 1,3
-  intPtr = m_filteredBlockTmp[3][0] + (halfFilterSize - 1) * intStride;
-  dstPtr = m_filteredBlock[1][3][0];
-  if (halfPelRef.getVer() == 0)
-  {
-    intPtr += intStride;
+    const Pel *intPtr = m_filteredBlockTmp[x & 3][0] + (halfFilterSize - 1 + rowBase) * intStride + (x >> 2) + 1;
+    m_if.filterVerBatch(intPtr, intStride, dst, dstStride, width, height, numPhases, verFrac, rowOffset, clpRng,
+                        InterpolationFilter::Filter::DEFAULT);
   }
-  m_if.filterVer(COMPONENT_Y, intPtr, intStride, dstPtr, dstStride, width, height, 1 << MV_FRACTIONAL_BITS_DIFF, false,
-                 true, clpRng, InterpolationFilter::Filter::DEFAULT);
-
-  // Generate @ 3,3
-  intPtr = m_filteredBlockTmp[3][0] + (halfFilterSize - 1) * intStride;
-  dstPtr = m_filteredBlock[3][3][0];
-  m_if.filterVer(COMPONENT_Y, intPtr, intStride, dstPtr, dstStride, width, height, 3 << MV_FRACTIONAL_BITS_DIFF, false,
-                 true, clpRng, InterpolationFilter::Filter::DEFAULT);
 }
 
 //! set wp tables
@@ -52,6 +52,7 @@
 #include "CommonLib/AffineGradientSearch.h"
 #include "CommonLib/IbcHashMap.h"
 #include "CommonLib/Hash.h"
+#include "CommonLib/ThreadPool.h"
 #include <unordered_map>
 #include <vector>
 #include "EncReshape.h"
@@ -106,6 +107,51 @@ typedef struct
 #endif
 } EncAffineMotion;
 
+/// search of one reference picture, executed by a worker of the parallel motion search
+struct MotionSearchTask
+{
+  RefPicList refList;
+  int        refIdx;
+  bool       bi;
+  bool       estimateMvp;      ///< select the AMVP candidate before the search (uni-directional search)
+  bool       search;           ///< run the motion search, false if only the AMVP selection is needed
+  AMVPInfo   amvp;
+  Mv         mvPredEst;        ///< predictor selected by the AMVP estimation
+  int        mvpIdxEst;
+  Distortion biPDist;
+  Mv         mvPred;
+  int        mvpIdx;
+  Mv         mv;
+  uint32_t   bits;
+  Distortion cost;
+#if GDR_ENABLED
+  bool       mvSolid;
+  bool       cleanCandExist;
+#endif
+  Mv         rdPredictor;      ///< motion cost state left behind by the search
+  int        rdCostScale;
+};
+
+/// luma prediction of one affine motion and its gradients, the affine ME evaluates the same motion of a block
+/// repeatedly (refinement rounds, bi-prediction iterations and the BCW/AMVR passes of the same CU)
+struct AffinePredCacheEntry
+{
+  Area             area;
+  const Picture   *refPic;
+  Mv               mv[3];
+  int              affineType;
+  uint8_t          interDir;
+  bool             skipProf;
+  bool             skipProfCond;
+  bool             biPredSearch;
+  bool             gradValid;
+#if GDR_ENABLED
+  bool             yyOk;
+#endif
+  std::vector<Pel> pred;
+  std::vector<int> grad[2];
+};
+
 /// encoder search class
 class InterSearch : public InterPrediction, AffineGradientSearch
 {
@@ -115,8 +161,8 @@ private:
   PelStorage      m_tmpPredStorage              [NUM_REF_PIC_LIST_01];
   PelStorage      m_tmpStorageLCU;
   PelStorage      m_tmpAffiStorage;
+  Pel             m_pyramidPattern              [ME_PYRAMID_LEVELS][( MAX_CU_SIZE >> 1 ) * ( MAX_CU_SIZE >> 1 )];
   Pel*            m_tmpAffiError;
-  int*            m_tmpAffiDeri[2];
 
   CodingStructure ****m_pSplitCS;
   CodingStructure ****m_pFullCS;
@@ -168,7 +214,7 @@ protected:
   int             m_currRefPicIndex;
   bool            m_skipFracME;
   int             m_numHashMVStoreds[NUM_REF_PIC_LIST_01][MAX_NUM_REF];
-  Mv              m_hashMVStoreds[NUM_REF_PIC_LIST_01][MAX_NUM_REF][5];
+  Mv              m_hashMVStoreds[NUM_REF_PIC_LIST_01][MAX_NUM_REF][HASH_ME_MAX_MATCHES];
 
   // Misc.
   Pel            *m_pTempPel;
@@ -190,6 +236,18 @@ protected:
   uint8_t         m_histBestMtsIdx;                     // historical best MTS idx  for PU of certain SSE values
   bool            m_clipMvInSubPic;
 
+  // parallel motion search
+  ThreadPool*     m_threadPool;
+  int             m_parallelMeMinArea;
+  std::vector<InterSearch*> m_meWorkers;                // search instance per thread slot
+  std::vector<RdCost*>      m_meWorkerRdCost;
+  MotionSearchTask          m_meTasks[NUM_REF_PIC_LIST_01 * MAX_NUM_REF];
+
+  // affine ME prediction cache, reset per CTU
+  AffinePredCacheEntry      m_affPredCache[AFFINE_ME_PRED_CACHE_SIZE];
+  int                       m_affPredCacheSize;
+  int                       m_affPredCacheNext;
+
 public:
   InterSearch();
   virtual ~InterSearch();
@@ -201,6 +259,9 @@ public:
 
   void destroy                      ();
 
+  /// creates the search workers of the parallel motion search, requires a prior call of init()
+  void setThreadPool                ( ThreadPool* threadPool );
+
   void       calcMinDistSbt         ( CodingStructure &cs, const CodingUnit& cu, const uint8_t sbtAllowed );
   uint8_t    skipSbtByRDCost        ( int width, int height, int mtDepth, uint8_t sbtIdx, uint8_t sbtPos, double bestCost, Distortion distSbtOff, double costSbtOff, bool rootCbfSbtOff );
   bool       getSkipSbtAll          ()                 { return m_skipSbtAll; }
@@ -213,6 +274,7 @@ public:
 
   void setTempBuffers               (CodingStructure ****pSlitCS, CodingStructure ****pFullCS, CodingStructure **pSaveCS );
   void resetCtuRecord               ()             { m_ctuRecord.clear(); }
+  void resetAffinePredCache         ()             { m_affPredCacheSize = 0; m_affPredCacheNext = 0; }
   void setAffineModeSelected        ( bool flag) { m_affineModeSelected = flag; }
   void resetAffineMVList() { m_affMVListIdx = 0; m_affMVListSize = 0; }
 #if GDR_ENABLED
@@ -429,12 +491,12 @@ public:
   void  xIBCEstimation   ( PredictionUnit& pu, PelUnitBuf& origBuf, Mv     *pcMvPred, Mv     &rcMv, Distortion &ruiCost, const int localSearchRangeX, const int localSearchRangeY);
   void  xIBCSearchMVCandUpdate  ( Distortion  uiSad, int x, int y, Distortion* uiSadBestCand, Mv* cMVCand);
   int   xIBCSearchMVChromaRefine( PredictionUnit& pu, int iRoiWidth, int iRoiHeight, int cuPelX, int cuPelY, Distortion* uiSadBestCand, Mv*     cMVCand);
-  void addToSortList(std::list<BlockHash>& listBlockHash, std::list<int>& listCost, int cost, const BlockHash& blockHash);
+  void addToSortList(BlockHashList& listBlockHash, static_vector<int, HASH_ME_MAX_MATCHES>& listCost, int cost, const BlockHash& blockHash);
   bool predInterHashSearch(CodingUnit& cu, Partitioner& partitioner, bool& isPerfectMatch);
   bool xHashInterEstimation(PredictionUnit& pu, RefPicList& bestRefPicList, int& bestRefIndex, Mv& bestMv, Mv& bestMvd, int& bestMVPIndex, bool& isPerfectMatch);
   bool xRectHashInterEstimation(PredictionUnit& pu, RefPicList& bestRefPicList, int& bestRefIndex, Mv& bestMv, Mv& bestMvd, int& bestMVPIndex, bool& isPerfectMatch);
-  void selectRectangleMatchesInter(const MapIterator& itBegin, int count, std::list<BlockHash>& listBlockHash, const BlockHash& currBlockHash, int width, int height, int idxNonSimple, unsigned int* &hashValues, int baseNum, int picWidth, int picHeight, bool isHorizontal, uint16_t* curHashPic);
-  void selectMatchesInter(const MapIterator& itBegin, int count, std::list<BlockHash>& vecBlockHash, const BlockHash& currBlockHash);
+  void selectRectangleMatchesInter(const MapIterator& itBegin, int count, BlockHashList& listBlockHash, const BlockHash& currBlockHash, int width, int height, int idxNonSimple, unsigned int* &hashValues, int baseNum, int picWidth, int picHeight, bool isHorizontal, uint16_t* curHashPic);
+  void selectMatchesInter(const MapIterator& itBegin, int count, BlockHashList& vecBlockHash, const BlockHash& currBlockHash);
 protected:
 
   // -------------------------------------------------------------------------------------------------------------------
@@ -477,9 +539,23 @@ protected:
                  Distortion &ruiSAD, const Mv *const pIntegerMv2Nx2NPred, const bool bExtendedSettings,
                  const bool bFastSettings = false);
 
+  // parallel motion search: the tasks in m_meTasks run on the workers, the results are applied in serial order
+  void xRunMotionSearchTasks        ( const PredictionUnit& pu, PelUnitBuf& origBuf, const int numTasks );
+  void xExecMotionSearchTask        ( const InterSearch& master, const PredictionUnit& pu, PelUnitBuf& origBuf, MotionSearchTask& task );
+#if GDR_ENABLED
+  void xApplyMotionSearchTask       ( const MotionSearchTask& task, Mv& rcMvPred, Mv& rcMv, bool& rcMvSolid, int& riMVPIdx,
+                                      uint32_t& ruiBits, Distortion& ruiCost, bool& rbCleanCandExist );
+#else
+  void xApplyMotionSearchTask       ( const MotionSearchTask& task, Mv& rcMvPred, Mv& rcMv, int& riMVPIdx,
+                                      uint32_t& ruiBits, Distortion& ruiCost );
+#endif
+
   void xTZSearchSelective(const PredictionUnit &pu, RefPicList eRefPicList, int refIdxPred, IntTZSearchStruct &cStruct,
                           Mv &rcMv, Distortion &ruiSAD, const Mv *const pIntegerMv2Nx2NPred);
 
+  void xPyramidSearch(const PredictionUnit &pu, RefPicList eRefPicList, int refIdxPred, IntTZSearchStruct &cStruct,
+                      Mv &rcMv, Distortion &ruiSAD, const Mv *const pIntegerMv2Nx2NPred);
+
   void xSetSearchRange(const PredictionUnit &pu, const Mv &cMvPred, const int iSrchRng, SearchRange &sr,
                        IntTZSearchStruct &cStruct
 #if GDR_ENABLED
@@ -541,6 +617,10 @@ protected:
                                const AffineAMVPInfo &aamvpi, bool bBi = false);
 #endif
 
+  // luma prediction of the affine ME through the per-CTU cache, returns the cache entry holding the prediction
+  int  xPredAffineLumaCached      ( const PredictionUnit &pu, const Picture *refPic, const Mv mv[3], PelUnitBuf &predBuf );
+  void xGetAffineGradients        ( const int cacheIdx, const CPelBuf &pred, int *gradients[2] );
+
   void xEstimateAffineAMVP(PredictionUnit &pu, AffineAMVPInfo &affineAMVPInfo, PelUnitBuf &origBuf,
                            RefPicList eRefPicList, int refIdx, Mv acMvPred[3], Distortion *puiDistBiP);
 
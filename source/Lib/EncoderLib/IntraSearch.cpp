@@ -52,6 +52,143 @@
  //! \ingroup EncoderLib
  //! \{
 #define PLTCtx(c) SubCtx( Ctx::Palette, c )
+
+void IntraGradHist::reset()
+{
+  m_pic       = nullptr;
+  m_poc       = 0;
+  m_numUnitsX = 0;
+  m_numUnitsY = 0;
+}
+
+void IntraGradHist::getHist( const CodingStructure &cs, const CompArea &area, uint32_t hist[NUM_LUMA_MODE] )
+{
+  const int ctuSize = cs.pcv->maxCUWidth;
+  const Position ctuPos( ( area.x / ctuSize ) * ctuSize, ( area.y / ctuSize ) * ctuSize );
+
+  if( m_pic != cs.picture || m_poc != cs.picture->getPOC() || m_ctuArea.pos() != ctuPos )
+  {
+    m_pic     = cs.picture;
+    m_poc     = cs.picture->getPOC();
+    m_ctuArea = Area( ctuPos, Size( std::min<int>( ctuSize, cs.pcv->lumaWidth  - ctuPos.x ),
+                                    std::min<int>( ctuSize, cs.pcv->lumaHeight - ctuPos.y ) ) );
+
+    xBuild( cs.picture->getOrigBuf().Y(), Area( 0, 0, cs.pcv->lumaWidth, cs.pcv->lumaHeight ),
+            cs.sps->getBitDepth( CHANNEL_TYPE_LUMA ) );
+  }
+
+  const int x0     = ( area.x - m_ctuArea.x ) >> 2;
+  const int y0     = ( area.y - m_ctuArea.y ) >> 2;
+  const int x1     = x0 + ( area.width  >> 2 );
+  const int y1     = y0 + ( area.height >> 2 );
+  const int stride = ( m_numUnitsX + 1 ) * NUM_LUMA_MODE;
+
+  CHECK( x1 > m_numUnitsX || y1 > m_numUnitsY, "Block outside of the CTU of the gradient histogram" );
+
+  const uint32_t *p00 = &m_integral[y0 * stride + x0 * NUM_LUMA_MODE];
+  const uint32_t *p01 = &m_integral[y0 * stride + x1 * NUM_LUMA_MODE];
+  const uint32_t *p10 = &m_integral[y1 * stride + x0 * NUM_LUMA_MODE];
+  const uint32_t *p11 = &m_integral[y1 * stride + x1 * NUM_LUMA_MODE];
+
+  for( int mode = 0; mode < NUM_LUMA_MODE; mode++ )
+  {
+    hist[mode] = p11[mode] - p01[mode] - p10[mode] + p00[mode];
+  }
+}
+
+void IntraGradHist::xBuild( const CPelBuf &org, const Area &picArea, const int bitDepth )
+{
+  // intraPredAngle of the modes HOR_IDX + k and VER_IDX + k
+  static const int angTable[17] = { 0, 1, 2, 3, 4, 6, 8, 10, 12, 14, 16, 18, 20, 23, 26, 29, 32 };
+
+  m_numUnitsX = ( m_ctuArea.width  + 3 ) >> 2;
+  m_numUnitsY = ( m_ctuArea.height + 3 ) >> 2;
+
+  const int stride = ( m_numUnitsX + 1 ) * NUM_LUMA_MODE;
+  m_integral.assign( ( m_numUnitsY + 1 ) * stride, 0 );
+
+  // keep the sums of a 128x128 CTU within 32 bit for any bit depth
+  const int shift = std::max( 0, bitDepth - 10 );
+
+  for( int y = m_ctuArea.y; y < m_ctuArea.y + m_ctuArea.height; y++ )
+  {
+    if( y == 0 || y + 1 >= picArea.height )
+    {
+      continue;
+    }
+
+    const Pel *rowT = org.bufAt( 0, y - 1 );
+    const Pel *rowC = org.bufAt( 0, y );
+    const Pel *rowB = org.bufAt( 0, y + 1 );
+    uint32_t  *unit = &m_integral[( ( ( y - m_ctuArea.y ) >> 2 ) + 1 ) * stride + NUM_LUMA_MODE];
+
+    for( int x = std::max( m_ctuArea.x, 1 ); x < std::min( m_ctuArea.x + m_ctuArea.width, picArea.width - 1 ); x++ )
+    {
+      const int gx = ( rowT[x + 1] - rowT[x - 1] ) + 2 * ( rowC[x + 1] - rowC[x - 1] ) + ( rowB[x + 1] - rowB[x - 1] );
+      const int gy = ( rowB[x - 1] - rowT[x - 1] ) + 2 * ( rowB[x] - rowT[x] ) + ( rowB[x + 1] - rowT[x + 1] );
+
+      if( gx == 0 && gy == 0 )
+      {
+        continue;
+      }
+
+      // the edge runs perpendicular to the gradient
+      int ex = -gy;
+      int ey = gx;
+      int mode;
+
+      if( abs( ex ) <= abs( ey ) )
+      {
+        if( ey > 0 )
+        {
+          ex = -ex;
+          ey = -ey;
+        }
+        const int num = abs( ex ), den = -ey;
+        int k = 0;
+        while( k < 16 && 64 * num > ( angTable[k] + angTable[k + 1] ) * den )
+        {
+          k++;
+        }
+        mode = ex < 0 ? VER_IDX - k : VER_IDX + k;
+      }
+      else
+      {
+        if( ex > 0 )
+        {
+          ex = -ex;
+          ey = -ey;
+        }
+        const int num = abs( ey ), den = -ex;
+        int k = 0;
+        while( k < 16 && 64 * num > ( angTable[k] + angTable[k + 1] ) * den )
+        {
+          k++;
+        }
+        mode = ey > 0 ? HOR_IDX - k : HOR_IDX + k;
+      }
+
+      unit[( ( x - m_ctuArea.x ) >> 2 ) * NUM_LUMA_MODE + mode] += ( abs( gx ) + abs( gy ) ) >> shift;
+    }
+  }
+
+  // turn the unit histograms into the integral image
+  for( int uy = 1; uy <= m_numUnitsY; uy++ )
+  {
+    uint32_t       *cur   = &m_integral[uy * stride];
+    const uint32_t *above = cur - stride;
+
+    for( int ux = 1; ux <= m_numUnitsX; ux++ )
+    {
+      for( int mode = 0; mode < NUM_LUMA_MODE; mode++ )
+      {
+        const int i = ux * NUM_LUMA_MODE + mode;
+        cur[i] += cur[i - NUM_LUMA_MODE] + above[i] - above[i - NUM_LUMA_MODE];
+      }
+    }
+  }
+}
+
 IntraSearch::IntraSearch()
   : m_pSplitCS      (nullptr)
   , m_pFullCS       (nullptr)
@@ -64,6 +201,10 @@ IntraSearch::IntraSearch()
   , m_CtxCache      (nullptr)
   , m_isInitialized (false)
 {
+  m_numGradHistSkipped       = 0;
+  m_intraCandCacheSize       = 0;
+  m_numIntraCandCacheLookups = 0;
+  m_numIntraCandCacheHits    = 0;
   for( uint32_t ch = 0; ch < MAX_NUM_TBLOCKS; ch++ )
   {
     m_pSharedPredTransformSkip[ch] = nullptr;
@@ -159,6 +300,23 @@ void IntraSearch::destroy()
 
   m_tmpStorageLCU.destroy();
   m_colorTransResiBuf.destroy();
+
+  if (m_numGradHistSkipped > 0)
+  {
+    msg(DETAILS, "Intra gradient histogram: %llu SATD predictions skipped\n", (unsigned long long) m_numGradHistSkipped);
+  }
+  m_numGradHistSkipped = 0;
+  m_gradHist.reset();
+
+  if (m_numIntraCandCacheLookups > 0)
+  {
+    msg(DETAILS, "Intra candidate cache: %llu of %llu lookups hit\n", (unsigned long long) m_numIntraCandCacheHits,
+        (unsigned long long) m_numIntraCandCacheLookups);
+  }
+  m_numIntraCandCacheLookups = 0;
+  m_numIntraCandCacheHits    = 0;
+  resetIntraCandCache();
+  m_intraCandCache.clear();
   m_isInitialized = false;
   if (m_indexError[0] != nullptr)
   {
@@ -299,6 +457,10 @@ void IntraSearch::init(EncCfg *pcEncCfg, TrQuant *pcTrQuant, RdCost *pcRdCost, C
 #endif
   }
 
+  m_gradHist.reset();
+  m_numGradHistSkipped = 0;
+  resetIntraCandCache();
+
   m_isInitialized = true;
   if (pcEncCfg->getPLTMode())
   {
@@ -525,6 +687,197 @@ bool IntraSearch::isValidIntraPredChroma(PredictionUnit &pu, int lumaDirMode, in
 }
 #endif
 
+bool IntraSearch::xGetGradHistModes(PredictionUnit &pu, bool keepMode[NUM_LUMA_MODE])
+{
+  uint32_t hist[NUM_LUMA_MODE];
+  m_gradHist.getHist(*pu.cs, pu.Y(), hist);
+
+  // an even angular mode also collects the extended modes next to it, those are refined in the second SATD round
+  const int numAngModes = (VDIA_IDX - 2) / 2 + 1;
+  int       angModes[numAngModes];
+  uint32_t  energy[NUM_LUMA_MODE];
+  uint64_t  totalEnergy = 0;
+
+  for (int i = 0; i < numAngModes; i++)
+  {
+    const int mode = 2 + 2 * i;
+    angModes[i]    = mode;
+    energy[mode]   = hist[mode] + (mode > 2 ? hist[mode - 1] : 0) + (mode < VDIA_IDX ? hist[mode + 1] : 0);
+    totalEnergy += energy[mode];
+  }
+  if (totalEnergy == 0)
+  {
+    return false;
+  }
+
+  std::partial_sort(angModes, angModes + GRAD_HIST_NUM_ANG_CAND, angModes + numAngModes,
+                    [&energy](const int a, const int b) { return energy[a] > energy[b] || (energy[a] == energy[b] && a < b); });
+
+  std::fill_n(keepMode, NUM_LUMA_MODE, false);
+  keepMode[PLANAR_IDX] = true;
+  keepMode[DC_IDX]     = true;
+  for (int i = 0; i < GRAD_HIST_NUM_ANG_CAND; i++)
+  {
+    keepMode[angModes[i]] = true;
+  }
+
+  unsigned mpm[NUM_MOST_PROBABLE_MODES];
+  PU::getIntraMPMs(pu, mpm);
+  for (int i = 0; i < NUM_MOST_PROBABLE_MODES; i++)
+  {
+    keepMode[mpm[i]] = true;
+  }
+  return true;
+}
+
+static inline uint64_t mixIntraCandKey(const uint64_t key, const uint64_t val)
+{
+  return key ^ (val + 0x9e3779b97f4a7c15ull + (key << 6) + (key >> 2));
+}
+
+template<typename T, size_t N> static inline void loadCandList(static_vector<T, N> &dst, const std::vector<T> &src)
+{
+  dst.resize(src.size());
+  std::copy(src.begin(), src.end(), dst.begin());
+}
+
+uint64_t IntraSearch::xGetIntraCandCacheKey(const PredictionUnit &pu, const double lambda, const int flags)
+{
+  const CodingUnit      &cu   = *pu.cu;
+  const CodingStructure &cs   = *cu.cs;
+  const CompArea        &area = pu.Y();
+
+  uint64_t lambdaBits;
+  memcpy(&lambdaBits, &lambda, sizeof(lambdaBits));
+
+  uint64_t key = mixIntraCandKey(0, (uint64_t(area.x) << 48) | (uint64_t(area.y) << 32) | (area.width << 16) | area.height);
+  key          = mixIntraCandKey(key, lambdaBits);
+  key          = mixIntraCandKey(key, (flags << 3) | (cu.colorTransform ? 4 : 0) | DeriveCtx::CtxMipFlag(cu));
+
+  unsigned mpm[NUM_MOST_PROBABLE_MODES];
+  PU::getIntraMPMs(pu, mpm);
+  for (int i = 0; i < NUM_MOST_PROBABLE_MODES; i++)
+  {
+    key = mixIntraCandKey(key, mpm[i]);
+  }
+
+  // availability of the reference sample units above (and above right) and left (and below left), the split paths
+  // reaching the area differ in which of them are already coded
+  const int unitWidth  = cs.pcv->minCUWidth;
+  const int unitHeight = cs.pcv->minCUHeight;
+  uint64_t  avail      = 0;
+  int       numBits    = 0;
+
+  const Position refPosAL = area.pos().offset(-1, -1);
+  avail = cs.isDecomp(refPosAL, CHANNEL_TYPE_LUMA) && cs.getCURestricted(refPosAL, cu, CHANNEL_TYPE_LUMA) ? 1 : 0;
+  numBits++;
+  for (int dx = 0; dx < 2 * int(area.width); dx += unitWidth)
+  {
+    const Position refPos = area.pos().offset(dx, -1);
+    avail = (avail << 1) | (cs.isDecomp(refPos, CHANNEL_TYPE_LUMA) && cs.getCURestricted(refPos, cu, CHANNEL_TYPE_LUMA) ? 1 : 0);
+    if (++numBits == 64)
+    {
+      key     = mixIntraCandKey(key, avail);
+      avail   = 0;
+      numBits = 0;
+    }
+  }
+  for (int dy = 0; dy < 2 * int(area.height); dy += unitHeight)
+  {
+    const Position refPos = area.pos().offset(-1, dy);
+    avail = (avail << 1) | (cs.isDecomp(refPos, CHANNEL_TYPE_LUMA) && cs.getCURestricted(refPos, cu, CHANNEL_TYPE_LUMA) ? 1 : 0);
+    if (++numBits == 64)
+    {
+      key     = mixIntraCandKey(key, avail);
+      avail   = 0;
+      numBits = 0;
+    }
+  }
+
+  return mixIntraCandKey(key, avail);
+}
+
+bool IntraSearch::xLoadIntraCandCache(const uint64_t key, PredictionUnit &pu, const double lambda,
+                                      int &numModesForFullRD, static_vector<ModeInfo, FAST_UDI_MAX_RDMODE_NUM> &rdModeList,
+                                      static_vector<double, FAST_UDI_MAX_RDMODE_NUM>   &candCostList,
+                                      static_vector<ModeInfo, FAST_UDI_MAX_RDMODE_NUM> &hadModeList,
+                                      static_vector<double, FAST_UDI_MAX_RDMODE_NUM>   &candHadList,
+                                      const bool loadISP, const bool loadLFNST)
+{
+  m_numIntraCandCacheLookups++;
+
+  const auto it = m_intraCandCacheIdx.find(key);
+  if (it == m_intraCandCacheIdx.end())
+  {
+    return false;
+  }
+  const IntraCandCacheEntry &entry = m_intraCandCache[it->second];
+  if (entry.area != pu.Y() || entry.lambda != lambda)
+  {
+    return false;
+  }
+
+  numModesForFullRD = entry.numModesForFullRD;
+  loadCandList(rdModeList, entry.rdModeList);
+  loadCandList(candCostList, entry.candCostList);
+  loadCandList(hadModeList, entry.hadModeList);
+  loadCandList(candHadList, entry.candHadList);
+  if (loadISP)
+  {
+    loadCandList(m_ispCandListHor, entry.ispCandListHor);
+  }
+  if (loadLFNST)
+  {
+    m_savedNumRdModesLFNST  = entry.savedNumRdModesLFNST;
+    loadCandList(m_savedRdModeListLFNST, entry.savedRdModeListLFNST);
+    loadCandList(m_savedModeCostLFNST, entry.savedModeCostLFNST);
+    loadCandList(m_savedHadModeListLFNST, entry.savedHadModeListLFNST);
+    loadCandList(m_savedHadListLFNST, entry.savedHadListLFNST);
+  }
+  pu.cu->mipFlag = entry.mipFlag;
+  pu.multiRefIdx = entry.multiRefIdx;
+
+  m_numIntraCandCacheHits++;
+  return true;
+}
+
+void IntraSearch::xStoreIntraCandCache(const uint64_t key, const PredictionUnit &pu, const double lambda,
+                                       const int numModesForFullRD,
+                                       const static_vector<ModeInfo, FAST_UDI_MAX_RDMODE_NUM> &rdModeList,
+                                       const static_vector<double, FAST_UDI_MAX_RDMODE_NUM>   &candCostList,
+                                       const static_vector<ModeInfo, FAST_UDI_MAX_RDMODE_NUM> &hadModeList,
+                                       const static_vector<double, FAST_UDI_MAX_RDMODE_NUM>   &candHadList)
+{
+  if (m_intraCandCacheSize >= INTRA_CAND_CACHE_SIZE)
+  {
+    return;
+  }
+  if (m_intraCandCache.size() <= m_intraCandCacheSize)
+  {
+    m_intraCandCache.emplace_back();
+  }
+
+  IntraCandCacheEntry &entry = m_intraCandCache[m_intraCandCacheSize];
+
+  entry.area                  = pu.Y();
+  entry.lambda                = lambda;
+  entry.numModesForFullRD     = numModesForFullRD;
+  entry.rdModeList.assign(rdModeList.begin(), rdModeList.end());
+  entry.candCostList.assign(candCostList.begin(), candCostList.end());
+  entry.hadModeList.assign(hadModeList.begin(), hadModeList.end());
+  entry.candHadList.assign(candHadList.begin(), candHadList.end());
+  entry.ispCandListHor.assign(m_ispCandListHor.begin(), m_ispCandListHor.end());
+  entry.savedNumRdModesLFNST  = m_savedNumRdModesLFNST;
+  entry.savedRdModeListLFNST.assign(m_savedRdModeListLFNST.begin(), m_savedRdModeListLFNST.end());
+  entry.savedModeCostLFNST.assign(m_savedModeCostLFNST.begin(), m_savedModeCostLFNST.end());
+  entry.savedHadModeListLFNST.assign(m_savedHadModeListLFNST.begin(), m_savedHadModeListLFNST.end());
+  entry.savedHadListLFNST.assign(m_savedHadListLFNST.begin(), m_savedHadListLFNST.end());
+  entry.mipFlag               = pu.cu->mipFlag;
+  entry.multiRefIdx           = pu.multiRefIdx;
+
+  m_intraCandCacheIdx[key] = m_intraCandCacheSize++;
+}
+
 bool IntraSearch::estIntraPredLumaQT(CodingUnit &cu, Partitioner &partitioner, const double bestCostSoFar, bool mtsCheckRangeFlag, int mtsFirstCheckId, int mtsLastCheckId, bool moreProbMTSIdxFirst, CodingStructure* bestCS)
 {
   CodingStructure &cs  = *cu.cs;
@@ -659,7 +1012,27 @@ bool IntraSearch::estIntraPredLumaQT(CodingUnit &cu, Partitioner &partitioner, c
         int  numOfPassesExtendRef = ((!sps.getUseMRL() || isFirstLineOfCtu) ? 1 : MRL_NUM_REF_LINES);
         pu.multiRefIdx            = 0;
 
-        if (numModesForFullRD != numModesAvailable)
+        // the SATD candidates of an area reached again through another split path with the same MPMs and the same
+        // neighbour availability are reused
+        const bool useCandCache =
+          m_pcEncCfg->getFastIntraCandReuse() && numModesForFullRD != numModesAvailable && !lfnstLoadFlag;
+        uint64_t   candCacheKey = 0;
+        if (useCandCache)
+        {
+          int candCacheFlags = (lfnstSaveFlag ? 1 : 0) | (saveDataForISP ? 2 : 0);
+#if GDR_ENABLED
+          candCacheFlags |= isEncodeGdrClean ? 4 : 0;
+#endif
+          candCacheKey = xGetIntraCandCacheKey(pu, sqrtLambdaForFirstPass, candCacheFlags);
+        }
+
+        if (useCandCache
+            && xLoadIntraCandCache(candCacheKey, pu, sqrtLambdaForFirstPass, numModesForFullRD, rdModeList,
+                                   candCostList, hadModeList, candHadList, saveDataForISP, lfnstSaveFlag))
+        {
+          lfnstSaveFlag = false;
+        }
+        else if (numModesForFullRD != numModesAvailable)
         {
           CHECK(numModesForFullRD >= numModesAvailable, "Too many modes for full RD search");
 
@@ -710,6 +1083,9 @@ bool IntraSearch::estIntraPredLumaQT(CodingUnit &cu, Partitioner &partitioner, c
 
           if (!lfnstLoadFlag)
           {
+            bool       keepMode[NUM_LUMA_MODE];
+            const bool gradHistPrune = m_pcEncCfg->getFastIntraGradHist() && xGetGradHistModes(pu, keepMode);
+
             for (int modeIdx = 0; modeIdx < numModesAvailable; modeIdx++)
             {
               uint32_t   mode      = modeIdx;
@@ -720,6 +1096,12 @@ bool IntraSearch::estIntraPredLumaQT(CodingUnit &cu, Partitioner &partitioner, c
               {
                 continue;
               }
+              // Skip the angular modes off the dominant gradient orientations of the original block
+              if (gradHistPrune && !keepMode[mode])
+              {
+                m_numGradHistSkipped++;
+                continue;
+              }
 
               satdChecked[mode] = true;
 
@@ -988,7 +1370,7 @@ bool IntraSearch::estIntraPredLumaQT(CodingUnit &cu, Partitioner &partitioner, c
               double mipHadCost[MAX_NUM_MIP_MODE] = { MAX_DOUBLE };
 
               initIntraPatternChType(cu, pu.Y());
-              initIntraMip(pu, pu.Y());
+              initIntraMipAllModes(pu, pu.Y());
 
               const int transpOff    = getNumModesMip(pu.Y());
               const int numModesFull = (transpOff << 1);
@@ -1143,6 +1525,12 @@ bool IntraSearch::estIntraPredLumaQT(CodingUnit &cu, Partitioner &partitioner, c
               }
             }
           }
+
+          if (useCandCache)
+          {
+            xStoreIntraCandCache(candCacheKey, pu, sqrtLambdaForFirstPass, numModesForFullRD, rdModeList,
+                                 candCostList, hadModeList, candHadList);
+          }
         }
         else
         {
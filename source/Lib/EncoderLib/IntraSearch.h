@@ -49,6 +49,8 @@
 #include "CommonLib/RdCost.h"
 #include "EncReshape.h"
 
+#include <unordered_map>
+
 //! \ingroup EncoderLib
 //! \{
 
@@ -185,6 +187,28 @@ private:
   uint32_t cnt[MAX_NUM_COMPONENT+1];
   int shift[3], lastCnt[3], data[3], sumData[3];
 };
+
+/// Sobel gradient orientation histogram of the original luma over the intra modes, built once per CTU as an integral
+/// image of 4x4 units so the histogram of any CU of the split tree costs four lookups per mode
+class IntraGradHist
+{
+public:
+  IntraGradHist() : m_pic( nullptr ), m_poc( 0 ), m_numUnitsX( 0 ), m_numUnitsY( 0 ) {}
+
+  void      reset   ();
+  void      getHist ( const CodingStructure &cs, const CompArea &area, uint32_t hist[NUM_LUMA_MODE] );
+
+private:
+  void      xBuild  ( const CPelBuf &org, const Area &picArea, const int bitDepth );
+
+  const Picture        *m_pic;
+  int                   m_poc;
+  Area                  m_ctuArea;
+  int                   m_numUnitsX;
+  int                   m_numUnitsY;
+  std::vector<uint32_t> m_integral; ///< [unitY][unitX][mode], sums of the units above and left of the position
+};
+
 /// encoder search class
 class IntraSearch : public IntraPrediction
 {
@@ -228,6 +252,27 @@ private:
     static bool compareModeInfoWithCost(ModeInfoWithCost a, ModeInfoWithCost b) { return a.rdCost < b.rdCost; }
   };
 
+  /// SATD candidate lists of the luma intra search of a CU area, reused when the same area is reached again through
+  /// another split path of the CTU with the same QP, MPMs and neighbour availability
+  struct IntraCandCacheEntry
+  {
+    Area                  area;
+    double                lambda;
+    int                   numModesForFullRD;
+    std::vector<ModeInfo> rdModeList;
+    std::vector<double>   candCostList;
+    std::vector<ModeInfo> hadModeList;
+    std::vector<double>   candHadList;
+    std::vector<ModeInfo> ispCandListHor;
+    uint32_t              savedNumRdModesLFNST;
+    std::vector<ModeInfo> savedRdModeListLFNST;
+    std::vector<ModeInfo> savedHadModeListLFNST;
+    std::vector<double>   savedModeCostLFNST;
+    std::vector<double>   savedHadListLFNST;
+    bool                  mipFlag;
+    int                   multiRefIdx;
+  };
+
   struct ISPTestedModeInfo
   {
     int    numCompSubParts;
@@ -367,6 +412,15 @@ private:
 
   PelStorage      m_tmpStorageLCU;
   PelStorage      m_colorTransResiBuf;
+
+  IntraGradHist   m_gradHist;
+  uint64_t        m_numGradHistSkipped;
+
+  std::vector<IntraCandCacheEntry>  m_intraCandCache;
+  std::unordered_map<uint64_t, int> m_intraCandCacheIdx;
+  int                               m_intraCandCacheSize;
+  uint64_t                          m_numIntraCandCacheLookups;
+  uint64_t                          m_numIntraCandCacheHits;
 protected:
   // interface to option
   EncCfg*         m_pcEncCfg;
@@ -414,6 +468,7 @@ public:
   CodingStructure  **getSaveCSBuf () { return m_pSaveCS; }
 
   void setModeCtrl                ( EncModeCtrl *modeCtrl ) { m_modeCtrl = modeCtrl; }
+  void resetIntraCandCache        ()                        { m_intraCandCacheIdx.clear(); m_intraCandCacheSize = 0; }
 
   bool getSaveCuCostInSCIPU       ()               { return m_saveCuCostInSCIPU; }
   void setSaveCuCostInSCIPU       ( bool b )       { m_saveCuCostInSCIPU = b;  }
@@ -459,6 +514,22 @@ protected:
   uint64_t xGetIntraFracBitsQTChroma(TransformUnit& tu, const ComponentID &compID);
   void xEncCoeffQT                                 ( CodingStructure &cs, Partitioner& pm, const ComponentID compID, const int subTuIdx = -1, const PartSplit ispType = TU_NO_ISP, CUCtx * cuCtx = nullptr );
 
+  bool xGetGradHistModes(PredictionUnit &pu, bool keepMode[NUM_LUMA_MODE]);
+
+  uint64_t xGetIntraCandCacheKey(const PredictionUnit &pu, const double lambda, const int flags);
+  bool     xLoadIntraCandCache(const uint64_t key, PredictionUnit &pu, const double lambda, int &numModesForFullRD,
+                               static_vector<ModeInfo, FAST_UDI_MAX_RDMODE_NUM> &rdModeList,
+                               static_vector<double, FAST_UDI_MAX_RDMODE_NUM>   &candCostList,
+                               static_vector<ModeInfo, FAST_UDI_MAX_RDMODE_NUM> &hadModeList,
+                               static_vector<double, FAST_UDI_MAX_RDMODE_NUM>   &candHadList,
+                               const bool loadISP, const bool loadLFNST);
+  void     xStoreIntraCandCache(const uint64_t key, const PredictionUnit &pu, const double lambda,
+                                const int numModesForFullRD,
+                                const static_vector<ModeInfo, FAST_UDI_MAX_RDMODE_NUM> &rdModeList,
+                                const static_vector<double, FAST_UDI_MAX_RDMODE_NUM>   &candCostList,
+                                const static_vector<ModeInfo, FAST_UDI_MAX_RDMODE_NUM> &hadModeList,
+                                const static_vector<double, FAST_UDI_MAX_RDMODE_NUM>   &candHadList);
+
   void xIntraCodingTUBlock(TransformUnit &tu, const ComponentID &compID, Distortion &dist,
                            const int &default0Save1Load2 = 0, uint32_t *numSig = nullptr, TrModeList *trModes = nullptr,
                            const bool loadTr = false);